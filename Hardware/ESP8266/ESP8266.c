@@ -1,6 +1,7 @@
 #include "ESP8266.h"
 #include <stdio.h>
 #include <stdarg.h>
+#include "Format.h"
 
 /*
  * 文件名：ESP8266.c
@@ -33,9 +34,9 @@ void DataForward_Init(void)
 
     // 发送初始化消息
     char init_msg[64];
-    snprintf(init_msg, sizeof(init_msg),
-             "Data Forwarder Initialized (Format: %s)\r\n",
-             forwarder_state.format == FORMAT_JSON ? "JSON" : "CSV");
+    Format_Sprintf(init_msg, sizeof(init_msg),
+                   "Data Forwarder Initialized (Format: %s)\r\n",
+                   forwarder_state.format == FORMAT_JSON ? "JSON" : "CSV");
     USART1_SendString(init_msg);
 }
 
@@ -49,9 +50,9 @@ void DataForward_SetFormat(DataFormat_t format)
     forwarder_state.format = format;
 
     char msg[64];
-    snprintf(msg, sizeof(msg),
-             "Data format changed to: %s\r\n",
-             format == FORMAT_JSON ? "JSON" : "CSV");
+    Format_Sprintf(msg, sizeof(msg),
+                   "Data format changed to: %s\r\n",
+                   format == FORMAT_JSON ? "JSON" : "CSV");
     USART1_SendString(msg);
 }
 
@@ -65,7 +66,7 @@ void DataForward_SetDelimiter(char delimiter)
     forwarder_state.delimiter = delimiter;
 
     char msg[32];
-    snprintf(msg, sizeof(msg), "CSV delimiter set to: '%c'\r\n", delimiter);
+    Format_Sprintf(msg, sizeof(msg), "CSV delimiter set to: '%c'\r\n", delimiter);
     USART1_SendString(msg);
 }
 
@@ -79,8 +80,8 @@ void DataForward_EnableTimestamp(bool enable)
     forwarder_state.auto_timestamp = enable;
 
     char msg[48];
-    snprintf(msg, sizeof(msg), "Auto timestamp: %s\r\n",
-             enable ? "Enabled" : "Disabled");
+    Format_Sprintf(msg, sizeof(msg), "Auto timestamp: %s\r\n",
+                   enable ? "Enabled" : "Disabled");
     USART1_SendString(msg);
 }
 
@@ -94,8 +95,8 @@ void DataForward_EnablePrettyJson(bool enable)
     forwarder_state.pretty_json = enable;
 
     char msg[48];
-    snprintf(msg, sizeof(msg), "Pretty JSON: %s\r\n",
-             enable ? "Enabled" : "Disabled");
+    Format_Sprintf(msg, sizeof(msg), "Pretty JSON: %s\r\n",
+                   enable ? "Enabled" : "Disabled");
     USART1_SendString(msg);
 }
 
@@ -112,7 +113,7 @@ void DataForward_SetDeviceID(const char *device_id_str)
         device_id[sizeof(device_id) - 1] = '\0';
 
         char msg[48];
-        snprintf(msg, sizeof(msg), "Device ID set to: %s\r\n", device_id);
+        Format_Sprintf(msg, sizeof(msg), "Device ID set to: %s\r\n", device_id);
         USART1_SendString(msg);
     }
 }
@@ -255,16 +256,20 @@ void DataPacket_Clear(DataPacket_t *packet)
  **/
 static void format_csv(DataPacket_t *packet, char *buffer, uint16_t size)
 {
-    int pos = 0;
+    Format_t fmt; // 流式追加，缓冲区满时自动截断，不会越界
+
+    Format_Init(&fmt, buffer, size);
 
     // 添加设备ID
-    pos += snprintf(buffer + pos, size - pos, "device:%s", packet->device_id);
+    Format_Str(&fmt, "device:");
+    Format_Str(&fmt, packet->device_id);
 
     // 添加时间戳
     if (forwarder_state.auto_timestamp)
     {
-        pos += snprintf(buffer + pos, size - pos, "%cts:%lu",
-                        forwarder_state.delimiter, packet->timestamp);
+        Format_Char(&fmt, forwarder_state.delimiter);
+        Format_Str(&fmt, "ts:");
+        Format_Uint(&fmt, packet->timestamp, 0, 0);
     }
 
     // 添加传感器数据
@@ -272,32 +277,29 @@ static void format_csv(DataPacket_t *packet, char *buffer, uint16_t size)
     {
         SensorData_t *sensor = &packet->sensors[i];
 
-        pos += snprintf(buffer + pos, size - pos, "%c%s:",
-                        forwarder_state.delimiter, sensor->name);
+        Format_Char(&fmt, forwarder_state.delimiter);
+        Format_Str(&fmt, sensor->name);
+        Format_Char(&fmt, ':');
 
         switch (sensor->type)
         {
         case DATA_TYPE_INT:
-            pos += snprintf(buffer + pos, size - pos, "%ld",
-                            sensor->value.int_value);
+            Format_Int(&fmt, sensor->value.int_value, 0, 0);
             break;
         case DATA_TYPE_FLOAT:
-            pos += snprintf(buffer + pos, size - pos, "%.2f",
-                            sensor->value.float_value);
+            Format_Float(&fmt, sensor->value.float_value, 2);
             break;
         case DATA_TYPE_STRING:
-            pos += snprintf(buffer + pos, size - pos, "%s",
-                            sensor->value.string_value);
+            Format_Str(&fmt, sensor->value.string_value);
             break;
         case DATA_TYPE_BOOL:
-            pos += snprintf(buffer + pos, size - pos, "%s",
-                            sensor->value.bool_value ? "true" : "false");
+            Format_Str(&fmt, sensor->value.bool_value ? "true" : "false");
             break;
         }
     }
 
     // 添加换行符
-    pos += snprintf(buffer + pos, size - pos, "\r\n");
+    Format_Str(&fmt, "\r\n");
 }
 
 /**
@@ -309,91 +311,54 @@ static void format_csv(DataPacket_t *packet, char *buffer, uint16_t size)
  **/
 static void format_json(DataPacket_t *packet, char *buffer, uint16_t size)
 {
-    int pos = 0;
+    Format_t fmt; // 流式追加，缓冲区满时自动截断，不会越界
+    const char *sep = forwarder_state.pretty_json ? ",\r\n  \"" : ",\"";   // 字段分隔
+    const char *colon = forwarder_state.pretty_json ? "\": " : "\":";     // 键值分隔
 
-    if (forwarder_state.pretty_json)
-    {
-        // 美化格式
-        pos += snprintf(buffer + pos, size - pos, "{\r\n");
-        pos += snprintf(buffer + pos, size - pos, "  \"device\": \"%s\"",
-                        packet->device_id);
+    Format_Init(&fmt, buffer, size);
 
-        if (forwarder_state.auto_timestamp)
-        {
-            pos += snprintf(buffer + pos, size - pos, ",\r\n  \"timestamp\": %lu",
-                            packet->timestamp);
-        }
-
-        for (uint8_t i = 0; i < packet->sensor_count; i++)
-        {
-            SensorData_t *sensor = &packet->sensors[i];
-
-            pos += snprintf(buffer + pos, size - pos, ",\r\n  \"%s\": ", sensor->name);
-
-            switch (sensor->type)
-            {
-            case DATA_TYPE_INT:
-                pos += snprintf(buffer + pos, size - pos, "%ld",
-                                sensor->value.int_value);
-                break;
-            case DATA_TYPE_FLOAT:
-                pos += snprintf(buffer + pos, size - pos, "%.2f",
-                                sensor->value.float_value);
-                break;
-            case DATA_TYPE_STRING:
-                pos += snprintf(buffer + pos, size - pos, "\"%s\"",
-                                sensor->value.string_value);
-                break;
-            case DATA_TYPE_BOOL:
-                pos += snprintf(buffer + pos, size - pos, "%s",
-                                sensor->value.bool_value ? "true" : "false");
-                break;
-            }
-        }
+    Format_Str(&fmt, forwarder_state.pretty_json ? "{\r\n  \"device" : "{\"device");
+    Format_Str(&fmt, colon);
+    Format_Char(&fmt, '"');
+    Format_Str(&fmt, packet->device_id);
+    Format_Char(&fmt, '"');
 
-        pos += snprintf(buffer + pos, size - pos, "\r\n}\r\n");
+    if (forwarder_state.auto_timestamp)
+    {
+        Format_Str(&fmt, sep);
+        Format_Str(&fmt, "timestamp");
+        Format_Str(&fmt, colon);
+        Format_Uint(&fmt, packet->timestamp, 0, 0);
     }
-    else
+
+    for (uint8_t i = 0; i < packet->sensor_count; i++)
     {
-        // 紧凑格式
-        pos += snprintf(buffer + pos, size - pos, "{\"device\":\"%s\"",
-                        packet->device_id);
+        SensorData_t *sensor = &packet->sensors[i];
 
-        if (forwarder_state.auto_timestamp)
-        {
-            pos += snprintf(buffer + pos, size - pos, ",\"timestamp\":%lu",
-                            packet->timestamp);
-        }
+        Format_Str(&fmt, sep);
+        Format_Str(&fmt, sensor->name);
+        Format_Str(&fmt, colon);
 
-        for (uint8_t i = 0; i < packet->sensor_count; i++)
+        switch (sensor->type)
         {
-            SensorData_t *sensor = &packet->sensors[i];
-
-            pos += snprintf(buffer + pos, size - pos, ",\"%s\":", sensor->name);
-
-            switch (sensor->type)
-            {
-            case DATA_TYPE_INT:
-                pos += snprintf(buffer + pos, size - pos, "%ld",
-                                sensor->value.int_value);
-                break;
-            case DATA_TYPE_FLOAT:
-                pos += snprintf(buffer + pos, size - pos, "%.2f",
-                                sensor->value.float_value);
-                break;
-            case DATA_TYPE_STRING:
-                pos += snprintf(buffer + pos, size - pos, "\"%s\"",
-                                sensor->value.string_value);
-                break;
-            case DATA_TYPE_BOOL:
-                pos += snprintf(buffer + pos, size - pos, "%s",
-                                sensor->value.bool_value ? "true" : "false");
-                break;
-            }
+        case DATA_TYPE_INT:
+            Format_Int(&fmt, sensor->value.int_value, 0, 0);
+            break;
+        case DATA_TYPE_FLOAT:
+            Format_Float(&fmt, sensor->value.float_value, 2);
+            break;
+        case DATA_TYPE_STRING:
+            Format_Char(&fmt, '"');
+            Format_Str(&fmt, sensor->value.string_value);
+            Format_Char(&fmt, '"');
+            break;
+        case DATA_TYPE_BOOL:
+            Format_Str(&fmt, sensor->value.bool_value ? "true" : "false");
+            break;
         }
-
-        pos += snprintf(buffer + pos, size - pos, "}\r\n");
     }
+
+    Format_Str(&fmt, forwarder_state.pretty_json ? "\r\n}\r\n" : "}\r\n");
 }
 
 /**
@@ -514,7 +479,7 @@ void DataForward_ResetCounter(void)
     forwarder_state.packet_counter = 0;
 
     char msg[32];
-    snprintf(msg, sizeof(msg), "Packet counter reset\r\n");
+    Format_Sprintf(msg, sizeof(msg), "Packet counter reset\r\n");
     USART1_SendString(msg);
 }
 
@@ -527,21 +492,21 @@ void DataForward_PrintStatus(void)
 {
     char status_msg[128];
 
-    snprintf(status_msg, sizeof(status_msg),
-             "\r\n=== Data Forwarder Status ===\r\n"
-             "Format: %s\r\n"
-             "Auto Timestamp: %s\r\n"
-             "Pretty JSON: %s\r\n"
-             "CSV Delimiter: '%c'\r\n"
-             "Device ID: %s\r\n"
-             "Packet Count: %lu\r\n"
-             "=============================\r\n",
-             DataForward_GetFormatString(),
-             forwarder_state.auto_timestamp ? "Yes" : "No",
-             forwarder_state.pretty_json ? "Yes" : "No",
-             forwarder_state.delimiter,
-             device_id,
-             forwarder_state.packet_counter);
+    Format_Sprintf(status_msg, sizeof(status_msg),
+                   "\r\n=== Data Forwarder Status ===\r\n"
+                   "Format: %s\r\n"
+                   "Auto Timestamp: %s\r\n"
+                   "Pretty JSON: %s\r\n"
+                   "CSV Delimiter: '%c'\r\n"
+                   "Device ID: %s\r\n"
+                   "Packet Count: %lu\r\n"
+                   "=============================\r\n",
+                   DataForward_GetFormatString(),
+                   forwarder_state.auto_timestamp ? "Yes" : "No",
+                   forwarder_state.pretty_json ? "Yes" : "No",
+                   forwarder_state.delimiter,
+                   device_id,
+                   forwarder_state.packet_counter);
 
     USART1_SendString(status_msg);
 }
@@ -568,7 +533,7 @@ void ESP8266_SendCommand(const char *command)
 void ESP8266_SendIntKeyValue(const char *key, int32_t value)
 {
     char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%s=%ld\r\n", key, value);
+    Format_Sprintf(buffer, sizeof(buffer), "%s=%ld\r\n", key, value);
     USART1_SendString(buffer);
 }
 
@@ -582,7 +547,7 @@ void ESP8266_SendIntKeyValue(const char *key, int32_t value)
 void ESP8266_SendFloatKeyValue(const char *key, float value, int decimalPlaces)
 {
     char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%s=%.*f\r\n", key, decimalPlaces, value);
+    Format_Sprintf(buffer, sizeof(buffer), "%s=%.*f\r\n", key, decimalPlaces, value);
     USART1_SendString(buffer);
 }
 
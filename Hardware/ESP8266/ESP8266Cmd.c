@@ -68,6 +68,15 @@ void ESP8266Cmd_Process(const char *data)
         extern void Menu_Back(void);
         Menu_Back();
     }
+    // 屏幕镜像命令
+    else if (strcmp(data, CYZ_CMD_MIRROR_ON) == 0)
+    {
+        Mirror_Enable(1);
+    }
+    else if (strcmp(data, CYZ_CMD_MIRROR_OFF) == 0)
+    {
+        Mirror_Enable(0);
+    }
 }
 
 // ================== 具体命令处理 ==================
@@ -6,6 +6,7 @@
 #include "Statistics.h"
 #include "OLED.h"
 #include "Menu.h"
+#include "Mirror.h"
 #include <string.h>
 
 /******************************************************************************
@@ -19,6 +20,8 @@
 #define CYZ_CMD_PAUSE_COUNT "Pause_count" // 暂停统计
 #define CYZ_CMD_CLEAR_COUNT "Clear_count" // 清零统计
 #define CYZ_CMD_MENU_BACK "Menu_back"     // 返回主菜单
+#define CYZ_CMD_MIRROR_ON "Mirror_on"     // 开启屏幕远程镜像
+#define CYZ_CMD_MIRROR_OFF "Mirror_off"   // 关闭屏幕远程镜像
 
 // STM32发送给ESP8266的数据(已经由ESP8266模块实现)
 
@@ -49,8 +49,8 @@
  * - PA3: 未使用 - 模拟输入 - 由GPIO_Config模块配置
  * - PA4: ADC1采集 (ADC通道4) - 模拟输入 - 由ADC模块配置
  * - PA5: 未使用 - 模拟输入 - 由GPIO_Config模块配置
- * - PA6: 未使用 (原USART1_CK) - 模拟输入 - 由GPIO_Config模块配置
- * - PA7: 未使用 (原USART1_TX) - 模拟输入 - 由GPIO_Config模块配置
+ * - PA6: 旋转编码器A相 (TIM3_CH1) - 上拉输入 - 先配置为模拟输入，Key_Init中由Encoder模块重新配置
+ * - PA7: 旋转编码器B相 (TIM3_CH2) - 上拉输入 - 先配置为模拟输入，Key_Init中由Encoder模块重新配置
  * - PA8: 蜂鸣器 (BUZZER_PIN) - 推挽输出 - 由Buzzer模块配置
  * - PA9: 未使用 (原USART1_TX) - 模拟输入 - 由GPIO_Config模块配置
  * - PA10: 未使用 (原USART1_RX) - 模拟输入 - 由GPIO_Config模块配置
@@ -69,8 +69,8 @@
  * - PB5: DHT11数据线 - 推挽输出 - 由DHT11模块配置
  * - PB6: USART1_TX (重映射) - 复用推挽输出 - 由USART1模块配置
  * - PB7: USART1_RX (重映射) - 浮空输入 - 由USART1模块配置
- * - PB8: OLED_SCL (I2C时钟) - 开漏输出 - 由OLED模块配置
- * - PB9: OLED_SDA (I2C数据) - 开漏输出 - 由OLED模块配置
+ * - PB8: OLED_SCL (I2C1重映射SCL) - 复用开漏 - 由OLED模块配置
+ * - PB9: OLED_SDA (I2C1重映射SDA) - 复用开漏 - 由OLED模块配置
  * - PB10: 按键-返回 (key_back) - 上拉输入 - 由Key_multi模块配置
  * - PB11: 未使用 - 模拟输入 - 由GPIO_Config模块配置
  * - PB12: 未使用 - 模拟输入 - 由GPIO_Config模块配置
@@ -31,8 +31,8 @@
  * PA3  ⚠️ 未使用                          - 模拟输入      - GPIO_Config模块
  * PA4  ✅ ADC1采集                        - 模拟输入      - ADC模块
  * PA5  ⚠️ 未使用                          - 模拟输入      - GPIO_Config模块
- * PA6  ⚠️ 未使用 (USART1重映射后空闲)       - 模拟输入      - GPIO_Config模块
- * PA7  ⚠️ 未使用 (USART1重映射后空闲)       - 模拟输入      - GPIO_Config模块
+ * PA6  ✅ 旋转编码器A相 (TIM3_CH1)        - 上拉输入      - Encoder模块
+ * PA7  ✅ 旋转编码器B相 (TIM3_CH2)        - 上拉输入      - Encoder模块
  * PA8  ✅ 蜂鸣器 (BUZZER_PIN)              - 推挽输出      - Buzzer模块
  * PA9  ⚠️ 未使用 (USART1已重映射到PB6)     - 模拟输入      - GPIO_Config模块
  * PA10 ⚠️ 未使用 (USART1已重映射到PB7)     - 模拟输入      - GPIO_Config模块
@@ -55,8 +55,8 @@
  * PB5  ✅ DHT11数据线                     - 推挽输出      - DHT11模块
  * PB6  ✅ USART1_TX (重映射)             - 复用推挽输出  - USART1模块
  * PB7  ✅ USART1_RX (重映射)             - 浮空输入      - USART1模块
- * PB8  ✅ OLED_SCL (I2C时钟)             - 开漏输出      - OLED模块
- * PB9  ✅ OLED_SDA (I2C数据)             - 开漏输出      - OLED模块
+ * PB8  ✅ OLED_SCL (I2C1重映射)          - 复用开漏      - OLED模块
+ * PB9  ✅ OLED_SDA (I2C1重映射)          - 复用开漏      - OLED模块
  * PB10 ✅ 按键-返回 (key_back)            - 上拉输入      - Key_multi模块
  * PB11 ⚠️ 未使用                          - 模拟输入      - GPIO_Config模块
  * PB12 ⚠️ 未使用                          - 模拟输入      - GPIO_Config模块
@@ -136,8 +136,6 @@
  * 【GPIOA】
  *   - PA3  (模拟输入)
  *   - PA5  (模拟输入)
- *   - PA6  (模拟输入) - 原USART1_CK，USART1已重映射
- *   - PA7  (模拟输入) - 原USART1_TX，USART1已重映射
  *   - PA9  (模拟输入) - 原USART1_TX，USART1已重映射到PB6
  *   - PA10 (模拟输入) - 原USART1_RX，USART1已重映射到PB7
  *   - PA15 (模拟输入)
@@ -224,17 +222,26 @@
  *   - PB10 (TX) - 已被按键占用 (PB10为返回键)
  *   - PB11 (RX) - 未使用，可复用
  *
+ * 【TIM1】
+ *   - 芯片检测过采样（SENSOR_USE_CHIP_OVERSAMPLE）时用作采样间隔定时器，更新事件触发DMA1通道5采样GPIOA->IDR，
+ *     不占用引脚；未开启时未使用
+ *
  * 【TIM2】
- *   - PA0 (CH1), PA1 (CH2) - 已被传感器占用
+ *   - 计数器作为系统1ms时基（Delay模块，1MHz计数）
+ *   - PA0 (CH1) - 定位孔输入捕获（Sensor模块，硬件滤波+最小间隔去抖）
+ *     DMA计数模式（SENSOR_USE_DMA_COUNT）下TIM2改由PA0外部时钟计孔数，CH1捕获触发DMA1通道5采样GPIOA->IDR，
+ *     延时改用SysTick（DELAY_USE_SYSTICK）
+ *   - PA1 (CH2) - 已被芯片检测传感器占用
  *   - PA2 (CH3) - 已被按键占用
  *   - PA3 (CH4) - 未使用，可复用
  *   - PA15 (CH1_ETR) - 未使用，可复用
  *
  * 【TIM3】
- *   - PA6 (CH1), PA7 (CH2) - 未使用 (USART1重映射后空闲)
+ *   - PA6 (CH1), PA7 (CH2) - 旋转编码器（编码器模式，Encoder模块）
  *   - PB0 (CH3), PB1 (CH4) - 已被按键占用
  *
  * 【TIM4】
+ *   - 计数器用作按键1ms采样时基（Key_multi模块，只用更新中断，不占用引脚）
  *   - PB6 (CH1), PB7 (CH2) - 已被USART1重映射占用
  *   - PB8 (CH3), PB9 (CH4) - 已被OLED占用 (I2C模式)
  *
@@ -244,10 +251,10 @@
  *   - PA3 (通道3) - 未使用，可复用
  *   - PA4 (通道4) - 已被ADC模块使用
  *   - PA5 (通道5) - 未使用，可复用
- *   - PA6 (通道6), PA7 (通道7) - 未使用 (USART1重映射后空闲)
+ *   - PA6 (通道6), PA7 (通道7) - 已被旋转编码器占用
  *   - PB0 (通道8), PB1 (通道9) - 已被按键占用
  *
- * 【可用ADC通道】: PA3, PA5, PA6, PA7
+ * 【可用ADC通道】: PA3, PA5
  */
 
 /*******************************************************************************
@@ -263,6 +270,7 @@
  * 2. 已使用引脚（由各模块配置）:
  *    - Sensor模块: PA0, PA1
  *    - Key_multi模块: PA2, PB0, PB1, PB10
+ *    - Encoder模块: PA6, PA7 (TIM3编码器模式，Key_Init中配置)
  *    - USART1模块: PB6 (TX), PB7 (RX) - 重映射模式
  *    - Buzzer模块: PA8
  *    - OLED模块: PB8, PB9 (I2C模式)
@@ -0,0 +1,69 @@
+#include "Encoder.h"
+/*
+文件名：Encoder.c
+描    述：旋转编码器驱动实现文件
+          TIM3编码器模式，两相的边沿都计数（每转过一格计4次），计数器溢出不影响差值计算
+*/
+
+static uint16_t encoder_last = 0; // 上次读取时的计数值
+
+/**
+ * 函    数：编码器初始化
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：PA6、PA7上拉输入，TIM3编码器模式，计数范围0~65535
+ */
+void Encoder_Init(void)
+{
+    GPIO_InitTypeDef GPIO_InitStructure;
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseInitStructure;
+    TIM_ICInitTypeDef TIM_ICInitStructure;
+
+    RCC_APB2PeriphClockCmd(ENCODER_RCC, ENABLE);
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM3, ENABLE);
+
+    /*配置PA6、PA7为上拉输入*/
+    GPIO_InitStructure.GPIO_Pin = ENCODER_PIN_A | ENCODER_PIN_B;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IPU;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_Init(ENCODER_PORT, &GPIO_InitStructure);
+
+    /*时基：不分频，计数值由编码器驱动*/
+    TIM_TimeBaseStructInit(&TIM_TimeBaseInitStructure);
+    TIM_TimeBaseInitStructure.TIM_Period = 65536 - 1;
+    TIM_TimeBaseInitStructure.TIM_Prescaler = 1 - 1;
+    TIM_TimeBaseInitStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+    TIM_TimeBaseInitStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseInit(TIM3, &TIM_TimeBaseInitStructure);
+
+    /*两个通道都打开输入滤波*/
+    TIM_ICStructInit(&TIM_ICInitStructure);
+    TIM_ICInitStructure.TIM_Channel = TIM_Channel_1;
+    TIM_ICInitStructure.TIM_ICFilter = ENCODER_FILTER;
+    TIM_ICInit(TIM3, &TIM_ICInitStructure);
+    TIM_ICInitStructure.TIM_Channel = TIM_Channel_2;
+    TIM_ICInitStructure.TIM_ICFilter = ENCODER_FILTER;
+    TIM_ICInit(TIM3, &TIM_ICInitStructure);
+
+    /*编码器模式：TI1和TI2的边沿都计数，不反相*/
+    TIM_EncoderInterfaceConfig(TIM3, TIM_EncoderMode_TI12, TIM_ICPolarity_Rising, TIM_ICPolarity_Rising);
+
+    TIM_SetCounter(TIM3, 0);
+    encoder_last = 0;
+    TIM_Cmd(TIM3, ENABLE);
+}
+
+/**
+ * 函    数：读取编码器计数变化
+ * 参    数：无
+ * 返 回 值：距上次读取的计数变化，顺时针为正（方向与接线有关）
+ * 说    明：只读计数器，不清零，两次读取之间转动不超过32767个计数即可
+ */
+int16_t Encoder_Read(void)
+{
+    uint16_t count = TIM_GetCounter(TIM3);
+    int16_t delta = (int16_t)(count - encoder_last);
+
+    encoder_last = count;
+    return delta;
+}
@@ -0,0 +1,25 @@
+#ifndef __ENCODER_H
+#define __ENCODER_H
+
+#include "stm32f10x.h"
+
+/*
+ * 文件名：Encoder.h
+ * 描    述：旋转编码器驱动头文件
+ *          A、B相接TIM3的CH1、CH2，定时器工作在编码器模式，硬件完成正交解码和计数，
+ *          旋转过程中不占用CPU，按键模块定期读取计数变化并转换为上下按键事件
+ */
+
+/*编码器引脚定义*/
+#define ENCODER_PIN_A GPIO_Pin_6 // PA6: TIM3_CH1
+#define ENCODER_PIN_B GPIO_Pin_7 // PA7: TIM3_CH2
+#define ENCODER_PORT GPIOA
+#define ENCODER_RCC RCC_APB2Periph_GPIOA
+
+#define ENCODER_FILTER 0xF // 输入滤波（0~0xF），滤除触点抖动
+
+/*函数声明*/
+void Encoder_Init(void);
+int16_t Encoder_Read(void);
+
+#endif
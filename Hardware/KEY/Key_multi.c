@@ -3,291 +3,375 @@
 作    者：褚耀宗
 日    期：2026-1-6
 描    述：按键驱动实现文件
+          TIM4每1ms采样一次，每个按键一个积分器：按下时加1，松开时减1，
+          加到KEY_DEBOUNCE_TIME_MS确认按下，减到0确认释放，抖动只会推迟确认，不会产生多余事件
+          中断只写队列头，主循环只写队列尾，不需要关中断
+          编码器由TIM3硬件计数，采样中断每5ms读一次计数变化，按转速加速后作为上下按键的按下事件
 */
 #include "Key_multi.h"
 
 #define USE_KEY_MUTIL // 启用多功能按键检测文件
 
 #ifdef USE_KEY_MUTIL
-// 全局变量定义
-Key_action Key_action_t = key_none;
-Key_status Key_status_t = key_idle;
-Key_struct Key_struct_t;
 
-// 内部函数声明
-static Key_action Key_read_GND(void);
-static uint32_t Key_Get_Time_Elapsed(uint32_t start_time);
+/*单个按键的采样状态（只在中断中访问）*/
+typedef struct
+{
+    uint8_t integrator;     // 积分器 0~KEY_DEBOUNCE_TIME_MS
+    uint8_t pressed;        // 消抖后的状态
+    uint8_t long_done;      // 本次按下已触发长按
+    uint32_t edge_time;     // 电平第一次变化的时刻
+    uint32_t press_time;    // 确认按下的时刻，长按和连发从这里计时
+    uint32_t next_repeat;   // 下一次连发的时刻
+} Key_ScanState;
+
+static Key_ScanState key_state[KEY_COUNT];
+static volatile uint8_t key_held = 0; // 消抖后按住的按键掩码
+
+/*事件队列：key_head只由Key_Scan修改，key_tail只由主循环修改*/
+static Key_Event_t key_fifo[KEY_FIFO_SIZE];
+static volatile uint8_t key_head = 0;
+static volatile uint8_t key_tail = 0;
+static volatile uint32_t key_overflow = 0;
+
+/*Key_Get_Press_Event中多步事件剩余的步数*/
+static Key_action key_press_key = key_none;
+static uint8_t key_press_left = 0;
+
+#ifdef KEY_USE_ENCODER
+/*编码器加速曲线：两格之间的间隔小于interval_ms时，每格走steps步*/
+static const struct
+{
+    uint16_t interval_ms;
+    uint8_t steps;
+} key_encoder_accel[] = {
+    {15, 8}, // 快速拨动，每秒60格以上
+    {30, 4},
+    {60, 2},
+};
+
+static int16_t key_encoder_counts = 0;    // 不足一格的计数
+static int8_t key_encoder_dir = 0;        // 上一格的方向
+static uint32_t key_encoder_last = 0;     // 上一格的时刻
+static uint8_t key_encoder_timer = 0;     // 读取周期计时
+#endif
+
+/*延迟统计（主循环中更新）*/
+static uint32_t key_latency_last = 0;
+static uint32_t key_latency_max = 0;
 
 /**
- * @brief 读取GPIO按键状态
- * @note 支持多键同时按下,返回组合键值
- * @return Key_action 按键动作码
+ * @brief 读取GPIO按键原始电平
+ * @return uint8_t 按下的按键掩码（低电平有效）
  */
-Key_action Key_read_GND(void)
+static uint8_t Key_read_GND(void)
 {
-    Key_action keys = key_none;
+    uint8_t keys = 0;
 
     if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_0) == 0)
     {
-        keys |= key_up;
+        keys |= KEY_MASK(key_up);
     }
     if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_1) == 0)
     {
-        keys |= key_down;
+        keys |= KEY_MASK(key_down);
     }
     if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10) == 0)
     {
-        keys |= key_back;
+        keys |= KEY_MASK(key_back);
     }
     if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2) == 0)
     {
-        keys |= key_enter;
+        keys |= KEY_MASK(key_enter);
     }
 
     return keys;
 }
 
 /**
- * @brief 计算时间差(带溢出保护)
- * @param start_time 起始时间戳
- * @return uint32_t 经过的毫秒数
+ * @brief 写入一个事件（只在Key_Scan中调用）
+ * @note 队列满时丢弃新事件并计数
  */
-static uint32_t Key_Get_Time_Elapsed(uint32_t start_time)
+static void Key_Push_Event(uint8_t type, uint8_t key, uint8_t count, uint32_t time)
 {
-    uint32_t current_time = Delay_Get_Ticks();
+    uint8_t head = key_head;
 
-    if (current_time >= start_time)
-    {
-        return current_time - start_time;
-    }
-    else
+    if ((uint8_t)(head - key_tail) >= KEY_FIFO_SIZE)
     {
-        // 处理定时器溢出情况
-        return (UINT32_MAX - start_time) + current_time + 1;
+        key_overflow++;
+        return;
     }
+
+    key_fifo[head & (KEY_FIFO_SIZE - 1)].type = type;
+    key_fifo[head & (KEY_FIFO_SIZE - 1)].key = key;
+    key_fifo[head & (KEY_FIFO_SIZE - 1)].keys = key_held;
+    key_fifo[head & (KEY_FIFO_SIZE - 1)].count = count;
+    key_fifo[head & (KEY_FIFO_SIZE - 1)].time = time;
+    key_head = head + 1; // 事件内容写完后再发布
 }
 
+#ifdef KEY_USE_ENCODER
 /**
- * @brief 按键状态机处理函数
- * @note 需要在主循环中周期性调用(建议10ms调用一次)
- * @note 支持短按、长按检测,支持组合键
+ * @brief 读取编码器并产生上下按键事件（只在Key_Scan中调用）
+ * @note 一个读取周期内转过的格数合并为一个事件，步数按两格之间的间隔查加速曲线
  */
-void Key_Status_Process(void)
+static void Key_Scan_Encoder(uint32_t now)
 {
-    Key_action current_keys;
-    uint32_t elapsed_time;
+    int16_t detents;
+    int8_t dir;
+    uint32_t interval;
+    uint16_t steps;
+    uint8_t i;
 
-    switch (Key_status_t)
+    key_encoder_counts += Encoder_Read();
+    detents = key_encoder_counts / KEY_ENCODER_COUNTS;
+    if (detents == 0)
     {
-    /* ========== 空闲状态 ========== */
-    case key_idle:
-        current_keys = Key_read_GND();
+        return;
+    }
+    key_encoder_counts -= detents * KEY_ENCODER_COUNTS;
+
+    dir = detents > 0 ? 1 : -1;
+    if (detents < 0)
+    {
+        detents = -detents;
+    }
 
-        if (current_keys != key_none)
+    // 换向后第一格按慢速处理，避免来回微调时跳步
+    interval = (dir == key_encoder_dir) ? (now - key_encoder_last) / detents : UINT32_MAX;
+    key_encoder_dir = dir;
+    key_encoder_last = now;
+
+    steps = 1;
+    for (i = 0; i < sizeof(key_encoder_accel) / sizeof(key_encoder_accel[0]); i++)
+    {
+        if (interval < key_encoder_accel[i].interval_ms)
         {
-            // 检测到按键按下,记录按键信息
-            Key_action_t = current_keys;
-            Key_status_t = key_debouncing;
-            Key_struct_t.last_time = Delay_Get_Ticks();
-            Key_struct_t.press_start_time =Delay_Get_Ticks();
-            Key_struct_t.long_press_flag = 0;
-            Key_struct_t.repeat_flag = 0;
+            steps = key_encoder_accel[i].steps;
+            break;
         }
-        break;
+    }
+    steps *= detents;
+    if (steps > 255)
+    {
+        steps = 255;
+    }
 
-    /* ========== 消抖状态 ========== */
-    case key_debouncing:
-        current_keys = Key_read_GND();
-        elapsed_time = Key_Get_Time_Elapsed(Key_struct_t.last_time);
+    if ((dir > 0) != KEY_ENCODER_REVERSE)
+    {
+        Key_Push_Event(KEY_EVENT_PRESS, key_down, steps, now);
+    }
+    else
+    {
+        Key_Push_Event(KEY_EVENT_PRESS, key_up, steps, now);
+    }
+}
+#endif
 
-        if (elapsed_time >= KEY_DEBOUNCE_TIME_MS)
+/**
+ * @brief 按键采样
+ * @note 每KEY_SCAN_PERIOD_MS调用一次（TIM4中断），积分消抖并产生事件
+ */
+void Key_Scan(void)
+{
+    uint8_t raw = Key_read_GND();
+    uint32_t now = Delay_Get_Ticks();
+    uint8_t i;
+
+    for (i = 0; i < KEY_COUNT; i++)
+    {
+        Key_ScanState *state = &key_state[i];
+        uint8_t key = i + 1;
+
+        if (raw & KEY_MASK(key))
         {
-            // 消抖完成,确认按键是否仍被按下
-            if (current_keys != key_none)
+            // 从稳定的松开状态离开时记录第一次变化的时刻
+            if (state->integrator == 0)
             {
-                Key_status_t = key_pressing;
-                Key_struct_t.key_pressed_flag = 1; // 设置按下标志
+                state->edge_time = now;
             }
-            else
+            if (state->integrator < KEY_DEBOUNCE_TIME_MS)
             {
-                // 消抖期间按键已释放,回到空闲状态
-                Key_status_t = key_idle;
-                Key_action_t = key_none;
+                state->integrator++;
             }
         }
-        break;
-
-    /* ========== 按下中状态 ========== */
-    case key_pressing:
-        current_keys = Key_read_GND();
-        elapsed_time = Key_Get_Time_Elapsed(Key_struct_t.press_start_time);
-
-        if (current_keys == key_none)
-        {
-            // 按键已释放,进入释放消抖状态
-            Key_status_t = key_releasing;
-            Key_struct_t.last_time = Delay_Get_Ticks();
-        }
-        else if (elapsed_time >= KEY_LONG_PRESS_TIME_MS && !Key_struct_t.long_press_flag)
+        else
         {
-            // 长按时间到达,触发长按事件
-            Key_struct_t.long_press_flag = 1;
-            Key_struct_t.key_long_press_flag = 1; // 设置长按标志
-        }
-        else if (elapsed_time >= KEY_LONG_PRESS_TIME_MS + KEY_SCROLL_SPEED_MS)
-        {
-            // 长按重复触发(支持连续按键)
-            if (Key_struct_t.repeat_flag == 0)
+            if (state->integrator == KEY_DEBOUNCE_TIME_MS)
             {
-                Key_struct_t.key_repeat_flag = 1; // 设置重复按键标志
-                Key_struct_t.repeat_flag = 1;
-                Key_struct_t.last_repeat_time = Delay_Get_Ticks();
+                state->edge_time = now;
             }
-            else
+            if (state->integrator > 0)
             {
-                // 检查是否到达重复触发时间
-                if (Key_Get_Time_Elapsed(Key_struct_t.last_repeat_time) >= KEY_SCROLL_SPEED_MS)
-                {
-                    Key_struct_t.key_repeat_flag = 1;
-                    Key_struct_t.last_repeat_time = Delay_Get_Ticks();
-                }
+                state->integrator--;
             }
         }
-        break;
 
-    /* ========== 释放消抖状态 ========== */
-    case key_releasing:
-        current_keys = Key_read_GND();
-        elapsed_time = Key_Get_Time_Elapsed(Key_struct_t.last_time);
+        if (!state->pressed && state->integrator == KEY_DEBOUNCE_TIME_MS)
+        {
+            // 确认按下：已有其它按键按住时为组合键
+            uint8_t others = key_held;
 
-        if (elapsed_time >= KEY_DEBOUNCE_TIME_MS)
+            state->pressed = 1;
+            state->long_done = 0;
+            state->press_time = now;
+            key_held |= KEY_MASK(key);
+            Key_Push_Event(others ? KEY_EVENT_CHORD : KEY_EVENT_PRESS, key, 1, state->edge_time);
+        }
+        else if (state->pressed && state->integrator == 0)
+        {
+            // 确认释放
+            state->pressed = 0;
+            key_held &= ~KEY_MASK(key);
+            Key_Push_Event(KEY_EVENT_RELEASE, key, 1, state->edge_time);
+        }
+        else if (state->pressed)
         {
-            // 释放消抖完成
-            if (current_keys == key_none)
+            // 按住：先触发一次长按，再按固定间隔连发
+            if (!state->long_done && now - state->press_time >= KEY_LONG_PRESS_TIME_MS)
             {
-                // 按键确实已释放
-                Key_status_t = key_released;
-                Key_struct_t.key_released_flag = 1; // 设置释放标志
+                state->long_done = 1;
+                state->next_repeat = now + KEY_SCROLL_SPEED_MS;
+                Key_Push_Event(KEY_EVENT_LONG, key, 1, now);
             }
-            else
+            else if (state->long_done && (int32_t)(now - state->next_repeat) >= 0)
             {
-                // 释放期间按键再次按下,回到按下状态
-                Key_status_t = key_pressing;
+                state->next_repeat += KEY_SCROLL_SPEED_MS;
+                Key_Push_Event(KEY_EVENT_REPEAT, key, 1, now);
             }
         }
-        break;
-
-    /* ========== 释放完成状态 ========== */
-    case key_released:
-        // 清理所有标志,准备下一次按键
-        Key_status_t = key_idle;
-        Key_action_t = key_none;
-        break;
-
-    default:
-        // 异常状态,重置为空闲状态
-        Key_status_t = key_idle;
-        Key_action_t = key_none;
-        Key_struct_t.key_pressed_flag = 0;
-        Key_struct_t.key_released_flag = 0;
-        Key_struct_t.key_long_press_flag = 0;
-        Key_struct_t.key_repeat_flag = 0;
-        break;
     }
+
+#ifdef KEY_USE_ENCODER
+    if (++key_encoder_timer >= KEY_ENCODER_PERIOD_MS / KEY_SCAN_PERIOD_MS)
+    {
+        key_encoder_timer = 0;
+        Key_Scan_Encoder(now);
+    }
+#endif
 }
 
 /**
- * @brief 获取按键按下事件(短按)
- * @return Key_action 按键码,0表示无事件
- * @note 调用后自动清除标志
+ * @brief 取出一个按键事件
+ * @param event 返回事件内容
+ * @return uint8_t 1取到事件，0队列为空
+ * @note 只在主循环中调用；同时更新按键到处理的延迟统计
  */
-Key_action Key_Get_Press_Event(void)
+uint8_t Key_Get_Event(Key_Event_t *event)
 {
-    if (Key_struct_t.key_pressed_flag)
+    uint8_t tail = key_tail;
+
+    if (tail == key_head)
     {
-        Key_struct_t.key_pressed_flag = 0;
-        return Key_action_t;
+        return 0;
     }
-    return key_none;
+
+    *event = key_fifo[tail & (KEY_FIFO_SIZE - 1)];
+    key_tail = tail + 1; // 读完后再释放位置
+
+    key_latency_last = Delay_Get_Ticks() - event->time;
+    if (key_latency_last > key_latency_max)
+    {
+        key_latency_max = key_latency_last;
+    }
+    return 1;
 }
 
 /**
- * @brief 获取按键释放事件
+ * @brief 获取按键按下事件(短按)
  * @return Key_action 按键码,0表示无事件
- * @note 调用后自动清除标志
+ * @note 丢弃队列中排在前面的其它事件（释放、长按、连发、组合键）
+ * @note 步数大于1的事件（编码器）在之后的调用中重复返回同一按键，调用者不需要处理步数
  */
-Key_action Key_Get_Release_Event(void)
+Key_action Key_Get_Press_Event(void)
 {
-    if (Key_struct_t.key_released_flag)
+    Key_Event_t event;
+
+    // 编码器快速转动的多步事件，每次调用返回一步
+    if (key_press_left > 0)
     {
-        Key_struct_t.key_released_flag = 0;
-        return Key_action_t;
+        key_press_left--;
+        return key_press_key;
+    }
+
+    while (Key_Get_Event(&event))
+    {
+        if (event.type == KEY_EVENT_PRESS)
+        {
+            key_press_key = (Key_action)event.key;
+            key_press_left = event.count - 1;
+            return key_press_key;
+        }
     }
     return key_none;
 }
 
 /**
- * @brief 获取长按事件
- * @return Key_action 按键码,0表示无事件
- * @note 调用后自动清除标志
+ * @brief 获取当前按住的按键
+ * @return uint8_t 按键掩码(KEY_MASK),0表示没有按键按住
  */
-Key_action Key_Get_Long_Press_Event(void)
+uint8_t Key_Get_Held(void)
 {
-    if (Key_struct_t.key_long_press_flag)
-    {
-        Key_struct_t.key_long_press_flag = 0;
-        return Key_action_t;
-    }
-    return key_none;
+    return key_held;
 }
 
 /**
- * @brief 获取重复按键事件(长按连续触发)
- * @return Key_action 按键码,0表示无事件
- * @note 调用后自动清除标志
+ * @brief 清空事件队列
+ * @note 进入游戏等新界面前调用，丢弃之前残留的事件
  */
-Key_action Key_Get_Repeat_Event(void)
+void Key_Clear_Events(void)
 {
-    if (Key_struct_t.key_repeat_flag)
+    key_tail = key_head;
+    key_press_left = 0;
+}
+
+/**
+ * @brief 获取按键延迟统计
+ * @param last_ms 最近一个事件从按键电平变化到被取出的时间,可传入NULL
+ * @param max_ms 最大延迟,可传入NULL
+ * @note 延迟包含消抖时间(KEY_DEBOUNCE_TIME_MS)和事件在队列中等待的时间
+ */
+void Key_GetLatency(uint32_t *last_ms, uint32_t *max_ms)
+{
+    if (last_ms != NULL)
     {
-        Key_struct_t.key_repeat_flag = 0;
-        return Key_action_t;
+        *last_ms = key_latency_last;
+    }
+    if (max_ms != NULL)
+    {
+        *max_ms = key_latency_max;
     }
-    return key_none;
 }
 
 /**
- * @brief 获取当前按键状态
- * @return Key_action 当前按键码,key_none表示无按键
+ * @brief 获取队列满丢弃的事件数
+ * @return uint32_t 丢弃的事件数
  */
-Key_action Key_Get_Current_Key(void)
+uint32_t Key_GetOverflow(void)
 {
-    return Key_action_t;
+    return key_overflow;
 }
 
 /**
- * @brief 获取按键状态机的当前状态
- * @return Key_status 当前状态
+ * @brief 清零延迟和丢弃统计
  */
-Key_status Key_Get_Status(void)
+void Key_ResetStats(void)
 {
-    return Key_status_t;
+    key_latency_last = 0;
+    key_latency_max = 0;
+    key_overflow = 0;
 }
 
 /**
- * @brief 清除所有按键标志
- * @note 用于紧急情况下的状态重置
+ * @brief TIM4中断服务函数,1ms采样一次按键
  */
-void Key_Clear_All_Flags(void)
+void TIM4_IRQHandler(void)
 {
-    Key_status_t = key_idle;
-    Key_action_t = key_none;
-    Key_struct_t.key_pressed_flag = 0;
-    Key_struct_t.key_released_flag = 0;
-    Key_struct_t.key_long_press_flag = 0;
-    Key_struct_t.key_repeat_flag = 0;
-    Key_struct_t.long_press_flag = 0;
-    Key_struct_t.repeat_flag = 0;
+    if (TIM_GetITStatus(TIM4, TIM_IT_Update) != RESET)
+    {
+        TIM_ClearITPendingBit(TIM4, TIM_IT_Update);
+        Key_Scan();
+    }
 }
 
 void Key_Init(void)
@@ -302,6 +386,34 @@ void Key_Init(void)
     GPIO_InitStruct.GPIO_Mode = GPIO_Mode_IPU;
     GPIO_InitStruct.GPIO_Speed = GPIO_Speed_50MHz;
     GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+#ifdef KEY_USE_ENCODER
+    Encoder_Init();
+#endif
+
+    // TIM4只作为采样时基，不使用引脚：72MHz / 72 = 1MHz，计数1000次 = 1ms
+    TIM_TimeBaseInitTypeDef TIM_InitStruct = {0};
+    NVIC_InitTypeDef NVIC_InitStruct = {0};
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM4, ENABLE);
+    TIM_InitStruct.TIM_Period = 1000 * KEY_SCAN_PERIOD_MS - 1;
+    TIM_InitStruct.TIM_Prescaler = 72 - 1;
+    TIM_InitStruct.TIM_ClockDivision = TIM_CKD_DIV1;
+    TIM_InitStruct.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_InitStruct.TIM_RepetitionCounter = 0;
+    TIM_TimeBaseInit(TIM4, &TIM_InitStruct);
+
+    TIM_ClearITPendingBit(TIM4, TIM_IT_Update);
+    TIM_ITConfig(TIM4, TIM_IT_Update, ENABLE);
+
+    // 优先级低于系统时基和串口，采样晚几十微秒不影响消抖
+    NVIC_InitStruct.NVIC_IRQChannel = TIM4_IRQn;
+    NVIC_InitStruct.NVIC_IRQChannelPreemptionPriority = 2;
+    NVIC_InitStruct.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStruct.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStruct);
+
+    TIM_Cmd(TIM4, ENABLE);
 }
 
 #endif // KEY_MULTI_H
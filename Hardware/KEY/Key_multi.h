@@ -3,6 +3,15 @@
 #include "stm32f10x.h" // Device header
 #include "Delay.h"
 
+/*
+ * 文件名：Key_multi.h
+ * 描    述：按键驱动头文件
+ *          TIM4每1ms在中断中采样一次按键，积分消抖后把按下、释放、长按、连发、组合键事件
+ *          连同时间戳写入事件队列（单生产者单消费者，无锁），主循环中的菜单、界面、游戏从队列取事件
+ *          事件时间戳为按键电平第一次变化的时刻，取出事件时统计按键到处理的延迟
+ *          旋转编码器转动时产生上下按键的按下事件，转得越快每个事件的步数越多
+ */
+
 /******************************************************************************
  * 按键参数配置宏定义 - 长按翻页速度控制
  ******************************************************************************/
@@ -10,10 +19,24 @@
 // 长按翻页滚动速度 - 修改此宏来调整翻页速度
 #define KEY_SCROLL_SPEED_MS 500 // 长按翻页间隔: xms/次
 // 消抖时间配置
-#define KEY_DEBOUNCE_TIME_MS 20 // 消抖时间: 20ms
+#define KEY_DEBOUNCE_TIME_MS 20 // 消抖时间: 电平稳定20ms(20次采样)后确认
 // 长按触发时间配置
 #define KEY_LONG_PRESS_TIME_MS 500 // 长按判断时间:
 
+#define KEY_SCAN_PERIOD_MS 1 // 按键采样周期（TIM4中断周期）
+#define KEY_FIFO_SIZE 16     // 事件队列长度，必须是2的幂
+#define KEY_COUNT 4          // 按键数量
+
+// 旋转编码器配置，不接编码器时注释掉KEY_USE_ENCODER
+#define KEY_USE_ENCODER
+#define KEY_ENCODER_PERIOD_MS 5 // 读取编码器计数的周期
+#define KEY_ENCODER_COUNTS 4    // 转过一格的计数值
+#define KEY_ENCODER_REVERSE 0   // 1：逆时针为向下
+
+#ifdef KEY_USE_ENCODER
+#include "Encoder.h"
+#endif
+
 /******************************************************************************
  * 类型定义和函数声明
  ******************************************************************************/
@@ -27,51 +50,42 @@ typedef enum
     key_enter
 } Key_action;
 
+// 按键码对应的掩码位，组合键事件中用掩码表示同时按下的按键
+#define KEY_MASK(key) ((uint8_t)(1 << ((key) - 1)))
+
 typedef enum
 {
-    key_debouncing, // 消抖中
-    key_idle,       // 空闲
-    key_pressing,   // 按下中(已消抖)
-    key_releasing,  // 释放中(消抖)
-    key_released    // 释放完成
+    KEY_EVENT_PRESS,   // 按下（消抖后）
+    KEY_EVENT_RELEASE, // 释放（消抖后）
+    KEY_EVENT_LONG,    // 长按，按住KEY_LONG_PRESS_TIME_MS后触发一次
+    KEY_EVENT_REPEAT,  // 连发，长按后每KEY_SCROLL_SPEED_MS触发一次
+    KEY_EVENT_CHORD    // 组合键，已有按键按住时又按下另一个按键
+} Key_EventType;
 
-} Key_status;
 typedef struct
 {
-    uint32_t current_time;       // 当前时间
-    uint32_t last_time;          // 上次时间
-    uint32_t press_start_time;   // 按键开始时间
-    uint32_t last_repeat_time;   // 上次重复触发时间
-    uint8_t key_pressed_flag;    // 按下标志(短按)
-    uint8_t key_released_flag;   // 释放标志
-    uint8_t key_long_press_flag; // 长按标志
-    uint8_t key_repeat_flag;     // 重复按键标志
-    uint8_t long_press_flag;     // 长按已完成标志
-    uint8_t repeat_flag;         // 重复触发标志
-
-} Key_struct;
-
-extern Key_action Key_action_t;
-extern Key_status Key_status_t;
-extern Key_struct Key_struct_t;
+    uint8_t type;  // 事件类型 Key_EventType
+    uint8_t key;   // 触发事件的按键 Key_action
+    uint8_t keys;  // 事件发生时按住的按键掩码（KEY_MASK）
+    uint8_t count; // 步数：按键为1，编码器为转过的格数乘以加速倍数
+    uint32_t time; // 时间戳（ms）：按下/释放为电平第一次变化的时刻，长按/连发为触发时刻
+} Key_Event_t;
 
 // 初始化函数
 void Key_Init(void);
 
-// 核心功能函数
-void Key_Status_Process(void);
+// 采样函数（TIM4中断中调用，也可由测试代码直接调用）
+void Key_Scan(void);
 
 // 事件获取函数
-Key_action Key_Get_Press_Event(void);      // 获取短按事件
-Key_action Key_Get_Release_Event(void);    // 获取释放事件
-Key_action Key_Get_Long_Press_Event(void); // 获取长按事件
-Key_action Key_Get_Repeat_Event(void);     // 获取重复按键事件
-Key_action Key_read_GND(void);             // 读取按键触发(低电平有效)
-// 状态查询函数
-Key_action Key_Get_Current_Key(void); // 获取当前按键码
-Key_status Key_Get_Status(void);      // 获取状态机状态
-
-// 辅助函数
-void Key_Clear_All_Flags(void); // 清除所有标志
+uint8_t Key_Get_Event(Key_Event_t *event); // 取出一个事件，队列为空返回0
+Key_action Key_Get_Press_Event(void);      // 取出下一个按下事件，跳过其它事件，多步事件分多次返回
+uint8_t Key_Get_Held(void);                // 获取当前按住的按键掩码（已消抖）
+void Key_Clear_Events(void);               // 清空事件队列
+
+// 统计函数
+void Key_GetLatency(uint32_t *last_ms, uint32_t *max_ms); // 按键到取出事件的延迟
+uint32_t Key_GetOverflow(void);                           // 队列满丢弃的事件数
+void Key_ResetStats(void);
 
 #endif
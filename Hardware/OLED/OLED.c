@@ -1,4 +1,5 @@
 #include "OLED.h"
+#include "Delay.h"
 
 /**
  * 数据存储格式：
@@ -53,10 +54,49 @@
  * 随后调用OLED_Update函数或OLED_UpdateArea函数
  * 才会将显存数组的数据发送到OLED硬件，进行显示
  */
-uint8_t OLED_DisplayBuf[8][128];
+uint8_t OLED_DisplayBuf[8][128] __attribute__((aligned(4))); // 按字对齐，便于整页按32位字操作
+
+/**
+ * OLED显存脏区记录
+ * 每一页记录一段被修改过的列范围[OLED_DirtyStart, OLED_DirtyEnd]
+ * 所有写显存的函数都会扩大对应页的脏区，OLED_Update函数只发送脏区内的数据
+ * 起始列大于终止列表示该页未被修改
+ */
+static uint8_t OLED_DirtyStart[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static uint8_t OLED_DirtyEnd[8];
+
+/**
+ * OLED屏幕内容镜像
+ * 记录上一次已发送到OLED硬件的数据
+ * 常见的"清屏-重绘"写法会把整屏标记为脏区，发送前再与镜像比较，去掉内容未变化的列
+ */
+static uint8_t OLED_SentBuf[8][128];
+
+/**
+ * OLED实际发送字节计数
+ * 包含I2C从机地址、控制字节、命令和数据，用于评估刷新开销
+ */
+static uint32_t OLED_SentBytes;
+
+/**
+ * OLED帧统计
+ * OLED_SwapAndFlush调用时上一帧仍在发送，本帧不再单独发送，其修改合并到下一帧
+ */
+static uint32_t OLED_FrameFlushed;	 // 已交换并开始发送的帧数
+static uint32_t OLED_FrameCoalesced; // 被合并（丢弃）的帧数
+
+/**
+ * OLED硬件滚动状态
+ * 显示起始行以页为单位偏移，逻辑页j（显存数组第j页）写入屏幕RAM的第(j + OLED_PageOffset) % 8页
+ * 连续滚动期间SSD1306禁止读写屏幕RAM，更新函数暂不发送，停止滚动时整屏重发
+ */
+static uint8_t OLED_PageOffset;	  // 显示起始页，范围：0~7
+static uint8_t OLED_ScrollActive; // 连续滚动进行中
 
 /*********************全局变量*/
 
+#if defined(OLED_USE_SOFT_I2C)
+
 /*引脚配置*********************/
 
 /**
@@ -180,218 +220,1507 @@ void OLED_I2C_SendByte(uint8_t Byte)
 }
 
 /**
- * 函    数：OLED写命令
- * 参    数：Command 要写入的命令值，范围：0x00~0xFF
+ * 函    数：软件I2C发送一次完整传输
+ * 参    数：Control 控制字节，0x00表示写命令，0x40表示写数据
+ * 参    数：Data 要写入数据的起始地址
+ * 参    数：Count 要写入数据的数量
  * 返 回 值：无
+ * 说    明：函数返回时传输已经完成
  */
-void OLED_WriteCommand(uint8_t Command)
+void OLED_SoftI2C_Write(uint8_t Control, const uint8_t *Data, uint16_t Count)
 {
+	uint16_t i;
+
 	OLED_I2C_Start();			// I2C起始
 	OLED_I2C_SendByte(0x78);	// 发送OLED的I2C从机地址
-	OLED_I2C_SendByte(0x00);	// 控制字节，给0x00，表示即将写命令
-	OLED_I2C_SendByte(Command); // 写入指定的命令
-	OLED_I2C_Stop();			// I2C终止
+	OLED_I2C_SendByte(Control); // 控制字节
+	/*循环Count次，进行连续的数据写入*/
+	for (i = 0; i < Count; i++)
+	{
+		OLED_I2C_SendByte(Data[i]); // 依次发送Data的每一个数据
+	}
+	OLED_I2C_Stop(); // I2C终止
+}
+
+/*软件I2C通信接口，同步发送*/
+const OLED_Transport_t OLED_Transport_SoftI2C = {OLED_GPIO_Init, OLED_SoftI2C_Write, 0, NULL};
+
+/*********************通信协议*/
+
+#endif // OLED_USE_SOFT_I2C
+
+#if defined(OLED_USE_HW_I2C)
+
+/*硬件I2C1+DMA*********************/
+
+/*I2C1发送状态*/
+#define OLED_HWI2C_IDLE		0 // 空闲
+#define OLED_HWI2C_START	1 // 已产生起始条件，等待SB
+#define OLED_HWI2C_ADDR		2 // 已发送从机地址，等待ADDR
+#define OLED_HWI2C_DATA		3 // DMA发送数据中，等待最后一个字节移出(BTF)
+
+static volatile uint8_t OLED_HwI2C_State = OLED_HWI2C_IDLE;
+static uint8_t OLED_HwI2C_Control;			// 本次传输的控制字节
+static const uint8_t *OLED_HwI2C_Data;		// 本次传输的数据地址
+static uint16_t OLED_HwI2C_Count;			// 本次传输的数据数量
+static volatile uint32_t OLED_HwI2C_Errors; // 传输错误次数（无应答、总线错误、超时等）
+
+/**
+ * 函    数：配置I2C1外设
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：主机模式，OLED_I2C_SPEED快速模式，初始化和总线恢复时调用
+ */
+static void OLED_HwI2C_Config(void)
+{
+	I2C_InitTypeDef I2C_InitStructure;
+
+	I2C_DeInit(I2C1);
+	I2C_InitStructure.I2C_Mode = I2C_Mode_I2C;
+	I2C_InitStructure.I2C_DutyCycle = I2C_DutyCycle_2;
+	I2C_InitStructure.I2C_OwnAddress1 = 0x00;
+	I2C_InitStructure.I2C_Ack = I2C_Ack_Enable;
+	I2C_InitStructure.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
+	I2C_InitStructure.I2C_ClockSpeed = OLED_I2C_SPEED;
+	I2C_Init(I2C1, &I2C_InitStructure);
+	I2C_Cmd(I2C1, ENABLE);
+	I2C_ITConfig(I2C1, I2C_IT_ERR, ENABLE);
 }
 
 /**
- * 函    数：OLED写数据
- * 参    数：Data 要写入数据的起始地址
+ * 函    数：硬件I2C1初始化
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：PB8/PB9通过I2C1重映射作为SCL/SDA，DMA1通道6负责I2C1_TX
+ *           传输由I2C1事件中断和DMA中断推进，不占用主循环
+ */
+void OLED_HwI2C_Init(void)
+{
+	uint32_t i, j;
+	GPIO_InitTypeDef GPIO_InitStructure;
+	DMA_InitTypeDef DMA_InitStructure;
+	NVIC_InitTypeDef NVIC_InitStructure;
+
+	/*在初始化前，加入适量延时，待OLED供电稳定*/
+	for (i = 0; i < 1000; i++)
+	{
+		for (j = 0; j < 1000; j++)
+			;
+	}
+
+	/*开启时钟*/
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOB | RCC_APB2Periph_AFIO, ENABLE);
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_I2C1, ENABLE);
+	RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+	/*I2C1重映射到PB8(SCL)/PB9(SDA)，配置为复用开漏*/
+	GPIO_PinRemapConfig(GPIO_Remap_I2C1, ENABLE);
+	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_OD;
+	GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+	GPIO_InitStructure.GPIO_Pin = GPIO_Pin_8 | GPIO_Pin_9;
+	GPIO_Init(GPIOB, &GPIO_InitStructure);
+
+	/*I2C1配置：主机模式，400kHz快速模式*/
+	OLED_HwI2C_Config();
+
+	/*DMA1通道6：内存到I2C1->DR，每次传输时再设置地址和数量*/
+	DMA_DeInit(DMA1_Channel6);
+	DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&I2C1->DR;
+	DMA_InitStructure.DMA_MemoryBaseAddr = 0;
+	DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralDST;
+	DMA_InitStructure.DMA_BufferSize = 1;
+	DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+	DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+	DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+	DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+	DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+	DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+	DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+	DMA_Init(DMA1_Channel6, &DMA_InitStructure);
+	DMA_ITConfig(DMA1_Channel6, DMA_IT_TC, ENABLE);
+
+	/*中断配置：优先级高于传感器、串口等中断，保证队列在它们执行期间也能推进*/
+	NVIC_PriorityGroupConfig(NVIC_PriorityGroup_2);
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel6_IRQn;
+	NVIC_Init(&NVIC_InitStructure);
+	NVIC_InitStructure.NVIC_IRQChannel = I2C1_EV_IRQn;
+	NVIC_Init(&NVIC_InitStructure);
+	NVIC_InitStructure.NVIC_IRQChannel = I2C1_ER_IRQn;
+	NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+ * 函    数：硬件I2C1启动一次传输
+ * 参    数：Control 控制字节，0x00表示写命令，0x40表示写数据
+ * 参    数：Data 要写入数据的起始地址，传输完成前必须保持有效
  * 参    数：Count 要写入数据的数量
  * 返 回 值：无
+ * 说    明：只产生起始条件后立即返回，后续由中断完成
+ *           传输完成后在中断中调用OLED_TransferComplete
+ *           在中断中被调用时，上一次传输尚未产生终止条件，此处的起始条件即重复起始条件；
+ *           只有主循环发起队列中的第一次传输时，才可能需要等待上一次的终止条件发完（约3us）
  */
-void OLED_WriteData(uint8_t *Data, uint8_t Count)
+void OLED_HwI2C_Write(uint8_t Control, const uint8_t *Data, uint16_t Count)
+{
+	uint16_t Timeout = 0xFFFF;
+
+	/*等待上一次传输的终止条件发送完毕*/
+	while ((I2C1->CR1 & I2C_CR1_STOP) && --Timeout)
+		;
+
+	OLED_HwI2C_Control = Control;
+	OLED_HwI2C_Data = Data;
+	OLED_HwI2C_Count = Count;
+	OLED_HwI2C_State = OLED_HWI2C_START;
+
+	I2C_ITConfig(I2C1, I2C_IT_EVT, ENABLE);
+	I2C_GenerateSTART(I2C1, ENABLE);
+}
+
+/**
+ * 函    数：硬件I2C1总线恢复
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：从机在传输中途复位或受干扰时可能一直拉低SDA，I2C1会停在BUSY状态
+ *           把SCL/SDA切换为开漏输出，补发最多9个时钟直到从机释放SDA，再产生终止条件，
+ *           最后复位I2C1并重新配置
+ */
+static void OLED_HwI2C_Recover(void)
 {
+	GPIO_InitTypeDef GPIO_InitStructure;
 	uint8_t i;
 
-	OLED_I2C_Start();		 // I2C起始
-	OLED_I2C_SendByte(0x78); // 发送OLED的I2C从机地址
-	OLED_I2C_SendByte(0x40); // 控制字节，给0x40，表示即将写数据
-	/*循环Count次，进行连续的数据写入*/
-	for (i = 0; i < Count; i++)
+	I2C_Cmd(I2C1, DISABLE);
+
+	/*SCL/SDA切换为通用开漏输出，先释放总线*/
+	GPIO_SetBits(GPIOB, GPIO_Pin_8 | GPIO_Pin_9);
+	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_Out_OD;
+	GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+	GPIO_InitStructure.GPIO_Pin = GPIO_Pin_8 | GPIO_Pin_9;
+	GPIO_Init(GPIOB, &GPIO_InitStructure);
+	Delay_us(5);
+
+	/*SDA被拉低时补发时钟，从机移出剩余的位后会释放SDA*/
+	for (i = 0; i < 9 && GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_9) == Bit_RESET; i++)
 	{
-		OLED_I2C_SendByte(Data[i]); // 依次发送Data的每一个数据
+		GPIO_ResetBits(GPIOB, GPIO_Pin_8);
+		Delay_us(5);
+		GPIO_SetBits(GPIOB, GPIO_Pin_8);
+		Delay_us(5);
 	}
-	OLED_I2C_Stop(); // I2C终止
-}
 
-/*********************通信协议*/
+	/*产生终止条件：SCL高电平期间SDA由低变高*/
+	GPIO_ResetBits(GPIOB, GPIO_Pin_9);
+	Delay_us(5);
+	GPIO_SetBits(GPIOB, GPIO_Pin_9);
+	Delay_us(5);
 
-/*硬件配置*********************/
+	/*恢复为复用开漏，复位I2C1清除BUSY标志后重新配置*/
+	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_OD;
+	GPIO_Init(GPIOB, &GPIO_InitStructure);
+	I2C_SoftwareResetCmd(I2C1, ENABLE);
+	I2C_SoftwareResetCmd(I2C1, DISABLE);
+	OLED_HwI2C_Config();
+}
 
 /**
- * 函    数：OLED初始化
+ * 函    数：硬件I2C1放弃当前传输
  * 参    数：无
  * 返 回 值：无
- * 说    明：使用前，需要调用此初始化函数
+ * 说    明：传输超时时由发送队列在主循环中调用
+ *           先关闭I2C1和DMA中断，之后中断不会再推进传输；恢复总线后计入错误次数
  */
-void OLED_Init(void)
+void OLED_HwI2C_Abort(void)
 {
-	OLED_GPIO_Init(); // 先调用底层的端口初始化
+	NVIC_DisableIRQ(I2C1_EV_IRQn);
+	NVIC_DisableIRQ(I2C1_ER_IRQn);
+	NVIC_DisableIRQ(DMA1_Channel6_IRQn);
+
+	DMA_Cmd(DMA1_Channel6, DISABLE);
+	DMA_ClearITPendingBit(DMA1_IT_GL6);
+	I2C_DMACmd(I2C1, DISABLE);
+	I2C_ITConfig(I2C1, I2C_IT_EVT, DISABLE);
+	OLED_HwI2C_Recover();
+
+	OLED_HwI2C_Errors++;
+	OLED_HwI2C_State = OLED_HWI2C_IDLE;
+
+	NVIC_ClearPendingIRQ(I2C1_EV_IRQn);
+	NVIC_ClearPendingIRQ(I2C1_ER_IRQn);
+	NVIC_ClearPendingIRQ(DMA1_Channel6_IRQn);
+	NVIC_EnableIRQ(I2C1_EV_IRQn);
+	NVIC_EnableIRQ(I2C1_ER_IRQn);
+	NVIC_EnableIRQ(DMA1_Channel6_IRQn);
+}
 
-	/*写入一系列的命令，对OLED进行初始化配置*/
-	OLED_WriteCommand(0xAE); // 设置显示开启/关闭，0xAE关闭，0xAF开启
+/**
+ * 函    数：获取硬件I2C传输错误次数
+ * 参    数：无
+ * 返 回 值：自上电以来的传输错误次数
+ */
+uint32_t OLED_HwI2C_GetErrors(void)
+{
+	return OLED_HwI2C_Errors;
+}
 
-	OLED_WriteCommand(0xD5); // 设置显示时钟分频比/振荡器频率
-	OLED_WriteCommand(0x80); // 0x00~0xFF
+/**
+ * 函    数：I2C1事件中断服务函数
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：SB：发送从机地址；ADDR：发送控制字节并交给DMA；
+ *           BTF：队列中还有数据时直接以重复起始条件开始下一次传输，否则产生终止条件，
+ *           中断中不等待终止条件发完
+ */
+void I2C1_EV_IRQHandler(void)
+{
+	uint16_t SR1 = I2C1->SR1;
 
-	OLED_WriteCommand(0xA8); // 设置多路复用率
-	OLED_WriteCommand(0x3F); // 0x0E~0x3F
+	if (SR1 & I2C_SR1_SB) // 起始条件已发送
+	{
+		I2C_Send7bitAddress(I2C1, 0x78, I2C_Direction_Transmitter);
+		OLED_HwI2C_State = OLED_HWI2C_ADDR;
+	}
+	else if (SR1 & I2C_SR1_ADDR) // 从机地址已应答
+	{
+		(void)I2C1->SR2;				// 读SR1后读SR2，清除ADDR
+		I2C1->DR = OLED_HwI2C_Control; // 写入控制字节
+		OLED_HwI2C_State = OLED_HWI2C_DATA;
 
-	OLED_WriteCommand(0xD3); // 设置显示偏移
-	OLED_WriteCommand(0x00); // 0x00~0x7F
+		if (OLED_HwI2C_Count > 0)
+		{
+			/*其余数据交给DMA搬运，搬运期间关闭事件中断*/
+			I2C_ITConfig(I2C1, I2C_IT_EVT, DISABLE);
+			DMA1_Channel6->CMAR = (uint32_t)OLED_HwI2C_Data;
+			DMA1_Channel6->CNDTR = OLED_HwI2C_Count;
+			DMA_Cmd(DMA1_Channel6, ENABLE);
+			I2C_DMACmd(I2C1, ENABLE);
+		}
+	}
+	else if (SR1 & I2C_SR1_BTF) // 最后一个字节已移出
+	{
+		I2C_ITConfig(I2C1, I2C_IT_EVT, DISABLE);
+		OLED_HwI2C_State = OLED_HWI2C_IDLE;
+		OLED_TransferComplete(); // 通知上层，发起队列中的下一次传输（OLED_HwI2C_Write产生重复起始条件）
+		if (OLED_HwI2C_State == OLED_HWI2C_IDLE)
+		{
+			I2C_GenerateSTOP(I2C1, ENABLE); // 队列已清空
+		}
+	}
+}
 
-	OLED_WriteCommand(0x40); // 设置显示开始行，0x40~0x7F
+/**
+ * 函    数：DMA1通道6中断服务函数
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：DMA搬运完成时最后一个字节还在移位，重新打开事件中断等待BTF
+ */
+void DMA1_Channel6_IRQHandler(void)
+{
+	if (DMA_GetITStatus(DMA1_IT_TC6) != RESET)
+	{
+		DMA_ClearITPendingBit(DMA1_IT_TC6);
+		DMA_Cmd(DMA1_Channel6, DISABLE);
+		I2C_DMACmd(I2C1, DISABLE);
+		I2C_ITConfig(I2C1, I2C_IT_EVT, ENABLE);
+	}
+}
 
-	OLED_WriteCommand(0xA1); // 设置左右方向，0xA1正常，0xA0左右反置
+/**
+ * 函    数：I2C1错误中断服务函数
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：无应答、总线错误或仲裁丢失时放弃本次传输，继续发送队列中的后续数据
+ *           与软件I2C不检查应答的行为保持一致
+ */
+void I2C1_ER_IRQHandler(void)
+{
+	/*写0清除错误标志*/
+	I2C1->SR1 &= ~(I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR);
 
-	OLED_WriteCommand(0xC8); // 设置上下方向，0xC8正常，0xC0上下反置
+	DMA_Cmd(DMA1_Channel6, DISABLE);
+	I2C_DMACmd(I2C1, DISABLE);
+	I2C_ITConfig(I2C1, I2C_IT_EVT, DISABLE);
 
-	OLED_WriteCommand(0xDA); // 设置COM引脚硬件配置
-	OLED_WriteCommand(0x12);
+	OLED_HwI2C_Errors++;
+	if (OLED_HwI2C_State != OLED_HWI2C_IDLE)
+	{
+		OLED_HwI2C_State = OLED_HWI2C_IDLE;
+		OLED_TransferComplete(); // 与BTF相同，有下一次传输时以重复起始条件开始
+	}
+	if (OLED_HwI2C_State == OLED_HWI2C_IDLE)
+	{
+		I2C_GenerateSTOP(I2C1, ENABLE);
+	}
+}
 
-	OLED_WriteCommand(0x81); // 设置对比度
-	OLED_WriteCommand(0xCF); // 0x00~0xFF
+/*硬件I2C通信接口，异步发送*/
+const OLED_Transport_t OLED_Transport_HwI2C = {OLED_HwI2C_Init, OLED_HwI2C_Write, 1, OLED_HwI2C_Abort};
 
-	OLED_WriteCommand(0xD9); // 设置预充电周期
-	OLED_WriteCommand(0xF1);
+/*********************硬件I2C1+DMA*/
 
-	OLED_WriteCommand(0xDB); // 设置VCOMH取消选择级别
-	OLED_WriteCommand(0x30);
+#endif // OLED_USE_HW_I2C
 
-	OLED_WriteCommand(0xA4); // 设置整个显示打开/关闭
+#if defined(OLED_USE_RECORDER)
 
-	OLED_WriteCommand(0xA6); // 设置正常/反色显示，0xA6正常，0xA7反色
+/*录制接口*********************/
 
-	OLED_WriteCommand(0x8D); // 设置充电泵
-	OLED_WriteCommand(0x14);
+/**
+ * 录制接口
+ * 不操作任何外设，按SSD1306页寻址模式解析命令/数据流，在OLED_RecGRAM中还原屏幕实际显示的内容
+ * 与OLED_DisplayBuf比对可发现脏区漏发，配合OLED_SetUpdateCallback可逐帧导出图像并统计通信字节数
+ */
+static uint8_t OLED_RecGRAM[8][128]; // 屏幕显存镜像
+static uint8_t OLED_RecPage;		 // 当前页地址
+static uint8_t OLED_RecColumn;		 // 当前列地址
+static uint8_t OLED_RecStartLine;	 // 显示起始行，屏幕第Y行显示RAM中的第(Y + OLED_RecStartLine) % 64行
+static uint32_t OLED_RecTransfers;	 // 传输次数
 
-	OLED_WriteCommand(0xAF); // 开启显示
+/**
+ * 函    数：录制接口初始化
+ * 参    数：无
+ * 返 回 值：无
+ */
+void OLED_Recorder_Init(void)
+{
+	OLED_Recorder_Reset();
+}
 
-	OLED_Clear();  // 清空显存数组
-	OLED_Update(); // 更新显示，清屏，防止初始化后未显示内容时花屏
+/**
+ * 函    数：获取SSD1306命令附带的参数字节数
+ * 参    数：Command 命令字节
+ * 返 回 值：参数字节数
+ */
+static uint8_t OLED_Recorder_ParamCount(uint8_t Command)
+{
+	switch (Command)
+	{
+	case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+	case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+		return 1;
+	case 0x21: case 0x22: case 0xA3:
+		return 2;
+	case 0x29: case 0x2A:
+		return 5;
+	case 0x26: case 0x27:
+		return 6;
+	default:
+		return 0;
+	}
 }
 
 /**
- * 函    数：OLED设置显示光标位置
- * 参    数：Page 指定光标所在的页，范围：0~7
- * 参    数：X 指定光标所在的X轴坐标，范围：0~127
+ * 函    数：录制一次传输
+ * 参    数：Control 控制字节，0x00表示命令，0x40表示数据
+ * 参    数：Data 数据地址
+ * 参    数：Count 数据数量
  * 返 回 值：无
- * 说    明：OLED默认的Y轴，只能8个Bit为一组写入，即1页等于8个Y轴坐标
+ * 说    明：只解析页地址、列地址和显示起始行命令，其余命令连同参数一起跳过
  */
-void OLED_SetCursor(uint8_t Page, uint8_t X)
+void OLED_Recorder_Write(uint8_t Control, const uint8_t *Data, uint16_t Count)
 {
-	/*如果使用此程序驱动1.3寸的OLED显示屏，则需要解除此注释*/
-	/*因为1.3寸的OLED驱动芯片（SH1106）有132列*/
-	/*屏幕的起始列接在了第2列，而不是第0列*/
-	/*所以需要将X加2，才能正常显示*/
-	//	X += 2;
+	uint16_t i;
 
-	/*通过指令设置页地址和列地址*/
-	OLED_WriteCommand(0xB0 | Page);				 // 设置页位置
-	OLED_WriteCommand(0x10 | ((X & 0xF0) >> 4)); // 设置X位置高4位
-	OLED_WriteCommand(0x00 | (X & 0x0F));		 // 设置X位置低4位
-}
+	OLED_RecTransfers++;
 
-/*********************硬件配置*/
+	if (Control == 0x40) // 写数据，列地址自动加1，到达末尾后回到0列（页寻址模式）
+	{
+		for (i = 0; i < Count; i++)
+		{
+			OLED_RecGRAM[OLED_RecPage][OLED_RecColumn] = Data[i];
+			OLED_RecColumn = (OLED_RecColumn + 1) & 0x7F;
+		}
+		return;
+	}
 
-/*工具函数*********************/
+	for (i = 0; i < Count; i++) // 写命令
+	{
+		if (Data[i] <= 0x0F) // 设置列地址低4位
+		{
+			OLED_RecColumn = (OLED_RecColumn & 0xF0) | Data[i];
+		}
+		else if (Data[i] <= 0x1F) // 设置列地址高4位
+		{
+			OLED_RecColumn = ((Data[i] & 0x07) << 4) | (OLED_RecColumn & 0x0F);
+		}
+		else if (Data[i] >= 0x40 && Data[i] <= 0x7F) // 设置显示起始行
+		{
+			OLED_RecStartLine = Data[i] & 0x3F;
+		}
+		else if (Data[i] >= 0xB0 && Data[i] <= 0xB7) // 设置页地址
+		{
+			OLED_RecPage = Data[i] & 0x07;
+		}
+		else
+		{
+			i += OLED_Recorder_ParamCount(Data[i]); // 跳过参数
+		}
+	}
+}
 
-/*工具函数仅供内部部分函数使用*/
+/**
+ * 函    数：清空录制的屏幕内容和传输次数
+ * 参    数：无
+ * 返 回 值：无
+ */
+void OLED_Recorder_Reset(void)
+{
+	memset(OLED_RecGRAM, 0, sizeof(OLED_RecGRAM));
+	OLED_RecPage = 0;
+	OLED_RecColumn = 0;
+	OLED_RecStartLine = 0;
+	OLED_RecTransfers = 0;
+}
 
 /**
- * 函    数：次方函数
- * 参    数：X 底数
- * 参    数：Y 指数
- * 返 回 值：等于X的Y次方
+ * 函    数：读取屏幕实际显示的某个点（已计入显示起始行）
+ * 参    数：X 指定点的横坐标，范围：0~127
+ * 参    数：Y 指定点的纵坐标，范围：0~63
+ * 返 回 值：指定位置点是否处于点亮状态，1：点亮，0：熄灭，超出屏幕返回0
  */
-uint32_t OLED_Pow(uint32_t X, uint32_t Y)
+uint8_t OLED_Recorder_GetPoint(int16_t X, int16_t Y)
 {
-	uint32_t Result = 1; // 结果默认为1
-	while (Y--)			 // 累乘Y次
+	if (X < 0 || X > 127 || Y < 0 || Y > 63)
 	{
-		Result *= X; // 每次把X累乘到结果上
+		return 0;
 	}
-	return Result;
+	Y = (Y + OLED_RecStartLine) & 0x3F; // 换算为RAM中的行
+	return (OLED_RecGRAM[Y / 8][X] >> (Y % 8)) & 0x01;
 }
 
 /**
- * 函    数：判断指定点是否在指定多边形内部
- * 参    数：nvert 多边形的顶点数
- * 参    数：vertx verty 包含多边形顶点的x和y坐标的数组
- * 参    数：testx testy 测试点的X和y坐标
- * 返 回 值：指定点是否在指定多边形内部，1：在内部，0：不在内部
+ * 函    数：获取录制的传输次数
+ * 参    数：无
+ * 返 回 值：自上次清空以来的I2C传输次数（每次含起始、地址、控制字节和终止）
  */
-uint8_t OLED_pnpoly(uint8_t nvert, int16_t *vertx, int16_t *verty, int16_t testx, int16_t testy)
+uint32_t OLED_Recorder_GetTransfers(void)
 {
-	int16_t i, j, c = 0;
+	return OLED_RecTransfers;
+}
 
-	/*此算法由W. Randolph Franklin提出*/
-	/*参考链接：https://wrfranklin.org/Research/Short_Notes/pnpoly.html*/
-	for (i = 0, j = nvert - 1; i < nvert; j = i++)
+/**
+ * 函    数：以PBM图像格式导出屏幕实际显示的内容
+ * 参    数：Put 输出一个字节的函数，例如写文件或串口发送
+ * 返 回 值：无
+ * 说    明：二进制PBM（P4），128×64，点亮的像素输出为1（黑色），共10+1024字节
+ */
+void OLED_Recorder_WritePBM(void (*Put)(uint8_t Byte))
+{
+	const char *Header = "P4\n128 64\n";
+	uint8_t X, Y, Row, i, Byte;
+
+	while (*Header != '\0')
 	{
-		if (((verty[i] > testy) != (verty[j] > testy)) &&
-			(testx < (vertx[j] - vertx[i]) * (testy - verty[i]) / (verty[j] - verty[i]) + vertx[i]))
+		Put(*Header++);
+	}
+
+	for (Y = 0; Y < 64; Y++)
+	{
+		Row = (Y + OLED_RecStartLine) & 0x3F; // 换算为RAM中的行
+		for (X = 0; X < 128; X += 8)
 		{
-			c = !c;
+			/*PBM每字节8个横向像素，高位在左*/
+			Byte = 0;
+			for (i = 0; i < 8; i++)
+			{
+				Byte = (Byte << 1) | ((OLED_RecGRAM[Row / 8][X + i] >> (Row % 8)) & 0x01);
+			}
+			Put(Byte);
 		}
 	}
-	return c;
 }
 
+/*录制接口，同步“发送”*/
+const OLED_Transport_t OLED_Transport_Recorder = {OLED_Recorder_Init, OLED_Recorder_Write, 0, NULL};
+
+/*********************录制接口*/
+
+#endif // OLED_USE_RECORDER
+
+/*发送队列*********************/
+
 /**
- * 函    数：判断指定点是否在指定角度内部
- * 参    数：X Y 指定点的坐标
- * 参    数：StartAngle EndAngle 起始角度和终止角度，范围：-180~180
- *           水平向右为0度，水平向左为180度或-180度，下方为正数，上方为负数，顺时针旋转
- * 返 回 值：指定点是否在指定角度内部，1：在内部，0：不在内部
+ * 发送队列
+ * 每个元素对应一次I2C传输（起始+从机地址+控制字节+数据+终止）
+ * 主循环写入队头，通信接口完成一次传输后取出队尾，异步通信接口下由中断推进
  */
-uint8_t OLED_IsInAngle(int16_t X, int16_t Y, int16_t StartAngle, int16_t EndAngle)
+#define OLED_TX_QUEUE_SIZE	32 // 必须为2的幂
+
+typedef struct
+{
+	const uint8_t *Data; // 数据地址，为NULL时发送Inline中的命令
+	uint8_t Inline[3];	 // 短命令直接保存在队列中，调用者无需保持缓冲区有效
+	uint8_t Control;	 // 控制字节
+	uint8_t Count;		 // 数据数量
+} OLED_TxJob_t;
+
+static OLED_TxJob_t OLED_TxQueue[OLED_TX_QUEUE_SIZE];
+static volatile uint8_t OLED_TxHead; // 下一个写入位置
+static volatile uint8_t OLED_TxTail; // 正在发送或下一个发送的位置
+static volatile uint8_t OLED_TxBusy; // 通信接口正在传输
+
+/*当前使用的通信接口*/
+#if defined(OLED_USE_HW_I2C)
+static const OLED_Transport_t *OLED_Transport = &OLED_Transport_HwI2C;
+#elif defined(OLED_USE_RECORDER)
+static const OLED_Transport_t *OLED_Transport = &OLED_Transport_Recorder;
+#else
+static const OLED_Transport_t *OLED_Transport = &OLED_Transport_SoftI2C;
+#endif
+
+/*发送队列清空后的回调函数*/
+static void (*OLED_TxCpltCallback)(void);
+
+/*每次更新函数排队完成后的回调函数，参数为本次更新的发送字节数*/
+static void (*OLED_UpdateCallback)(uint32_t Bytes);
+
+static void OLED_TxKick(void);
+
+/**
+ * 函    数：等待通信接口推进发送队列
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：当前传输OLED_TX_TIMEOUT_MS内没有完成时认为总线卡死，
+ *           调用通信接口的Abort复位外设、恢复总线，丢弃该传输后继续发送后续数据
+ */
+static void OLED_TxWaitProgress(void)
+{
+	uint8_t Tail = OLED_TxTail;
+	uint32_t Start = Delay_Get_Ticks();
+
+	while (OLED_TxBusy && OLED_TxTail == Tail)
+	{
+		if (OLED_Transport->Abort != NULL && Delay_Get_Ticks() - Start >= OLED_TX_TIMEOUT_MS)
+		{
+			OLED_Transport->Abort(); // 返回后中断不会再推进传输
+			if (!OLED_TxBusy)
+			{
+				return; // Abort之前中断恰好发完了整个队列
+			}
+			if (OLED_TxTail == Tail)
+			{
+				OLED_TransferComplete(); // 丢弃卡住的传输，启动下一次
+			}
+			else
+			{
+				/*卡住的传输在Abort之前恰好完成，被放弃的是刚启动的下一次传输，重新发送*/
+				OLED_TxBusy = 0;
+				OLED_TxKick();
+			}
+			return;
+		}
+	}
+}
+
+/**
+ * 函    数：启动发送队列中的传输
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：同步通信接口在此处把队列全部发完，异步通信接口只启动一次传输
+ */
+static void OLED_TxKick(void)
+{
+	OLED_TxJob_t *Job;
+	uint8_t Sent = 0;
+
+	while (!OLED_TxBusy && OLED_TxHead != OLED_TxTail)
+	{
+		OLED_TxBusy = 1;
+		Job = &OLED_TxQueue[OLED_TxTail];
+		OLED_Transport->Write(Job->Control, Job->Data ? Job->Data : Job->Inline, Job->Count);
+
+		if (OLED_Transport->IsAsync)
+		{
+			return; // 剩余部分由OLED_TransferComplete推进
+		}
+
+		/*同步通信接口，返回时已发送完毕*/
+		OLED_TxTail = (OLED_TxTail + 1) & (OLED_TX_QUEUE_SIZE - 1);
+		OLED_TxBusy = 0;
+		Sent = 1;
+	}
+
+	if (Sent && OLED_TxCpltCallback != NULL)
+	{
+		OLED_TxCpltCallback();
+	}
+}
+
+/**
+ * 函    数：将一次传输加入发送队列
+ * 参    数：Control 控制字节，0x00表示写命令，0x40表示写数据
+ * 参    数：Data 数据地址，为NULL时发送Inline中的命令
+ * 参    数：Inline 短命令内容，Data为NULL时有效，最多3个字节
+ * 参    数：Count 数据数量
+ * 返 回 值：无
+ * 说    明：队列已满时等待通信接口腾出位置
+ */
+static void OLED_TxPush(uint8_t Control, const uint8_t *Data, const uint8_t *Inline, uint8_t Count)
+{
+	OLED_TxJob_t *Job;
+	uint8_t Next = (OLED_TxHead + 1) & (OLED_TX_QUEUE_SIZE - 1);
+
+	while (Next == OLED_TxTail)
+	{
+		OLED_TxWaitProgress(); // 队列已满，等待中断取出
+	}
+
+	Job = &OLED_TxQueue[OLED_TxHead];
+	Job->Control = Control;
+	Job->Data = Data;
+	Job->Count = Count;
+	if (Data == NULL)
+	{
+		memcpy(Job->Inline, Inline, Count);
+	}
+	OLED_TxHead = Next;
+
+	OLED_SentBytes += 2 + Count; // 从机地址+控制字节+数据
+
+	OLED_TxKick();
+}
+
+/**
+ * 函    数：通信接口完成一次传输
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：由异步通信接口在传输完成（或出错放弃）时调用，通常位于中断中
+ *           取出已完成的传输，并启动队列中的下一次传输
+ */
+void OLED_TransferComplete(void)
+{
+	OLED_TxTail = (OLED_TxTail + 1) & (OLED_TX_QUEUE_SIZE - 1);
+	OLED_TxBusy = 0;
+
+	if (OLED_TxHead != OLED_TxTail)
+	{
+		OLED_TxKick();
+	}
+	else if (OLED_TxCpltCallback != NULL)
+	{
+		OLED_TxCpltCallback(); // 队列已清空
+	}
+}
+
+/**
+ * 函    数：设置OLED通信接口
+ * 参    数：Transport 通信接口，参见OLED_Transport_t
+ * 返 回 值：无
+ * 说    明：默认使用OLED_USE_HW_I2C/OLED_USE_SOFT_I2C/OLED_USE_RECORDER选择的接口
+ *           需在OLED_Init之前调用，可用于替换为记录字节流的接口进行比对
+ */
+void OLED_SetTransport(const OLED_Transport_t *Transport)
+{
+	OLED_Transport = Transport;
+}
+
+/**
+ * 函    数：设置发送完成回调函数
+ * 参    数：Callback 回调函数，发送队列清空时调用，传入NULL取消
+ * 返 回 值：无
+ * 说    明：使用异步通信接口时，回调函数在中断中执行，应尽量简短
+ */
+void OLED_SetTxCpltCallback(void (*Callback)(void))
+{
+	OLED_TxCpltCallback = Callback;
+}
+
+/**
+ * 函    数：设置更新完成回调函数
+ * 参    数：Callback 回调函数，OLED_Update/OLED_UpdateArea/OLED_UpdateFull排队完成后调用，传入NULL取消
+ *           回调参数为本次更新的发送字节数（含从机地址、控制字节、命令和数据），无修改时为0
+ * 返 回 值：无
+ * 说    明：在调用更新函数的上下文中执行；配合录制接口可逐帧导出图像，用于画面和通信开销的回归比对
+ */
+void OLED_SetUpdateCallback(void (*Callback)(uint32_t Bytes))
+{
+	OLED_UpdateCallback = Callback;
+}
+
+/**
+ * 函    数：查询OLED是否正在发送
+ * 参    数：无
+ * 返 回 值：1：发送队列中还有数据未发送完成，0：空闲
+ */
+uint8_t OLED_IsBusy(void)
+{
+	return OLED_TxBusy || OLED_TxHead != OLED_TxTail;
+}
+
+/**
+ * 函    数：等待OLED发送完成
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：总线卡死时每次传输最多等待OLED_TX_TIMEOUT_MS，超时的传输被丢弃
+ */
+void OLED_WaitIdle(void)
+{
+	while (OLED_IsBusy())
+	{
+		OLED_TxWaitProgress();
+	}
+}
+
+/**
+ * 函    数：OLED写命令
+ * 参    数：Command 要写入的命令值，范围：0x00~0xFF
+ * 返 回 值：无
+ */
+void OLED_WriteCommand(uint8_t Command)
+{
+	OLED_TxPush(0x00, NULL, &Command, 1); // 控制字节给0x00，表示写命令
+}
+
+/**
+ * 函    数：OLED写数据
+ * 参    数：Data 要写入数据的起始地址
+ * 参    数：Count 要写入数据的数量
+ * 返 回 值：无
+ * 说    明：使用异步通信接口时函数立即返回，发送完成前Data指向的数据必须保持不变
+ */
+void OLED_WriteData(uint8_t *Data, uint8_t Count)
+{
+	OLED_TxPush(0x40, Data, NULL, Count); // 控制字节给0x40，表示写数据
+}
+
+/*********************发送队列*/
+
+/*硬件配置*********************/
+
+/**
+ * 函    数：OLED初始化
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：使用前，需要调用此初始化函数
+ */
+void OLED_Init(void)
+{
+	OLED_Transport->Init(); // 先调用底层的通信接口初始化
+
+	OLED_PageOffset = 0;
+	OLED_ScrollActive = 0;
+
+	/*写入一系列的命令，对OLED进行初始化配置*/
+	OLED_WriteCommand(0xAE); // 设置显示开启/关闭，0xAE关闭，0xAF开启
+
+	OLED_WriteCommand(0x2E); // 停止硬件滚动，单片机复位时屏幕可能仍在滚动
+
+	OLED_WriteCommand(0xD5); // 设置显示时钟分频比/振荡器频率
+	OLED_WriteCommand(0x80); // 0x00~0xFF
+
+	OLED_WriteCommand(0xA8); // 设置多路复用率
+	OLED_WriteCommand(0x3F); // 0x0E~0x3F
+
+	OLED_WriteCommand(0xD3); // 设置显示偏移
+	OLED_WriteCommand(0x00); // 0x00~0x7F
+
+	OLED_WriteCommand(0x40); // 设置显示开始行，0x40~0x7F
+
+	OLED_WriteCommand(0xA1); // 设置左右方向，0xA1正常，0xA0左右反置
+
+	OLED_WriteCommand(0xC8); // 设置上下方向，0xC8正常，0xC0上下反置
+
+	OLED_WriteCommand(0xDA); // 设置COM引脚硬件配置
+	OLED_WriteCommand(0x12);
+
+	OLED_WriteCommand(0x81); // 设置对比度
+	OLED_WriteCommand(0xCF); // 0x00~0xFF
+
+	OLED_WriteCommand(0xD9); // 设置预充电周期
+	OLED_WriteCommand(0xF1);
+
+	OLED_WriteCommand(0xDB); // 设置VCOMH取消选择级别
+	OLED_WriteCommand(0x30);
+
+	OLED_WriteCommand(0xA4); // 设置整个显示打开/关闭
+
+	OLED_WriteCommand(0xA6); // 设置正常/反色显示，0xA6正常，0xA7反色
+
+	OLED_WriteCommand(0x8D); // 设置充电泵
+	OLED_WriteCommand(0x14);
+
+	OLED_WriteCommand(0xAF); // 开启显示
+
+	OLED_Clear();		// 清空显存数组
+	OLED_UpdateFull(); // 整屏更新显示，清屏，防止初始化后未显示内容时花屏
+}
+
+/**
+ * 函    数：OLED设置显示光标位置
+ * 参    数：Page 指定光标所在的页，范围：0~7
+ * 参    数：X 指定光标所在的X轴坐标，范围：0~127
+ * 返 回 值：无
+ * 说    明：OLED默认的Y轴，只能8个Bit为一组写入，即1页等于8个Y轴坐标
+ */
+void OLED_SetCursor(uint8_t Page, uint8_t X)
+{
+	/*如果使用此程序驱动1.3寸的OLED显示屏，则需要解除此注释*/
+	/*因为1.3寸的OLED驱动芯片（SH1106）有132列*/
+	/*屏幕的起始列接在了第2列，而不是第0列*/
+	/*所以需要将X加2，才能正常显示*/
+	//	X += 2;
+
+	/*通过指令设置页地址和列地址，三条命令合并在一次传输中发送*/
+	uint8_t Command[3];
+	Command[0] = 0xB0 | ((Page + OLED_PageOffset) & 0x07); // 设置页位置，加上硬件滚动的起始页偏移
+	Command[1] = 0x10 | ((X & 0xF0) >> 4); // 设置X位置高4位
+	Command[2] = 0x00 | (X & 0x0F);		// 设置X位置低4位
+	OLED_TxPush(0x00, NULL, Command, 3);
+}
+
+/*********************硬件配置*/
+
+/*工具函数*********************/
+
+/*工具函数仅供内部部分函数使用*/
+
+/**
+ * 函    数：次方函数
+ * 参    数：X 底数
+ * 参    数：Y 指数
+ * 返 回 值：等于X的Y次方
+ */
+uint32_t OLED_Pow(uint32_t X, uint32_t Y)
+{
+	uint32_t Result = 1; // 结果默认为1
+	while (Y--)			 // 累乘Y次
+	{
+		Result *= X; // 每次把X累乘到结果上
+	}
+	return Result;
+}
+
+/**
+ * 函    数：判断指定点是否在指定多边形内部
+ * 参    数：nvert 多边形的顶点数
+ * 参    数：vertx verty 包含多边形顶点的x和y坐标的数组
+ * 参    数：testx testy 测试点的X和y坐标
+ * 返 回 值：指定点是否在指定多边形内部，1：在内部，0：不在内部
+ */
+uint8_t OLED_pnpoly(uint8_t nvert, int16_t *vertx, int16_t *verty, int16_t testx, int16_t testy)
+{
+	int16_t i, j, c = 0;
+
+	/*此算法由W. Randolph Franklin提出*/
+	/*参考链接：https://wrfranklin.org/Research/Short_Notes/pnpoly.html*/
+	for (i = 0, j = nvert - 1; i < nvert; j = i++)
+	{
+		if (((verty[i] > testy) != (verty[j] > testy)) &&
+			(testx < (vertx[j] - vertx[i]) * (testy - verty[i]) / (verty[j] - verty[i]) + vertx[i]))
+		{
+			c = !c;
+		}
+	}
+	return c;
+}
+
+/**
+ * 角度判定表
+ * 第k项（k = 1~180）为sin、cos(k * 3.14 / 180)，Q30定点数
+ * 与原atan2(Y, X) / 3.14 * 180的换算保持一致（除数为3.14而不是π），使判定结果逐点相同
+ */
+static const int32_t OLED_AngleSin[180] = {
+	18729880, 37454060, 56166843, 74862534, 93535444, 112179892, 130790203, 149360714,
+	167885775, 186359748, 204777012, 223131962, 241419012, 259632599, 277767179, 295817234,
+	313777272, 331641827, 349405463, 367062775, 384608389, 402036967, 419343204, 436521835,
+	453567632, 470475407, 487240017, 503856359, 520319377, 536624062, 552765451, 568738633,
+	584538748, 600160986, 615600596, 630852877, 645913189, 660776950, 675439635, 689896784,
+	704143996, 718176936, 731991335, 745582988, 758947759, 772081582, 784980460, 797640467,
+	810057752, 822228535, 834149114, 845815860, 857225224, 868373733, 879257995, 889874698,
+	900220612, 910292587, 920087560, 929602549, 938834659, 947781081, 956439093, 964806059,
+	972879434, 980656760, 988135672, 995313893, 1002189239, 1008759619, 1015023031, 1020977571,
+	1026621427, 1031952881, 1036970311, 1041672190, 1046057087, 1050123667, 1053870695, 1057297028,
+	1060401625, 1063183540, 1065641928, 1067776040, 1069585227, 1071068938, 1072226722, 1073058227,
+	1073563198, 1073741484, 1073593028, 1073117878, 1072316177, 1071188169, 1069734197, 1067954704,
+	1065850232, 1063421420, 1060669009, 1057593834, 1054196833, 1050479039, 1046441583, 1042085694,
+	1037412698, 1032424016, 1027121166, 1021505762, 1015579513, 1009344222, 1002801787, 995954199,
+	988803540, 981351988, 973601810, 965555363, 957215097, 948583550, 939663348, 930457205,
+	920967924, 911198391, 901151579, 890830547, 880238433, 869378463, 858253939, 846868249,
+	835224855, 823327302, 811179209, 798784274, 786146268, 773269037, 760156500, 746812646,
+	733241537, 719447301, 705434137, 691206309, 676768146, 662124041, 647278452, 632235896,
+	617000949, 601578248, 585972487, 570188414, 554230831, 538104596, 521814615, 505365846,
+	488763293, 472012009, 455117091, 438083681, 420916962, 403622157, 386204529, 368669379,
+	351022043, 333267890, 315412324, 297460777, 279418713, 261291621, 243085019, 224804445,
+	206455463, 188043656, 169574627, 151053997, 132487401, 113880489, 95238923, 76568375,
+	57874528, 39163070, 20439694, 1710098,
+};
+static const int32_t OLED_AngleCos[180] = {
+	1073578454, 1073088392, 1072271789, 1071128893, 1069660051, 1067865711, 1065746418, 1063302817,
+	1060535653, 1057445766, 1054034098, 1050301686, 1046249667, 1041879272, 1037191833, 1032188776,
+	1026871622, 1021241991, 1015301594, 1009052240, 1002495831, 995634362, 988469920, 981004685,
+	973240930, 965181017, 956827398, 948182616, 939249301, 930030172, 920528034, 910745778,
+	900686381, 890352905, 879748493, 868876373, 857739854, 846342323, 834687249, 822778179,
+	810618738, 798212624, 785563613, 772675555, 759552370, 746198054, 732616668, 718812347,
+	704789290, 690551765, 676104105, 661450705, 646596026, 631544587, 616300968, 600869808,
+	585255803, 569463704, 553498317, 537364499, 521067161, 504611262, 488001810, 471243858,
+	454342506, 437302897, 420130216, 402829689, 385406581, 367866194, 350213864, 332454964,
+	314594898, 296639100, 278593034, 260462193, 242252092, 223968274, 205616302, 187201761,
+	168730255, 150207403, 131638844, 113030226, 94387213, 75715478, 57020703, 38308577,
+	19584793, 855049, -17874954, -36599519, -55312946, -74009541, -92683616, -111329486,
+	-129941479, -148513930, -167041189, -185517617, -203937591, -222295508, -240585779, -258802840,
+	-276941147, -294995181, -312959447, -330828479, -348596841, -366259123, -383809953, -401243989,
+	-418555926, -435740496, -452792470, -469706659, -486477915, -503101136, -519571263, -535883284,
+	-552032235, -568013202, -583821322, -599451784, -614899833, -630160768, -645229943, -660102775,
+	-674774737, -689241365, -703498255, -717541071, -731365537, -744967449, -758342667, -771487120,
+	-784396809, -797067805, -809496253, -821678370, -833610450, -845288861, -856710050, -867870542,
+	-878766939, -889395927, -899754272, -909838820, -919646503, -929174337, -938419422, -947378946,
+	-956050181, -964430489, -972517320, -980308213, -987800798, -994992794, -1001882012, -1008466357,
+	-1014743825, -1020712505, -1026370581, -1031716332, -1036748131, -1041464446, -1045863843, -1049944982,
+	-1053706623, -1057147619, -1060266924, -1063063589, -1065536763, -1067685693, -1069509725, -1071008305,
+	-1072180975, -1073027380, -1073547262, -1073740462,
+};
+
+/**
+ * 函    数：计算指定点的角度
+ * 参    数：X Y 指定点的坐标
+ * 返 回 值：指定点的角度，范围：-180~180，等于(int16_t)(atan2(Y, X) / 3.14 * 180)
+ * 说    明：不使用浮点运算，在上半平面内二分查找角度判定表
+ *           点(|Y|, X)的角度不小于第k项角度，等价于X * sin - |Y| * cos <= 0
+ */
+int16_t OLED_PointAngle(int16_t X, int16_t Y)
+{
+	int32_t AbsY = Y < 0 ? -Y : Y;
+	int16_t Low = 0, High = 180, Mid;
+
+	if (X == 0 && Y == 0)
+	{
+		return 0; // 原点的角度为0
+	}
+
+	/*二分查找满足条件的最大k*/
+	while (Low < High)
+	{
+		Mid = (Low + High + 1) / 2;
+		if ((int64_t)X * OLED_AngleSin[Mid - 1] - (int64_t)AbsY * OLED_AngleCos[Mid - 1] <= 0)
+		{
+			Low = Mid;
+		}
+		else
+		{
+			High = Mid - 1;
+		}
+	}
+
+	/*下半平面的角度为负数*/
+	return Y < 0 ? -Low : Low;
+}
+
+/**
+ * 函    数：判断指定点是否在指定角度内部
+ * 参    数：X Y 指定点的坐标
+ * 参    数：StartAngle EndAngle 起始角度和终止角度，范围：-180~180
+ *           水平向右为0度，水平向左为180度或-180度，下方为正数，上方为负数，顺时针旋转
+ * 返 回 值：指定点是否在指定角度内部，1：在内部，0：不在内部
+ */
+uint8_t OLED_IsInAngle(int16_t X, int16_t Y, int16_t StartAngle, int16_t EndAngle)
 {
 	int16_t PointAngle;
-	PointAngle = atan2(Y, X) / 3.14 * 180; // 计算指定点的弧度，并转换为角度表示
+	PointAngle = OLED_PointAngle(X, Y); // 计算指定点的角度，查表实现，不使用atan2
 	if (StartAngle < EndAngle)			   // 起始角度小于终止角度的情况
 	{
-		/*如果指定角度在起始终止角度之间，则判定指定点在指定角度*/
-		if (PointAngle >= StartAngle && PointAngle <= EndAngle)
-		{
-			return 1;
-		}
+		/*如果指定角度在起始终止角度之间，则判定指定点在指定角度*/
+		if (PointAngle >= StartAngle && PointAngle <= EndAngle)
+		{
+			return 1;
+		}
+	}
+	else // 起始角度大于于终止角度的情况
+	{
+		/*如果指定角度大于起始角度或者小于终止角度，则判定指定点在指定角度*/
+		if (PointAngle >= StartAngle || PointAngle <= EndAngle)
+		{
+			return 1;
+		}
+	}
+	return 0; // 不满足以上条件，则判断判定指定点不在指定角度
+}
+
+/*OLED_MaskArea的Op参数数值*/
+#define OLED_MASK_CLEAR		0 // 清零
+#define OLED_MASK_REVERSE	1 // 取反
+
+/**
+ * 函    数：按页掩码对显存数组的矩形区域进行清零或取反
+ * 参    数：X 指定区域左上角的横坐标，范围：-32768~32767，屏幕区域：0~127
+ * 参    数：Y 指定区域左上角的纵坐标，范围：-32768~32767，屏幕区域：0~63
+ * 参    数：Width 指定区域的宽度，范围：0~128
+ * 参    数：Height 指定区域的高度，范围：0~64
+ * 参    数：Op 操作类型，OLED_MASK_CLEAR或OLED_MASK_REVERSE
+ * 返 回 值：无
+ * 说    明：区域先一次性裁剪到屏幕范围内，再逐页处理
+ *           每页只计算一次行掩码，整页被覆盖时按32位字读写，首尾不足一个字的列逐字节处理
+ */
+void OLED_MaskArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, uint8_t Op)
+{
+	int16_t X0, X1, Y0, Y1, Page, Top, Bottom, i;
+	uint8_t Mask;
+	uint8_t *Row;
+	uint32_t *Word;
+
+	/*裁剪到屏幕范围，[X0, X1)、[Y0, Y1)为需要处理的列和行*/
+	X0 = X < 0 ? 0 : X;
+	X1 = X + Width > 128 ? 128 : X + Width;
+	Y0 = Y < 0 ? 0 : Y;
+	Y1 = Y + Height > 64 ? 64 : Y + Height;
+	if (X0 >= X1 || Y0 >= Y1)
+	{
+		return;
+	}
+
+	for (Page = Y0 / 8; Page <= (Y1 - 1) / 8; Page++)
+	{
+		/*本页内需要处理的行*/
+		Top = Y0 > Page * 8 ? Y0 - Page * 8 : 0;
+		Bottom = Y1 - 1 < Page * 8 + 7 ? Y1 - 1 - Page * 8 : 7;
+		Mask = (0xFF << Top) & (0xFF >> (7 - Bottom));
+		Row = OLED_DisplayBuf[Page];
+		i = X0;
+
+		if (Mask == 0xFF)
+		{
+			/*整页覆盖，首部逐字节处理到字对齐*/
+			for (; i < X1 && (i & 3); i++)
+			{
+				Row[i] = (Op == OLED_MASK_CLEAR) ? 0x00 : Row[i] ^ 0xFF;
+			}
+			/*中间按32位字处理*/
+			Word = (uint32_t *)&Row[i];
+			if (Op == OLED_MASK_CLEAR)
+			{
+				for (; i + 4 <= X1; i += 4)
+				{
+					*Word++ = 0x00000000;
+				}
+			}
+			else
+			{
+				for (; i + 4 <= X1; i += 4)
+				{
+					*Word++ ^= 0xFFFFFFFF;
+				}
+			}
+		}
+
+		/*部分页，或整页剩余的尾部字节*/
+		if (Op == OLED_MASK_CLEAR)
+		{
+			for (; i < X1; i++)
+			{
+				Row[i] &= ~Mask;
+			}
+		}
+		else
+		{
+			for (; i < X1; i++)
+			{
+				Row[i] ^= Mask;
+			}
+		}
+	}
+}
+
+/**
+ * 函    数：标记显存脏区
+ * 参    数：X 指定区域左上角的横坐标，范围：-32768~32767，屏幕区域：0~127
+ * 参    数：Y 指定区域左上角的纵坐标，范围：-32768~32767，屏幕区域：0~63
+ * 参    数：Width 指定区域的宽度，范围：0~32767
+ * 参    数：Height 指定区域的高度，范围：0~32767
+ * 返 回 值：无
+ * 说    明：将指定区域涉及的页和列并入脏区，超出屏幕的部分会被裁剪
+ */
+void OLED_MarkDirty(int16_t X, int16_t Y, int16_t Width, int16_t Height)
+{
+	int16_t X0 = X, X1 = X + Width - 1;
+	int16_t Y0 = Y, Y1 = Y + Height - 1;
+	int16_t j;
+
+	/*裁剪到屏幕区域*/
+	if (X0 < 0)
+	{
+		X0 = 0;
+	}
+	if (X1 > 127)
+	{
+		X1 = 127;
+	}
+	if (Y0 < 0)
+	{
+		Y0 = 0;
+	}
+	if (Y1 > 63)
+	{
+		Y1 = 63;
+	}
+	if (Width <= 0 || Height <= 0 || X0 > X1 || Y0 > Y1)
+	{
+		return; // 区域完全在屏幕外
+	}
+
+	/*扩大涉及页的脏区列范围*/
+	for (j = Y0 / 8; j <= Y1 / 8; j++)
+	{
+		if (X0 < OLED_DirtyStart[j])
+		{
+			OLED_DirtyStart[j] = X0;
+		}
+		if (X1 > OLED_DirtyEnd[j])
+		{
+			OLED_DirtyEnd[j] = X1;
+		}
+	}
+}
+
+/**
+ * 函    数：发送显存数组一页中的指定列范围
+ * 参    数：Page 指定页，范围：0~7
+ * 参    数：X0 X1 指定起始列和终止列，范围：0~127
+ * 参    数：Compare 是否与屏幕内容镜像比较，1：去掉两端内容未变化的列，0：全部发送
+ * 返 回 值：无
+ * 说    明：发送后同步更新屏幕内容镜像
+ */
+void OLED_SendSpan(uint8_t Page, uint8_t X0, uint8_t X1, uint8_t Compare)
+{
+	if (OLED_ScrollActive)
+	{
+		return; // 连续滚动期间禁止写屏幕RAM，停止滚动时整屏重发
+	}
+
+	if (Compare)
+	{
+		/*跳过两端与屏幕内容一致的列*/
+		while (X0 <= X1 && OLED_DisplayBuf[Page][X0] == OLED_SentBuf[Page][X0])
+		{
+			X0++;
+		}
+		if (X0 > X1)
+		{
+			return; // 内容完全一致，无需发送
+		}
+		while (OLED_DisplayBuf[Page][X1] == OLED_SentBuf[Page][X1])
+		{
+			X1--;
+		}
+	}
+
+	/*先复制到屏幕内容镜像，再从镜像发送*/
+	/*异步发送期间绘图函数可以继续修改显存数组，不影响正在发送的数据*/
+	memcpy(&OLED_SentBuf[Page][X0], &OLED_DisplayBuf[Page][X0], X1 - X0 + 1);
+
+	/*设置光标位置并连续写入数据*/
+	OLED_SetCursor(Page, X0);
+	OLED_WriteData(&OLED_SentBuf[Page][X0], X1 - X0 + 1);
+}
+
+/**
+ * 函    数：点亮一行中的连续多个点
+ * 参    数：X0 X1 起始和终止横坐标（包含两端），范围：-32768~32767，屏幕区域：0~127
+ * 参    数：Y 纵坐标，范围：-32768~32767，屏幕区域：0~63
+ * 返 回 值：无
+ * 说    明：与逐点调用OLED_DrawPoint效果相同，裁剪和脏区标记每行只做一次
+ */
+void OLED_FillSpan(int16_t X0, int16_t X1, int16_t Y)
+{
+	int16_t i;
+	uint8_t Bit;
+	uint8_t *Row;
+
+	if (Y < 0 || Y > 63)
+	{
+		return;
+	}
+	if (X0 < 0)
+	{
+		X0 = 0;
+	}
+	if (X1 > 127)
+	{
+		X1 = 127;
+	}
+	if (X0 > X1)
+	{
+		return;
+	}
+
+	Bit = 0x01 << (Y % 8);
+	Row = OLED_DisplayBuf[Y / 8];
+	for (i = X0; i <= X1; i++)
+	{
+		Row[i] |= Bit;
+	}
+	OLED_MarkDirty(X0, Y, X1 - X0 + 1, 1);
+}
+
+/*多边形填充支持的最大顶点数*/
+#define OLED_POLYGON_MAX_VERTEX	16
+
+/**
+ * 函    数：扫描线填充多边形
+ * 参    数：nvert 多边形的顶点数，范围：3~OLED_POLYGON_MAX_VERTEX
+ * 参    数：vertx verty 包含多边形顶点的x和y坐标的数组
+ * 返 回 值：无
+ * 说    明：填充结果与对包围矩形内每个点调用OLED_pnpoly判断完全相同
+ *           每一行求出各条边与该行的交点（计算方法与OLED_pnpoly相同），排序后按奇偶规则成对填充
+ *           点X在多边形内部，等价于大于X的交点个数为奇数，即X位于第2k个与第2k+1个交点之间
+ */
+void OLED_FillPolygon(uint8_t nvert, int16_t *vertx, int16_t *verty)
+{
+	int32_t Cross[OLED_POLYGON_MAX_VERTEX], t;
+	int16_t i, j, k, n, y, miny, maxy;
+
+	if (nvert < 3 || nvert > OLED_POLYGON_MAX_VERTEX)
+	{
+		return;
+	}
+
+	/*找到顶点最小、最大的Y坐标，并裁剪到屏幕范围*/
+	miny = maxy = verty[0];
+	for (i = 1; i < nvert; i++)
+	{
+		if (verty[i] < miny)
+		{
+			miny = verty[i];
+		}
+		if (verty[i] > maxy)
+		{
+			maxy = verty[i];
+		}
+	}
+	if (miny < 0)
+	{
+		miny = 0;
+	}
+	if (maxy > 63)
+	{
+		maxy = 63;
+	}
+
+	/*逐行扫描*/
+	for (y = miny; y <= maxy; y++)
+	{
+		/*求出所有与本行相交的边的交点，同时插入排序*/
+		n = 0;
+		for (i = 0, j = nvert - 1; i < nvert; j = i++)
+		{
+			if ((verty[i] > y) != (verty[j] > y))
+			{
+				t = (vertx[j] - vertx[i]) * (y - verty[i]) / (verty[j] - verty[i]) + vertx[i];
+				for (k = n; k > 0 && Cross[k - 1] > t; k--)
+				{
+					Cross[k] = Cross[k - 1];
+				}
+				Cross[k] = t;
+				n++;
+			}
+		}
+
+		/*交点成对出现，填充每一对交点之间的部分，先限制到屏幕附近避免超出int16_t范围*/
+		for (k = 0; k + 1 < n; k += 2)
+		{
+			if (Cross[k] < 128 && Cross[k + 1] > 0)
+			{
+				OLED_FillSpan(Cross[k] < 0 ? 0 : Cross[k], Cross[k + 1] > 128 ? 127 : Cross[k + 1] - 1, y);
+			}
+		}
+	}
+}
+
+/**
+ * 函    数：计算单个汉字的编码值
+ * 参    数：Chinese 单个汉字，长度为OLED_CHN_CHAR_WIDTH个字节
+ * 返 回 值：编码值，UTF-8格式为解码后的Unicode码点，GB2312格式为两个字节组成的内码
+ *           空字符串（字模库末尾的默认图形）返回0
+ */
+uint32_t OLED_ChineseCode(const char *Chinese)
+{
+	const uint8_t *p = (const uint8_t *)Chinese;
+
+	if (p[0] == '\0')
+	{
+		return 0;
+	}
+#if OLED_CHN_CHAR_WIDTH == 3
+	/*UTF-8三字节编码：1110xxxx 10xxxxxx 10xxxxxx*/
+	return ((uint32_t)(p[0] & 0x0F) << 12) | ((uint32_t)(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+#else
+	return ((uint32_t)p[0] << 8) | p[1];
+#endif
+}
+
+/**
+ * 函    数：在汉字字模库中查找指定汉字
+ * 参    数：Chinese 单个汉字，长度为OLED_CHN_CHAR_WIDTH个字节
+ * 返 回 值：汉字在OLED_CF16x16中的下标，未找到时返回末尾默认图形的下标
+ * 说    明：在oled_index.py生成的常量索引OLED_CF16x16_Index中二分查找，
+ *           比较的是整数编码值，查找次数约为log2(字模数量)，不需要在启动时排序
+ */
+uint16_t OLED_FindChinese(const char *Chinese)
+{
+	uint16_t Low = 0, High, Mid;
+	uint32_t Code;
+
+	Code = OLED_ChineseCode(Chinese);
+	if (Code != 0)
+	{
+		/*查找第一个编码值不小于Code的位置*/
+		High = OLED_CF16x16_IndexCount;
+		while (Low < High)
+		{
+			Mid = (Low + High) / 2;
+			if (OLED_CF16x16_Index[Mid].Code < Code)
+			{
+				Low = Mid + 1;
+			}
+			else
+			{
+				High = Mid;
+			}
+		}
+
+		/*找到匹配的汉字*/
+		if (Low < OLED_CF16x16_IndexCount && OLED_CF16x16_Index[Low].Code == Code)
+		{
+			return OLED_CF16x16_Index[Low].Index;
+		}
+	}
+
+	/*未找到，返回末尾默认图形（定义为空字符串）的下标*/
+	return OLED_CF16x16_Count - 1;
+}
+
+/*********************工具函数*/
+
+/*功能函数*********************/
+
+/**
+ * 函    数：将OLED显存数组更新到OLED屏幕
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：所有的显示函数，都只是对OLED显存数组进行读写
+ *           随后调用OLED_Update函数或OLED_UpdateArea函数
+ *           才会将显存数组的数据发送到OLED硬件，进行显示
+ *           故调用显示函数后，要想真正地呈现在屏幕上，还需调用更新函数
+ */
+void OLED_Update(void)
+{
+	uint8_t j;
+	uint32_t Bytes = OLED_SentBytes;
+	/*遍历每一页*/
+	for (j = 0; j < 8; j++)
+	{
+		/*只发送被修改过的列范围，未修改的页直接跳过*/
+		if (OLED_DirtyStart[j] <= OLED_DirtyEnd[j])
+		{
+			OLED_SendSpan(j, OLED_DirtyStart[j], OLED_DirtyEnd[j], 1);
+
+			/*清除该页脏区*/
+			OLED_DirtyStart[j] = 0xFF;
+			OLED_DirtyEnd[j] = 0;
+		}
+	}
+
+	if (OLED_UpdateCallback != NULL)
+	{
+		OLED_UpdateCallback(OLED_SentBytes - Bytes);
+	}
+}
+
+/**
+ * 函    数：将OLED显存数组全部强制更新到OLED屏幕
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：不判断脏区，整屏8页×128列全部发送
+ *           用于初始化，或屏幕内容与显存数组可能不一致时（如上电、受干扰后）恢复显示
+ */
+void OLED_UpdateFull(void)
+{
+	uint8_t j;
+	uint32_t Bytes = OLED_SentBytes;
+	for (j = 0; j < 8; j++)
+	{
+		OLED_SendSpan(j, 0, 127, 0);
+		OLED_DirtyStart[j] = 0xFF;
+		OLED_DirtyEnd[j] = 0;
+	}
+
+	if (OLED_UpdateCallback != NULL)
+	{
+		OLED_UpdateCallback(OLED_SentBytes - Bytes);
+	}
+}
+
+/**
+ * 函    数：交换显存并在后台发送一帧
+ * 参    数：无
+ * 返 回 值：1：本帧已交换并开始发送，0：上一帧仍在发送，本帧被合并到下一帧
+ * 说    明：OLED_DisplayBuf作为后台缓冲区供绘图函数写入，屏幕内容镜像作为前台缓冲区供通信接口读取
+ *           交换时把后台缓冲区中被修改的部分复制到前台缓冲区并排入发送队列，随后立即返回
+ *           调用者可以马上绘制下一帧，绘制与发送同时进行
+ *           若上一帧尚未发送完，本帧不复制也不发送，脏区保留，其修改随下一次调用一起发送
+ *           适用于周期性刷新的界面（游戏、实时统计），最后一帧需要确保显示时可调用OLED_Update
+ */
+uint8_t OLED_SwapAndFlush(void)
+{
+	if (OLED_IsBusy())
+	{
+		OLED_FrameCoalesced++;
+		return 0;
+	}
+
+	OLED_Update();
+	OLED_FrameFlushed++;
+	return 1;
+}
+
+/**
+ * 函    数：获取OLED帧统计
+ * 参    数：Flushed 返回已交换并开始发送的帧数，可传入NULL
+ * 参    数：Coalesced 返回因上一帧未发送完而被合并的帧数，可传入NULL
+ * 返 回 值：无
+ */
+void OLED_GetFrameStats(uint32_t *Flushed, uint32_t *Coalesced)
+{
+	if (Flushed != NULL)
+	{
+		*Flushed = OLED_FrameFlushed;
 	}
-	else // 起始角度大于于终止角度的情况
+	if (Coalesced != NULL)
 	{
-		/*如果指定角度大于起始角度或者小于终止角度，则判定指定点在指定角度*/
-		if (PointAngle >= StartAngle || PointAngle <= EndAngle)
-		{
-			return 1;
-		}
+		*Coalesced = OLED_FrameCoalesced;
 	}
-	return 0; // 不满足以上条件，则判断判定指定点不在指定角度
 }
 
-/*********************工具函数*/
+/**
+ * 函    数：清零OLED帧统计
+ * 参    数：无
+ * 返 回 值：无
+ */
+void OLED_ResetFrameStats(void)
+{
+	OLED_FrameFlushed = 0;
+	OLED_FrameCoalesced = 0;
+}
 
-/*功能函数*********************/
+/**
+ * 函    数：获取OLED累计发送字节数
+ * 参    数：无
+ * 返 回 值：自上次清零以来通过I2C发送的字节数（含从机地址、控制字节、命令和数据）
+ * 说    明：可在刷新前后读取差值，评估一次更新的通信开销
+ */
+uint32_t OLED_GetSentBytes(void)
+{
+	return OLED_SentBytes;
+}
 
 /**
- * 函    数：将OLED显存数组更新到OLED屏幕
+ * 函    数：清零OLED累计发送字节数
  * 参    数：无
  * 返 回 值：无
- * 说    明：所有的显示函数，都只是对OLED显存数组进行读写
- *           随后调用OLED_Update函数或OLED_UpdateArea函数
- *           才会将显存数组的数据发送到OLED硬件，进行显示
- *           故调用显示函数后，要想真正地呈现在屏幕上，还需调用更新函数
  */
-void OLED_Update(void)
+void OLED_ResetSentBytes(void)
 {
-	uint8_t j;
-	/*遍历每一页*/
-	for (j = 0; j < 8; j++)
-	{
-		/*设置光标位置为每一页的第一列*/
-		OLED_SetCursor(j, 0);
-		/*连续写入128个数据，将显存数组的数据写入到OLED硬件*/
-		OLED_WriteData(OLED_DisplayBuf[j], 128);
-	}
+	OLED_SentBytes = 0;
 }
 
 /**
@@ -412,6 +1741,7 @@ void OLED_UpdateArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height)
 {
 	int16_t j;
 	int16_t Page, Page1;
+	uint32_t Bytes = OLED_SentBytes;
 
 	/*负数坐标在计算页地址时需要加一个偏移*/
 	/*(Y + Height - 1) / 8 + 1的目的是(Y + Height) / 8并向上取整*/
@@ -426,14 +1756,208 @@ void OLED_UpdateArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height)
 	/*遍历指定区域涉及的相关页*/
 	for (j = Page; j < Page1; j++)
 	{
-		if (X >= 0 && X <= 127 && j >= 0 && j <= 7) // 超出屏幕的内容不显示
+		if (X >= 0 && X <= 127 && j >= 0 && j <= 7 && Width > 0) // 超出屏幕的内容不显示
+		{
+			/*连续写入Width个数据，将显存数组的数据写入到OLED硬件，超出右边界的列不发送*/
+			OLED_SendSpan(j, X, (X + Width - 1 > 127) ? 127 : X + Width - 1, 0);
+		}
+	}
+
+	if (OLED_UpdateCallback != NULL)
+	{
+		OLED_UpdateCallback(OLED_SentBytes - Bytes);
+	}
+}
+
+/**
+ * 函    数：交换两页数据
+ * 参    数：Buf 显存数组或屏幕内容镜像
+ * 参    数：A B 要交换的两页，范围：0~7
+ * 返 回 值：无
+ */
+static void OLED_SwapPage(uint8_t (*Buf)[128], uint8_t A, uint8_t B)
+{
+	uint32_t *PA = (uint32_t *)Buf[A];
+	uint32_t *PB = (uint32_t *)Buf[B];
+	uint32_t Temp;
+	uint8_t i;
+
+	for (i = 0; i < 32; i++)
+	{
+		Temp = PA[i];
+		PA[i] = PB[i];
+		PB[i] = Temp;
+	}
+}
+
+/**
+ * 函    数：OLED整屏按页硬件滚动一步
+ * 参    数：Pages 滚动的页数，范围：-7~7，正数内容向上移动（底部露出新页），负数内容向下移动（顶部露出新页）
+ * 返 回 值：无
+ * 说    明：通过设置显示起始行（0x40~0x7F）移动屏幕，屏幕RAM中已有的内容无需重发
+ *           显存数组同步移动，露出的页被清零，调用者在其中绘制新内容后调用更新函数，只有新露出的页需要发送
+ *           例如菜单下移一项（16像素）：OLED_ScrollPages(2)，在底部两页绘制新菜单项，再调用OLED_Update
+ *           整屏一起移动，需要固定不动的区域（如状态栏）要在滚动后重绘
+ *           会等待正在进行的发送完成
+ */
+void OLED_ScrollPages(int8_t Pages)
+{
+	uint8_t Count, j;
+
+	if (Pages == 0 || Pages > 7 || Pages < -7 || OLED_ScrollActive)
+	{
+		return;
+	}
+
+	OLED_WaitIdle(); // 屏幕内容镜像正被通信接口读取时不能移动
+
+	Count = Pages > 0 ? Pages : -Pages;
+
+	if (Pages > 0) // 内容向上移动
+	{
+		memmove(OLED_DisplayBuf[0], OLED_DisplayBuf[Count], (8 - Count) * 128);
+		memmove(OLED_DirtyStart, OLED_DirtyStart + Count, 8 - Count);
+		memmove(OLED_DirtyEnd, OLED_DirtyEnd + Count, 8 - Count);
+		for (j = 8 - Count; j < 8; j++)
+		{
+			memset(OLED_DisplayBuf[j], 0x00, 128);
+			OLED_DirtyStart[j] = 0; // 露出的页在屏幕RAM中是卷回来的旧内容，整页标记为脏区
+			OLED_DirtyEnd[j] = 127;
+		}
+	}
+	else // 内容向下移动
+	{
+		memmove(OLED_DisplayBuf[Count], OLED_DisplayBuf[0], (8 - Count) * 128);
+		memmove(OLED_DirtyStart + Count, OLED_DirtyStart, 8 - Count);
+		memmove(OLED_DirtyEnd + Count, OLED_DirtyEnd, 8 - Count);
+		for (j = 0; j < Count; j++)
 		{
-			/*设置光标位置为相关页的指定列*/
-			OLED_SetCursor(j, X);
-			/*连续写入Width个数据，将显存数组的数据写入到OLED硬件*/
-			OLED_WriteData(&OLED_DisplayBuf[j][X], Width);
+			memset(OLED_DisplayBuf[j], 0x00, 128);
+			OLED_DirtyStart[j] = 0;
+			OLED_DirtyEnd[j] = 127;
 		}
 	}
+
+	/*屏幕RAM不变，只是显示的起始页改变，屏幕内容镜像按页循环移位（三次翻转实现）*/
+	Count = Pages > 0 ? Count : 8 - Count; // 统一为向上循环移动Count页
+	for (j = 0; j < Count / 2; j++)
+	{
+		OLED_SwapPage(OLED_SentBuf, j, Count - 1 - j);
+	}
+	for (j = 0; j < (8 - Count) / 2; j++)
+	{
+		OLED_SwapPage(OLED_SentBuf, Count + j, 7 - j);
+	}
+	for (j = 0; j < 4; j++)
+	{
+		OLED_SwapPage(OLED_SentBuf, j, 7 - j);
+	}
+
+	OLED_PageOffset = (OLED_PageOffset + Count) & 0x07;
+	OLED_WriteCommand(0x40 | (OLED_PageOffset * 8)); // 设置显示起始行
+}
+
+/**
+ * 函    数：OLED开始水平连续滚动
+ * 参    数：Direction 滚动方向
+ *           范围：OLED_SCROLL_RIGHT	向右滚动
+ *                 OLED_SCROLL_LEFT		向左滚动
+ * 参    数：StartPage 起始页，范围：0~7
+ * 参    数：EndPage 终止页，范围：StartPage~7
+ * 参    数：Interval 每步间隔，SSD1306编码，范围：0~7，分别为5/64/128/256/3/4/25/2帧
+ * 返 回 值：无
+ * 说    明：由OLED控制器自行滚动，滚动期间不占用通信，适合跑马灯、背景滚动等效果
+ *           滚动期间更新函数不发送数据（显存数组照常绘制），调用OLED_ScrollStop后整屏重发
+ *           经过OLED_ScrollPages偏移后页范围在屏幕RAM中跨越末页时，改为整屏滚动
+ */
+void OLED_ScrollStart(uint8_t Direction, uint8_t StartPage, uint8_t EndPage, uint8_t Interval)
+{
+	uint8_t Command[7];
+	uint8_t Start = (StartPage + OLED_PageOffset) & 0x07;
+	uint8_t End = (EndPage + OLED_PageOffset) & 0x07;
+
+	if (Start > End)
+	{
+		Start = 0;
+		End = 7;
+	}
+
+	OLED_WaitIdle(); // 滚动开始后禁止写屏幕RAM，先发完已排队的数据
+
+	Command[0] = 0x26 + (Direction & 0x01); // 0x26向右，0x27向左
+	Command[1] = 0x00;
+	Command[2] = Start;
+	Command[3] = Interval & 0x07;
+	Command[4] = End;
+	Command[5] = 0x00;
+	Command[6] = 0xFF;
+	OLED_TxPush(0x00, Command, NULL, 7);
+	OLED_WaitIdle(); // Command在栈上，发送完成后才能返回
+
+	OLED_WriteCommand(0x2F); // 开始滚动
+	OLED_ScrollActive = 1;
+}
+
+/**
+ * 函    数：OLED开始垂直加水平连续滚动
+ * 参    数：Direction 水平滚动方向，OLED_SCROLL_RIGHT或OLED_SCROLL_LEFT
+ * 参    数：StartPage 水平滚动起始页，范围：0~7
+ * 参    数：EndPage 水平滚动终止页，范围：StartPage~7
+ * 参    数：Interval 每步间隔，编码同OLED_ScrollStart
+ * 参    数：VerticalStep 每步垂直滚动的行数，范围：0~63，为0时只水平滚动
+ * 返 回 值：无
+ * 说    明：垂直滚动区域为整屏64行，停止后整屏重发
+ */
+void OLED_ScrollDiagonalStart(uint8_t Direction, uint8_t StartPage, uint8_t EndPage, uint8_t Interval, uint8_t VerticalStep)
+{
+	uint8_t Command[6];
+	uint8_t Start = (StartPage + OLED_PageOffset) & 0x07;
+	uint8_t End = (EndPage + OLED_PageOffset) & 0x07;
+
+	if (Start > End)
+	{
+		Start = 0;
+		End = 7;
+	}
+
+	OLED_WaitIdle();
+
+	Command[0] = 0xA3; // 设置垂直滚动区域：顶部固定0行，滚动64行
+	Command[1] = 0x00;
+	Command[2] = 64;
+	OLED_TxPush(0x00, NULL, Command, 3);
+
+	Command[0] = 0x29 + (Direction & 0x01); // 0x29向右，0x2A向左
+	Command[1] = 0x00;
+	Command[2] = Start;
+	Command[3] = Interval & 0x07;
+	Command[4] = End;
+	Command[5] = VerticalStep & 0x3F;
+	OLED_TxPush(0x00, Command, NULL, 6);
+	OLED_WaitIdle();
+
+	OLED_WriteCommand(0x2F);
+	OLED_ScrollActive = 1;
+}
+
+/**
+ * 函    数：OLED停止连续滚动
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：停止后屏幕RAM内容已被滚动改变（SSD1306要求停止后重写），此函数恢复显示起始行并把显存数组整屏重发
+ *           滚动期间对显存数组的绘制在此时一并显示
+ */
+void OLED_ScrollStop(void)
+{
+	if (!OLED_ScrollActive)
+	{
+		return;
+	}
+
+	OLED_WriteCommand(0x2E);						 // 停止滚动
+	OLED_WriteCommand(0x40 | (OLED_PageOffset * 8)); // 垂直滚动会改变显示起始行，恢复
+	OLED_ScrollActive = 0;
+	OLED_UpdateFull();
 }
 
 /**
@@ -444,14 +1968,13 @@ void OLED_UpdateArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height)
  */
 void OLED_Clear(void)
 {
-	uint8_t i, j;
-	for (j = 0; j < 8; j++) // 遍历8页
+	uint16_t i;
+	uint32_t *Word = (uint32_t *)OLED_DisplayBuf;
+	for (i = 0; i < sizeof(OLED_DisplayBuf) / 4; i++) // 按32位字遍历整个显存数组
 	{
-		for (i = 0; i < 128; i++) // 遍历128列
-		{
-			OLED_DisplayBuf[j][i] = 0x00; // 将显存数组数据全部清零
-		}
+		Word[i] = 0x00000000; // 将显存数组数据全部清零
 	}
+	OLED_MarkDirty(0, 0, 128, 64); // 整屏标记为脏区
 }
 
 /**
@@ -465,18 +1988,8 @@ void OLED_Clear(void)
  */
 void OLED_ClearArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height)
 {
-	int16_t i, j;
-
-	for (j = Y; j < Y + Height; j++) // 遍历指定页
-	{
-		for (i = X; i < X + Width; i++) // 遍历指定列
-		{
-			if (i >= 0 && i <= 127 && j >= 0 && j <= 63) // 超出屏幕的内容不显示
-			{
-				OLED_DisplayBuf[j / 8][i] &= ~(0x01 << (j % 8)); // 将显存数组指定数据清零
-			}
-		}
-	}
+	OLED_MaskArea(X, Y, Width, Height, OLED_MASK_CLEAR); // 将显存数组指定区域清零
+	OLED_MarkDirty(X, Y, Width, Height); // 标记脏区
 }
 
 /**
@@ -487,14 +2000,13 @@ void OLED_ClearArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height)
  */
 void OLED_Reverse(void)
 {
-	uint8_t i, j;
-	for (j = 0; j < 8; j++) // 遍历8页
+	uint16_t i;
+	uint32_t *Word = (uint32_t *)OLED_DisplayBuf;
+	for (i = 0; i < sizeof(OLED_DisplayBuf) / 4; i++) // 按32位字遍历整个显存数组
 	{
-		for (i = 0; i < 128; i++) // 遍历128列
-		{
-			OLED_DisplayBuf[j][i] ^= 0xFF; // 将显存数组数据全部取反
-		}
+		Word[i] ^= 0xFFFFFFFF; // 将显存数组数据全部取反
 	}
+	OLED_MarkDirty(0, 0, 128, 64); // 整屏标记为脏区
 }
 
 /**
@@ -508,18 +2020,8 @@ void OLED_Reverse(void)
  */
 void OLED_ReverseArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height)
 {
-	int16_t i, j;
-
-	for (j = Y; j < Y + Height; j++) // 遍历指定页
-	{
-		for (i = X; i < X + Width; i++) // 遍历指定列
-		{
-			if (i >= 0 && i <= 127 && j >= 0 && j <= 63) // 超出屏幕的内容不显示
-			{
-				OLED_DisplayBuf[j / 8][i] ^= 0x01 << (j % 8); // 将显存数组指定数据取反
-			}
-		}
-	}
+	OLED_MaskArea(X, Y, Width, Height, OLED_MASK_REVERSE); // 将显存数组指定区域取反
+	OLED_MarkDirty(X, Y, Width, Height); // 标记脏区
 }
 
 /**
@@ -583,12 +2085,13 @@ void OLED_ShowString(int16_t X, int16_t Y, char *String, uint8_t FontSize)
 void OLED_ShowNum(int16_t X, int16_t Y, uint32_t Number, uint8_t Length, uint8_t FontSize)
 {
 	uint8_t i;
-	for (i = 0; i < Length; i++) // 遍历数字的每一位
+	for (i = Length; i > 0; i--) // 从最低位开始遍历数字的每一位
 	{
-		/*调用OLED_ShowChar函数，依次显示每个数字*/
-		/*Number / OLED_Pow(10, Length - i - 1) % 10 可以十进制提取数字的每一位*/
+		/*调用OLED_ShowChar函数，从右向左依次显示每个数字*/
+		/*Number % 10 取出最低位，Number / 10 去掉最低位，每位只做一次除法*/
 		/*+ '0' 可将数字转换为字符格式*/
-		OLED_ShowChar(X + i * FontSize, Y, Number / OLED_Pow(10, Length - i - 1) % 10 + '0', FontSize);
+		OLED_ShowChar(X + (i - 1) * FontSize, Y, Number % 10 + '0', FontSize);
+		Number /= 10;
 	}
 }
 
@@ -606,7 +2109,6 @@ void OLED_ShowNum(int16_t X, int16_t Y, uint32_t Number, uint8_t Length, uint8_t
  */
 void OLED_ShowSignedNum(int16_t X, int16_t Y, int32_t Number, uint8_t Length, uint8_t FontSize)
 {
-	uint8_t i;
 	uint32_t Number1;
 
 	if (Number >= 0) // 数字大于等于0
@@ -620,13 +2122,8 @@ void OLED_ShowSignedNum(int16_t X, int16_t Y, int32_t Number, uint8_t Length, ui
 		Number1 = -Number;					// Number1等于Number取负
 	}
 
-	for (i = 0; i < Length; i++) // 遍历数字的每一位
-	{
-		/*调用OLED_ShowChar函数，依次显示每个数字*/
-		/*Number1 / OLED_Pow(10, Length - i - 1) % 10 可以十进制提取数字的每一位*/
-		/*+ '0' 可将数字转换为字符格式*/
-		OLED_ShowChar(X + (i + 1) * FontSize, Y, Number1 / OLED_Pow(10, Length - i - 1) % 10 + '0', FontSize);
-	}
+	/*显示数字部分，紧跟在符号之后*/
+	OLED_ShowNum(X + FontSize, Y, Number1, Length, FontSize);
 }
 
 /**
@@ -646,8 +2143,8 @@ void OLED_ShowHexNum(int16_t X, int16_t Y, uint32_t Number, uint8_t Length, uint
 	uint8_t i, SingleNumber;
 	for (i = 0; i < Length; i++) // 遍历数字的每一位
 	{
-		/*以十六进制提取数字的每一位*/
-		SingleNumber = Number / OLED_Pow(16, Length - i - 1) % 16;
+		/*以十六进制提取数字的每一位，每位4bit，移位代替除法*/
+		SingleNumber = (Number >> ((Length - i - 1) * 4)) & 0x0F;
 
 		if (SingleNumber < 10) // 单个数字小于10
 		{
@@ -682,9 +2179,9 @@ void OLED_ShowBinNum(int16_t X, int16_t Y, uint32_t Number, uint8_t Length, uint
 	for (i = 0; i < Length; i++) // 遍历数字的每一位
 	{
 		/*调用OLED_ShowChar函数，依次显示每个数字*/
-		/*Number / OLED_Pow(2, Length - i - 1) % 2 可以二进制提取数字的每一位*/
+		/*(Number >> (Length - i - 1)) & 1 可以二进制提取数字的每一位*/
 		/*+ '0' 可将数字转换为字符格式*/
-		OLED_ShowChar(X + i * FontSize, Y, Number / OLED_Pow(2, Length - i - 1) % 2 + '0', FontSize);
+		OLED_ShowChar(X + i * FontSize, Y, ((Number >> (Length - i - 1)) & 1) + '0', FontSize);
 	}
 }
 
@@ -719,7 +2216,7 @@ void OLED_ShowFloatNum(int16_t X, int16_t Y, double Number, uint8_t IntLength, u
 	IntNum = Number;				  // 直接赋值给整型变量，提取整数
 	Number -= IntNum;				  // 将Number的整数减掉，防止之后将小数乘到整数时因数过大造成错误
 	PowNum = OLED_Pow(10, FraLength); // 根据指定小数的位数，确定乘数
-	FraNum = round(Number * PowNum);  // 将小数乘到整数，同时四舍五入，避免显示误差
+	FraNum = Number * PowNum + 0.5;	  // 将小数乘到整数，同时四舍五入，避免显示误差
 	IntNum += FraNum / PowNum;		  // 若四舍五入造成了进位，则需要再加给整数
 
 	/*显示整数部分*/
@@ -745,8 +2242,8 @@ void OLED_ShowFloatNum(int16_t X, int16_t Y, double Number, uint8_t IntLength, u
 void OLED_ShowChinese(int16_t X, int16_t Y, char *Chinese)
 {
 	uint8_t pChinese = 0;
-	uint8_t pIndex;
-	uint8_t i;
+	uint16_t pIndex;
+	uint16_t i;
 	char SingleChinese[OLED_CHN_CHAR_WIDTH + 1] = {0};
 
 	for (i = 0; Chinese[i] != '\0'; i++) // 遍历汉字串
@@ -759,16 +2256,8 @@ void OLED_ShowChinese(int16_t X, int16_t Y, char *Chinese)
 		{
 			pChinese = 0; // 计次归零
 
-			/*遍历整个汉字字模库，寻找匹配的汉字*/
-			/*如果找到最后一个汉字（定义为空字符串），则表示汉字未在字模库定义，停止寻找*/
-			for (pIndex = 0; strcmp(OLED_CF16x16[pIndex].Index, "") != 0; pIndex++)
-			{
-				/*找到匹配的汉字*/
-				if (strcmp(OLED_CF16x16[pIndex].Index, SingleChinese) == 0)
-				{
-					break; // 跳出循环，此时pIndex的值为指定汉字的索引
-				}
-			}
+			/*在排序索引中二分查找匹配的汉字，未找到时为末尾默认图形的下标*/
+			pIndex = OLED_FindChinese(SingleChinese);
 
 			/*将汉字字模库OLED_CF16x16的指定数据以16*16的图像格式显示*/
 			OLED_ShowImage(X + ((i + 1) / OLED_CHN_CHAR_WIDTH - 1) * 16, Y, 16, 16, OLED_CF16x16[pIndex].Data);
@@ -788,54 +2277,179 @@ void OLED_ShowChinese(int16_t X, int16_t Y, char *Chinese)
  */
 void OLED_ShowImage(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const uint8_t *Image)
 {
-	uint8_t i = 0, j = 0;
-	int16_t Page, Shift;
+	OLED_ShowImageMode(X, Y, Width, Height, Image, OLED_IMAGE_OPAQUE);
+}
+
+/**
+ * 函    数：OLED按指定模式显示图像
+ * 参    数：X 指定图像左上角的横坐标，范围：-32768~32767，屏幕区域：0~127
+ * 参    数：Y 指定图像左上角的纵坐标，范围：-32768~32767，屏幕区域：0~63
+ * 参    数：Width 指定图像的宽度，范围：0~128
+ * 参    数：Height 指定图像的高度，范围：0~64
+ * 参    数：Image 指定要显示的图像
+ * 参    数：Mode 指定显示模式
+ *           范围：OLED_IMAGE_OPAQUE		不透明，先清空图像区域再显示，与OLED_ShowImage相同
+ *                 OLED_IMAGE_TRANSPARENT	透明，只点亮图像中为1的点，不清空背景，适用于精灵图
+ * 返 回 值：无
+ * 说    明：调用此函数后，要想真正地呈现在屏幕上，还需调用更新函数
+ * 说    明：按目标页逐字节合成，不逐点计算：
+ *           Y对齐到页时，每个目标字节只来自图像的一个字节，整页覆盖时直接复制
+ *           Y不对齐时，每个目标字节由图像相邻两页移位拼接，并用掩码保留图像区域外的像素
+ *           超出屏幕的列和页在开始时一次性裁剪
+ */
+void OLED_ShowImageMode(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const uint8_t *Image, uint8_t Mode)
+{
+	int16_t Page, Shift, PageCount, i0, i1, d, d0, d1, Top, Bottom;
+	uint8_t Keep, Count, i;
+	uint8_t *Dst;
+	const uint8_t *Lo, *Hi;
+
+	if (Width == 0 || Height == 0)
+	{
+		return;
+	}
+
+	/*裁剪列，[i0, i1)为图像中需要显示的列*/
+	i0 = X < 0 ? -X : 0;
+	i1 = X + Width > 128 ? 128 - X : Width;
+	if (i0 >= i1)
+	{
+		return; // 图像完全在屏幕左右两侧之外
+	}
+	Count = i1 - i0;
+
+	/*计算起始页和页内偏移，负数坐标向下取整*/
+	Page = Y >= 0 ? Y / 8 : -((7 - Y) / 8);
+	Shift = Y - Page * 8;
+
+	/*图像占用的页数，(Height - 1) / 8 + 1的目的是Height / 8并向上取整*/
+	PageCount = (Height - 1) / 8 + 1;
+
+	/*裁剪页，[d0, d1]为需要写入的目标页，Y不对齐时图像最后一页会延伸到下一页*/
+	d0 = Page < 0 ? 0 : Page;
+	d1 = Page + PageCount - (Shift == 0 ? 1 : 0);
+	if (d1 > 7)
+	{
+		d1 = 7;
+	}
+
+	for (d = d0; d <= d1; d++)
+	{
+		/*不透明模式下需要清空的行为[Y, Y + Height - 1]，计算本页内保留的位*/
+		Keep = 0xFF;
+		if (Mode == OLED_IMAGE_OPAQUE)
+		{
+			Top = Y > d * 8 ? Y - d * 8 : 0;
+			Bottom = Y + Height - 1 < d * 8 + 7 ? Y + Height - 1 - d * 8 : 7;
+			if (Top <= Bottom)
+			{
+				Keep = ~((0xFF << Top) & (0xFF >> (7 - Bottom)));
+			}
+		}
+
+		/*Lo为移入本页低位的图像页，Hi为从上一页溢出到本页高位的图像页*/
+		Lo = (d - Page < PageCount) ? Image + (d - Page) * Width + i0 : NULL;
+		Hi = (Shift != 0 && d - Page >= 1) ? Image + (d - Page - 1) * Width + i0 : NULL;
+		Dst = &OLED_DisplayBuf[d][X + i0];
+
+		if (Lo != NULL && Hi != NULL) // 两页移位拼接
+		{
+			for (i = 0; i < Count; i++)
+			{
+				Dst[i] = (Dst[i] & Keep) | (uint8_t)(Lo[i] << Shift) | (Hi[i] >> (8 - Shift));
+			}
+		}
+		else if (Lo != NULL && Shift == 0 && Keep == 0x00) // 页对齐且整页覆盖，直接复制
+		{
+			memcpy(Dst, Lo, Count);
+		}
+		else if (Lo != NULL) // 首页，或页对齐的部分覆盖页
+		{
+			for (i = 0; i < Count; i++)
+			{
+				Dst[i] = (Dst[i] & Keep) | (uint8_t)(Lo[i] << Shift);
+			}
+		}
+		else // 图像最后一页溢出的部分
+		{
+			for (i = 0; i < Count; i++)
+			{
+				Dst[i] = (Dst[i] & Keep) | (Hi[i] >> (8 - Shift));
+			}
+		}
+	}
+
+	/*图像按整页写入，最后一页中超出Height的位也会被写入，按整页标记脏区*/
+	OLED_MarkDirty(X, Y, Width, PageCount * 8);
+}
+
+/**
+ * 函    数：OLED显示RLE压缩图像
+ * 参    数：X 指定图像左上角的横坐标，范围：-32768~32767，屏幕区域：0~127
+ * 参    数：Y 指定图像左上角的纵坐标，范围：-32768~32767，屏幕区域：0~63
+ * 参    数：Width 指定图像的宽度，范围：0~128
+ * 参    数：Height 指定图像的高度，范围：0~64
+ * 参    数：Packed 指定要显示的压缩图像，由oled_pack.py生成
+ * 返 回 值：无
+ * 说    明：调用此函数后，要想真正地呈现在屏幕上，还需调用更新函数
+ * 说    明：压缩格式：控制字节0x00~0x7F，后跟控制字节+1个原样数据
+ *                     控制字节0x80~0xFF，后跟1个数据，重复控制字节-0x80+2次
+ *           每解压出一页（Width个字节）就写入显存数组，只占用一页大小的栈空间，不保存整幅解压图像
+ *           显示效果与对解压后的图像调用OLED_ShowImage相同
+ */
+void OLED_ShowPackedImage(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const uint8_t *Packed)
+{
+	uint8_t Row[128]; // 当前页的解压数据
+	uint8_t i, j, Rows;
+	uint8_t Remain = 0; // 当前控制字节剩余的数据个数，游程可以跨页
+	uint8_t IsRun = 0;	// 当前是否为重复数据
+	uint8_t Value = 0;	// 重复数据的值
 
-	/*将图像所在区域清空*/
-	OLED_ClearArea(X, Y, Width, Height);
+	if (Width == 0 || Width > 128 || Height == 0)
+	{
+		return;
+	}
 
-	/*遍历指定图像涉及的相关页*/
-	/*(Height - 1) / 8 + 1的目的是Height / 8并向上取整*/
+	/*逐页解压，(Height - 1) / 8 + 1的目的是Height / 8并向上取整*/
 	for (j = 0; j < (Height - 1) / 8 + 1; j++)
 	{
-		/*遍历指定图像涉及的相关列*/
 		for (i = 0; i < Width; i++)
 		{
-			if (X + i >= 0 && X + i <= 127) // 超出屏幕的内容不显示
+			/*读取下一个控制字节*/
+			if (Remain == 0)
 			{
-				/*负数坐标在计算页地址和移位时需要加一个偏移*/
-				Page = Y / 8;
-				Shift = Y % 8;
-				if (Y < 0)
-				{
-					Page -= 1;
-					Shift += 8;
-				}
-
-				if (Page + j >= 0 && Page + j <= 7) // 超出屏幕的内容不显示
+				if (*Packed & 0x80)
 				{
-					/*显示图像在当前页的内容*/
-					OLED_DisplayBuf[Page + j][X + i] |= Image[j * Width + i] << (Shift);
+					IsRun = 1;
+					Remain = *Packed++ - 0x80 + 2;
+					Value = *Packed++;
 				}
-
-				if (Page + j + 1 >= 0 && Page + j + 1 <= 7) // 超出屏幕的内容不显示
+				else
 				{
-					/*显示图像在下一页的内容*/
-					OLED_DisplayBuf[Page + j + 1][X + i] |= Image[j * Width + i] >> (8 - Shift);
+					IsRun = 0;
+					Remain = *Packed++ + 1;
 				}
 			}
+
+			Row[i] = IsRun ? Value : *Packed++;
+			Remain--;
 		}
+
+		/*本页的行数，最后一页可能不足8行*/
+		Rows = Height - j * 8 < 8 ? Height - j * 8 : 8;
+		OLED_ShowImageMode(X, Y + j * 8, Width, Rows, Row, OLED_IMAGE_OPAQUE);
 	}
 }
 
 /**
- * 函    数：OLED使用printf函数打印格式化字符串
+ * 函    数：OLED打印格式化字符串
  * 参    数：X 指定格式化字符串左上角的横坐标，范围：-32768~32767，屏幕区域：0~127
  * 参    数：Y 指定格式化字符串左上角的纵坐标，范围：-32768~32767，屏幕区域：0~63
  * 参    数：FontSize 指定字体大小
  *           范围：OLED_8X16		宽8像素，高16像素
  *                 OLED_6X8		宽6像素，高8像素
  * 参    数：format 指定要显示的格式化字符串，范围：ASCII码可见字符组成的字符串
+ *           支持的格式见Format.h（printf子集，%f不依赖printf浮点库）
  * 参    数：... 格式化字符串参数列表
  * 返 回 值：无
  * 说    明：调用此函数后，要想真正地呈现在屏幕上，还需调用更新函数
@@ -845,7 +2459,7 @@ void OLED_Printf(int16_t X, int16_t Y, uint8_t FontSize, char *format, ...)
 	char String[256];						 // 定义字符数组
 	va_list arg;							 // 定义可变参数列表数据类型的变量arg
 	va_start(arg, format);					 // 从format开始，接收参数列表到arg变量
-	vsprintf(String, format, arg);			 // 使用vsprintf打印格式化字符串和参数列表到字符数组中
+	Format_VSprintf(String, sizeof(String), format, arg); // 格式化到字符数组中，超长时截断
 	va_end(arg);							 // 结束变量arg
 	OLED_ShowString(X, Y, String, FontSize); // OLED显示字符数组（字符串）
 }
@@ -863,6 +2477,16 @@ void OLED_DrawPoint(int16_t X, int16_t Y)
 	{
 		/*将显存数组指定位置的一个Bit数据置1*/
 		OLED_DisplayBuf[Y / 8][X] |= 0x01 << (Y % 8);
+
+		/*并入该页脏区*/
+		if (X < OLED_DirtyStart[Y / 8])
+		{
+			OLED_DirtyStart[Y / 8] = X;
+		}
+		if (X > OLED_DirtyEnd[Y / 8])
+		{
+			OLED_DirtyEnd[Y / 8] = X;
+		}
 	}
 }
 
@@ -1100,8 +2724,6 @@ void OLED_DrawRectangle(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, uin
  */
 void OLED_DrawTriangle(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1, int16_t X2, int16_t Y2, uint8_t IsFilled)
 {
-	int16_t minx = X0, miny = Y0, maxx = X0, maxy = Y0;
-	int16_t i, j;
 	int16_t vx[] = {X0, X1, X2};
 	int16_t vy[] = {Y0, Y1, Y2};
 
@@ -1114,59 +2736,43 @@ void OLED_DrawTriangle(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1, int16_t X
 	}
 	else // 指定三角形填充
 	{
-		/*找到三个点最小的X、Y坐标*/
-		if (X1 < minx)
-		{
-			minx = X1;
-		}
-		if (X2 < minx)
-		{
-			minx = X2;
-		}
-		if (Y1 < miny)
-		{
-			miny = Y1;
-		}
-		if (Y2 < miny)
-		{
-			miny = Y2;
-		}
+		/*按扫描线逐行填充，结果与逐点调用OLED_pnpoly判断相同*/
+		OLED_FillPolygon(3, vx, vy);
+	}
+}
 
-		/*找到三个点最大的X、Y坐标*/
-		if (X1 > maxx)
-		{
-			maxx = X1;
-		}
-		if (X2 > maxx)
-		{
-			maxx = X2;
-		}
-		if (Y1 > maxy)
-		{
-			maxy = Y1;
-		}
-		if (Y2 > maxy)
-		{
-			maxy = Y2;
-		}
+/**
+ * 函    数：OLED多边形
+ * 参    数：X Y 包含多边形各顶点横、纵坐标的数组，范围：-32768~32767，屏幕区域：X 0~127，Y 0~63
+ * 参    数：Count 顶点数，范围：3~16
+ * 参    数：IsFilled 指定多边形是否填充
+ *           范围：OLED_UNFILLED		不填充
+ *                 OLED_FILLED			填充
+ * 返 回 值：无
+ * 说    明：调用此函数后，要想真正地呈现在屏幕上，还需调用更新函数
+ *           填充按奇偶规则判断内部，自相交的多边形中重叠两次的部分不填充
+ */
+void OLED_DrawPolygon(int16_t *X, int16_t *Y, uint8_t Count, uint8_t IsFilled)
+{
+	uint8_t i;
 
-		/*最小最大坐标之间的矩形为可能需要填充的区域*/
-		/*遍历此区域中所有的点*/
-		/*遍历X坐标*/
-		for (i = minx; i <= maxx; i++)
+	if (Count < 3)
+	{
+		return; // 顶点数不足，不构成多边形
+	}
+
+	if (!IsFilled) // 指定多边形不填充
+	{
+		/*调用画线函数，将相邻顶点用直线连接，最后一个顶点连回第一个顶点*/
+		for (i = 0; i < Count; i++)
 		{
-			/*遍历Y坐标*/
-			for (j = miny; j <= maxy; j++)
-			{
-				/*调用OLED_pnpoly，判断指定点是否在指定三角形之中*/
-				/*如果在，则画点，如果不在，则不做处理*/
-				if (OLED_pnpoly(3, vx, vy, i, j))
-				{
-					OLED_DrawPoint(i, j);
-				}
-			}
+			OLED_DrawLine(X[i], Y[i], X[(i + 1) % Count], Y[(i + 1) % Count]);
 		}
 	}
+	else // 指定多边形填充
+	{
+		OLED_FillPolygon(Count, X, Y);
+	}
 }
 
 /**
@@ -1267,15 +2873,17 @@ void OLED_DrawCircle(int16_t X, int16_t Y, uint8_t Radius, uint8_t IsFilled)
 void OLED_DrawEllipse(int16_t X, int16_t Y, uint8_t A, uint8_t B, uint8_t IsFilled)
 {
 	int16_t x, y, j;
-	int16_t a = A, b = B;
-	float d1, d2;
+	int32_t a2 = A * A, b2 = B * B; // 半轴长度的平方
+	int32_t d1;						  // 第一段判别式的4倍
+	int64_t d2;						  // 第二段判别式的4倍，半轴较长时超出int32_t范围
 
-	/*使用Bresenham算法画椭圆，可以避免部分耗时的浮点运算，效率更高*/
+	/*使用Bresenham算法画椭圆*/
 	/*参考链接：https://blog.csdn.net/myf_666/article/details/128167392*/
+	/*判别式中含有0.5，将判别式和判断条件都乘以4或2，全部使用整数运算，避免软件浮点运算*/
 
 	x = 0;
-	y = b;
-	d1 = b * b + a * a * (-b + 0.5);
+	y = B;
+	d1 = 4 * b2 + a2 * (2 - 4 * y); // 4 * (b * b + a * a * (-b + 0.5))
 
 	if (IsFilled) // 指定椭圆填充
 	{
@@ -1295,15 +2903,15 @@ void OLED_DrawEllipse(int16_t X, int16_t Y, uint8_t A, uint8_t B, uint8_t IsFill
 	OLED_DrawPoint(X + x, Y - y);
 
 	/*画椭圆中间部分*/
-	while (b * b * (x + 1) < a * a * (y - 0.5))
+	while (2 * b2 * (x + 1) < a2 * (2 * y - 1)) // b * b * (x + 1) < a * a * (y - 0.5)
 	{
 		if (d1 <= 0) // 下一个点在当前点东方
 		{
-			d1 += b * b * (2 * x + 3);
+			d1 += 4 * b2 * (2 * x + 3);
 		}
 		else // 下一个点在当前点东南方
 		{
-			d1 += b * b * (2 * x + 3) + a * a * (-2 * y + 2);
+			d1 += 4 * (b2 * (2 * x + 3) + a2 * (-2 * y + 2));
 			y--;
 		}
 		x++;
@@ -1327,18 +2935,19 @@ void OLED_DrawEllipse(int16_t X, int16_t Y, uint8_t A, uint8_t B, uint8_t IsFill
 	}
 
 	/*画椭圆两侧部分*/
-	d2 = b * b * (x + 0.5) * (x + 0.5) + a * a * (y - 1) * (y - 1) - a * a * b * b;
+	/*4 * (b * b * (x + 0.5) * (x + 0.5) + a * a * (y - 1) * (y - 1) - a * a * b * b)*/
+	d2 = (int64_t)b2 * (2 * x + 1) * (2 * x + 1) + (int64_t)4 * a2 * (y - 1) * (y - 1) - (int64_t)4 * a2 * b2;
 
 	while (y > 0)
 	{
 		if (d2 <= 0) // 下一个点在当前点东方
 		{
-			d2 += b * b * (2 * x + 2) + a * a * (-2 * y + 3);
+			d2 += 4 * (b2 * (2 * x + 2) + a2 * (-2 * y + 3));
 			x++;
 		}
 		else // 下一个点在当前点东南方
 		{
-			d2 += a * a * (-2 * y + 3);
+			d2 += 4 * a2 * (-2 * y + 3);
 		}
 		y--;
 
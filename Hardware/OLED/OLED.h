@@ -7,8 +7,44 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include "Format.h"
 /*接线定义*********************/
 //P_B8---SCL | P_B9---SDA
+
+/*通信接口选择*********************/
+/*三选一：硬件I2C1(PB8/PB9重映射)+DMA后台发送，软件模拟I2C阻塞发送，或录制接口*/
+/*录制接口不操作任何外设，按SSD1306的寻址规则把命令/数据流还原成屏幕内容，供主机编译测试和截屏比对*/
+/*也可以在编译命令行中定义（如-DOLED_USE_RECORDER），命令行的选择优先，这里的默认值不再生效*/
+#if !defined(OLED_USE_HW_I2C) && !defined(OLED_USE_SOFT_I2C) && !defined(OLED_USE_RECORDER)
+#define OLED_USE_HW_I2C // 使用硬件I2C1+DMA
+//#define OLED_USE_SOFT_I2C // 使用软件模拟I2C
+//#define OLED_USE_RECORDER // 使用录制接口
+#endif
+
+#if defined(OLED_USE_HW_I2C) + defined(OLED_USE_SOFT_I2C) + defined(OLED_USE_RECORDER) != 1
+#error "OLED_USE_HW_I2C/OLED_USE_SOFT_I2C/OLED_USE_RECORDER只能定义一个"
+#endif
+
+#define OLED_I2C_SPEED			400000 // 硬件I2C时钟频率，单位Hz
+#define OLED_TX_TIMEOUT_MS		10	   // 一次传输超过此时间未完成则认为总线卡死（最长一次传输约3ms）
+
+/**
+ * OLED通信接口
+ * Init：初始化端口/外设
+ * Write：发送一次完整传输（起始+从机地址0x78+Control+Data+终止）
+ * IsAsync：为0时Write返回即发送完成，为1时Write只启动传输，完成后需调用OLED_TransferComplete
+ * Abort：放弃正在进行的传输并复位接口，返回后不会再调用OLED_TransferComplete；同步接口为NULL
+ */
+typedef struct
+{
+	void (*Init)(void);
+	void (*Write)(uint8_t Control, const uint8_t *Data, uint16_t Count);
+	uint8_t IsAsync;
+	void (*Abort)(void);
+} OLED_Transport_t;
+
+/*********************通信接口选择*/
+
 /*参数宏定义*********************/
 
 /*FontSize参数取值*/
@@ -20,6 +56,14 @@
 #define OLED_UNFILLED			0
 #define OLED_FILLED				1
 
+/*Mode参数数值*/
+#define OLED_IMAGE_OPAQUE		0
+#define OLED_IMAGE_TRANSPARENT	1
+
+/*Direction参数数值*/
+#define OLED_SCROLL_RIGHT		0
+#define OLED_SCROLL_LEFT		1
+
 /*********************参数宏定义*/
 
 
@@ -31,6 +75,37 @@ void OLED_Init(void);
 /*更新函数*/
 void OLED_Update(void);
 void OLED_UpdateArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height);
+void OLED_UpdateFull(void);
+uint8_t OLED_SwapAndFlush(void);
+
+/*通信接口函数*/
+void OLED_SetTransport(const OLED_Transport_t *Transport);
+void OLED_TransferComplete(void);
+void OLED_SetTxCpltCallback(void (*Callback)(void));
+uint8_t OLED_IsBusy(void);
+void OLED_WaitIdle(void);
+void OLED_SetUpdateCallback(void (*Callback)(uint32_t Bytes));
+#if defined(OLED_USE_HW_I2C)
+uint32_t OLED_HwI2C_GetErrors(void);
+#endif
+#if defined(OLED_USE_RECORDER)
+void OLED_Recorder_Reset(void);
+uint8_t OLED_Recorder_GetPoint(int16_t X, int16_t Y);
+uint32_t OLED_Recorder_GetTransfers(void);
+void OLED_Recorder_WritePBM(void (*Put)(uint8_t Byte));
+#endif
+
+/*刷新开销统计函数*/
+uint32_t OLED_GetSentBytes(void);
+void OLED_ResetSentBytes(void);
+void OLED_GetFrameStats(uint32_t *Flushed, uint32_t *Coalesced);
+void OLED_ResetFrameStats(void);
+
+/*硬件滚动函数*/
+void OLED_ScrollPages(int8_t Pages);
+void OLED_ScrollStart(uint8_t Direction, uint8_t StartPage, uint8_t EndPage, uint8_t Interval);
+void OLED_ScrollDiagonalStart(uint8_t Direction, uint8_t StartPage, uint8_t EndPage, uint8_t Interval, uint8_t VerticalStep);
+void OLED_ScrollStop(void);
 
 /*显存控制函数*/
 void OLED_Clear(void);
@@ -48,6 +123,8 @@ void OLED_ShowBinNum(int16_t X, int16_t Y, uint32_t Number, uint8_t Length, uint
 void OLED_ShowFloatNum(int16_t X, int16_t Y, double Number, uint8_t IntLength, uint8_t FraLength, uint8_t FontSize);
 void OLED_ShowChinese(int16_t X, int16_t Y, char *Chinese);
 void OLED_ShowImage(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const uint8_t *Image);
+void OLED_ShowImageMode(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const uint8_t *Image, uint8_t Mode);
+void OLED_ShowPackedImage(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const uint8_t *Packed);
 void OLED_Printf(int16_t X, int16_t Y, uint8_t FontSize, char *format, ...);
 
 /*绘图函数*/
@@ -56,6 +133,7 @@ uint8_t OLED_GetPoint(int16_t X, int16_t Y);
 void OLED_DrawLine(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1);
 void OLED_DrawRectangle(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, uint8_t IsFilled);
 void OLED_DrawTriangle(int16_t X0, int16_t Y0, int16_t X1, int16_t Y1, int16_t X2, int16_t Y2, uint8_t IsFilled);
+void OLED_DrawPolygon(int16_t *X, int16_t *Y, uint8_t Count, uint8_t IsFilled);
 void OLED_DrawCircle(int16_t X, int16_t Y, uint8_t Radius, uint8_t IsFilled);
 void OLED_DrawEllipse(int16_t X, int16_t Y, uint8_t A, uint8_t B, uint8_t IsFilled);
 void OLED_DrawArc(int16_t X, int16_t Y, uint8_t Radius, int16_t StartAngle, int16_t EndAngle, uint8_t IsFilled);
@@ -382,6 +382,20 @@ const ChineseCell_t OLED_CF16x16[] = {
 	0xFF,0x80,0x80,0x80,0x80,0x80,0x80,0x96,0x81,0x80,0x80,0x80,0x80,0x80,0x80,0xFF,
 };
 
+/*汉字字模数量（含末尾的默认图形），由上面的数组自动计算，加入新汉字时无需修改*/
+const uint16_t OLED_CF16x16_Count = sizeof(OLED_CF16x16) / sizeof(OLED_CF16x16[0]);
+
+/*
+ * 汉字字模按编码排序的索引，由oled_index.py生成，供OLED_FindChinese二分查找
+ * 修改上面的字模库后运行 python oled_index.py OLED_Data.c -o OLED_Data_index.h 重新生成
+ */
+#include "OLED_Data_index.h"
+
+const uint16_t OLED_CF16x16_IndexCount = OLED_CF16X16_INDEX_SIZE;
+
+/*字模数量与生成索引时不同，说明修改字模库后没有重新生成索引*/
+typedef char oled_chinese_index_out_of_date[(sizeof(OLED_CF16x16) / sizeof(OLED_CF16x16[0]) == OLED_CF16X16_SIZE) ? 1 : -1];
+
 /*********************汉字字模数据*/
 
 
@@ -428,7 +442,8 @@ const uint8_t Diode[] = {
 0xEF,0xFE,0x7F,0xEF,0xFF,0x7E,0xFF,0xFF,0xFF,0x7F,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFD,0xFB,0xF5,0xCA,0x55,0x2A,0x15,0x6A,0x95,0x60,0x8A,0x50,0x00,0x40,0x00,0x00,0x00,0x00,0x00,0x00,0x2A,0x7B,0x06,0x07,0x23,0x1B,0x03,0x0B,0x12,0x04,0x28,0x52,0x09,0xB6,0x41,0x14,0x40,0x00,0x02,0x08,0x23,0x0C,0x50,0x00,0x01,0x44,
 0x08,0x20,0x10,0x20,0x40,0x40,0x00,0x40,0x00,0x40,0x00,0x40,0x10,0x00,0x08,0x00,0x22,0x01,0x30,0x10,0x08,0x1C,0x02,0x0E,0x00,0x0F,0x04,0x03,0x02,0x03,0x00,0x03,0x01,0x00,0x40,0x00,0x00,0x00,0x80,0xC0,0xE0,0xE0,0xF8,0xFC,0xFE,0xFF,0x7F,0xFF,0xFF,0x7F,0xFF,0xEE,0x7F,0xFF,0xBB,0xFF,0xEE,0x7F,0xFB,0xDF,0x7E,0xF7,0xFF,0x5D,
 };*/
-const uint8_t HT_LOGO1[] = {
+/*LOGO原始取模数据（64*64），仅作为oled_pack.py的输入保留，不参与编译*/
+/*const uint8_t HT_LOGO1[] = {
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xe0, 0x30, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xc0, 0x60, 0x30, 0x18, 0x08, 
@@ -451,6 +466,25 @@ const uint8_t HT_LOGO1[] = {
 0x00, 0x00, 0x00, 0x00, 0x10, 0x0e, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+};*/
+/*RLE压缩图像，原始512字节，压缩后304字节，使用OLED_ShowPackedImage显示*/
+const uint8_t HT_LOGO1_RLE[] = {
+0xb3, 0x00, 0x03, 0xc0, 0xe0, 0x30, 0x04, 0x87, 0x00, 0x05, 0x80, 0xc0, 0x60, 0x30, 0x18, 0x08, 0x80, 0x0c, 0x80, 0x04, 
+0x86, 0x06, 0x82, 0x04, 0x80, 0x0c, 0x80, 0x08, 0x01, 0x18, 0x10, 0x80, 0x30, 0x80, 0xe0, 0x01, 0xc0, 0xe0, 0x80, 0xf0, 
+0x10, 0x38, 0x98, 0xcc, 0xc4, 0xe2, 0x71, 0x18, 0x0c, 0x02, 0x81, 0xc0, 0xf0, 0xf8, 0xfe, 0x7f, 0x0f, 0x01, 0x88, 0x00, 
+0x01, 0x5d, 0x03, 0x8d, 0x00, 0x80, 0x80, 0x80, 0xc0, 0x00, 0xe0, 0x80, 0xf0, 0x80, 0xf8, 0x09, 0x7c, 0x7e, 0x3e, 0x9f, 
+0xcf, 0xe7, 0xe3, 0xf1, 0x78, 0xfc, 0x83, 0xff, 0x00, 0xfc, 0x80, 0xf8, 0x01, 0xfc, 0xfe, 0x81, 0xff, 0x01, 0x1f, 0x03, 
+0x8b, 0x00, 0x04, 0x01, 0x04, 0x10, 0x20, 0x80, 0x85, 0x00, 0x03, 0x80, 0xe0, 0xfc, 0xfe, 0x80, 0xff, 0x09, 0x7f, 0x3f, 
+0x1f, 0x0f, 0x07, 0xe3, 0xf1, 0xf8, 0xfc, 0xfe, 0x81, 0xff, 0x05, 0x7f, 0x3f, 0x0f, 0x00, 0x01, 0x83, 0x82, 0x87, 0x01, 
+0xc7, 0xe3, 0x81, 0xff, 0x09, 0x7f, 0x0f, 0x03, 0x07, 0x0e, 0x1c, 0x38, 0x70, 0xc0, 0x80, 0x8b, 0x00, 0x0a, 0x01, 0x02, 
+0x00, 0x08, 0x00, 0x30, 0x5c, 0x8f, 0x07, 0x03, 0x01, 0x81, 0x00, 0x02, 0x80, 0xe0, 0xfc, 0x82, 0xff, 0x08, 0x7f, 0x1f, 
+0x0f, 0x03, 0x81, 0xc0, 0xf0, 0xf8, 0xfe, 0x87, 0xff, 0x01, 0x1f, 0x03, 0x86, 0x00, 0x06, 0x01, 0x03, 0x0f, 0x3c, 0xf8, 
+0xe0, 0x80, 0x8e, 0x00, 0x05, 0x03, 0x00, 0x04, 0x88, 0xf0, 0xfc, 0x80, 0xff, 0x08, 0x3f, 0x9f, 0x07, 0x03, 0x80, 0xe0, 
+0xf0, 0xfc, 0xfe, 0x80, 0xff, 0x81, 0x7f, 0x81, 0x3f, 0x80, 0x1f, 0x80, 0x0f, 0x00, 0x07, 0x8e, 0x00, 0x80, 0xff, 0x00, 
+0xfc, 0x8d, 0x00, 0x06, 0x80, 0xf0, 0x7c, 0x3f, 0x0f, 0x07, 0x01, 0x80, 0x00, 0x01, 0x01, 0x00, 0x80, 0x03, 0x0b, 0x05, 
+0x01, 0x08, 0x10, 0x00, 0x10, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x80, 0x40, 0x00, 0x00, 0x80, 0x40, 0x00, 0x00, 0x83, 
+0x40, 0x02, 0x20, 0x60, 0x40, 0x80, 0x60, 0x06, 0x20, 0x30, 0x18, 0x1c, 0x0e, 0x07, 0x03, 0x8c, 0x00, 0x03, 0x10, 0x0e, 
+0x03, 0x01, 0xae, 0x00, 
 };
 
 
@@ -13,12 +13,22 @@ typedef struct
 	uint8_t Data[32];						//字模数据
 } ChineseCell_t;
 
+/*汉字排序索引单元*/
+typedef struct
+{
+	uint16_t Code;							//编码值，参见OLED_ChineseCode
+	uint16_t Index;							//在OLED_CF16x16中的下标
+} ChineseIndex_t;
+
 /*ASCII字模数据声明*/
 extern const uint8_t OLED_F8x16[][16];
 extern const uint8_t OLED_F6x8[][6];
 
 /*汉字字模数据声明*/
 extern const ChineseCell_t OLED_CF16x16[];
+extern const uint16_t OLED_CF16x16_Count;
+extern const ChineseIndex_t OLED_CF16x16_Index[];
+extern const uint16_t OLED_CF16x16_IndexCount;
 
 
 //***********//
@@ -26,7 +36,7 @@ extern const ChineseCell_t OLED_CF16x16[];
 // extern const uint8_t Diode[];
 // extern const uint8_t XpWallpaper[];
 // extern const uint8_t Win11Wallpaper[];
-extern const uint8_t HT_LOGO1[];
+extern const uint8_t HT_LOGO1_RLE[]; // RLE压缩，64*64，使用OLED_ShowPackedImage显示
 
 
 /*按照上面的格式，在这个位置加入新的图像数据声明*/
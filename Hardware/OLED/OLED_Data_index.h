@@ -0,0 +1,22 @@
+/*
+ * 文件名：OLED_Data_index.h
+ * 描    述：汉字字模排序索引，由oled_index.py根据OLED_Data.c中的OLED_CF16x16生成，请勿手动修改
+ *          修改字模库后重新运行：python oled_index.py OLED_Data.c -o OLED_Data_index.h
+ */
+
+#define OLED_CF16X16_SIZE 11 // 字模库数量（含末尾的默认图形），用于检查索引是否过期
+#define OLED_CF16X16_INDEX_SIZE 10
+
+const ChineseIndex_t OLED_CF16x16_Index[OLED_CF16X16_INDEX_SIZE] = {
+    // {编码值, 在OLED_CF16x16中的下标}
+    {0x4E2D, 6}, // 中
+    {0x52A8, 5}, // 动
+    {0x534E, 0}, // 华
+    {0x542F, 4}, // 启
+    {0x5929, 1}, // 天
+    {0x5B8C, 7}, // 完
+    {0x6210, 8}, // 成
+    {0x7CFB, 2}, // 系
+    {0x7EDF, 3}, // 统
+    {0x8515, 9}, // 蔕
+};
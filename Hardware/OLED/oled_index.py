@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+文件名：oled_index.py
+描  述：汉字字模索引生成工具，把OLED_Data.c中的OLED_CF16x16按编码值排序，生成Flash中的常量索引
+
+OLED_FindChinese在索引中二分查找，启动时不需要排序，也不占用RAM。
+编码值与OLED.c中的OLED_ChineseCode相同：UTF-8为Unicode码点，GB2312为两个字节组成的内码。
+重复定义的汉字只保留第一个，与顺序查找的结果一致；末尾的默认图形（空字符串）不进入索引。
+
+用法（修改OLED_CF16x16后重新运行，生成的OLED_Data_index.h一并提交）：
+  python oled_index.py OLED_Data.c -o OLED_Data_index.h
+  python oled_index.py OLED_Data.c --check OLED_Data_index.h   检查已提交的索引是否需要重新生成
+  GB2312编码的字模库加 --gb2312
+"""
+
+import argparse
+import re
+import sys
+
+
+def strip_comments(text):
+    """去掉C注释，字模库中的字符串不含注释符号"""
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    return re.sub(r'//[^\n]*', '', text)
+
+
+def extract_cells(source, name):
+    """从C源文件中提取字模库的每一项，返回汉字字符串列表"""
+    match = re.search(r'\b' + re.escape(name) + r'\s*\[\s*\]\s*=\s*\{(.*?)\n\s*\};', source, re.S)
+    if match is None:
+        sys.exit('未找到字模库：' + name)
+    cells = []
+    for m in re.finditer(r'"((?:[^"\\]|\\.)*)"|(0[xX][0-9a-fA-F]+)', strip_comments(match.group(1))):
+        if m.group(2) is None:
+            cells.append([m.group(1), 0])
+        elif not cells:
+            sys.exit('字模数据前缺少汉字索引')
+        else:
+            cells[-1][1] += 1
+    for text, size in cells:
+        if size != 32:
+            sys.exit('字模数据数量错误："%s" 有%d个字节，应为32' % (text, size))
+    if not cells or cells[-1][0] != '':
+        sys.exit('字模库末尾必须是默认图形（空字符串）')
+    return [text for text, _ in cells]
+
+
+def chinese_code(text, gb2312):
+    """计算编码值，与OLED_ChineseCode相同"""
+    if gb2312:
+        raw = text.encode('gb2312')
+        if len(raw) != 2:
+            sys.exit('不是单个GB2312汉字："%s"' % text)
+        return raw[0] << 8 | raw[1]
+    if len(text) != 1 or len(text.encode('utf-8')) != 3:
+        sys.exit('不是单个3字节UTF-8汉字："%s"' % text)
+    return ord(text)
+
+
+def build(cells, gb2312):
+    """按编码值排序，重复的汉字保留第一个"""
+    index = {}
+    for i, text in enumerate(cells[:-1]):
+        index.setdefault(chinese_code(text, gb2312), (i, text))
+    return sorted((code, i, text) for code, (i, text) in index.items())
+
+
+def emit(entries, count, source_name):
+    """输出C代码"""
+    lines = [
+        '/*',
+        ' * 文件名：OLED_Data_index.h',
+        ' * 描    述：汉字字模排序索引，由oled_index.py根据%s中的OLED_CF16x16生成，请勿手动修改' % source_name,
+        ' *          修改字模库后重新运行：python oled_index.py %s -o OLED_Data_index.h' % source_name,
+        ' */',
+        '',
+        '#define OLED_CF16X16_SIZE %d // 字模库数量（含末尾的默认图形），用于检查索引是否过期' % count,
+        '#define OLED_CF16X16_INDEX_SIZE %d' % len(entries),
+        '',
+        'const ChineseIndex_t OLED_CF16x16_Index[OLED_CF16X16_INDEX_SIZE] = {',
+        '    // {编码值, 在OLED_CF16x16中的下标}',
+    ]
+    for code, i, text in entries:
+        lines.append('    {0x%04X, %d}, // %s' % (code, i, text))
+    lines.append('};')
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='汉字字模索引生成工具')
+    parser.add_argument('input', help='包含OLED_CF16x16字模库的C源文件')
+    parser.add_argument('--table', default='OLED_CF16x16', help='字模库数组名，默认OLED_CF16x16')
+    parser.add_argument('--gb2312', action='store_true', help='字模库为GB2312编码（OLED_CHN_CHAR_WIDTH为2）')
+    parser.add_argument('-o', '--output', help='输出文件，省略时输出到标准输出')
+    parser.add_argument('--check', metavar='FILE', help='与已生成的文件比较，不一致时返回错误')
+    args = parser.parse_args()
+
+    with open(args.input, encoding='gb2312' if args.gb2312 else 'utf-8-sig') as f:
+        cells = extract_cells(f.read(), args.table)
+
+    text = emit(build(cells, args.gb2312), len(cells), args.input.replace('\\', '/').split('/')[-1])
+    if args.check:
+        with open(args.check, encoding='utf-8') as f:
+            if f.read() != text:
+                sys.exit('%s已过期，请重新运行oled_index.py' % args.check)
+    elif args.output:
+        with open(args.output, 'w', encoding='utf-8', newline='\n') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+文件名：oled_pack.py
+描  述：OLED图像压缩工具，生成OLED_ShowPackedImage使用的RLE压缩数据
+
+输入为OLED_ShowImage使用的取模数据（纵向8点、高位在下、逐页从左到右），
+可以直接从C源文件中按数组名提取，也可以是二进制文件。
+
+压缩格式（PackBits风格，按字节流连续编码，游程可以跨页）：
+  控制字节 0x00~0x7F：后面跟随 控制字节+1 个原样数据（1~128个）
+  控制字节 0x80~0xFF：后面跟随 1 个数据，重复 控制字节-0x80+2 次（2~129次）
+
+用法：
+  python oled_pack.py OLED_Data.c HT_LOGO1 --name HT_LOGO1_RLE
+  python oled_pack.py logo.bin --name LOGO_RLE
+"""
+
+import argparse
+import re
+import sys
+
+
+def extract_array(source, name):
+    """从C源文件中提取指定数组的所有十六进制数据，忽略注释"""
+    match = re.search(r'\b' + re.escape(name) + r'\s*\[\s*\]\s*=\s*\{(.*?)\};', source, re.S)
+    if match is None:
+        sys.exit('未找到数组：' + name)
+    body = re.sub(r'/\*.*?\*/', '', match.group(1), flags=re.S)
+    body = re.sub(r'//[^\n]*', '', body)
+    return [int(x, 16) for x in re.findall(r'0[xX][0-9a-fA-F]+', body)]
+
+
+def pack(data):
+    """RLE压缩，返回压缩后的字节列表"""
+    out = []
+    i = 0
+    n = len(data)
+    while i < n:
+        # 统计重复次数，最少2个才编码为游程
+        run = 1
+        while i + run < n and data[i + run] == data[i] and run < 129:
+            run += 1
+        if run >= 2:
+            out += [0x80 + run - 2, data[i]]
+            i += run
+            continue
+        # 原样数据，遇到下一个游程或满128个时结束
+        j = i
+        while j < n and j - i < 128:
+            if j + 1 < n and data[j + 1] == data[j]:
+                break
+            j += 1
+        out += [j - i - 1] + data[i:j]
+        i = j
+    return out
+
+
+def unpack(packed, length):
+    """解压，用于校验"""
+    out = []
+    i = 0
+    while len(out) < length:
+        ctrl = packed[i]
+        i += 1
+        if ctrl & 0x80:
+            out += [packed[i]] * (ctrl - 0x80 + 2)
+            i += 1
+        else:
+            out += packed[i:i + ctrl + 1]
+            i += ctrl + 1
+    return out[:length]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='OLED图像RLE压缩工具')
+    parser.add_argument('input', help='C源文件或二进制取模数据文件')
+    parser.add_argument('array', nargs='?', help='C源文件中的数组名，输入为二进制文件时省略')
+    parser.add_argument('--name', required=True, help='输出的数组名')
+    args = parser.parse_args()
+
+    if args.array:
+        with open(args.input, encoding='utf-8') as f:
+            data = extract_array(f.read(), args.array)
+    else:
+        with open(args.input, 'rb') as f:
+            data = list(f.read())
+
+    packed = pack(data)
+    if unpack(packed, len(data)) != data:
+        sys.exit('校验失败')
+
+    print('/*RLE压缩图像，原始%d字节，压缩后%d字节，使用OLED_ShowPackedImage显示*/' % (len(data), len(packed)))
+    print('const uint8_t %s[] = {' % args.name)
+    for i in range(0, len(packed), 20):
+        print(', '.join('0x%02x' % b for b in packed[i:i + 20]) + ', ')
+    print('};')
+
+
+if __name__ == '__main__':
+    main()
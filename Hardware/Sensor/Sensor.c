@@ -9,22 +9,41 @@
 /*外部变量*/
 // volatile uint8_t g_sensor_counting_enabled = 0;  // 计数使能标志
 
+#if defined(SENSOR_USE_DMA_COUNT)
+#if !defined(DELAY_USE_SYSTICK)
+#error "DMA计数模式把TIM2用作定位孔计数器，需要在Delay.h中改用DELAY_USE_SYSTICK"
+#endif
+static void Sensor_DmaCountInit(void);
+#else
+#if !defined(DELAY_USE_TIM2)
+#error "定位孔输入捕获使用TIM2通道1（与延时共用TIM2的1us计数器），需要定义DELAY_USE_TIM2"
+#endif
+static void Sensor_OnIndexEdge(uint32_t time_us);
+#endif
+#if defined(SENSOR_USE_CHIP_OVERSAMPLE)
+static void Sensor_ChipSampleInit(void);
+#endif
+
 /**
  * 函    数：传感器初始化
  * 参    数：无
  * 返 回 值：无
- * 说    明：初始化PA0为外部中断，PA1为普通输入
+ * 说    明：PA0为TIM2通道1输入捕获（上升沿，硬件滤波），PA1为普通输入
+ *          TIM2的时基由Delay_Init配置（1MHz计数，1ms溢出），必须先调用Delay_Init
+ *          DMA计数模式下TIM2改为由定位孔信号计数，见Sensor_DmaCountInit
+ *          PendSV设为最低优先级，作为计数处理的下半部
  */
 void Sensor_Init(void)
 {
     GPIO_InitTypeDef GPIO_InitStructure;
-    EXTI_InitTypeDef EXTI_InitStructure;
-    NVIC_InitTypeDef NVIC_InitStructure;
+#if !defined(SENSOR_USE_DMA_COUNT)
+    TIM_ICInitTypeDef TIM_ICInitStructure;
+#endif
 
-    /*使能GPIO和AFIO时钟*/
-    RCC_APB2PeriphClockCmd(INDEX_HOLE_RCC | CHIP_DETECT_RCC | RCC_APB2Periph_AFIO, ENABLE);
+    /*使能GPIO时钟*/
+    RCC_APB2PeriphClockCmd(INDEX_HOLE_RCC | CHIP_DETECT_RCC, ENABLE);
 
-    /*配置PA0为浮空输入（用于外部中断）*/
+    /*配置PA0为浮空输入（TIM2_CH1输入捕获）*/
     GPIO_InitStructure.GPIO_Pin = INDEX_HOLE_PIN;
     GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
     GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
@@ -34,22 +53,32 @@ void Sensor_Init(void)
     GPIO_InitStructure.GPIO_Pin = CHIP_DETECT_PIN;
     GPIO_Init(CHIP_DETECT_PORT, &GPIO_InitStructure);
 
-    /*配置PA0连接到EXTI0*/
-    GPIO_EXTILineConfig(GPIO_PortSourceGPIOA, GPIO_PinSource0);
+#if defined(SENSOR_USE_DMA_COUNT)
+    Sensor_DmaCountInit();
+#else
+    /*滤波采样时钟fDTS = 72MHz / 4，滤波器0xF要求电平连续8次采样（fDTS/32）一致，约14us*/
+    TIM_SetClockDivision(TIM2, TIM_CKD_DIV4);
 
-    /*配置EXTI0*/
-    EXTI_InitStructure.EXTI_Line = EXTI_Line0;
-    EXTI_InitStructure.EXTI_Mode = EXTI_Mode_Interrupt;
-    EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Rising; // 上升沿触发（可根据实际硬件调整）
-    EXTI_InitStructure.EXTI_LineCmd = ENABLE;
-    EXTI_Init(&EXTI_InitStructure);
+    /*配置TIM2通道1为上升沿输入捕获（可根据实际硬件调整）*/
+    TIM_ICStructInit(&TIM_ICInitStructure);
+    TIM_ICInitStructure.TIM_Channel = TIM_Channel_1;
+    TIM_ICInitStructure.TIM_ICPolarity = TIM_ICPolarity_Rising;
+    TIM_ICInitStructure.TIM_ICSelection = TIM_ICSelection_DirectTI;
+    TIM_ICInitStructure.TIM_ICPrescaler = TIM_ICPSC_DIV1;
+    TIM_ICInitStructure.TIM_ICFilter = INDEX_HOLE_FILTER;
+    TIM_ICInit(TIM2, &TIM_ICInitStructure);
 
-    /*配置NVIC*/
-    NVIC_InitStructure.NVIC_IRQChannel = EXTI0_IRQn;
-    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
-    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
-    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
-    NVIC_Init(&NVIC_InitStructure);
+    /*捕获中断与TIM2溢出中断共用TIM2_IRQHandler（Delay.c），由回调处理*/
+    Delay_SetCaptureCallback(Sensor_OnIndexEdge);
+    TIM_ClearITPendingBit(TIM2, TIM_IT_CC1);
+    TIM_ITConfig(TIM2, TIM_IT_CC1, ENABLE);
+#if defined(SENSOR_USE_CHIP_OVERSAMPLE)
+    Sensor_ChipSampleInit();
+#endif
+#endif
+
+    /*PendSV低于所有外设中断，只抢占主循环（阻塞的显示、上传、游戏期间照常计数）*/
+    NVIC_SetPriority(PendSV_IRQn, SENSOR_PENDSV_PRIORITY);
 }
 
 /**
@@ -94,93 +123,615 @@ void Sensor_Calibration(void)
     // 具体实现可以在菜单回调函数中完成
 }
 
-/**
- * 函    数：传感器中断处理函数（在主循环中调用）
- * 参    数：无
- * 返 回 值：无
- * 说    明：在中断外进行实际的芯片检测和统计处理，避免中断中执行耗时操作
- */
+volatile uint32_t exti0_trigger_count = 0;  // 触发次数计数（定位孔有效边沿数，保留原变量名）
 
-volatile uint32_t exti0_trigger_count = 0;  // 触发次数计数
-volatile uint8_t sensor_interrupt_flag = 0; // 传感器中断标志位
+/*定位孔边沿判断（在TIM2中断中更新）*/
+static uint8_t index_edge_seen = 0;             // 已有有效边沿
+static uint32_t index_last_us = 0;              // 上一个有效边沿的时刻
+static volatile uint32_t index_rejected = 0;    // 被剔除的抖动边沿数
+static volatile uint32_t index_period_us = 0;   // 最近两个有效边沿的间隔
+
+#if defined(SENSOR_USE_DMA_COUNT)
+/*采样缓冲区：DMA在每个孔的边沿写入GPIOA->IDR，dma_read与dma_holes只由PendSV修改（主循环清空时先加锁）*/
+static uint16_t dma_samples[SENSOR_DMA_BUFFER_SIZE];
+static uint16_t dma_read = 0;     // 下一个待处理的采样位置
+static uint16_t dma_holes = 0;    // 已处理到的TIM2孔计数（16位回绕）
+static uint32_t dma_flush_ms = 0; // 主循环上次触发处理的时间（毫秒）
+#else
+/*料袋事件队列：pocket_head只由捕获中断修改，pocket_tail只由PendSV修改（主循环清空时先加锁）*/
+static SensorPocket_t pocket_ring[SENSOR_POCKET_RING_SIZE];
+static volatile uint16_t pocket_head = 0;
+static volatile uint16_t pocket_tail = 0;
+#endif
+#if defined(SENSOR_USE_CHIP_OVERSAMPLE)
+static uint32_t chip_samples[(CHIP_SAMPLE_COUNT + 3) / 4]; // DMA按字节写入的IDR低8位，按字读取打包
+#endif
+static volatile uint32_t pocket_overflow = 0; // 队列满（DMA模式：缓冲区被覆盖）丢失的料袋数
+static uint16_t pocket_max_depth = 0;         // PendSV开始处理时见过的最大积压
+static uint32_t pocket_max_cycles = 0;        // 处理一个料袋的最长时间（周期）
+static uint32_t pocket_max_latency = 0;       // 边沿到处理完成的最大延迟（微秒）
 uint8_t chip_state = 0;                     // 检测芯片存在状态
 uint8_t chip_present = 0;                   // 芯片存在标志
 // 载带类型枚举实例
 carrier_class_t carrier_class = CARRIER_MSOP; // 首次初始化为MSOP类型
 
-void Sensor_ProcessInLoop(void)
+/*主循环调用统计*/
+static uint32_t loop_last_cycles = 0; // 上次调用时的周期计数，0表示尚未开始统计
+static uint32_t loop_max_gap = 0;     // 最大调用间隔（周期）
+static uint32_t loop_count = 0;       // 当前秒内的调用次数
+static uint32_t loop_hz = 0;          // 上一个完整秒内的调用次数
+static uint32_t loop_second = 0;      // 当前统计秒的起始时间（毫秒）
+
+/**
+ * 函    数：记录一次主循环调用
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：只读两个计数器并做几次比较，不影响计数处理的速度
+ */
+static void Sensor_RecordLoop(void)
 {
-    if (sensor_interrupt_flag) // 中断触发
+    uint32_t now = Delay_Get_Cycles();
+    uint32_t ms = Delay_Get_Ticks();
+
+    if (loop_last_cycles != 0 && now - loop_last_cycles > loop_max_gap)
     {
-        // 根据当前载带类型选择不同的计数方式
-        switch (carrier_class)
+        loop_max_gap = now - loop_last_cycles;
+    }
+    loop_last_cycles = now | 1; // 保证非0
+
+    loop_count++;
+    if (ms - loop_second >= 1000)
+    {
+        loop_hz = loop_count;
+        loop_count = 0;
+        loop_second = ms;
+    }
+}
+
+/**
+ * 函    数：获取主循环调用统计
+ * 参    数：stats - 返回调用频率和最大调用间隔
+ * 返 回 值：无
+ */
+void Sensor_GetLoopStats(SensorLoopStats_t *stats)
+{
+    stats->loop_hz = loop_hz;
+    stats->max_gap_us = loop_max_gap / (SystemCoreClock / 1000000);
+}
+
+/**
+ * 函    数：清零主循环调用统计
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：进入计数界面时调用，避免把菜单操作期间的间隔计入最大值
+ */
+void Sensor_ResetLoopStats(void)
+{
+    loop_last_cycles = 0;
+    loop_max_gap = 0;
+    loop_count = 0;
+    loop_hz = 0;
+    loop_second = Delay_Get_Ticks();
+}
+
+/**
+ * 函    数：按载带类型处理一个料袋
+ * 参    数：pocket - 料袋事件
+ * 返 回 值：无
+ */
+static void Sensor_ProcessPocket(const SensorPocket_t *pocket)
+{
+    chip_state = pocket->chip;
+    chip_present = (chip_state == SENSOR_HIGH) ? CHIP_PRESENT : CHIP_ABSENT;
+
+    // 根据当前载带类型选择不同的计数方式
+    switch (carrier_class)
+    {
+    case CARRIER_MSOP:
+        if (pocket->ordinal % 2 == 1)
+        { // 确保是在有芯片槽的地方进行判断,奇数次触发
+            Statistics_ProcessChip(chip_present);
+        }
+        break;
+    case CARRIER_SOT:
+        Statistics_ProcessChip(chip_present);
+        break;
+    case CARRIER_QFP:
+        break;
+    case CARRIER_DFN:
+        break;
+    case CARRIER_QFN:
+        break;
+    case CARRIER_LQFP:
+        break;
+    case CARRIER_TSSOP:
+        break;
+    case CARRIER_SSOP:
+        break;
+    default:
+        // 未知类型，使用默认检测方式
+        Statistics_ProcessChip(chip_present);
+        break;
+    }
+}
+
+#if defined(SENSOR_USE_DMA_COUNT)
+/**
+ * 函    数：DMA计数模式初始化
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：TIM2工作在外部时钟模式1，时钟为滤波后的TI1（PA0上升沿），计数器即孔数；
+ *          同一边沿在通道1产生捕获，捕获的DMA请求（DMA1通道5）把GPIOA->IDR搬到采样缓冲区，
+ *          每个孔不再进中断，只有缓冲区半满/全满时各进一次中断
+ */
+static void Sensor_DmaCountInit(void)
+{
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseInitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+    /*计数器16位自由回绕，处理时只用差值；fDTS = 72MHz / 4，滤波与输入捕获模式相同（约14us）*/
+    TIM_TimeBaseStructInit(&TIM_TimeBaseInitStructure);
+    TIM_TimeBaseInitStructure.TIM_Period = 0xFFFF;
+    TIM_TimeBaseInitStructure.TIM_Prescaler = 0;
+    TIM_TimeBaseInitStructure.TIM_ClockDivision = TIM_CKD_DIV4;
+    TIM_TimeBaseInit(TIM2, &TIM_TimeBaseInitStructure);
+
+    /*外部时钟模式1，时钟源TI1FP1上升沿；该函数同时把通道1配置为TI1输入捕获*/
+    TIM_TIxExternalClockConfig(TIM2, TIM_TIxExternalCLK1Source_TI1, TIM_ICPolarity_Rising, INDEX_HOLE_FILTER);
+    TIM_DMACmd(TIM2, TIM_DMA_CC1, ENABLE);
+
+    /*DMA1通道5：GPIOA->IDR -> 采样缓冲区，循环模式，半满和全满中断*/
+    DMA_DeInit(DMA1_Channel5);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&GPIOA->IDR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)dma_samples;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = SENSOR_DMA_BUFFER_SIZE;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel5, &DMA_InitStructure);
+    DMA_ClearITPendingBit(DMA1_IT_GL5);
+    DMA_ITConfig(DMA1_Channel5, DMA_IT_HT | DMA_IT_TC, ENABLE);
+
+    /*半满/全满中断只挂起PendSV，优先级与PendSV同组（最低）*/
+    NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel5_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 3;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+
+    DMA_Cmd(DMA1_Channel5, ENABLE);
+    TIM_Cmd(TIM2, ENABLE);
+}
+
+/**
+ * 函    数：DMA1通道5中断服务函数
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：采样缓冲区半满或全满，挂起PendSV成批处理
+ */
+void DMA1_Channel5_IRQHandler(void)
+{
+    if (DMA_GetITStatus(DMA1_IT_HT5) != RESET || DMA_GetITStatus(DMA1_IT_TC5) != RESET)
+    {
+        DMA_ClearITPendingBit(DMA1_IT_HT5 | DMA1_IT_TC5);
+        SCB->ICSR = SCB_ICSR_PENDSVSET;
+    }
+}
+
+/**
+ * 函    数：PendSV中断服务函数（计数下半部，DMA计数模式）
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：处理DMA已写入、尚未处理的全部采样，每个采样即一个孔在边沿时刻的芯片检测状态
+ *          先读孔数再读DMA位置，用硬件孔数判断缓冲区是否已被覆盖（处理不及时），覆盖时整批丢弃并计入丢失
+ */
+void PendSV_Handler(void)
+{
+    uint16_t holes, write, count, behind;
+    uint32_t start, cycles;
+    SensorPocket_t pocket;
+
+    holes = TIM_GetCounter(TIM2);
+    write = (uint16_t)(SENSOR_DMA_BUFFER_SIZE - DMA_GetCurrDataCounter(DMA1_Channel5)) & (SENSOR_DMA_BUFFER_SIZE - 1);
+    behind = (uint16_t)(holes - dma_holes);
+
+    if (behind >= SENSOR_DMA_BUFFER_SIZE)
+    {
+        // 缓冲区已绕过一圈，无法区分新旧采样，丢弃这批孔，序号按硬件孔数跳过（保持MSOP奇偶）
+        pocket_overflow += behind;
+        if (g_statistics.is_beginning == 1)
         {
-        case CARRIER_MSOP:
-            if (exti0_trigger_count % 2 == 1)
-            { // 确保是在有芯片槽的地方进行判断,奇数次触发
-                chip_state = Sensor_GetChipDetectState();
-                chip_present = (chip_state == SENSOR_HIGH) ? CHIP_PRESENT : CHIP_ABSENT;
-                Statistics_ProcessChip(chip_present);
-            }
-            break;
-        case CARRIER_SOT:
-            if (exti0_trigger_count > 0)
-            {
-                chip_state = Sensor_GetChipDetectState();
-                chip_present = (chip_state == SENSOR_HIGH) ? CHIP_PRESENT : CHIP_ABSENT;
-                Statistics_ProcessChip(chip_present);
-            }
-            break;
-        case CARRIER_QFP:
-            break;
-        case CARRIER_DFN:
-            break;
-        case CARRIER_QFN:
-            break;
-        case CARRIER_LQFP:
-            break;
-        case CARRIER_TSSOP:
-            break;
-        case CARRIER_SSOP:
-            break;
-        default:
-            // 未知类型，使用默认检测方式
-            if (exti0_trigger_count > 0)
+            exti0_trigger_count += behind;
+        }
+        dma_holes = holes;
+        dma_read = write;
+        return;
+    }
+
+    count = (uint16_t)(write - dma_read) & (SENSOR_DMA_BUFFER_SIZE - 1);
+    if (count > pocket_max_depth)
+    {
+        pocket_max_depth = count;
+    }
+
+    pocket.time_us = 0; // 此模式没有微秒时基
+    while (count--)
+    {
+        pocket.chip = (dma_samples[dma_read] & CHIP_DETECT_PIN) ? SENSOR_HIGH : SENSOR_LOW;
+        dma_read = (dma_read + 1) & (SENSOR_DMA_BUFFER_SIZE - 1);
+        dma_holes++;
+
+        if (g_statistics.is_beginning == 1) // 计数功能使能后再进行计数统计
+        {
+            exti0_trigger_count++;
+            pocket.ordinal = exti0_trigger_count;
+            start = Delay_Get_Cycles();
+            Sensor_ProcessPocket(&pocket);
+            cycles = Delay_Get_Cycles() - start;
+            if (cycles > pocket_max_cycles)
             {
-                chip_state = Sensor_GetChipDetectState();
-                chip_present = (chip_state == SENSOR_HIGH) ? CHIP_PRESENT : CHIP_ABSENT;
-                Statistics_ProcessChip(chip_present);
+                pocket_max_cycles = cycles;
             }
-            break;
         }
-        // 清除中断标志位
-        sensor_interrupt_flag = 0;
     }
 }
 
+#else
 /**
- * 函    数：PA0外部中断服务函数
+ * 函    数：PendSV中断服务函数（计数下半部）
  * 参    数：无
  * 返 回 值：无
- * 说    明：检测到定位孔时设置标志位，实际处理在主循环中进行
+ * 说    明：定位孔中断记录料袋后挂起PendSV，在所有中断返回后、主循环继续之前取完队列中的料袋
+ *          每个料袋只做载带规则判断和统计累加，没有循环和阻塞调用，处理时间有固定上限；
+ *          报警只记录标志，蜂鸣器和弹窗由主循环中的Sensor_ProcessInLoop完成
  */
-void EXTI0_IRQHandler(void)
+void PendSV_Handler(void)
 {
+    uint16_t head, tail, depth;
+    uint32_t start, cycles, latency;
+    const SensorPocket_t *pocket;
 
-    if (EXTI_GetITStatus(EXTI_Line0) == SET)
+    head = pocket_head;
+    tail = pocket_tail;
+    depth = (uint16_t)(head - tail);
+    if (depth > pocket_max_depth)
     {
-        EXTI_ClearITPendingBit(EXTI_Line0);                // 清除中断标志位
-        Delay_ms(20);                                      // 延时去抖动
-        if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_0) == 1) // 确保是上升沿
+        pocket_max_depth = depth;
+    }
+
+    while (tail != head)
+    {
+        pocket = &pocket_ring[tail & (SENSOR_POCKET_RING_SIZE - 1)];
+        start = Delay_Get_Cycles();
+        Sensor_ProcessPocket(pocket);
+        cycles = Delay_Get_Cycles() - start;
+        latency = Delay_Get_Us() - pocket->time_us;
+        pocket_tail = ++tail; // 处理完一个立即释放，中断可以继续写入
+
+        if (cycles > pocket_max_cycles)
         {
-            if (g_statistics.is_beginning == 1) // 计数功能使能后再进行计数统计
-            {
-                exti0_trigger_count++; // 触发计数
-                // 设置中断标志位，实际处理在外部完成
-                sensor_interrupt_flag = 1;
-            }
+            pocket_max_cycles = cycles;
+        }
+        if (latency > pocket_max_latency)
+        {
+            pocket_max_latency = latency;
+        }
+        head = pocket_head; // 处理期间新到的料袋一并处理
+    }
+}
+#endif
+
+/**
+ * 函    数：传感器处理函数（在主循环中调用）
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：计数已在PendSV中完成，这里只弹出报警界面（蜂鸣器会阻塞）并统计主循环的调用间隔
+ */
+void Sensor_ProcessInLoop(void)
+{
+    Sensor_RecordLoop(); // 统计调用频率与间隔
+    Statistics_DispatchAlarms();
+
+#if defined(SENSOR_USE_DMA_COUNT)
+    if (Delay_Get_Ticks() - dma_flush_ms >= SENSOR_DMA_FLUSH_MS)
+    {
+        dma_flush_ms = Delay_Get_Ticks();
+        SCB->ICSR = SCB_ICSR_PENDSVSET; // 孔速较慢时处理未满半个缓冲区的采样，避免显示滞后
+    }
+#endif
+}
+
+/**
+ * 函    数：暂缓计数处理
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：屏蔽PendSV（其它中断不受影响），用于主循环中一次修改多个统计数据，
+ *          期间到达的料袋留在队列中，解锁后立即处理；与Sensor_UnlockCounting成对使用，不可嵌套
+ */
+void Sensor_LockCounting(void)
+{
+    __set_BASEPRI(SENSOR_PENDSV_PRIORITY << (8 - __NVIC_PRIO_BITS));
+}
+
+/**
+ * 函    数：恢复计数处理
+ * 参    数：无
+ * 返 回 值：无
+ */
+void Sensor_UnlockCounting(void)
+{
+    __set_BASEPRI(0);
+}
 
-        } // if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_0) == 1)
-        EXTI_ClearITPendingBit(EXTI_Line0); // 清除中断标志位
-    } // if (EXTI_GetITStatus(EXTI_Line0) == SET)
+/**
+ * 函    数：获取料袋队列统计
+ * 参    数：stats - 返回丢失的料袋数和最大积压
+ * 返 回 值：无
+ */
+void Sensor_GetPocketStats(SensorPocketStats_t *stats)
+{
+    stats->overflow = pocket_overflow;
+    stats->max_depth = pocket_max_depth;
+    stats->max_cycles = pocket_max_cycles;
+    stats->max_latency_us = pocket_max_latency;
+}
+
+/**
+ * 函    数：清空料袋队列和统计
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：开始新一轮计数时调用，只在主循环中调用，调用前需Sensor_LockCounting
+ */
+void Sensor_ResetPockets(void)
+{
+#if defined(SENSOR_USE_DMA_COUNT)
+    dma_holes = TIM_GetCounter(TIM2); // 先读孔数再读DMA位置，与PendSV_Handler相同
+    dma_read = (uint16_t)(SENSOR_DMA_BUFFER_SIZE - DMA_GetCurrDataCounter(DMA1_Channel5)) & (SENSOR_DMA_BUFFER_SIZE - 1);
+#else
+    pocket_tail = pocket_head;
+#endif
+    pocket_overflow = 0;
+    pocket_max_depth = 0;
+    pocket_max_cycles = 0;
+    pocket_max_latency = 0;
+}
+
+/**
+ * 函    数：判断定位孔边沿是否有效
+ * 参    数：time_us - 边沿时刻（微秒）
+ * 返 回 值：1有效，0无效（距上一个有效边沿不足INDEX_HOLE_MIN_INTERVAL_US，视为抖动）
+ * 说    明：硬件滤波去掉微秒级毛刺，更长的抖动按最小间隔剔除
+ */
+uint8_t Sensor_AcceptIndexEdge(uint32_t time_us)
+{
+    uint32_t interval = time_us - index_last_us;
+
+    if (index_edge_seen && interval < INDEX_HOLE_MIN_INTERVAL_US)
+    {
+        index_rejected++;
+        return 0;
+    }
+
+    if (index_edge_seen)
+    {
+        index_period_us = interval;
+    }
+    index_edge_seen = 1;
+    index_last_us = time_us;
+    return 1;
+}
+
+/**
+ * 函    数：把采样字节中的芯片检测位打包为位图
+ * 参    数：samples - 采样缓冲区（每字节一次采样，小端，按字读取）
+ *          count - 采样次数（1~32）
+ * 返 回 值：位图，第i位为第i次采样的芯片检测电平
+ * 说    明：每个字先把4个字节的检测位移到各字节最低位，再乘以0x10204080，
+ *          4个位无进位地收集到结果的最高4位（第j字节的位移动28-7j位）
+ */
+uint32_t Sensor_PackChipSamples(const uint32_t *samples, uint8_t count)
+{
+    uint32_t bits = 0;
+    uint32_t lanes;
+    uint8_t i;
+
+    for (i = 0; i < count; i += 4)
+    {
+        lanes = (samples[i / 4] >> CHIP_DETECT_BIT) & 0x01010101;
+        bits |= ((lanes * 0x10204080) >> 28) << i;
+    }
+    if (count < 32)
+    {
+        bits &= (1UL << count) - 1; // 去掉最后一个字中没有采样的字节
+    }
+    return bits;
+}
+
+/**
+ * 函    数：多数表决
+ * 参    数：bits - 采样位图
+ *          count - 采样次数
+ * 返 回 值：超过一半的采样为高时返回SENSOR_HIGH，否则SENSOR_LOW
+ * 说    明：并行位计数，固定12次运算，与采样次数无关
+ */
+uint8_t Sensor_ChipMajority(uint32_t bits, uint8_t count)
+{
+    bits = bits - ((bits >> 1) & 0x55555555);
+    bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+    bits = (bits + (bits >> 4)) & 0x0F0F0F0F;
+    bits = (bits * 0x01010101) >> 24;
+    return (bits * 2 > count) ? SENSOR_HIGH : SENSOR_LOW;
+}
+
+/**
+ * 函    数：连续游程判断
+ * 参    数：bits - 采样位图
+ *          run - 需要的连续高电平采样数（1~32）
+ * 返 回 值：存在连续run个高电平采样时返回SENSOR_HIGH，否则SENSOR_LOW
+ * 说    明：每次与右移一位的自身相与，剩下的1都是长度加1的游程的起点，run-1次后非0即存在
+ *          孤立的反光尖峰达不到游程长度，会被滤掉
+ */
+uint8_t Sensor_ChipRun(uint32_t bits, uint8_t run)
+{
+    while (run > 1 && bits != 0)
+    {
+        bits &= bits >> 1;
+        run--;
+    }
+    return (bits != 0) ? SENSOR_HIGH : SENSOR_LOW;
+}
+
+#if defined(SENSOR_USE_CHIP_OVERSAMPLE)
+/**
+ * 函    数：芯片检测过采样初始化
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：TIM1（72MHz，不分频）每CHIP_SAMPLE_WINDOW_US/CHIP_SAMPLE_COUNT溢出一次，
+ *          更新事件的DMA请求（DMA1通道5）把GPIOA->IDR的低8位写入chip_samples；
+ *          TIM1平时停止，由定位孔中断启动，采满后在DMA中断中停止
+ */
+static void Sensor_ChipSampleInit(void)
+{
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseInitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_TIM1, ENABLE);
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+    TIM_TimeBaseStructInit(&TIM_TimeBaseInitStructure);
+    TIM_TimeBaseInitStructure.TIM_Period = 72 * CHIP_SAMPLE_WINDOW_US / CHIP_SAMPLE_COUNT - 1;
+    TIM_TimeBaseInitStructure.TIM_Prescaler = 0;
+    TIM_TimeBaseInit(TIM1, &TIM_TimeBaseInitStructure);
+
+    /*DMA1通道5：GPIOA->IDR（半字读）-> chip_samples（字节写，保留低8位），普通模式*/
+    DMA_DeInit(DMA1_Channel5);
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&GPIOA->IDR;
+    DMA_InitStructure.DMA_MemoryBaseAddr = (uint32_t)chip_samples;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStructure.DMA_BufferSize = CHIP_SAMPLE_COUNT;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+    DMA_InitStructure.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel5, &DMA_InitStructure);
+    DMA_ClearITPendingBit(DMA1_IT_GL5);
+    DMA_ITConfig(DMA1_Channel5, DMA_IT_TC, ENABLE);
+
+    /*采满中断与定位孔中断同组，窗口结束后尽快发布料袋*/
+    NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel5_IRQn;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+ * 函    数：启动一次芯片检测采样（定位孔中断中调用）
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：先关闭更新DMA请求，清掉上次停止前可能残留的请求，再从0开始计时
+ */
+static void Sensor_StartChipSampling(void)
+{
+    TIM_DMACmd(TIM1, TIM_DMA_Update, DISABLE);
+    DMA_Cmd(DMA1_Channel5, DISABLE);
+    DMA_SetCurrDataCounter(DMA1_Channel5, CHIP_SAMPLE_COUNT);
+    DMA_Cmd(DMA1_Channel5, ENABLE);
+    TIM_SetCounter(TIM1, 0);
+    TIM_DMACmd(TIM1, TIM_DMA_Update, ENABLE);
+    TIM_Cmd(TIM1, ENABLE);
+}
+
+/**
+ * 函    数：DMA1通道5中断服务函数（芯片检测采满）
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：停止TIM1，判断芯片状态后发布定位孔中断预留的料袋
+ */
+void DMA1_Channel5_IRQHandler(void)
+{
+    uint16_t head;
+    uint32_t bits;
+
+    if (DMA_GetITStatus(DMA1_IT_TC5) != RESET)
+    {
+        DMA_ClearITPendingBit(DMA1_IT_TC5);
+        TIM_Cmd(TIM1, DISABLE);
+
+        bits = Sensor_PackChipSamples(chip_samples, CHIP_SAMPLE_COUNT);
+        head = pocket_head;
+#if CHIP_SAMPLE_RUN > 0
+        pocket_ring[head & (SENSOR_POCKET_RING_SIZE - 1)].chip = Sensor_ChipRun(bits, CHIP_SAMPLE_RUN);
+#else
+        pocket_ring[head & (SENSOR_POCKET_RING_SIZE - 1)].chip = Sensor_ChipMajority(bits, CHIP_SAMPLE_COUNT);
+#endif
+        pocket_head = head + 1;
+        SCB->ICSR = SCB_ICSR_PENDSVSET;
+    }
+}
+#endif
+
+#if !defined(SENSOR_USE_DMA_COUNT)
+/**
+ * 函    数：定位孔上升沿捕获回调（TIM2中断中执行）
+ * 参    数：time_us - 捕获时刻（微秒）
+ * 返 回 值：无
+ * 说    明：只做间隔判断、计数和锁存芯片状态，实际处理在PendSV中进行，不再在中断里延时去抖
+ */
+static void Sensor_OnIndexEdge(uint32_t time_us)
+{
+    if (!Sensor_AcceptIndexEdge(time_us))
+    {
+        return;
+    }
+
+    if (g_statistics.is_beginning == 1) // 计数功能使能后再进行计数统计
+    {
+        uint16_t head = pocket_head;
+        SensorPocket_t *pocket;
+
+        exti0_trigger_count++; // 触发计数，队列满时也计数，序号保持连续
+        if ((uint16_t)(head - pocket_tail) >= SENSOR_POCKET_RING_SIZE)
+        {
+            pocket_overflow++; // PendSV来不及处理（被更高优先级的中断长时间占用），记录丢失
+            return;
+        }
+
+        // 在定位孔边沿处锁存芯片检测状态，实际统计在PendSV中完成
+        pocket = &pocket_ring[head & (SENSOR_POCKET_RING_SIZE - 1)];
+        pocket->time_us = time_us;
+        pocket->ordinal = exti0_trigger_count;
+#if defined(SENSOR_USE_CHIP_OVERSAMPLE)
+        Sensor_StartChipSampling(); // 采样窗口结束后在DMA中断中写入芯片状态并发布
+#else
+        pocket->chip = Sensor_GetChipDetectState();
+        pocket_head = head + 1; // 内容写完后再发布
+        SCB->ICSR = SCB_ICSR_PENDSVSET; // 中断返回后执行计数下半部
+#endif
+    }
+}
+#endif
+
+/**
+ * 函    数：获取定位孔边沿统计
+ * 参    数：stats - 返回被剔除的抖动边沿数和最近的孔间隔
+ * 返 回 值：无
+ */
+void Sensor_GetIndexStats(SensorIndexStats_t *stats)
+{
+    stats->rejected = index_rejected;
+    stats->period_us = index_period_us;
 }
@@ -4,7 +4,8 @@
 #include "stm32f10x.h"
 #include "Delay.h"
 #include "Statistics.h"
-#include "stm32f10x_exti.h"
+#include "stm32f10x_tim.h"
+#include "stm32f10x_dma.h"
 #include "stm32f10x_gpio.h"
 #include "misc.h"
 
@@ -12,10 +13,53 @@
 #define INDEX_HOLE_PIN GPIO_Pin_0 // PA0: 定位孔传感器
 #define INDEX_HOLE_PORT GPIOA
 #define INDEX_HOLE_RCC RCC_APB2Periph_GPIOA
+#define INDEX_HOLE_FILTER 0xF              // TIM2输入捕获滤波（0~0xF），0xF约14us
+#define INDEX_HOLE_MIN_INTERVAL_US 300     // 有效边沿最小间隔，更近的边沿视为抖动（支持3kHz以内的孔速率）
 
-#define CHIP_DETECT_PIN GPIO_Pin_1 // PA1: 芯片检测传感器
+#define CHIP_DETECT_PIN 0x0002 // PA1: 芯片检测传感器（GPIO_Pin_1，写成数值以便预处理器检查）
+#define CHIP_DETECT_BIT 1      // CHIP_DETECT_PIN的位号
 #define CHIP_DETECT_PORT GPIOA
 #define CHIP_DETECT_RCC RCC_APB2Periph_GPIOA
+#if CHIP_DETECT_PIN != (1 << CHIP_DETECT_BIT)
+#error "CHIP_DETECT_PIN与CHIP_DETECT_BIT不一致"
+#endif
+
+/*计数下半部：定位孔中断只记录料袋并挂起PendSV，统计在PendSV中完成*/
+#define SENSOR_PENDSV_PRIORITY 0x0F // PendSV优先级（4位，最低），只抢占主循环
+
+/*DMA计数模式（默认关闭）：定位孔信号作为TIM2的外部时钟，孔数由TIM2计数器硬件累计，
+  每个孔的边沿同时触发DMA把GPIOA->IDR写入环形缓冲区，不再每个孔进一次中断，
+  PendSV在缓冲区半满/全满时（以及主循环每SENSOR_DMA_FLUSH_MS）成批处理芯片检测位
+  TIM2不能再作延时时基，打开此宏时需在Delay.h中改用DELAY_USE_SYSTICK；DMA使用DMA1通道5（TIM2_CH1请求）*/
+// #define SENSOR_USE_DMA_COUNT
+#define SENSOR_DMA_BUFFER_SIZE 256 // 采样缓冲区长度（每个孔一个采样），必须是2的幂
+#define SENSOR_DMA_FLUSH_MS 50     // 孔速较慢、半个缓冲区迟迟不满时，主循环按此周期触发处理
+#if (SENSOR_DMA_BUFFER_SIZE & (SENSOR_DMA_BUFFER_SIZE - 1)) != 0
+#error "SENSOR_DMA_BUFFER_SIZE必须是2的幂"
+#endif
+
+/*芯片检测过采样（默认关闭）：定位孔边沿后由TIM1在窗口内均匀触发CHIP_SAMPLE_COUNT次DMA，采样GPIOA->IDR，
+  窗口结束后把PA1的采样打包成位图，按多数表决或连续游程判断有无芯片，代替边沿时刻的单次读取，
+  减少反光和料袋边缘造成的误判；采样期间不占用CPU，只在窗口结束时进一次中断（DMA1通道5）*/
+// #define SENSOR_USE_CHIP_OVERSAMPLE
+#define CHIP_SAMPLE_COUNT 9      // 每个料袋的采样次数（1~32）
+#define CHIP_SAMPLE_WINDOW_US 90 // 采样窗口宽度（微秒），第k次采样在边沿后k*窗口/次数处
+#define CHIP_SAMPLE_RUN 0        // 判决规则：0为多数表决；大于0时需连续该数量的采样为高才判为有芯片
+#if CHIP_SAMPLE_COUNT < 1 || CHIP_SAMPLE_COUNT > 32
+#error "CHIP_SAMPLE_COUNT范围为1~32"
+#endif
+#if CHIP_SAMPLE_WINDOW_US < CHIP_SAMPLE_COUNT || CHIP_SAMPLE_WINDOW_US >= INDEX_HOLE_MIN_INTERVAL_US
+#error "CHIP_SAMPLE_WINDOW_US须不小于采样次数（微秒），且小于INDEX_HOLE_MIN_INTERVAL_US（下一个边沿到来前采完）"
+#endif
+#if CHIP_SAMPLE_RUN > CHIP_SAMPLE_COUNT
+#error "CHIP_SAMPLE_RUN不能大于CHIP_SAMPLE_COUNT"
+#endif
+#if defined(SENSOR_USE_CHIP_OVERSAMPLE) && CHIP_DETECT_BIT > 7
+#error "过采样DMA只保存IDR的低8位，芯片检测引脚须在PA0~PA7"
+#endif
+#if defined(SENSOR_USE_CHIP_OVERSAMPLE) && defined(SENSOR_USE_DMA_COUNT)
+#error "过采样需要在定位孔中断中启动，不能与DMA计数模式同时使用"
+#endif
 
 /*传感器状态定义*/
 #define SENSOR_HIGH 1
@@ -38,17 +82,63 @@ typedef enum
     CARRIER_COUNT      // 载带类型总数（用于边界检查）
 } carrier_class_t;
 
+/*主循环调用统计（Sensor_ProcessInLoop的调用频率与最大间隔，游戏等阻塞界面期间不调用）*/
+typedef struct
+{
+    uint32_t loop_hz;    // 最近一个完整秒内的调用次数
+    uint32_t max_gap_us; // 两次调用之间的最大间隔（微秒），反映显示等耗时操作对计数的阻塞
+} SensorLoopStats_t;
+
+#define SENSOR_POCKET_RING_SIZE 64 // 料袋事件队列长度，必须是2的幂
+#if (SENSOR_POCKET_RING_SIZE & (SENSOR_POCKET_RING_SIZE - 1)) != 0
+#error "SENSOR_POCKET_RING_SIZE必须是2的幂"
+#endif
+
+/*料袋事件：定位孔中断中写入，PendSV中批量处理*/
+typedef struct
+{
+    uint32_t time_us; // 定位孔边沿时刻（微秒）
+    uint32_t ordinal; // 定位孔序号（从1开始，即当时的exti0_trigger_count）
+    uint8_t chip;     // 边沿时刻的芯片检测状态（SENSOR_HIGH或SENSOR_LOW）
+} SensorPocket_t;
+
+/*料袋事件队列统计*/
+typedef struct
+{
+    uint32_t overflow;       // 队列满丢失的料袋数
+    uint16_t max_depth;      // PendSV开始处理时的最大积压
+    uint32_t max_cycles;     // 处理一个料袋的最长时间（CPU周期，72周期为1us）
+    uint32_t max_latency_us; // 定位孔边沿到料袋统计完成的最大延迟（微秒），DMA计数模式下不统计（为0）
+} SensorPocketStats_t;
+
+/*定位孔边沿统计*/
+typedef struct
+{
+    uint32_t rejected;  // 因间隔过短被剔除的边沿数
+    uint32_t period_us; // 最近两个有效边沿的间隔（微秒）
+} SensorIndexStats_t;
+
 /*函数声明*/
 void Sensor_Init(void);
 // void Sensor_EnableCounting(uint8_t enable);
 uint8_t Sensor_GetChipDetectState(void);
 uint8_t Sensor_GetIndexHoleState(void);
 void Sensor_Calibration(void);
-void Sensor_ProcessInLoop(void); // 循环中调用的传感器处理函数
+void Sensor_ProcessInLoop(void); // 主循环中调用：弹出报警界面、统计主循环
+void Sensor_LockCounting(void);   // 主循环修改统计数据前调用，暂缓PendSV中的计数处理
+void Sensor_UnlockCounting(void);
+void Sensor_GetLoopStats(SensorLoopStats_t *stats);
+void Sensor_ResetLoopStats(void);
+uint8_t Sensor_AcceptIndexEdge(uint32_t time_us);
+void Sensor_GetIndexStats(SensorIndexStats_t *stats);
+void Sensor_GetPocketStats(SensorPocketStats_t *stats);
+void Sensor_ResetPockets(void);
+uint32_t Sensor_PackChipSamples(const uint32_t *samples, uint8_t count); // 采样字节的芯片检测位打包为位图
+uint8_t Sensor_ChipMajority(uint32_t bits, uint8_t count);               // 多数表决
+uint8_t Sensor_ChipRun(uint32_t bits, uint8_t run);                      // 连续游程判断
 
 /*外部变量声明*/
 extern volatile uint32_t exti0_trigger_count;  // 定位孔触发计数
-extern volatile uint8_t sensor_interrupt_flag; // 传感器中断标志位
 extern carrier_class_t carrier_class;          // 载带类型
 
 #endif
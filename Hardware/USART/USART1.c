@@ -9,7 +9,7 @@
 // ================== 静态全局变量 ==================
 
 static uint8_t rx_buffer[USART1_RX_BUFFER_SIZE]; ///< 接收缓冲区数组
-// static uint8_t tx_buffer[USART1_TX_BUFFER_SIZE]; ///< 发送缓冲区数组
+static uint8_t tx_buffer[USART1_TX_BUFFER_SIZE]; ///< 发送缓冲区数组
 
 /**
  * @brief 接收缓冲区结构体实例
@@ -24,6 +24,19 @@ static USART1_Buffer_t rx_buf = {
     .overflow = false              ///< 缓冲区溢出标志
 };
 
+/**
+ * @brief 发送缓冲区结构体实例
+ * @details 存储USART1_SendArrayAsync写入的数据，由TXE中断逐字节发出
+ */
+static USART1_Buffer_t tx_buf = {
+    .buffer = tx_buffer,           ///< 缓冲区指针，指向tx_buffer数组
+    .size = USART1_TX_BUFFER_SIZE, ///< 缓冲区大小，单位字节
+    .head = 0,                     ///< 缓冲区头部索引，写入位置
+    .tail = 0,                     ///< 缓冲区尾部索引，读取位置
+    .count = 0,                    ///< 缓冲区中当前存储的数据量
+    .overflow = false              ///< 缓冲区溢出标志
+};
+
 static volatile bool tx_busy = false;            ///< 发送忙标志
 static volatile bool rx_enabled = true;          ///< 接收使能标志
 static void (*rx_callback)(uint8_t data) = NULL; ///< 接收回调函数指针
@@ -118,6 +131,24 @@ static void USART1_BufferClear(USART1_Buffer_t *buf)
     buf->overflow = false;
 }
 
+/**
+ * @brief 等待中断发送缓冲区发送完毕
+ * @param timer 指向已启动的超时定时器的指针
+ * @return bool 发送完毕返回true，超时返回false
+ * @note 轮询发送前调用，避免与USART1_SendArrayAsync的数据交错
+ */
+static bool USART1_WaitTxBufferEmpty(DelayTimer *timer)
+{
+    while (tx_busy)
+    {
+        if (Delay_Check(timer))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 // ================== 初始化函数 ==================
 
 /**
@@ -178,6 +209,7 @@ void USART1_Init(uint32_t baudrate)
 
     // 初始化缓冲区
     USART1_BufferClear(&rx_buf);
+    USART1_BufferClear(&tx_buf);
     tx_busy = false;
     rx_enabled = true;
 
@@ -205,6 +237,7 @@ void USART1_DeInit(void)
 
     // 清除缓冲区
     USART1_BufferClear(&rx_buf);
+    USART1_BufferClear(&tx_buf);
     tx_busy = false;
 
     // 复位外设
@@ -240,6 +273,11 @@ USART1_Status_t USART1_SendByteTimeout(uint8_t data, uint32_t timeout)
     // 创建非阻塞定时器
     DelayTimer timer;                      // 创建一个定时器
     Delay_Start(&timer,timeout);      // 启动定时器
+    // 等待中断发送缓冲区发完
+    if (!USART1_WaitTxBufferEmpty(&timer))
+    {
+        return USART1_TIMEOUT;
+    }
     // 等待发送缓冲区为空
     while (USART_GetFlagStatus(USART1, USART_FLAG_TXE) == RESET)
     {
@@ -301,6 +339,11 @@ USART1_Status_t USART1_SendArrayTimeout(const uint8_t *array, uint16_t length, u
     DelayTimer timer; // 创建一个定时器
 
     Delay_Start(&timer, timeout); // 启动定时器
+    // 等待中断发送缓冲区发完
+    if (!USART1_WaitTxBufferEmpty(&timer))
+    {
+        return USART1_TIMEOUT;
+    }
     for (uint16_t i = 0; i < length; i++)
     {
         // 等待发送缓冲区为空
@@ -330,6 +373,55 @@ USART1_Status_t USART1_SendArrayTimeout(const uint8_t *array, uint16_t length, u
     return USART1_OK;
 }
 
+/**
+ * @brief 非阻塞发送字节数组
+ * @param array 指向要发送的字节数组的指针
+ * @param length 要发送的字节数
+ * @return USART1_Status_t 发送状态
+ * @retval USART1_OK 已全部写入发送缓冲区
+ * @retval USART1_ERROR 参数错误
+ * @retval USART1_BUFFER_FULL 发送缓冲区空间不足，没有写入任何数据
+ * @note 数据写入发送缓冲区后立即返回，由TXE中断逐字节发出；
+ *       要么全部写入要么不写，调用者可先用USART1_GetTxBufferFree()确认空间
+ */
+USART1_Status_t USART1_SendArrayAsync(const uint8_t *array, uint16_t length)
+{
+    if (array == NULL || length == 0)
+    {
+        return USART1_ERROR;
+    }
+
+    // 关闭TXE中断，避免与中断服务函数同时修改count
+    USART_ITConfig(USART1, USART_IT_TXE, DISABLE);
+    if (tx_buf.size - tx_buf.count < length)
+    {
+        tx_buf.overflow = true;
+        if (tx_busy)
+        {
+            USART_ITConfig(USART1, USART_IT_TXE, ENABLE);
+        }
+        return USART1_BUFFER_FULL;
+    }
+    for (uint16_t i = 0; i < length; i++)
+    {
+        USART1_BufferWrite(&tx_buf, array[i]);
+    }
+    tx_busy = true;
+    USART_ITConfig(USART1, USART_IT_TXE, ENABLE);
+
+    return USART1_OK;
+}
+
+/**
+ * @brief 获取发送缓冲区剩余空间
+ * @return uint16_t 发送缓冲区剩余可用空间（字节数）
+ * @note 用于USART1_SendArrayAsync之前检查能否一次写入
+ */
+uint16_t USART1_GetTxBufferFree(void)
+{
+    return tx_buf.size - tx_buf.count;
+}
+
 /**
  * @brief 发送字符串（使用默认超时时间）
  * @param str 指向要发送的字符串的指针
@@ -377,12 +469,13 @@ USART1_Status_t USART1_SendStringTimeout(const char *str, uint32_t timeout)
  * @return USART1_Status_t 发送状态
  * @retval USART1_OK 发送成功
  * @retval USART1_ERROR 参数错误或格式化失败
- * @note 支持标准printf格式化，最大字符串长度由USART1_MAX_STRING_LEN定义
+ * @note 使用Format_VPrintf格式化（printf子集，见Format.h），最大字符串长度由USART1_MAX_STRING_LEN定义
  * @warning 格式化后的字符串长度不能超过USART1_MAX_STRING_LEN-1
  */
 USART1_Status_t USART1_Printf(const char *format, ...)
 {
     char buffer[USART1_MAX_STRING_LEN];
+    Format_t fmt;
     va_list args;
 
     if (format == NULL)
@@ -391,11 +484,12 @@ USART1_Status_t USART1_Printf(const char *format, ...)
     }
 
     // 格式化字符串
+    Format_Init(&fmt, buffer, sizeof(buffer));
     va_start(args, format);
-    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+    Format_VPrintf(&fmt, format, args);
     va_end(args);
 
-    if (len < 0 || len >= (int)sizeof(buffer))
+    if (fmt.overflow)
     {
         return USART1_ERROR;
     }
@@ -415,16 +509,15 @@ USART1_Status_t USART1_Printf(const char *format, ...)
 USART1_Status_t USART1_SendNumber(uint32_t number, uint8_t digits)
 {
     char buffer[12]; // 32位整数的最大位数 + 1
-    char format[8];
+    Format_t fmt;
 
     if (digits > 10)
     {
         digits = 10;
     }
 
-    // 生成格式字符串
-    snprintf(format, sizeof(format), "%%0%du", digits);
-    snprintf(buffer, sizeof(buffer), format, number);
+    Format_Init(&fmt, buffer, sizeof(buffer));
+    Format_Uint(&fmt, number, digits, FORMAT_ZERO);
 
     return USART1_SendString(buffer);
 }
@@ -440,16 +533,15 @@ USART1_Status_t USART1_SendNumber(uint32_t number, uint8_t digits)
 USART1_Status_t USART1_SendFloat(float number, uint8_t decimal_places)
 {
     char buffer[32];
-    char format[8];
+    Format_t fmt;
 
     if (decimal_places > 6)
     {
         decimal_places = 6;
     }
 
-    // 生成格式字符串
-    snprintf(format, sizeof(format), "%%.%df", decimal_places);
-    snprintf(buffer, sizeof(buffer), format, number);
+    Format_Init(&fmt, buffer, sizeof(buffer));
+    Format_Float(&fmt, number, decimal_places);
 
     return USART1_SendString(buffer);
 }
@@ -640,12 +732,13 @@ void USART1_ClearRxBuffer(void)
 
 /**
  * @brief 清空发送缓冲区
- * @note 当前实现为空，因为使用轮询发送模式
+ * @note 丢弃USART1_SendArrayAsync写入但尚未发出的数据，轮询发送不经过此缓冲区
  */
 void USART1_ClearTxBuffer(void)
 {
-    // 对于轮询模式，没有发送缓冲区
-    // 对于中断模式，需要清空发送缓冲区
+    USART_ITConfig(USART1, USART_IT_TXE, DISABLE);
+    USART1_BufferClear(&tx_buf);
+    tx_busy = false;
 }
 
 /**
@@ -691,7 +784,7 @@ void USART1_DisableRxBuffer(void)
 
 /**
  * @brief 检查发送是否忙
- * @return bool 发送忙返回true，否则返回false
+ * @return bool 发送缓冲区中还有数据返回true，否则返回false
  * @note 主要用于中断发送模式
  */
 bool USART1_IsTxBusy(void)
@@ -724,6 +817,8 @@ USART1_Status_t USART1_GetStatus(void)
 void USART1_Flush(void)
 {
     // 等待所有数据发送完成
+    while (tx_busy)
+        ;
     while (USART_GetFlagStatus(USART1, USART_FLAG_TC) == RESET)
         ;
 }
@@ -822,13 +917,24 @@ void USART1_IRQHandler(void)
 
         USART_ClearITPendingBit(USART1, USART_IT_RXNE);
     }
-#ifdef USART1_USE_SendInterrupt // 如果启用发送中断
-    // 发送中断（如果启用）
+
+    // 发送中断：只在USART1_SendArrayAsync写入数据后使能，写DR即清除TXE
     if (USART_GetITStatus(USART1, USART_IT_TXE) != RESET)
     {
-        // 发送中断处理代码（如果需要中断发送）
-        USART_ClearITPendingBit(USART1, USART_IT_TXE);
+        uint8_t data;
+
+        if (USART1_BufferRead(&tx_buf, &data))
+        {
+            USART_SendData(USART1, data);
+        }
+        else
+        {
+            // 缓冲区已空，关闭TXE中断，否则会一直进入中断
+            USART_ITConfig(USART1, USART_IT_TXE, DISABLE);
+            tx_busy = false;
+        }
     }
+#ifdef USART1_USE_SendInterrupt // 如果启用发送完成中断
 
     // 发送完成中断
     if (USART_GetITStatus(USART1, USART_IT_TC) != RESET)
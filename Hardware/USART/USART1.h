@@ -8,6 +8,7 @@
 #include <string.h>
 #include "OLED.h"
 #include "delay.h"
+#include "Format.h"
 
 // ================== 配置宏定义 ==================
 #define USART1_RX_BUFFER_SIZE     256     // 接收缓冲区大小
@@ -53,6 +54,10 @@ USART1_Status_t USART1_SendByteTimeout(uint8_t data, uint32_t timeout);
 USART1_Status_t USART1_SendArrayTimeout(const uint8_t *array, uint16_t length, uint32_t timeout);
 USART1_Status_t USART1_SendStringTimeout(const char *str, uint32_t timeout);
 
+// 非阻塞发送函数（TXE中断发送）
+USART1_Status_t USART1_SendArrayAsync(const uint8_t *array, uint16_t length);
+uint16_t USART1_GetTxBufferFree(void);
+
 // 接收函数
 USART1_Status_t USART1_ReceiveByte(uint8_t *data);
 USART1_Status_t USART1_ReceiveArray(uint8_t *array, uint16_t *length, uint32_t timeout);
@@ -82,12 +82,17 @@ void show_adc_display(void)
     OLED_ShowString(5, 40, "Percent:", OLED_6X8);
     OLED_ShowString(5, 50, "Status:", OLED_6X8);
 
+    // 数值字段，只重绘变化的字符
+    Widget_t adc_field, volt_field, percent_field, status_label;
+    Widget_InitNumber(&adc_field, 68, 20, OLED_6X8, NULL, "/4095", 0);
+    Widget_InitNumber(&volt_field, 60, 30, OLED_6X8, NULL, "V", 3); // 以mV为单位，显示3位小数
+    Widget_InitNumber(&percent_field, 60, 40, OLED_6X8, NULL, "%", 0);
+    Widget_InitLabel(&status_label, 60, 50, OLED_6X8);
+
     uint16_t last_adc_value = 0;
 
     while (1)
     {
-        Key_Status_Process(); // 调用按键状态处理
-
         // 检查退出条件
         if (Key_Get_Press_Event() == key_back)
         {
@@ -104,33 +109,22 @@ void show_adc_display(void)
         // 只有数值变化超过阈值时才更新显示，减少闪烁
         if (abs((int)adc_value - (int)last_adc_value) > 5)
         {
-            // 1. 清除旧的数值区域
-            OLED_ClearArea(68, 20, 60, 8); // ADC值区域
-            OLED_ClearArea(60, 30, 60, 8); // 电压值区域
-            OLED_ClearArea(60, 40, 60, 8); // 百分比区域
-
-            // 2. 显示ADC数值（小字体）
-            OLED_ShowNum(68, 20, adc_value, 4, OLED_6X8);
-            OLED_ShowString(95, 20, "/4095", OLED_6X8);
-
-            // 3. 显示电压值（保留3位小数）
-            float voltage = adc_value * 3.3f / 4095.0f;
-            OLED_ShowFloatNum(60, 30, voltage, 1, 3, OLED_6X8);
-            OLED_ShowString(100, 30, "V", OLED_6X8);
-
-            // 4. 显示百分比
-            uint8_t percent = adc_value * 100 / 4095;
-            OLED_ShowNum(60, 40, percent, 3, OLED_6X8);
-            OLED_ShowString(80, 40, "%", OLED_6X8);
-
-            // 5. 显示状态
-            OLED_ClearArea(60, 50, 60, 8);
+            // 1. 显示ADC数值（小字体）
+            Widget_SetNumber(&adc_field, adc_value);
+
+            // 2. 显示电压值（保留3位小数，整数运算，单位mV）
+            Widget_SetNumber(&volt_field, (int32_t)adc_value * 3300 / 4095);
+
+            // 3. 显示百分比
+            Widget_SetNumber(&percent_field, (int32_t)adc_value * 100 / 4095);
+
+            // 4. 显示状态
             if (adc_value < 1000)
-                OLED_ShowString(60, 50, "Low", OLED_6X8);
+                Widget_SetText(&status_label, "Low");
             else if (adc_value < 3000)
-                OLED_ShowString(60, 50, "Normal", OLED_6X8);
+                Widget_SetText(&status_label, "Normal");
             else
-                OLED_ShowString(60, 50, "High", OLED_6X8);
+                Widget_SetText(&status_label, "High");
 
             OLED_Update();
             last_adc_value = adc_value;
@@ -2,6 +2,7 @@
 #define __ADC_H
 #include "stm32f10x.h"
 #include "OLED.h"
+#include "Widget.h"
 #include "Delay.h"
 #include "Key_multi.h"
 #include <string.h>
@@ -5,13 +5,46 @@
 作    者：褚耀宗
 日    期：2025-12-26
 */
+// ========================================
+// 公共部分：DWT周期计数器（两套方案共用）
+// ========================================
+
+// CMSIS 1.x 的core_cm3.h未定义DWT，直接使用寄存器地址
+#define DWT_CTRL (*(volatile uint32_t *)0xE0001000)   // DWT控制寄存器
+#define DWT_CYCCNT (*(volatile uint32_t *)0xE0001004) // 周期计数寄存器
+#define DEM_CR (*(volatile uint32_t *)0xE000EDFC)     // 调试异常与监控控制寄存器
+#define DEM_CR_TRCENA (1 << 24)                       // 使能DWT/ITM
+#define DWT_CTRL_CYCCNTENA (1 << 0)                   // 使能周期计数
+
+/**
+ * @brief  使能DWT周期计数器
+ * @note   由Delay_Init调用
+ */
+static void Delay_CycleCounterInit(void)
+{
+  DEM_CR |= DEM_CR_TRCENA;
+  DWT_CYCCNT = 0;
+  DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+/**
+ * @brief  获取CPU周期计数
+ * @return 72MHz下的周期数，约59.6秒回绕一次
+ * @note   用于测量微秒级的时间间隔，两次读数相减即为经过的周期数（回绕后相减仍正确）
+ */
+uint32_t Delay_Get_Cycles(void)
+{
+  return DWT_CYCCNT;
+}
+
 // ========================================
 // 方案1：基于TIM2定时器的延时实现
 // ========================================
 
 #if defined(DELAY_USE_TIM2)
 
-static volatile uint32_t system_time = 0; // 系统时间（毫秒）
+static volatile uint32_t system_time = 0;             // 系统时间（毫秒）
+static Delay_CaptureCallback capture_callback = NULL; // TIM2通道1输入捕获回调
 
 /**
  * @brief  初始化TIM2为1ms定时器
@@ -23,6 +56,7 @@ void Delay_Init(void)
   SysTick->VAL = 0;                                // 清零计数器
   SysTick->LOAD = 72000 - 1;                       // 1ms中断，重装载值 = 72000 - 1
   SysTick->CTRL |= (1 << 2) | (1 << 1) | (1 << 0); // 选择HCLK，开启中断，使能定时器
+  Delay_CycleCounterInit();                        // 使能周期计数器，用于测量时间间隔
   // 定时器配置
   TIM_TimeBaseInitTypeDef TIM_InitStruct = {0};
   NVIC_InitTypeDef NVIC_InitStruct = {0};
@@ -30,9 +64,9 @@ void Delay_Init(void)
   // 1. 使能TIM2时钟（APB1总线）
   RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
   // 实际定时器2的时钟频率为72MHz，因此需要修改预分频值
-  //  原来的**配置为：36MHz / 3600 = 10KHz，计数10次 = 1ms
-  TIM_InitStruct.TIM_Period = 10 - 1;      // 自动重装载值：10
-  TIM_InitStruct.TIM_Prescaler = 7200 - 1; // 预分频值：7200（72MHz/7200=10KHz）
+  // 计数器以1us计数，1000次 = 1ms，通道1输入捕获时计数值即为毫秒内的微秒数
+  TIM_InitStruct.TIM_Period = 1000 - 1;  // 自动重装载值：1000
+  TIM_InitStruct.TIM_Prescaler = 72 - 1; // 预分频值：72（72MHz/72=1MHz）
   TIM_InitStruct.TIM_ClockDivision = TIM_CKD_DIV1;
   TIM_InitStruct.TIM_CounterMode = TIM_CounterMode_Up;
   TIM_InitStruct.TIM_RepetitionCounter = 0;
@@ -61,13 +95,48 @@ void Delay_Init(void)
  */
 void TIM2_IRQHandler(void)
 {
+  uint8_t updated = 0;
+  uint16_t capture;
+  uint32_t ms;
+
   if (TIM_GetITStatus(TIM2, TIM_IT_Update) != RESET)
   {
     system_time++; // 系统时间增加1ms
     TIM_ClearITPendingBit(TIM2, TIM_IT_Update);
+    updated = 1;
+  }
+
+  if (TIM_GetITStatus(TIM2, TIM_IT_CC1) != RESET)
+  {
+    capture = TIM_GetCapture1(TIM2); // 读取捕获值同时清除CC1标志
+    ms = system_time;
+    // 捕获和计数器溢出几乎同时发生时，按捕获值判断它属于溢出前还是溢出后的那一毫秒
+    if (updated && capture >= 500)
+    {
+      ms--; // 捕获在溢出之前，system_time已经在上面加过1
+    }
+    else if (!updated && capture < 500 && TIM_GetFlagStatus(TIM2, TIM_FLAG_Update) != RESET)
+    {
+      ms++; // 捕获在溢出之后，溢出中断还没来得及处理
+    }
+    if (capture_callback != NULL)
+    {
+      capture_callback(ms * 1000 + capture);
+    }
   }
 }
 
+/**
+ * @brief  设置TIM2通道1输入捕获回调
+ * @param  callback: 回调函数，参数为捕获时刻（微秒，约71.6分钟回绕一次），NULL表示不回调
+ * @note   回调在TIM2中断（最高优先级）中执行，必须尽快返回
+ *         通道1的输入捕获由使用者配置（TIM_ICInit、TIM_ITConfig(TIM2, TIM_IT_CC1, ENABLE)）
+ */
+void Delay_SetCaptureCallback(Delay_CaptureCallback callback)
+{
+  capture_callback = callback;
+}
+
 /**
  * @brief  获取当前系统时间
  * @return 当前时间（毫秒）
@@ -77,6 +146,29 @@ uint32_t Delay_Get_Ticks(void)
   return system_time;
 }
 
+/**
+ * @brief  获取当前系统时间（微秒）
+ * @return 与TIM2输入捕获时刻同一时间基准的微秒数（约71.6分钟回绕一次）
+ * @note   毫秒数和计数值分两次读取，期间发生溢出时重读；溢出中断未及处理（关中断时）按溢出标志补1ms
+ */
+uint32_t Delay_Get_Us(void)
+{
+  uint32_t ms;
+  uint16_t count;
+
+  do
+  {
+    ms = system_time;
+    count = TIM2->CNT;
+  } while (ms != system_time);
+
+  if (count < 500 && TIM_GetFlagStatus(TIM2, TIM_FLAG_Update) != RESET)
+  {
+    ms++; // 计数器已溢出，溢出中断还没来得及处理
+  }
+  return ms * 1000 + count;
+}
+
 /**
  * @brief  开始非阻塞延时
  * @param  timer: 延时器指针
@@ -203,6 +295,7 @@ void Delay_Init(void)
   SysTick->VAL = 0;                                // 清零计数器
   SysTick->LOAD = 72000 - 1;                       // 1ms中断，重装载值 = 72000 - 1
   SysTick->CTRL |= (1 << 2) | (1 << 1) | (1 << 0); // 选择HCLK，开启中断，使能定时器
+  Delay_CycleCounterInit();                        // 使能周期计数器，用于测量时间间隔
 }
 
 /**
@@ -38,6 +38,14 @@ bool Delay_Start(DelayTimer *timer, uint32_t ms); // 开始非阻塞延时
 bool Delay_Check(DelayTimer *timer);              // 检查非阻塞延时
 void Delay_Stop(DelayTimer *timer);
 uint32_t Delay_Get_Ticks(void); // 获取当前系统时间（毫秒）
+uint32_t Delay_Get_Cycles(void); // 获取CPU周期计数（72MHz），用于测量微秒级间隔
+
+#if defined(DELAY_USE_TIM2)
+// TIM2通道1输入捕获回调，参数为捕获时刻（微秒）
+typedef void (*Delay_CaptureCallback)(uint32_t time_us);
+void Delay_SetCaptureCallback(Delay_CaptureCallback callback);
+uint32_t Delay_Get_Us(void); // 获取当前系统时间（微秒），与输入捕获时刻可直接相减
+#endif
 
 /*基础阻塞延时*/
 void Delay_us(uint32_t nus);
@@ -0,0 +1,473 @@
+#include "Format.h"
+
+/*
+文件名：Format.c
+描    述：轻量格式化库实现文件
+          整数按位除法逆序生成，浮点数拆成整数和小数两部分后按整数输出，
+          不链接printf及其浮点格式化支持；不使用堆，调用者提供缓冲区
+*/
+
+#define FORMAT_FRAC_MAX   6   // 浮点数最多保留的小数位数
+
+static const uint32_t Format_Pow10[FORMAT_FRAC_MAX + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+// ================== 内部函数 ==================
+
+/**
+ * @brief 追加一个字符，不写结束符
+ * @note 缓冲区满时丢弃并置overflow标志，始终为结束符保留1字节
+ */
+static void Format_Put(Format_t *f, char c)
+{
+    if (f->len + 1 < f->size)
+    {
+        f->buf[f->len++] = c;
+    }
+    else
+    {
+        f->overflow = 1;
+    }
+}
+
+/**
+ * @brief 写结束符，每个公开函数返回前调用一次
+ */
+static void Format_End(Format_t *f)
+{
+    if (f->size)
+    {
+        f->buf[f->len] = '\0';
+    }
+}
+
+/**
+ * @brief 无符号整数转字符串，从end向前写入
+ * @param end 缓冲区末尾（不写入该位置）
+ * @return char* 第一个数字的位置，数值为0时输出"0"
+ */
+static char *Format_Utoa(char *end, uint32_t value, uint8_t base, uint8_t upper)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    do
+    {
+        *--end = digits[value % base];
+        value /= base;
+    } while (value);
+
+    return end;
+}
+
+/**
+ * @brief 按宽度和对齐方式输出一个字段
+ * @param sign 符号字符，0表示无符号
+ * @param body 字段内容（不含符号）
+ * @param n 字段内容长度
+ * @note 补0时符号在0之前，与printf一致
+ */
+static void Format_Field(Format_t *f, char sign, const char *body, uint8_t n, uint8_t width, uint8_t flags)
+{
+    uint8_t total = n + (sign ? 1 : 0);
+    uint8_t pad = width > total ? width - total : 0;
+
+    if (!(flags & (FORMAT_LEFT | FORMAT_ZERO)))
+    {
+        for (; pad; pad--) Format_Put(f, ' ');
+    }
+    if (sign)
+    {
+        Format_Put(f, sign);
+    }
+    if (!(flags & FORMAT_LEFT))
+    {
+        for (; pad; pad--) Format_Put(f, '0');
+    }
+    while (n--)
+    {
+        Format_Put(f, *body++);
+    }
+    for (; pad; pad--) Format_Put(f, ' ');
+}
+
+/**
+ * @brief 有符号整数字段
+ */
+static void Format_IntField(Format_t *f, int32_t value, uint8_t width, uint8_t flags)
+{
+    char tmp[10];
+    char *p;
+    char sign = 0;
+    uint32_t u = value;
+
+    if (value < 0)
+    {
+        sign = '-';
+        u = 0u - u;
+    }
+    else if (flags & FORMAT_PLUS)
+    {
+        sign = '+';
+    }
+    p = Format_Utoa(tmp + sizeof(tmp), u, 10, 0);
+    Format_Field(f, sign, p, tmp + sizeof(tmp) - p, width, flags);
+}
+
+/**
+ * @brief 浮点数字段
+ * @note 按float精度处理，整数部分超过32位时输出"ovf"
+ */
+static void Format_FloatField(Format_t *f, float value, uint8_t frac, uint8_t width, uint8_t flags)
+{
+    char tmp[18];
+    char *p = tmp + sizeof(tmp);
+    char sign = 0;
+    uint32_t ipart, fpart;
+    uint8_t i;
+
+    if (value != value)
+    {
+        Format_Field(f, 0, "nan", 3, width, flags & ~FORMAT_ZERO);
+        return;
+    }
+    if (value < 0)
+    {
+        sign = '-';
+        value = -value;
+    }
+    else if (flags & FORMAT_PLUS)
+    {
+        sign = '+';
+    }
+    if (value >= 4294967296.0f)
+    {
+        Format_Field(f, sign, "ovf", 3, width, flags & ~FORMAT_ZERO);
+        return;
+    }
+    if (frac > FORMAT_FRAC_MAX)
+    {
+        frac = FORMAT_FRAC_MAX;
+    }
+
+    // 拆分整数和小数，小数部分四舍五入，进位时加给整数
+    ipart = (uint32_t)value;
+    fpart = (uint32_t)((value - (float)ipart) * (float)Format_Pow10[frac] + 0.5f);
+    if (fpart >= Format_Pow10[frac])
+    {
+        fpart -= Format_Pow10[frac];
+        ipart++;
+    }
+
+    for (i = 0; i < frac; i++)
+    {
+        *--p = '0' + fpart % 10;
+        fpart /= 10;
+    }
+    if (frac)
+    {
+        *--p = '.';
+    }
+    p = Format_Utoa(p, ipart, 10, 0);
+    Format_Field(f, sign, p, tmp + sizeof(tmp) - p, width, flags);
+}
+
+// ================== 流式追加API ==================
+
+/**
+ * @brief 初始化输出状态
+ * @param buf 输出缓冲区
+ * @param size 缓冲区大小（含结束符）
+ */
+void Format_Init(Format_t *f, char *buf, uint16_t size)
+{
+    f->buf = buf;
+    f->size = size;
+    f->len = 0;
+    f->overflow = 0;
+    Format_End(f);
+}
+
+/**
+ * @brief 追加一个字符
+ */
+void Format_Char(Format_t *f, char c)
+{
+    Format_Put(f, c);
+    Format_End(f);
+}
+
+/**
+ * @brief 追加字符串
+ */
+void Format_Str(Format_t *f, const char *s)
+{
+    while (*s)
+    {
+        Format_Put(f, *s++);
+    }
+    Format_End(f);
+}
+
+/**
+ * @brief 追加无符号十进制整数
+ * @param width 最小宽度，0表示不限
+ * @param flags FORMAT_LEFT/FORMAT_ZERO/FORMAT_PLUS的组合
+ */
+void Format_Uint(Format_t *f, uint32_t value, uint8_t width, uint8_t flags)
+{
+    char tmp[10];
+    char *p = Format_Utoa(tmp + sizeof(tmp), value, 10, 0);
+
+    Format_Field(f, (flags & FORMAT_PLUS) ? '+' : 0, p, tmp + sizeof(tmp) - p, width, flags);
+    Format_End(f);
+}
+
+/**
+ * @brief 追加有符号十进制整数
+ * @param width 最小宽度（含符号），0表示不限
+ * @param flags FORMAT_LEFT/FORMAT_ZERO/FORMAT_PLUS的组合
+ */
+void Format_Int(Format_t *f, int32_t value, uint8_t width, uint8_t flags)
+{
+    Format_IntField(f, value, width, flags);
+    Format_End(f);
+}
+
+/**
+ * @brief 追加十六进制整数，不足宽度时左侧补0
+ * @param upper 1使用大写字母，0使用小写字母
+ */
+void Format_Hex(Format_t *f, uint32_t value, uint8_t width, uint8_t upper)
+{
+    char tmp[8];
+    char *p = Format_Utoa(tmp + sizeof(tmp), value, 16, upper);
+
+    Format_Field(f, 0, p, tmp + sizeof(tmp) - p, width, FORMAT_ZERO);
+    Format_End(f);
+}
+
+/**
+ * @brief 追加定点数
+ * @param value 放大10^frac倍后的整数值
+ * @param frac 小数位数
+ * @note 例如：Format_Fixed(f, -1234, 2)追加"-12.34"，全程整数运算
+ */
+void Format_Fixed(Format_t *f, int32_t value, uint8_t frac)
+{
+    char tmp[22];
+    char *p = tmp + sizeof(tmp);
+    uint32_t u = value;
+    uint8_t i;
+
+    if (value < 0)
+    {
+        u = 0u - u;
+    }
+    if (frac > 10)
+    {
+        frac = 10;
+    }
+    for (i = 0; i < frac; i++)
+    {
+        *--p = '0' + u % 10;
+        u /= 10;
+    }
+    if (frac)
+    {
+        *--p = '.';
+    }
+    p = Format_Utoa(p, u, 10, 0);
+    Format_Field(f, value < 0 ? '-' : 0, p, tmp + sizeof(tmp) - p, 0, 0);
+    Format_End(f);
+}
+
+/**
+ * @brief 追加浮点数
+ * @param frac 小数位数，最大为6
+ * @note 不依赖printf浮点库，按float精度四舍五入
+ */
+void Format_Float(Format_t *f, float value, uint8_t frac)
+{
+    Format_FloatField(f, value, frac, 0, 0);
+    Format_End(f);
+}
+
+/**
+ * @brief 按格式字符串追加（printf子集）
+ * @note 支持：标志 - 0 +，宽度（数字或*），精度 .N 或 .*（仅用于%f和%s），
+ *       长度 l h（忽略），转换 d i u x X c s f %
+ *       %f的精度默认6位，最大6位
+ */
+void Format_VPrintf(Format_t *f, const char *fmt, va_list args)
+{
+    char tmp[10];
+    char *p;
+    const char *s;
+    uint8_t flags, width, islong;
+    int16_t prec;
+    int32_t iv;
+    uint32_t uv;
+    uint16_t n;
+
+    while (*fmt)
+    {
+        if (*fmt != '%')
+        {
+            Format_Put(f, *fmt++);
+            continue;
+        }
+        fmt++;
+
+        // 标志
+        flags = 0;
+        for (;; fmt++)
+        {
+            if (*fmt == '-') flags |= FORMAT_LEFT;
+            else if (*fmt == '0') flags |= FORMAT_ZERO;
+            else if (*fmt == '+') flags |= FORMAT_PLUS;
+            else break;
+        }
+
+        // 宽度
+        width = 0;
+        if (*fmt == '*')
+        {
+            iv = va_arg(args, int);
+            if (iv < 0)
+            {
+                flags |= FORMAT_LEFT;
+                iv = -iv;
+            }
+            width = iv > 255 ? 255 : iv;
+            fmt++;
+        }
+        else
+        {
+            for (; *fmt >= '0' && *fmt <= '9'; fmt++)
+            {
+                width = width * 10 + (*fmt - '0');
+            }
+        }
+
+        // 精度
+        prec = -1;
+        if (*fmt == '.')
+        {
+            fmt++;
+            prec = 0;
+            if (*fmt == '*')
+            {
+                prec = va_arg(args, int);
+                fmt++;
+            }
+            else
+            {
+                for (; *fmt >= '0' && *fmt <= '9'; fmt++)
+                {
+                    prec = prec * 10 + (*fmt - '0');
+                }
+            }
+        }
+
+        // 长度，32位平台上int与long等宽，仅为取参类型区分
+        islong = 0;
+        for (; *fmt == 'l' || *fmt == 'h'; fmt++)
+        {
+            if (*fmt == 'l') islong = 1;
+        }
+
+        switch (*fmt)
+        {
+        case 'd':
+        case 'i':
+            iv = islong ? (int32_t)va_arg(args, long) : (int32_t)va_arg(args, int);
+            Format_IntField(f, iv, width, flags);
+            break;
+
+        case 'u':
+        case 'x':
+        case 'X':
+            uv = islong ? (uint32_t)va_arg(args, unsigned long) : (uint32_t)va_arg(args, unsigned int);
+            p = Format_Utoa(tmp + sizeof(tmp), uv, *fmt == 'u' ? 10 : 16, *fmt == 'X');
+            Format_Field(f, 0, p, tmp + sizeof(tmp) - p, width, flags);
+            break;
+
+        case 'c':
+            tmp[0] = (char)va_arg(args, int);
+            Format_Field(f, 0, tmp, 1, width, flags & ~FORMAT_ZERO);
+            break;
+
+        case 's':
+            s = va_arg(args, const char *);
+            if (s == NULL)
+            {
+                s = "(null)";
+            }
+            for (n = 0; s[n] && (prec < 0 || n < prec) && n < 255; n++);
+            Format_Field(f, 0, s, n, width, flags & ~FORMAT_ZERO);
+            break;
+
+        case 'f':
+            Format_FloatField(f, (float)va_arg(args, double), prec < 0 ? 6 : prec, width, flags);
+            break;
+
+        case '%':
+            Format_Put(f, '%');
+            break;
+
+        case '\0':
+            // 格式字符串以单独的%结尾
+            Format_End(f);
+            return;
+
+        default:
+            // 不支持的转换原样输出
+            Format_Put(f, '%');
+            Format_Put(f, *fmt);
+            break;
+        }
+        fmt++;
+    }
+    Format_End(f);
+}
+
+/**
+ * @brief 按格式字符串追加（可变参数版本）
+ */
+void Format_Printf(Format_t *f, const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    Format_VPrintf(f, fmt, args);
+    va_end(args);
+}
+
+// ================== 一次性格式化 ==================
+
+/**
+ * @brief 格式化到缓冲区（vsnprintf的替代）
+ * @return uint16_t 写入长度（不含结束符），截断时为截断后的长度
+ */
+uint16_t Format_VSprintf(char *buf, uint16_t size, const char *fmt, va_list args)
+{
+    Format_t f;
+
+    Format_Init(&f, buf, size);
+    Format_VPrintf(&f, fmt, args);
+    return f.len;
+}
+
+/**
+ * @brief 格式化到缓冲区（snprintf的替代）
+ * @return uint16_t 写入长度（不含结束符），截断时为截断后的长度
+ */
+uint16_t Format_Sprintf(char *buf, uint16_t size, const char *fmt, ...)
+{
+    va_list args;
+    uint16_t len;
+
+    va_start(args, fmt);
+    len = Format_VSprintf(buf, size, fmt, args);
+    va_end(args);
+    return len;
+}
@@ -0,0 +1,42 @@
+#ifndef __FORMAT_H
+#define __FORMAT_H
+#include "stm32f10x.h"
+#include <stdarg.h>
+#include <stddef.h>
+
+/*
+文件名：Format.h
+描    述：轻量格式化库头文件，替代热路径上的sprintf/vsnprintf
+          不使用堆、不依赖printf浮点库，输出始终以'\0'结尾，超长时安全截断
+*/
+
+// 格式化标志（Format_Printf内部及Format_Uint/Format_Int的flags参数）
+#define FORMAT_LEFT   0x01  // 左对齐，右侧补空格
+#define FORMAT_ZERO   0x02  // 左侧补0（左对齐时无效）
+#define FORMAT_PLUS   0x04  // 正数也显示+号
+
+// 流式追加的输出状态，栈上定义即可，无需释放
+typedef struct {
+    char *buf;        // 输出缓冲区
+    uint16_t size;    // 缓冲区大小（含结束符）
+    uint16_t len;     // 已写入长度（不含结束符）
+    uint8_t overflow; // 发生过截断时置1
+} Format_t;
+
+// 流式追加API
+void Format_Init(Format_t *f, char *buf, uint16_t size);
+void Format_Char(Format_t *f, char c);
+void Format_Str(Format_t *f, const char *s);
+void Format_Uint(Format_t *f, uint32_t value, uint8_t width, uint8_t flags);
+void Format_Int(Format_t *f, int32_t value, uint8_t width, uint8_t flags);
+void Format_Hex(Format_t *f, uint32_t value, uint8_t width, uint8_t upper);
+void Format_Fixed(Format_t *f, int32_t value, uint8_t frac);
+void Format_Float(Format_t *f, float value, uint8_t frac);
+void Format_VPrintf(Format_t *f, const char *fmt, va_list args);
+void Format_Printf(Format_t *f, const char *fmt, ...);
+
+// 一次性格式化，snprintf的替代，返回写入长度（不含结束符）
+uint16_t Format_VSprintf(char *buf, uint16_t size, const char *fmt, va_list args);
+uint16_t Format_Sprintf(char *buf, uint16_t size, const char *fmt, ...);
+
+#endif
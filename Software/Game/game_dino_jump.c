@@ -2,8 +2,9 @@
 #include "OLED.h"
 #include "stm32f10x.h" // Device header
 #include "Delay.h"
-/* 定时器周期设置：30ms */
-#define TIMER_PERIOD 30000 // 1MHz 定时器频率下，30ms = 30000
+#include "Key_multi.h"
+/* 游戏刷新周期：30ms */
+#define FRAME_PERIOD_MS 30
 
 /* ==== 游戏参数 ==== */
 #define SCREEN_WIDTH 128 // 屏幕宽度
@@ -83,7 +84,7 @@ void Game_Jump(void)
     }
 }
 
-/* ==== 游戏刷新（定时器调用，约30ms一次） ==== */
+/* ==== 游戏刷新（主循环调用，约30ms一次） ==== */
 void Game_Update(void)
 {
     if (gameState != GAME_RUNNING)
@@ -159,7 +160,15 @@ void Game_Update(void)
         OLED_ShowString(28, 17, "GAME OVER", OLED_8X16);
     }
 
-    OLED_Update();
+    /* 游戏结束画面之后不再刷新，需完整发送；其余帧交换显存后台发送，上一帧未发完时合并到下一帧 */
+    if (gameState == GAME_OVER)
+    {
+        OLED_Update();
+    }
+    else
+    {
+        OLED_SwapAndFlush();
+    }
 }
 
 /* ==== 获取分数 ==== */
@@ -169,54 +178,40 @@ uint32_t Game_GetScore(void)
 }
 /* ==== 游戏结束 ==== */
 
-void TIM3_Config(void)
-{
-    TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
-    NVIC_InitTypeDef NVIC_InitStructure;
-    RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM3, ENABLE); // 使能TIM3时钟
-    TIM_TimeBaseStructure.TIM_Period = TIMER_PERIOD - 1;
-    TIM_TimeBaseStructure.TIM_Prescaler = 72 - 1; // 72MHz/72 = 1MHz
-    TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
-    TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
-    TIM_TimeBaseInit(TIM3, &TIM_TimeBaseStructure);
-
-    TIM_ITConfig(TIM3, TIM_IT_Update, ENABLE);
-    TIM_Cmd(TIM3, ENABLE);
-
-    NVIC_InitStructure.NVIC_IRQChannel = TIM3_IRQn;
-    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
-    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
-    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
-    NVIC_Init(&NVIC_InitStructure);
-}
-/* ==== TIM3中断：每30ms刷新一次游戏 ==== */
-void TIM3_IRQHandler(void)
-{
-    if (TIM_GetITStatus(TIM3, TIM_IT_Update) != RESET)
-    {
-        TIM_ClearITPendingBit(TIM3, TIM_IT_Update);
-        Game_Update(); // 刷新游戏
-    }
-}
-uint8_t inited = 0; // 游戏初始化标志，只在第一次调用时为0
+static DelayTimer frameTimer; // 游戏刷新定时器
 
-void Game_Start_t(void)
+/* 处理按键事件并刷新游戏，返回1表示按下返回键退出 */
+uint8_t Game_Start_t(void)
 {
-    if (!inited)
+    Key_Event_t event;
+
+    // 游戏逻辑循环部分
+    while (Key_Get_Event(&event))
     {
-        TIM3_Config(); // 初始化一次
-        inited = 1;    // 标记已经初始化
+        if (event.type != KEY_EVENT_PRESS)
+        {
+            continue;
+        }
+        if (event.key == key_enter)
+        {
+            Game_Jump();
+        }
+        else if (event.key == key_back)
+        {
+            return 1;
+        }
     }
-    // 游戏逻辑循环部分
-    if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2) == 0)
+    /* 到达刷新周期时在主循环中刷新游戏，绘制下一帧时上一帧在后台发送 */
+    if (Delay_Check(&frameTimer))
     {
-        Game_Jump();
+        Delay_Start(&frameTimer, FRAME_PERIOD_MS);
+        Game_Update(); // 刷新游戏
     }
+    return 0;
 }
 void Game_Stop(void)
 {
-    TIM_Cmd(TIM3, DISABLE); // 关闭定时器
-    inited = 0;             // 标记未初始化
+    Delay_Stop(&frameTimer); // 停止刷新定时器
     /*重置游戏状态*/
     gameState = GAME_READY;
     dinoY = GROUND_Y - DINO_HEIGHT;
@@ -233,13 +228,13 @@ void Game_Start(void)
     // OLED_ShowImage(30, 30, DINO_WIDTH, DINO_HEIGHT, DinoRun1);//测试
     // OLED_Update();
   Game_Init(); // 初始化游戏
+  Key_Clear_Events(); // 丢弃进入游戏前的按键事件
+  Delay_Start(&frameTimer, FRAME_PERIOD_MS);
   while (1)
   {
-    Game_Start_t(); // 开始游戏
-    if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10) == 0)
+    if (Game_Start_t()) // 开始游戏
     {
-      Game_Stop(); // 停止游戏,并清理资源
-      while (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10) == 0); // 等待按键释放
+      Game_Stop(); // 停止游戏,并清理资源（释放事件留在队列中，回到菜单后被忽略）
       break;
     }
   }
@@ -2,6 +2,7 @@
 #include "OLED.h"
 #include "stm32f10x.h"
 #include "Delay.h"
+#include "Key_multi.h"
 #include <stdlib.h>
 
 /* 游戏参数 */
@@ -176,7 +177,12 @@ void Flappy_Update(void)
         OLED_Printf(20, 40, OLED_6X8, "Press PA2 to Restart");
     }
     
-    OLED_Update();
+    /* 游戏结束画面之后不再刷新，需完整发送；其余帧交换显存后台发送，上一帧未发完时合并到下一帧 */
+    if (gameState == FLAPPY_OVER) {
+        OLED_Update();
+    } else {
+        OLED_SwapAndFlush();
+    }
 }
 
 /* 小鸟跳跃 */
@@ -207,6 +213,7 @@ uint32_t Flappy_GetScore(void)
 void Flappy_Start(void)
 {
     Flappy_Init();
+    Key_Clear_Events(); /* 丢弃进入游戏前的按键事件 */
     
     /* 按键功能说明：
      * PA2: 跳跃/开始游戏/重新开始
@@ -214,26 +221,13 @@ void Flappy_Start(void)
      */
     
     while (1) {
-        /* 处理按键输入 */
-        if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2) == 0) {
-            Flappy_Jump();
-            Delay_ms(100); /* 防抖 */
-        } else if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10) == 0) {
-            /* 返回键退出游戏 */
+        /* 处理按键事件，返回键退出游戏 */
+        if (Flappy_HandleInput()) {
             break;
         }
         
         Flappy_Update();
         
-        if (gameState == FLAPPY_OVER) {
-            Delay_ms(100);
-            if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2) == 0) {
-                /* 按PA2重新开始 */
-                Flappy_Init();
-                Delay_ms(200);
-            }
-        }
-        
         Delay_ms(10); /* 控制刷新率 */
     }
 }
@@ -246,10 +240,20 @@ void Flappy_Stop(void)
     OLED_Update();
 }
 
-/* 处理按键输入 */
-void Flappy_HandleInput(void)
+/* 处理按键输入，返回1表示按下返回键退出游戏 */
+uint8_t Flappy_HandleInput(void)
 {
-    if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2) == 0) {
-        Flappy_Jump();
+    Key_Event_t event;
+
+    while (Key_Get_Event(&event)) {
+        if (event.type != KEY_EVENT_PRESS) {
+            continue;
+        }
+        if (event.key == key_enter) {
+            Flappy_Jump(); /* 跳跃/开始游戏/重新开始 */
+        } else if (event.key == key_back) {
+            return 1;
+        }
     }
+    return 0;
 }
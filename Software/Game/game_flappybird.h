@@ -30,7 +30,7 @@ void Flappy_Start(void);
 void Flappy_Stop(void);
 
 /* 处理按键输入 */
-void Flappy_HandleInput(void);
+uint8_t Flappy_HandleInput(void);
 
 #endif
 
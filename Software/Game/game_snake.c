@@ -2,6 +2,7 @@
 #include "OLED.h"
 #include "stm32f10x.h"
 #include "Delay.h"
+#include "Key_multi.h"
 
 /* 游戏参数 */
 #define SCREEN_WIDTH 128
@@ -11,6 +12,7 @@
 #define GRID_HEIGHT (SCREEN_HEIGHT / GRID_SIZE)
 
 #define MAX_SNAKE_LENGTH 64
+#define DOUBLE_CLICK_MS 300 /* 双击最大间隔 */
 
 /* 游戏变量 */
 static SnakeGameState_t gameState;
@@ -25,10 +27,8 @@ static uint32_t score;
 static uint16_t frameCount;
 
 /* 双击检测变量 */
-static uint32_t rightPressTimeCounter = 0;
-static uint8_t rightPressCount = 0;
-static uint8_t rightButtonPressed = 0;
-static uint8_t rightButtonLastState = 1;
+static uint8_t backPressed = 0;        /* 已按下过一次返回键 */
+static uint32_t backPressTime = 0;     /* 上一次按下返回键的时间戳 */
 
 /* 初始化贪吃蛇游戏 */
 void Snake_Init(void)
@@ -49,10 +49,7 @@ void Snake_Init(void)
     frameCount = 0;
     
     /* 重置双击检测变量 */
-    rightPressTimeCounter = 0;
-    rightPressCount = 0;
-    rightButtonPressed = 0;
-    rightButtonLastState = 1;
+    backPressed = 0;
     
     /* 生成第一个食物 */
     foodX = rand() % GRID_WIDTH;
@@ -184,7 +181,12 @@ void Snake_Update(void)
         OLED_ShowString(28, 17, "GAME OVER", OLED_8X16);
     }
     
-    OLED_Update();
+    /* 游戏结束画面之后不再刷新，需完整发送；其余帧交换显存后台发送，上一帧未发完时合并到下一帧 */
+    if (gameState == SNAKE_OVER) {
+        OLED_Update();
+    } else {
+        OLED_SwapAndFlush();
+    }
 }
 
 /* 改变蛇的方向 */
@@ -223,93 +225,25 @@ uint32_t Snake_GetScore(void)
     return score;
 }
 
-/* 处理右键双击检测 */
-static uint8_t CheckRightButtonDoubleClick(void)
-{
-    uint8_t currentState = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10);
-    
-    /* 检测按键按下 */
-    if (currentState == 0 && rightButtonLastState == 1) {
-        Delay_ms(20); // 消抖
-        currentState = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10);
-        if (currentState == 0) {
-            // 按键确实被按下
-            if (rightPressCount == 0) {
-                // 第一次按下
-                rightPressCount = 1;
-                rightPressTimeCounter = 0; // 开始计时
-            } else if (rightPressCount == 1 && rightPressTimeCounter < 30) {
-                // 第二次按下且在300ms内（10ms*30=300ms）
-                rightPressCount = 0;
-                rightPressTimeCounter = 0;
-                return 1; // 双击成功
-            }
-        }
-    }
-    
-    /* 更新按键状态 */
-    rightButtonLastState = currentState;
-    
-    /* 更新时间计数器 */
-    if (rightPressCount == 1) {
-        rightPressTimeCounter++;
-        if (rightPressTimeCounter >= 30) {
-            // 超过300ms，重置计数
-            rightPressCount = 0;
-            rightPressTimeCounter = 0;
-        }
-    }
-    
-    return 0;
-}
-
 /* 开始游戏 */
 void Snake_Start(void)
 {
     Snake_Init();
+    Key_Clear_Events(); /* 丢弃进入游戏前的按键事件 */
     uint8_t exitGame = 0;
     
     /* 简单的按键处理循环 */
     while (!exitGame) {
-        /* 处理右键双击检测（每10ms检测一次） */
-        if (CheckRightButtonDoubleClick()) {
+        /* 处理按键事件，双击返回键退出 */
+        if (Snake_HandleInput()) {
             exitGame = 1;
             break;
         }
         
-        /* 处理方向按键输入 */
-        if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_0) == 0) {
-            /* 上键 */
-            Snake_ChangeDirection(DIR_UP);
-            Delay_ms(200);
-        } else if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_1) == 0) {
-            /* 下键 */
-            Snake_ChangeDirection(DIR_DOWN);
-            Delay_ms(200);
-        } else if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10) == 0) {
-            /* 左键 */
-            Snake_ChangeDirection(DIR_LEFT);
-            Delay_ms(200);
-        } else if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2) == 0) {
-            /* 右键（单次按下改变方向） */
-            Snake_ChangeDirection(DIR_RIGHT);
-            Delay_ms(200);
-        }
-        
         /* 更新游戏 */
         Snake_Update();
         
-        /* 游戏结束后等待按键 */
-        if (gameState == SNAKE_OVER) {
-            Delay_ms(100);
-            if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2) == 0) {
-                /* 按右键重新开始 */
-                Snake_Init();
-                Delay_ms(200);
-            }
-        }
-        
-        Delay_ms(10); /* 控制刷新率，也用于双击计时 */
+        Delay_ms(10); /* 控制刷新率 */
     }
     
     /* 退出游戏时清屏 */
@@ -324,17 +258,38 @@ void Snake_Stop(void)
     OLED_Update();
 }
 
-/* 处理按键输入 */
-void Snake_HandleInput(void)
+/* 处理按键输入，返回1表示双击返回键退出游戏 */
+uint8_t Snake_HandleInput(void)
 {
-    if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_0) == 0) {
-        Snake_ChangeDirection(DIR_UP);
-    } else if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_1) == 0) {
-        Snake_ChangeDirection(DIR_DOWN);
-    } else if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10) == 0) {
-        Snake_ChangeDirection(DIR_LEFT);
-    } else if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2) == 0) {
-        Snake_ChangeDirection(DIR_RIGHT);
+    Key_Event_t event;
+
+    while (Key_Get_Event(&event)) {
+        if (event.type != KEY_EVENT_PRESS) {
+            continue;
+        }
+        switch (event.key) {
+            case key_up:
+                Snake_ChangeDirection(DIR_UP);
+                break;
+            case key_down:
+                Snake_ChangeDirection(DIR_DOWN);
+                break;
+            case key_back:
+                /* 按事件时间戳判断双击，与主循环速度无关 */
+                if (backPressed && event.time - backPressTime < DOUBLE_CLICK_MS) {
+                    backPressed = 0;
+                    return 1;
+                }
+                backPressed = 1;
+                backPressTime = event.time;
+                Snake_ChangeDirection(DIR_LEFT);
+                break;
+            case key_enter:
+                Snake_ChangeDirection(DIR_RIGHT); /* 游戏结束后按任意方向键重新开始 */
+                break;
+            default:
+                break;
+        }
     }
+    return 0;
 }
-
@@ -38,7 +38,7 @@ void Snake_Start(void);
 void Snake_Stop(void);
 
 /* 处理按键输入 */
-void Snake_HandleInput(void);
+uint8_t Snake_HandleInput(void);
 
 #endif
 
@@ -2,6 +2,7 @@
 #include "OLED.h"
 #include "stm32f10x.h"
 #include "Delay.h"
+#include "Key_multi.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -19,7 +20,7 @@
 #define TETRIS_HEIGHT ((GAME_AREA_HEIGHT - 4) / CELL_SIZE) /* 动态计算行数：约15行 */
 #define FALL_SPEED 20               /* 正常下落速度帧数 */
 #define FAST_FALL_SPEED 5           /* 加速下落速度帧数 */
-#define DOUBLE_CLICK_MAX_TIME 10    /* 双击最大时间（50ms*10=500ms） */
+#define DOUBLE_CLICK_MS 500         /* 双击最大间隔 */
 
 /* 方块形状定义 */
 static const uint8_t SHAPES[7][4][4] = {
@@ -86,9 +87,8 @@ static uint8_t nextBlockType;
 static uint8_t isFastFall = 0;       /* 是否加速下落 */
 
 /* 双击检测变量 */
-static uint8_t pb10LastState = 1;    /* PB10上次状态 */
-static uint8_t pb10PressCount = 0;   /* PB10按键计数 */
-static uint8_t pb10Timer = 0;        /* PB10双击计时器 */
+static uint8_t pb10Pressed = 0;      /* 已按下过一次PB10 */
+static uint32_t pb10PressTime = 0;   /* 上一次按下PB10的时间戳 */
 
 /* 初始化游戏 */
 void Tetris_Init(void)
@@ -100,9 +100,7 @@ void Tetris_Init(void)
     isFastFall = 0;
     
     /* 重置双击检测变量 */
-    pb10LastState = 1;
-    pb10PressCount = 0;
-    pb10Timer = 0;
+    pb10Pressed = 0;
     
     /* 生成第一个方块 */
     currentBlock = rand() % 7;
@@ -227,46 +225,6 @@ static void NewBlock(void)
     }
 }
 
-/* 检查PB10双击 */
-static uint8_t CheckPB10DoubleClick(void)
-{
-    uint8_t currentState = GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10);
-    uint8_t result = 0;
-    
-    /* 检测按键按下 */
-    if (currentState == 0 && pb10LastState == 1) {
-        Delay_ms(20); // 消抖
-        if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10) == 0) {
-            // 按键确实被按下
-            if (pb10PressCount == 0) {
-                // 第一次按下
-                pb10PressCount = 1;
-                pb10Timer = 0;
-            } else if (pb10PressCount == 1 && pb10Timer <= DOUBLE_CLICK_MAX_TIME) {
-                // 第二次按下且在500ms内
-                pb10PressCount = 0;
-                pb10Timer = 0;
-                result = 1; // 双击成功
-            }
-        }
-    }
-    
-    /* 更新按键状态 */
-    pb10LastState = currentState;
-    
-    /* 更新时间计数器 */
-    if (pb10PressCount == 1) {
-        pb10Timer++;
-        if (pb10Timer > DOUBLE_CLICK_MAX_TIME) {
-            // 超过500ms，重置计数
-            pb10PressCount = 0;
-            pb10Timer = 0;
-        }
-    }
-    
-    return result;
-}
-
 /* 游戏刷新 */
 void Tetris_Update(void)
 {
@@ -371,7 +329,12 @@ void Tetris_Update(void)
         OLED_ShowString(SCREEN_WIDTH/2-48, SCREEN_HEIGHT/2+10, "PA2 Restart", OLED_6X8);
     }
     
-    OLED_Update();
+    /* 游戏结束画面之后不再刷新，需完整发送；其余帧交换显存后台发送，上一帧未发完时合并到下一帧 */
+    if (gameState == TETRIS_OVER) {
+        OLED_Update();
+    } else {
+        OLED_SwapAndFlush();
+    }
 }
 
 /* 移动控制 */
@@ -455,6 +418,7 @@ uint32_t Tetris_GetScore(void)
 void Tetris_Start(void)
 {
     Tetris_Init();
+    Key_Clear_Events(); /* 丢弃进入游戏前的按键事件 */
     
     /* 按键功能说明：
      * PB1: 旋转方块
@@ -467,44 +431,15 @@ void Tetris_Start(void)
     uint8_t exitGame = 0;
     
     while (!exitGame) {
-        /* 检查PB10双击退出 */
-        if (CheckPB10DoubleClick()) {
+        /* 处理按键事件，PB10双击退出 */
+        if (Tetris_HandleInput()) {
             exitGame = 1;
             break;
         }
         
-        /* 处理按键输入 */
-        if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_1) == 0) {
-            /* PB1 - 旋转方块 */
-            Tetris_Rotate();
-            Delay_ms(200);
-        } else if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_0) == 0) {
-            /* PB0 - 左移 */
-            Tetris_MoveLeft();
-            Delay_ms(200);
-        } else if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10) == 0) {
-            /* PB10 - 右移（单次按下） */
-            Tetris_MoveRight();
-            Delay_ms(200);
-        } else if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2) == 0) {
-            /* PA2 - 开始游戏/重新开始/加速下落 */
-            Tetris_Accelerate();
-            Delay_ms(200);
-        }
-        
         Tetris_Update();
         
-        if (gameState == TETRIS_OVER) {
-            Delay_ms(100);
-            /* 游戏结束后，PA2可以重新开始 */
-            if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2) == 0) {
-                Tetris_Init();
-                gameState = TETRIS_RUNNING;
-                Delay_ms(200);
-            }
-        }
-        
-        Delay_ms(50); /* 控制主循环速度，也用于双击计时 */
+        Delay_ms(50); /* 控制主循环速度 */
     }
     
     /* 退出游戏时清屏 */
@@ -520,17 +455,45 @@ void Tetris_Stop(void)
     OLED_Update();
 }
 
-/* 处理按键输入 */
-void Tetris_HandleInput(void)
+/* 处理按键输入，返回1表示PB10双击退出游戏 */
+uint8_t Tetris_HandleInput(void)
 {
-    if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_1) == 0) {
-        Tetris_Rotate();
-    } else if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_0) == 0) {
-        Tetris_MoveLeft();
-    } else if (GPIO_ReadInputDataBit(GPIOB, GPIO_Pin_10) == 0) {
-        Tetris_MoveRight();
-    } else if (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2) == 0) {
-        Tetris_Accelerate();
+    Key_Event_t event;
+
+    while (Key_Get_Event(&event)) {
+        if (event.type != KEY_EVENT_PRESS) {
+            continue;
+        }
+        switch (event.key) {
+            case key_down:
+                Tetris_Rotate();
+                break;
+            case key_up:
+                Tetris_MoveLeft();
+                break;
+            case key_back:
+                /* 按事件时间戳判断双击，与主循环速度无关 */
+                if (pb10Pressed && event.time - pb10PressTime <= DOUBLE_CLICK_MS) {
+                    pb10Pressed = 0;
+                    return 1;
+                }
+                pb10Pressed = 1;
+                pb10PressTime = event.time;
+                Tetris_MoveRight();
+                break;
+            case key_enter:
+                if (gameState == TETRIS_OVER) {
+                    /* 游戏结束后，PA2可以重新开始 */
+                    Tetris_Init();
+                    gameState = TETRIS_RUNNING;
+                } else {
+                    Tetris_Accelerate();
+                }
+                break;
+            default:
+                break;
+        }
     }
+    return 0;
 }
 
@@ -49,7 +49,7 @@ void Tetris_Start(void);
 void Tetris_Stop(void);
 
 /* 处理按键输入 */
-void Tetris_HandleInput(void);
+uint8_t Tetris_HandleInput(void);
 
 #endif
 
@@ -1,4 +1,5 @@
 #include "Menu.h"
+#include "Screen.h"
 /*
  *菜单控制结构体
     * 文件名：Menu.c
@@ -32,143 +33,130 @@ MenuCtrl_t MenuCtrl;
  * 参    数：root_menu - 根菜单指针
  * 返 回 值：无
  */
-void Menu_Init(MenuItem_t *root_menu)
+void Menu_Init(const MenuItem_t *root_menu)
 {
     MenuCtrl.current_menu = root_menu;
     MenuCtrl.current_item = root_menu;
     MenuCtrl.cursor_pos = 0;
     MenuCtrl.scroll_offset = 0;
     MenuCtrl.need_refresh = 1;
+    MenuCtrl.redraw = 0;
+    MenuCtrl.list = NULL;
 }
 
 /**
- * 函    数：创建菜单项
- * 参    数：name - 菜单项名称
- *          type - 菜单项类型
- * 返 回 值：菜单项指针
+ * 函    数：获取上一个同级菜单项
+ * 参    数：item - 菜单项指针
+ * 返 回 值：上一个同级菜单项，已是第一项时返回NULL
+ * 说    明：同级菜单项在菜单树数组中连续存放，直接取相邻元素
  */
-MenuItem_t* Menu_CreateItem(char *name, MenuItemType_t type)
+static const MenuItem_t *Menu_PrevItem(const MenuItem_t *item)
 {
-    static MenuItem_t items[50];  // 静态分配菜单项数组（可根据需要调整大小）
-    static uint8_t item_index = 0; // 菜单项索引
-    
-    if(item_index >= 50) return NULL;
-    
-    MenuItem_t *item = &items[item_index++];
-    memset(item, 0, sizeof(MenuItem_t));
-    
-    item->name = name;
-    item->type = type;
-    item->parent = NULL;
-    item->child = NULL;
-    item->next = NULL;
-    item->prev = NULL;
-    item->func = NULL;
-    item->value = NULL;
-    item->min = 0;
-    item->max = 100;
-    item->toggle = NULL;
-    
-    return item;
+    return item->index > 0 ? item - 1 : NULL;
 }
 
 /**
- * 函    数：添加菜单项到父菜单
- * 参    数：parent - 父菜单指针
- *          item - 要添加的菜单项
- * 返 回 值：无
+ * 函    数：获取下一个同级菜单项
+ * 参    数：item - 菜单项指针
+ * 返 回 值：下一个同级菜单项，已是最后一项时返回NULL
  */
-void Menu_AddItem(MenuItem_t *parent, MenuItem_t *item)
+static const MenuItem_t *Menu_NextItem(const MenuItem_t *item)
 {
-    if(parent == NULL || item == NULL) return;
-    
-    item->parent = parent;
-    
-    if(parent->child == NULL)
+    if(item->parent == NULL || item->index + 1 >= item->parent->child_count)
     {
-        // 第一个子菜单项
-        parent->child = item;
-        item->prev = NULL;
-        item->next = NULL;
-    }
-    else
-    {
-        // 添加到子菜单列表末尾
-        MenuItem_t *last = parent->child;
-        while(last->next != NULL)
-        {
-            last = last->next;
-        }
-        last->next = item;
-        item->prev = last;
-        item->next = NULL;
+        return NULL;
     }
+    return item + 1;
 }
 
 /**
- * 函    数：设置菜单项功能回调
- * 参    数：item - 菜单项指针
- *          func - 回调函数指针
+ * 函    数：调整虚拟列表滚动偏移，使选中行可见
+ * 参    数：count - 列表当前行数
  * 返 回 值：无
+ * 说    明：行数减少（数据被删除）时先把选中行限制在范围内
  */
-void Menu_SetFunc(MenuItem_t *item, void (*func)(void))
+static void Menu_ListClamp(uint16_t count)
 {
-    if(item != NULL)
+    if(count == 0)
+    {
+        MenuCtrl.list_index = 0;
+        MenuCtrl.list_offset = 0;
+    }
+    else if(MenuCtrl.list_index >= count)
+    {
+        MenuCtrl.list_index = count - 1;
+    }
+
+    if(MenuCtrl.list_index < MenuCtrl.list_offset)
+    {
+        MenuCtrl.list_offset = MenuCtrl.list_index;
+    }
+    else if(MenuCtrl.list_index >= MenuCtrl.list_offset + MENU_MAX_ITEM_LINES)
     {
-        item->func = func;
+        MenuCtrl.list_offset = MenuCtrl.list_index - MENU_MAX_ITEM_LINES + 1;
     }
+    MenuCtrl.cursor_pos = MenuCtrl.list_index - MenuCtrl.list_offset;
 }
 
 /**
- * 函    数：设置菜单项数值参数
- * 参    数：item - 菜单项指针
- *          value - 数值指针
- *          min - 最小值
- *          max - 最大值
+ * 函    数：虚拟列表移动一行
+ * 参    数：up - 1向上，0向下
  * 返 回 值：无
+ * 说    明：只修改选中行和滚动偏移，与列表行数无关
  */
-void Menu_SetValue(MenuItem_t *item, int32_t *value, int32_t min, int32_t max)
+static void Menu_ListMove(uint8_t up)
 {
-    if(item != NULL)
+    uint16_t count = MenuCtrl.list->count();
+
+    Menu_ListClamp(count);
+    if(up && MenuCtrl.list_index > 0)
+    {
+        MenuCtrl.list_index--;
+    }
+    else if(!up && MenuCtrl.list_index + 1 < count)
+    {
+        MenuCtrl.list_index++;
+    }
+    else
     {
-        item->value = value;
-        item->min = min;
-        item->max = max;
+        return;
     }
+    Menu_ListClamp(count);
+    MenuCtrl.redraw |= MENU_REDRAW_NAV;
 }
 
 /**
- * 函    数：设置菜单项开关参数
- * 参    数：item - 菜单项指针
- *          toggle - 开关值指针
+ * 函    数：打开虚拟列表
+ * 参    数：item - 列表菜单项
  * 返 回 值：无
  */
-void Menu_SetToggle(MenuItem_t *item, uint8_t *toggle)
+static void Menu_OpenList(const MenuItem_t *item)
 {
-    if(item != NULL)
-    {
-        item->toggle = toggle;
-    }
+    MenuCtrl.current_menu = item;
+    MenuCtrl.current_item = item;
+    MenuCtrl.list = item->list;
+    MenuCtrl.list_index = item->list->initial != NULL ? item->list->initial() : 0;
+    MenuCtrl.list_offset = 0;
+    Menu_ListClamp(item->list->count());
+    MenuCtrl.need_refresh = 1;
 }
 
 /**
- * 函    数：计算当前项在菜单中的索引
+ * 函    数：关闭虚拟列表，回到列表所在的菜单
  * 参    数：无
- * 返 回 值：当前项的索引
+ * 返 回 值：无
+ * 说    明：返回后光标停在列表菜单项上
  */
-static uint8_t Menu_GetItemIndex(MenuItem_t *item)
+static void Menu_CloseList(void)
 {
-    uint8_t index = 0;
-    MenuItem_t *menu = MenuCtrl.current_menu;
-    MenuItem_t *current = menu->child;
-    
-    while(current != NULL && current != item)
-    {
-        index++;
-        current = current->next;
-    }
-    
-    return index;
+    const MenuItem_t *item = MenuCtrl.current_menu;
+
+    MenuCtrl.list = NULL;
+    MenuCtrl.current_menu = item->parent;
+    MenuCtrl.current_item = item;
+    MenuCtrl.scroll_offset = item->index < MENU_MAX_ITEM_LINES ? 0 : item->index - MENU_MAX_ITEM_LINES + 1;
+    MenuCtrl.cursor_pos = item->index - MenuCtrl.scroll_offset;
+    MenuCtrl.need_refresh = 1;
 }
 
 /**
@@ -178,12 +166,20 @@ static uint8_t Menu_GetItemIndex(MenuItem_t *item)
  */
 void Menu_MoveUp(void)
 {
-    if(MenuCtrl.current_item->prev != NULL)
+    if(MenuCtrl.list != NULL)
+    {
+        Menu_ListMove(1);
+        return;
+    }
+
+    const MenuItem_t *prev = Menu_PrevItem(MenuCtrl.current_item);
+
+    if(prev != NULL)
     {
-        MenuCtrl.current_item = MenuCtrl.current_item->prev;
+        MenuCtrl.current_item = prev;
 
-        // 计算当前项在菜单中的索引
-        uint8_t item_index = Menu_GetItemIndex(MenuCtrl.current_item);
+        // 当前项在菜单中的索引（菜单树生成时已计算）
+        uint8_t item_index = prev->index;
 
         // 如果当前项在显示区域上方，需要向上滚动
         if(item_index < MenuCtrl.scroll_offset)
@@ -197,7 +193,7 @@ void Menu_MoveUp(void)
             MenuCtrl.cursor_pos = item_index - MenuCtrl.scroll_offset;
         }
 
-        MenuCtrl.need_refresh = 1;
+        MenuCtrl.redraw |= MENU_REDRAW_NAV;
     }
 }
 
@@ -208,12 +204,20 @@ void Menu_MoveUp(void)
  */
 void Menu_MoveDown(void)
 {
-    if(MenuCtrl.current_item->next != NULL)
+    if(MenuCtrl.list != NULL)
+    {
+        Menu_ListMove(0);
+        return;
+    }
+
+    const MenuItem_t *next = Menu_NextItem(MenuCtrl.current_item);
+
+    if(next != NULL)
     {
-        MenuCtrl.current_item = MenuCtrl.current_item->next;
+        MenuCtrl.current_item = next;
 
-        // 计算当前项在菜单中的索引
-        uint8_t item_index = Menu_GetItemIndex(MenuCtrl.current_item);
+        // 当前项在菜单中的索引（菜单树生成时已计算）
+        uint8_t item_index = next->index;
 
         // 如果当前项在显示区域下方，需要向下滚动（菜单项最多显示MENU_MAX_ITEM_LINES行）
         if(item_index >= MenuCtrl.scroll_offset + MENU_MAX_ITEM_LINES)
@@ -227,7 +231,7 @@ void Menu_MoveDown(void)
             MenuCtrl.cursor_pos = item_index - MenuCtrl.scroll_offset;
         }
 
-        MenuCtrl.need_refresh = 1;
+        MenuCtrl.redraw |= MENU_REDRAW_NAV;
     }
 }
 
@@ -238,7 +242,21 @@ void Menu_MoveDown(void)
  */
 void Menu_Enter(void)
 {
-    MenuItem_t *item = MenuCtrl.current_item;
+    const MenuItem_t *item = MenuCtrl.current_item;
+    
+    // 虚拟列表中按确认键，由提供者处理选中行
+    if(MenuCtrl.list != NULL)
+    {
+        if(MenuCtrl.list->select != NULL && MenuCtrl.list->count() > 0)
+        {
+            if(MenuCtrl.list->select(MenuCtrl.list_index))
+            {
+                Menu_CloseList();
+            }
+        }
+        MenuCtrl.need_refresh = 1;
+        return;
+    }
     
     switch(item->type)
     {
@@ -274,12 +292,20 @@ void Menu_Enter(void)
                     item->func();
                 }
             }
-            MenuCtrl.need_refresh = 1;
+            MenuCtrl.redraw |= MENU_REDRAW_ITEM; // 只重绘该行的[ON]/[OFF]
             break;
             
         case MENU_TYPE_VALUE:
             // 进入数值编辑模式（可以后续扩展）
-            MenuCtrl.need_refresh = 1;
+            MenuCtrl.redraw |= MENU_REDRAW_ITEM;
+            break;
+            
+        case MENU_TYPE_LIST:
+            // 打开虚拟列表
+            if(item->list != NULL)
+            {
+                Menu_OpenList(item);
+            }
             break;
             
         default:
@@ -294,6 +320,12 @@ void Menu_Enter(void)
  */
 void Menu_Back(void)
 {
+    if(MenuCtrl.list != NULL)
+    {
+        Menu_CloseList();
+        return;
+    }
+
     if(MenuCtrl.current_menu->parent != NULL)
     {
         MenuCtrl.current_menu = MenuCtrl.current_menu->parent;
@@ -314,42 +346,50 @@ void Menu_Back(void)
 
 /**
  * 函    数：处理按键输入（支持长按连续翻动）
- * 参    数：key - 按键值
+ * 参    数：key - 按键值（未使用，按键从事件队列中读取）
  * 返 回 值：无
+ * 说    明：依次处理队列中的事件；打开功能界面后停止，剩余事件留给界面处理
  */
 void Menu_Process(Key_action Key_action_t)
 {
-    // 检查短按事件
-    Key_action press_event = Key_Get_Press_Event();
-    // 检查重复按键事件（长按连续触发）
-    Key_action repeat_event = Key_Get_Repeat_Event();
+    Key_Event_t event;
+    uint8_t i;
 
-    // 优先处理重复事件（长按连续翻动）
-    if(repeat_event != key_none)
+    (void)Key_action_t;
+    while(!Screen_IsOpen() && Key_Get_Event(&event))
     {
-        switch(repeat_event)
+        if(event.type == KEY_EVENT_REPEAT)
         {
-            case key_up:
+            // 长按连续翻动
+            if(event.key == key_up)
+            {
                 Menu_MoveUp();
-                break;
-            case key_down:
+            }
+            else if(event.key == key_down)
+            {
                 Menu_MoveDown();
-                break;
-            default:
-                break;
+            }
+            continue;
+        }
+        if(event.type != KEY_EVENT_PRESS)
+        {
+            continue;
         }
-    }
 
-    // 处理短按事件
-    if(press_event != key_none)
-    {
-        switch(press_event)
+        switch(event.key)
         {
             case key_up:
-                Menu_MoveUp();
+                // 编码器快速转动时一个事件走多步
+                for(i = 0; i < event.count; i++)
+                {
+                    Menu_MoveUp();
+                }
                 break;
             case key_down:
-                Menu_MoveDown();
+                for(i = 0; i < event.count; i++)
+                {
+                    Menu_MoveDown();
+                }
                 break;
             case key_enter:
                 Menu_Enter();
@@ -374,7 +414,7 @@ void Menu_Process(Key_action Key_action_t)
 void Menu_DisplayStatusBar(void)
 {
     char status_str[21];  // OLED一行最多显示约21个字符（128像素/6像素）
-    MenuItem_t *menu = MenuCtrl.current_menu;
+    const MenuItem_t *menu = MenuCtrl.current_menu;
     uint8_t menu_name_len = 0;
     
     // 构建菜单路径（简化版：只显示当前菜单名称，移除[*]前缀）
@@ -384,11 +424,11 @@ void Menu_DisplayStatusBar(void)
         if(menu_name_len > 10) menu_name_len = 10;  // 限制菜单名称长度为10个字符
         
         // 格式：菜单名称（移除[*]前缀）
-        sprintf(status_str, "%s", menu->name);
+        Format_Sprintf(status_str, sizeof(status_str), "%s", menu->name);
     }
     else
     {
-        sprintf(status_str, "Menu");
+        Format_Sprintf(status_str, sizeof(status_str), "Menu");
         menu_name_len = 4;
     }
     
@@ -416,7 +456,8 @@ void Menu_DisplayStatusBar(void)
         time_start_pos = 60;
     }
     
-    // 在右侧显示时间（使用8x16大字体）
+    // 在右侧显示时间（使用8x16大字体），记录位置供走时只重绘时间
+    MenuCtrl.time_x = time_start_pos;
     Menu_DisplayTime(time_start_pos, 0, OLED_8X16);
 }
 
@@ -431,185 +472,267 @@ void Menu_DisplayStatusBar(void)
 void Menu_DisplayTime(int16_t x, int16_t y, uint8_t font)
 {
     char time_str[16];
-    sprintf(time_str, "%02d:%02d:%02d", g_current_time.hour, g_current_time.minute, g_current_time.second);
+    Format_Sprintf(time_str, sizeof(time_str), "%02d:%02d:%02d", g_current_time.hour, g_current_time.minute, g_current_time.second);
     OLED_ShowString(x, y, time_str, font);
 }
 
 /**
- * 函    数：显示菜单
- * 参    数：无
+ * 函    数：显示菜单项区域的一行
+ * 参    数：line - 行号（1~MENU_MAX_ITEM_LINES，第0行是状态栏）
  * 返 回 值：无
+ * 说    明：调用前该行应已清除；行号超出菜单项或列表行数时不显示
  */
-void Menu_Display(void)
+static void Menu_DrawRow(uint8_t line)
 {
-    if(!MenuCtrl.need_refresh) return;// 如果不需要刷新，直接返回
-    
-    OLED_Clear();
-    // 第一行：显示状态栏
-    Menu_DisplayStatusBar();
-    MenuItem_t *menu = MenuCtrl.current_menu;
-    MenuItem_t *item = menu->child;
-    
-    if(item == NULL)
-    {
-        OLED_ShowString(0, 16, "Empty Menu", OLED_8X16);
-        OLED_Update();
-        MenuCtrl.need_refresh = 0;
-        return;
-    }
-    
-    // 移动到显示起始位置
-    for(uint8_t i = 0; i < MenuCtrl.scroll_offset && item != NULL; i++)
+    char display_str[MENU_ITEM_NAME_LEN + 8];
+    uint8_t selected;
+
+    if(MenuCtrl.list != NULL)
     {
-        item = item->next;
+        // 虚拟列表：只向提供者请求这一行
+        uint16_t index = MenuCtrl.list_offset + line - 1;
+        if(index >= MenuCtrl.list->count())
+        {
+            return;
+        }
+        MenuCtrl.list->get_row(index, display_str, MENU_ITEM_NAME_LEN + 1);
+        selected = (index == MenuCtrl.list_index);
     }
-    
-    // 显示菜单项（从第二行开始，索引从1开始）
-    uint8_t line = 1;  // 从第二行开始（第一行是状态栏）
-    while(item != NULL && line < MENU_MAX_DISPLAY_LINES)
+    else
     {
-        char display_str[20];
-        uint8_t len = strlen(item->name);
-        if(len > MENU_ITEM_NAME_LEN) len = MENU_ITEM_NAME_LEN;
-        
-        // 复制菜单名称
-        strncpy(display_str, item->name, len);
-        display_str[len] = '\0';
-        
+        const MenuItem_t *menu = MenuCtrl.current_menu;
+        uint8_t index = MenuCtrl.scroll_offset + line - 1;
+        Format_t fmt;
+
+        if(menu->child == NULL || index >= menu->child_count)
+        {
+            return;
+        }
+        // 同级菜单项连续存放，直接按序号定位
+        const MenuItem_t *item = menu->child + index;
+
+        // 复制菜单名称（最多MENU_ITEM_NAME_LEN个字符），超出缓冲区的部分被截断
+        Format_Init(&fmt, display_str, sizeof(display_str));
+        Format_Printf(&fmt, "%.*s", MENU_ITEM_NAME_LEN, item->name);
+
         // 添加类型标识
         switch(item->type)
         {
             case MENU_TYPE_NORMAL:
                 if(item->child != NULL)
                 {
-                    strcat(display_str, " >");
+                    Format_Str(&fmt, " >");
                 }
                 break;
                 
             case MENU_TYPE_TOGGLE:
                 if(item->toggle != NULL)
                 {
-                    strcat(display_str, item->toggle[0] ? " [ON]" : " [OFF]");
+                    Format_Str(&fmt, item->toggle[0] ? " [ON]" : " [OFF]");
                 }
                 break;
                 
             case MENU_TYPE_VALUE:
                 if(item->value != NULL)
                 {
-                    char num_str[10];
-                    sprintf(num_str, ":%ld", *item->value);
-                    strcat(display_str, num_str);
+                    Format_Char(&fmt, ':');
+                    Format_Int(&fmt, *item->value, 0, 0);
                 }
                 break;
                 
             default:
                 break;
         }
-        
-        // 显示光标（菜单项从第二行开始，所以Y坐标是line*16）
-        if(item == MenuCtrl.current_item)
-        {
-            OLED_ShowString(0, line * 16, ">", OLED_8X16);
-            OLED_ShowString(8, line * 16, display_str, OLED_8X16);
-        }
-        else
+        selected = (item == MenuCtrl.current_item);
+    }
+
+    // 显示光标（菜单项从第二行开始，所以Y坐标是line*16）
+    if(selected)
+    {
+        OLED_ShowString(0, line * 16, ">", OLED_8X16);
+    }
+    OLED_ShowString(8, line * 16, display_str, OLED_8X16);
+}
+
+/**
+ * 函    数：显示虚拟列表的滚动条
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：行数超过一屏时在右侧显示，滑块高度与可见比例对应，最小4像素
+ */
+static void Menu_DrawScrollBar(void)
+{
+    uint16_t count = MenuCtrl.list->count();
+    uint8_t track = MENU_MAX_ITEM_LINES * 16;
+    uint8_t thumb, pos;
+
+    if(count <= MENU_MAX_ITEM_LINES)
+    {
+        return;
+    }
+    thumb = (uint32_t)track * MENU_MAX_ITEM_LINES / count;
+    if(thumb < 4)
+    {
+        thumb = 4;
+    }
+    pos = (uint32_t)(track - thumb) * MenuCtrl.list_offset / (count - MENU_MAX_ITEM_LINES);
+    OLED_ClearArea(125, 16, 3, track);
+    OLED_DrawRectangle(126, 16 + pos, 2, thumb, OLED_FILLED);
+}
+
+/**
+ * 函    数：显示菜单项区域（状态栏以下的所有行）
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：虚拟列表只向提供者请求可见的MENU_MAX_ITEM_LINES行，耗时与列表行数无关
+ */
+static void Menu_DrawRows(void)
+{
+    OLED_ClearArea(0, 16, 128, MENU_MAX_ITEM_LINES * 16);
+
+    if(MenuCtrl.list != NULL)
+    {
+        Menu_ListClamp(MenuCtrl.list->count());
+        if(MenuCtrl.list->count() == 0)
         {
-            OLED_ShowString(8, line * 16, display_str, OLED_8X16);
+            OLED_ShowString(0, 16, "Empty List", OLED_8X16);
+            return;
         }
-        
-        item = item->next;
-        line++;
     }
-    
-    OLED_Update();
-    MenuCtrl.need_refresh = 0;
+    else if(MenuCtrl.current_menu->child == NULL)
+    {
+        OLED_ShowString(0, 16, "Empty Menu", OLED_8X16);
+        return;
+    }
+
+    for(uint8_t line = 1; line <= MENU_MAX_ITEM_LINES; line++)
+    {
+        Menu_DrawRow(line);
+    }
+    if(MenuCtrl.list != NULL)
+    {
+        Menu_DrawScrollBar();
+    }
 }
 
 /**
- * 函    数：强制刷新菜单
- * 参    数：无
+ * 函    数：菜单项区域滚动一行
+ * 参    数：down - 1向下滚动（内容上移），0向上滚动（内容下移）
  * 返 回 值：无
+ * 说    明：用OLED_ScrollPages移动整屏，屏幕上已有的菜单项不重发，
+ *          只重绘被移走的状态栏、新露出的一行、旧光标和滚动条
  */
-void Menu_Refresh(void)
+static void Menu_ScrollRows(uint8_t down)
 {
-    MenuCtrl.need_refresh = 1;
-    Menu_Display();
+    uint8_t old_line = MenuCtrl.drawn_cursor + 1;
+    uint8_t new_line = down ? MENU_MAX_ITEM_LINES : 1;
+
+    OLED_ScrollPages(down ? 2 : -2);
+
+    // 状态栏跟着移走了，原位置是上一行菜单项（向下滚动）或已被清零（向上滚动）
+    OLED_ClearArea(0, 0, 128, 16);
+    Menu_DisplayStatusBar();
+
+    // 向上滚动时旧状态栏移到了第一行
+    OLED_ClearArea(0, new_line * 16, 128, 16);
+    Menu_DrawRow(new_line);
+
+    // 旧光标随所在行移动了一行
+    old_line = down ? old_line - 1 : old_line + 1;
+    if(old_line >= 1 && old_line <= MENU_MAX_ITEM_LINES && old_line != MenuCtrl.cursor_pos + 1)
+    {
+        OLED_ClearArea(0, old_line * 16, 8, 16);
+    }
+    OLED_ShowString(0, (MenuCtrl.cursor_pos + 1) * 16, ">", OLED_8X16);
+
+    if(MenuCtrl.list != NULL)
+    {
+        Menu_DrawScrollBar();
+    }
 }
 
 /**
- * 函    数：从定义表自动构建菜单树
- * 参    数：menu_table - 菜单定义表数组
- *          table_size - 定义表大小
- * 返 回 值：根菜单指针
- * 说    明：使用此函数可以简化菜单创建，只需定义菜单表即可
- *          ID从1开始，0表示根菜单
- *          示例：
- *          MenuDef_t menu_table[] = {
- *              {"Main Menu", MENU_TYPE_NORMAL, 0, NULL, NULL, 0, 0, NULL},
- *              {"System", MENU_TYPE_NORMAL, 1, NULL, NULL, 0, 0, NULL},
- *              {"Start", MENU_TYPE_FUNC, 2, Func_Start, NULL, 0, 0, NULL},
- *          };
- *          MenuItem_t *root = Menu_BuildFromTable(menu_table, 3);
+ * 函    数：显示菜单
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：need_refresh（进入/返回菜单、功能界面返回后）整屏重绘；
+ *          其他情况按MenuCtrl.redraw只重绘变化的部分：
+ *            光标在可见范围内移动 - 只擦除旧光标、绘制新光标
+ *            滚动一行             - 硬件移屏，只重绘状态栏和新露出的一行
+ *            开关/数值改变        - 只重绘选中行
+ *            时钟走时             - 只重绘状态栏中的HH:MM:SS
+ *          绘图函数只标记实际写过的区域，发送时再与屏幕内容比较，未变化的页不发送
  */
-MenuItem_t* Menu_BuildFromTable(const MenuDef_t *menu_table, uint8_t table_size)
+void Menu_Display(void)
 {
-    MenuItem_t *items[50] = {NULL};  // 存储创建的菜单项指针
-    MenuItem_t *root = NULL;
-    
-    if(menu_table == NULL || table_size == 0) return NULL;
-    
-    // 第一遍：创建所有菜单项
-    for(uint8_t i = 0; i < table_size; i++)
+    uint16_t offset;
+
+    if(MenuCtrl.need_refresh)
     {
-        items[i] = Menu_CreateItem(menu_table[i].name, menu_table[i].type);
-        
-        if(items[i] == NULL) return NULL;
-        
-        // 设置回调函数（功能菜单和开关菜单都支持回调函数）
-        if(menu_table[i].func != NULL)
+        OLED_Clear();
+        // 第一行：显示状态栏
+        Menu_DisplayStatusBar();
+        Menu_DrawRows();
+    }
+    else if(MenuCtrl.redraw & ~MENU_REDRAW_FLUSH)
+    {
+        offset = MenuCtrl.list != NULL ? MenuCtrl.list_offset : MenuCtrl.scroll_offset;
+        if(MenuCtrl.redraw & MENU_REDRAW_NAV)
         {
-            if(menu_table[i].type == MENU_TYPE_FUNC || menu_table[i].type == MENU_TYPE_TOGGLE)
+            if(offset == MenuCtrl.drawn_offset + 1 || offset + 1 == MenuCtrl.drawn_offset)
             {
-                Menu_SetFunc(items[i], menu_table[i].func);
+                Menu_ScrollRows(offset > MenuCtrl.drawn_offset); // 滚动一行：硬件移屏
+            }
+            else if(offset != MenuCtrl.drawn_offset)
+            {
+                Menu_DrawRows(); // 跳转多行：重绘菜单项区域
+            }
+            else if(MenuCtrl.cursor_pos != MenuCtrl.drawn_cursor)
+            {
+                OLED_ClearArea(0, (MenuCtrl.drawn_cursor + 1) * 16, 8, 16);
+                OLED_ShowString(0, (MenuCtrl.cursor_pos + 1) * 16, ">", OLED_8X16);
             }
         }
-        
-        // 设置数值参数
-        if(menu_table[i].type == MENU_TYPE_VALUE && menu_table[i].value != NULL)
-        {
-            Menu_SetValue(items[i], menu_table[i].value, menu_table[i].min, menu_table[i].max);
-        }
-        
-        // 设置开关参数
-        if(menu_table[i].type == MENU_TYPE_TOGGLE && menu_table[i].toggle != NULL)
+        if((MenuCtrl.redraw & MENU_REDRAW_ITEM) && offset == MenuCtrl.drawn_offset)
         {
-            Menu_SetToggle(items[i], menu_table[i].toggle);
+            OLED_ClearArea(0, (MenuCtrl.cursor_pos + 1) * 16, 128, 16);
+            Menu_DrawRow(MenuCtrl.cursor_pos + 1);
         }
-        
-        // 第一个菜单项作为根菜单
-        if(i == 0)
+        if(MenuCtrl.redraw & MENU_REDRAW_TIME)
         {
-            root = items[i];
+            Menu_DisplayTime(MenuCtrl.time_x, 0, OLED_8X16);
         }
     }
-    
-    // 第二遍：建立父子关系
-    for(uint8_t i = 0; i < table_size; i++)
+    else if(!MenuCtrl.redraw)
     {
-        uint8_t parent_id = menu_table[i].parent_id;
-        
-        if(parent_id == 0)
-        {
-            // 根菜单，不需要设置父菜单
-            continue;
-        }
-        else if(parent_id <= table_size)
-        {
-            // 添加到父菜单
-            Menu_AddItem(items[parent_id - 1], items[i]);
-        }
+        return; // 没有变化，也没有待发送的内容
     }
-    
-    return root;
+
+    MenuCtrl.need_refresh = 0;
+    MenuCtrl.drawn_offset = MenuCtrl.list != NULL ? MenuCtrl.list_offset : MenuCtrl.scroll_offset;
+    MenuCtrl.drawn_cursor = MenuCtrl.cursor_pos;
+    // 交换显存后台发送；上一帧尚未发送完时脏区保留，下次调用时只需重新发送，不必重绘
+    MenuCtrl.redraw = OLED_SwapAndFlush() ? 0 : MENU_REDRAW_FLUSH;
 }
 
+/**
+ * 函    数：强制刷新菜单
+ * 参    数：无
+ * 返 回 值：无
+ */
+void Menu_Refresh(void)
+{
+    MenuCtrl.need_refresh = 1;
+    Menu_Display();
+}
+
+/**
+ * 函    数：时钟走时
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：g_current_time更新后调用，下次Menu_Display只重绘状态栏中的时间
+ */
+void Menu_UpdateTime(void)
+{
+    MenuCtrl.redraw |= MENU_REDRAW_TIME;
+}
@@ -7,6 +7,7 @@
 #include "OLED.h"
 #include "Key_multi.h"
 #include "Timestamp.h"
+#include "Format.h"
 #include <string.h>
 
 
@@ -16,23 +17,39 @@ typedef enum
     MENU_TYPE_NORMAL,      // 普通菜单项（可进入子菜单）
     MENU_TYPE_FUNC,        // 功能菜单项（执行回调函数）
     MENU_TYPE_TOGGLE,      // 开关菜单项
-    MENU_TYPE_VALUE        // 数值菜单项
+    MENU_TYPE_VALUE,       // 数值菜单项
+    MENU_TYPE_LIST         // 虚拟列表菜单项（行内容由数据提供者按需生成）
 } MenuItemType_t;
 
-/*菜单项结构体*/
+/*虚拟列表数据提供者
+ * 列表行不占用菜单项，显示时只向提供者请求可见的几行，行数可以很大且可以动态变化
+ */
+typedef struct
+{
+    uint16_t (*count)(void);                                  // 返回当前行数
+    void (*get_row)(uint16_t index, char *buf, uint8_t size); // 生成第index行的文本
+    uint8_t (*select)(uint16_t index);                        // 按确认键时调用，返回1关闭列表，可为NULL
+    uint16_t (*initial)(void);                                // 打开列表时的初始选中行，可为NULL（从第0行开始）
+} MenuListProvider_t;
+
+/*菜单项结构体
+ * 菜单树为Flash中的常量数组（由menu_gen.py从MenuDef_t菜单表生成），同级菜单项在数组中连续存放，
+ * 上一项/下一项为相邻元素，菜单项序号直接保存在index中，不需要遍历链表
+ */
 typedef struct MenuItem
 {
-    char *name;                    // 菜单项名称
+    const char *name;              // 菜单项名称
     MenuItemType_t type;           // 菜单项类型
-    struct MenuItem *parent;      // 父菜单指针
-    struct MenuItem *child;        // 子菜单指针（第一个子菜单项）
-    struct MenuItem *next;         // 下一个同级菜单项
-    struct MenuItem *prev;         // 上一个同级菜单项
+    const struct MenuItem *parent; // 父菜单指针（根菜单为NULL）
+    const struct MenuItem *child;  // 子菜单指针（第一个子菜单项）
+    uint8_t child_count;           // 子菜单项数量
+    uint8_t index;                 // 在同级菜单项中的序号（从0开始）
     void (*func)(void);            // 功能回调函数（MENU_TYPE_FUNC类型使用）
     int32_t *value;                // 数值指针（MENU_TYPE_VALUE类型使用）
     int32_t min;                   // 最小值（MENU_TYPE_VALUE类型使用）
     int32_t max;                   // 最大值（MENU_TYPE_VALUE类型使用）
     uint8_t *toggle;               // 开关值指针（MENU_TYPE_TOGGLE类型使用）
+    const MenuListProvider_t *list; // 数据提供者（MENU_TYPE_LIST类型使用）
 } MenuItem_t;
 
 /*菜单显示配置*/
@@ -40,17 +57,30 @@ typedef struct MenuItem
 #define MENU_MAX_ITEM_LINES    3   // 菜单项最多显示3行（第一行用于状态栏）
 #define MENU_ITEM_NAME_LEN     16   // 菜单项名称最大长度
 
+/*局部重绘标志（MenuCtrl.redraw），由Menu_Display按标志只重绘变化的部分*/
+#define MENU_REDRAW_NAV        0x01 // 选中项改变（光标移动或滚动）
+#define MENU_REDRAW_ITEM       0x02 // 选中项的开关/数值改变
+#define MENU_REDRAW_TIME       0x04 // 时钟走时
+#define MENU_REDRAW_FLUSH      0x08 // 已绘制但上一帧未发送完，等待重新发送
+
 /*菜单控制结构体*/
 typedef struct
 {
-    MenuItem_t *current_menu;      // 当前菜单指针
-    MenuItem_t *current_item;       // 当前选中项指针
+    const MenuItem_t *current_menu; // 当前菜单指针
+    const MenuItem_t *current_item; // 当前选中项指针
     uint8_t cursor_pos;             // 光标位置（0-3）
     uint8_t scroll_offset;          // 滚动偏移量
-    uint8_t need_refresh;           // 需要刷新标志
+    uint8_t need_refresh;           // 需要整屏刷新标志
+    uint8_t redraw;                 // 局部重绘标志（MENU_REDRAW_*）
+    uint8_t drawn_cursor;           // 屏幕上显示的光标位置
+    uint16_t drawn_offset;          // 屏幕上显示的滚动偏移量（菜单或虚拟列表）
+    uint8_t time_x;                 // 状态栏中时间的X坐标
+    const MenuListProvider_t *list; // 当前打开的虚拟列表（NULL表示普通菜单）
+    uint16_t list_index;            // 虚拟列表选中行
+    uint16_t list_offset;           // 虚拟列表滚动偏移量
 } MenuCtrl_t;
 
-/*菜单定义结构体 - 用于简化菜单创建*/
+/*菜单定义结构体 - 菜单表的编写格式，由menu_gen.py转换为常量菜单树*/
 typedef struct
 {
     char *name;                 // 菜单项名称
@@ -61,24 +91,18 @@ typedef struct
     int32_t min;                // 最小值（MENU_TYPE_VALUE类型使用）
     int32_t max;                // 最大值（MENU_TYPE_VALUE类型使用）
     uint8_t *toggle;            // 开关值指针（MENU_TYPE_TOGGLE类型使用）
+    const MenuListProvider_t *list; // 数据提供者（MENU_TYPE_LIST类型使用，其他类型为NULL）
 } MenuDef_t;
 
 /*函数声明*/
-void Menu_Init(MenuItem_t *root_menu);
+void Menu_Init(const MenuItem_t *root_menu);
 void Menu_Process(Key_action key);
 void Menu_Display(void);
 void Menu_Refresh(void);
-MenuItem_t* Menu_CreateItem(char *name, MenuItemType_t type);
-void Menu_AddItem(MenuItem_t *parent, MenuItem_t *item);
-void Menu_SetFunc(MenuItem_t *item, void (*func)(void));
-void Menu_SetValue(MenuItem_t *item, int32_t *value, int32_t min, int32_t max);
-void Menu_SetToggle(MenuItem_t *item, uint8_t *toggle);
+void Menu_UpdateTime(void);        // 时钟走时，只重绘时间
 void Menu_DisplayStatusBar(void);  // 显示状态栏
 void Menu_DisplayTime(int16_t x, int16_t y, uint8_t font);  // 显示时间
 
-/*简化菜单创建函数 - 从定义表自动构建菜单树*/
-MenuItem_t* Menu_BuildFromTable(const MenuDef_t *menu_table, uint8_t table_size);
-
 /*外部变量声明*/
 extern MenuCtrl_t MenuCtrl;
 
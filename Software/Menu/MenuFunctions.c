@@ -10,208 +10,323 @@
 // static uint8_t  g_live_counting_active = 0;
 /*实时统计显示页面*/
 // static uint8_t  g_live_display_page = 0;
-extern bool CYZ_Receiver_Process(void); // CYZ数据包接收处理函数
+
 /**
- * 函    数：显示实时统计界面
- * 参    数：无
+ * 函    数：显示"标签+计数值"
+ * 参    数：x, y - 显示位置
+ *          label - 标签字符串
+ *          value - 计数值
  * 返 回 值：无
- * 说    明：显示关键统计信息：前空、后空、芯片数、缺失数
+ * 说    明：统计界面每帧刷新，直接追加整数，不经过sprintf
  */
-void LiveCounting_Display(void)
+static void Menu_ShowCount(int16_t x, int16_t y, const char *label, uint32_t value)
 {
-    StatisticsData_t *data = Statistics_GetData();
-    char str[32];
-    const char *stage_name[] = {"Lead", "Chips", "Tail"};
+    char str[24];
+    Format_t fmt;
+
+    Format_Init(&fmt, str, sizeof(str));
+    Format_Str(&fmt, label);
+    Format_Uint(&fmt, value, 0, 0);
+    OLED_ShowString(x, y, str, OLED_8X16);
+}
+
+/**
+ * 函    数：显示良率"Yield:xx.x%"
+ * 参    数：x, y - 显示位置
+ *          yield_rate - 良率（百分数）
+ * 返 回 值：无
+ */
+static void Menu_ShowYield(int16_t x, int16_t y, float yield_rate)
+{
+    char str[24];
+    Format_t fmt;
+
+    Format_Init(&fmt, str, sizeof(str));
+    Format_Str(&fmt, "Yield:");
+    Format_Float(&fmt, yield_rate, 1);
+    Format_Char(&fmt, '%');
+    OLED_ShowString(x, y, str, OLED_8X16);
+}
 
+/*实时统计界面控件，只重绘数值变化的字符*/
+static Widget_t live_stage, live_yield;
+static Widget_t live_front, live_loss, live_chip, live_hole, live_tail, live_add;
+static uint8_t live_layout_ready = 0; // 0：需要清屏并重建控件（首次进入或被弹窗覆盖后）
+
+/**
+ * 函    数：建立实时统计界面布局
+ * 参    数：无
+ * 返 回 值：无
+ */
+static void LiveCounting_Layout(void)
+{
     OLED_Clear();
 
     // 第一行：状态栏（显示运行状态和当前阶段）/良率
-    sprintf(str, "%s", stage_name[data->current_stage]);
-    OLED_ShowString(0, 0, str, OLED_6X8);
-    sprintf(str, "Yield:%.1f%%", data->yield_rate); // 转换为百分比并保留1位小数
-    OLED_ShowString(32, 0, str, OLED_8X16);
+    Widget_InitLabel(&live_stage, 0, 0, OLED_6X8);
+    Widget_InitNumber(&live_yield, 32, 0, OLED_8X16, "Yield:", "%", 1); // 百分比保留1位小数
 
     // 第二行：前空 / 缺失统计
-    sprintf(str, "F: %lu", data->lead_empty_count);
-    OLED_ShowString(0, 16, str, OLED_8X16);
-    sprintf(str, "LOSS :%lu", data->Middle_LOSS);
-    OLED_ShowString(62, 16, str, OLED_8X16);
+    Widget_InitNumber(&live_front, 0, 16, OLED_8X16, "F: ", NULL, 0);
+    Widget_InitNumber(&live_loss, 62, 16, OLED_8X16, "LOSS :", NULL, 0);
 
     // 第三行：芯片数
-    sprintf(str, "C: %lu", data->middle_chip_count);
-    OLED_ShowString(0, 32, str, OLED_8X16);
-    sprintf(str, "H: %lu", exti0_trigger_count);
-    OLED_ShowString(62, 32, str, OLED_8X16);
+    Widget_InitNumber(&live_chip, 0, 32, OLED_8X16, "C: ", NULL, 0);
+    Widget_InitNumber(&live_hole, 62, 32, OLED_8X16, "H: ", NULL, 0);
 
     // 第四行：后空 / 多余统计
-    sprintf(str, "T: %lu", data->trail_empty_count);
-    OLED_ShowString(0, 48, str, OLED_8X16);
-    sprintf(str, "ADD: %lu", data->Lead_Tail_ADD);
-    OLED_ShowString(62, 48, str, OLED_8X16);
+    Widget_InitNumber(&live_tail, 0, 48, OLED_8X16, "T: ", NULL, 0);
+    Widget_InitNumber(&live_add, 62, 48, OLED_8X16, "ADD: ", NULL, 0);
 
-    OLED_Update();
+    live_layout_ready = 1;
 }
 
 /**
- * 函    数：实时统计功能
+ * 函    数：显示实时统计界面
  * 参    数：无
  * 返 回 值：无
+ * 说    明：显示关键统计信息：前空、后空、芯片数、缺失数
+ *          不清屏重绘，各字段只在数值变化时重绘变化的字符
  */
-void Func_LiveCounting(void)
+void LiveCounting_Display(void)
 {
+    StatisticsData_t *data = Statistics_GetData();
+    const char *stage_name[] = {"Lead", "Chips", "Tail"};
 
+    if (!live_layout_ready)
+    {
+        LiveCounting_Layout();
+    }
+
+    Widget_SetText(&live_stage, stage_name[data->current_stage]);
+    Widget_SetNumber(&live_yield, (int32_t)(data->yield_rate * 10 + 0.5f));
+    Widget_SetNumber(&live_front, data->lead_empty_count);
+    Widget_SetNumber(&live_loss, data->Middle_LOSS);
+    Widget_SetNumber(&live_chip, data->middle_chip_count);
+    Widget_SetNumber(&live_hole, exti0_trigger_count);
+    Widget_SetNumber(&live_tail, data->trail_empty_count);
+    Widget_SetNumber(&live_add, data->Lead_Tail_ADD);
+
+    OLED_SwapAndFlush(); // 交换显存后台发送，计数处理与屏幕传输同时进行
+}
+
+/*实时统计界面状态*/
+static uint32_t live_last_frame = 0;    // 上次刷新界面的时间（毫秒）
+static uint32_t live_shown_update = 0;  // 上次刷新时的统计更新次数
+static uint32_t live_shown_trigger = 0; // 上次刷新时的定位孔触发次数
+
+/**
+ * 函    数：实时统计界面 - 进入
+ * 参    数：无
+ * 返 回 值：无
+ */
+static void LiveCounting_Enter(void)
+{
     // Sensor_EnableCounting(1);  // 使能计数
-    Statistics_Resume(); // 统计开始
-    while (1)
+    live_last_frame = 0;
+    g_statistics.force_update_display = 0; // 报警界面不在本界面之上关闭时留下的标志
+    Sensor_ResetLoopStats(); // 重新统计主循环频率与最大间隔
+    Statistics_Resume();     // 统计开始
+}
+
+/**
+ * 函    数：实时统计界面 - 绘制
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：首次进入或弹窗关闭后重建控件
+ */
+static void LiveCounting_Render(void)
+{
+    live_layout_ready = 0;
+    LiveCounting_Display();
+    live_last_frame = Delay_Get_Ticks();
+    live_shown_update = g_statistics.update_count;
+    live_shown_trigger = exti0_trigger_count;
+}
+
+/**
+ * 函    数：实时统计界面 - 更新
+ * 参    数：key - 按键事件
+ * 返 回 值：无
+ * 说    明：计数在PendSV中进行，本界面只负责显示；返回键只关闭界面，计数在后台继续，
+ *          由清零、远程/语音暂停命令或报警界面的返回键停止
+ */
+static void LiveCounting_Update(Key_action key)
+{
+    if (key == key_back || g_statistics.force_update_display)
     {
-        // 调用传感器中断标志处理数据
-        Sensor_ProcessInLoop();
-        // 调用按键状态处理
-        Key_Status_Process();
-        if (Key_Get_Press_Event() == key_back)
-        {
-            // 停止计数并返回主菜单
-            // Sensor_EnableCounting(0);
-            Statistics_Pause(); // 暂停统计
-            Menu_Refresh();
-            break;
-        }
+        // 返回主菜单（报警界面中按返回键时已暂停计数，由force_update_display通知）
+        g_statistics.force_update_display = 0;
+        SensorLoopStats_t loop_stats;
+        SensorPocketStats_t pocket_stats;
+        Sensor_GetLoopStats(&loop_stats);
+        Sensor_GetPocketStats(&pocket_stats);
+        USART1_Printf("[Loop] %lu Hz, max gap %lu us\r\n", loop_stats.loop_hz, loop_stats.max_gap_us);
+        USART1_Printf("[Pocket] lost %lu, max backlog %u, max %lu cycles/pocket, max latency %lu us\r\n",
+                      pocket_stats.overflow, pocket_stats.max_depth, pocket_stats.max_cycles, pocket_stats.max_latency_us);
+        Screen_Pop();
+        return;
+    }
 
-        if (g_statistics.is_beginning == 1)
-        {
-            // 显示实时统计界面
-            LiveCounting_Display();
-        }
-        if (g_statistics.force_update_display) // 强制刷新显示
-        {
-            g_statistics.force_update_display = 0;
-            break; // 强制刷新后退出循环
-        }
-        CYZ_Receiver_Process(); // 处理接收到的特定数据包
+    // 限制刷新率，且只在统计数据变化时刷新，其余时间全速处理计数；统计停止后不再刷新
+    if (g_statistics.is_beginning == 1 &&
+        Delay_Get_Ticks() - live_last_frame >= 1000 / LIVE_REFRESH_HZ &&
+        (g_statistics.update_count != live_shown_update || exti0_trigger_count != live_shown_trigger))
+    {
+        live_last_frame = Delay_Get_Ticks();
+        live_shown_update = g_statistics.update_count;
+        live_shown_trigger = exti0_trigger_count;
+        // 显示实时统计界面
+        LiveCounting_Display();
     }
 }
 
+/*实时统计界面*/
+static const Screen_t live_screen = {LiveCounting_Enter, LiveCounting_Update, LiveCounting_Render, NULL};
+
 /**
- * 函    数：数据查看功能,查看上一次的统计结果
+ * 函    数：实时统计功能
+ * 参    数：无
+ * 返 回 值：无
+ */
+void Func_LiveCounting(void)
+{
+    Screen_Push(&live_screen);
+}
+
+/**
+ * 函    数：上一次数据界面 - 绘制
  * 参    数：无
  * 返 回 值：无
  * 说    明：显示关键统计信息：前空、后空、芯片数、缺失数
  */
-void Func_LastResult(void)
+static void LastResult_Render(void)
 {
     StatisticsData_t *data = Statistics_GetData();
-    char str[32];
-    OLED_Clear();
 
     if (!data->data_valid)
     {
         OLED_ShowString(0, 0, "No Data", OLED_8X16);
         OLED_ShowString(0, 16, "Press BACK", OLED_8X16);
-        OLED_Update();
+        return;
     }
-    else
-    {
-        // 第一行：状态栏
-        OLED_ShowString(0, 0, "Last", OLED_6X8);
-        sprintf(str, "Yield:%.1f%%", data->yield_rate); // 转换为百分比并保留1位小数
-        OLED_ShowString(32, 0, str, OLED_8X16);
-        // 第二行：前空 / 缺失统计
-        sprintf(str, "F: %lu", data->lead_empty_count);
-        OLED_ShowString(0, 16, str, OLED_8X16);
-        sprintf(str, "LOSS:%lu", data->Middle_LOSS);
-        OLED_ShowString(62, 16, str, OLED_8X16);
-
-        // 第三行：芯片数
-        sprintf(str, "C: %lu", data->middle_chip_count);
-        OLED_ShowString(0, 32, str, OLED_8X16);
-        sprintf(str, "H: %lu", exti0_trigger_count);
-        OLED_ShowString(62, 32, str, OLED_8X16);
-
-        // 第四行：后空 / 多余统计
-        sprintf(str, "T: %lu", data->trail_empty_count);
-        OLED_ShowString(0, 48, str, OLED_8X16);
-        sprintf(str, "ADD:%lu", data->Lead_Tail_ADD);
-        OLED_ShowString(62, 48, str, OLED_8X16);
 
-        OLED_Update();
-    }
+    // 第一行：状态栏
+    OLED_ShowString(0, 0, "Last", OLED_6X8);
+    Menu_ShowYield(32, 0, data->yield_rate); // 百分比保留1位小数
+    // 第二行：前空 / 缺失统计
+    Menu_ShowCount(0, 16, "F: ", data->lead_empty_count);
+    Menu_ShowCount(62, 16, "LOSS:", data->Middle_LOSS);
 
-    // 等待返回键
-    while (Key_Get_Press_Event() != key_back)
-    {
-        Key_Status_Process();
-        CYZ_Receiver_Process(); // 处理接收到的特定数据包
-        Delay_ms(1);
-    }
+    // 第三行：芯片数
+    Menu_ShowCount(0, 32, "C: ", data->middle_chip_count);
+    Menu_ShowCount(62, 32, "H: ", exti0_trigger_count);
 
-    Menu_Refresh();
+    // 第四行：后空 / 多余统计
+    Menu_ShowCount(0, 48, "T: ", data->trail_empty_count);
+    Menu_ShowCount(62, 48, "ADD:", data->Lead_Tail_ADD);
 }
 
 /**
- * 函    数：查看历史记录
- * 参    数：无
+ * 函    数：信息界面（只显示内容，按返回键关闭） - 更新
+ * 参    数：key - 按键事件
  * 返 回 值：无
  */
-void Func_ViewHistory(void)
+static void InfoScreen_Update(Key_action key)
 {
-    OLED_Clear();
-    OLED_ShowString(0, 0, "History", OLED_8X16);
-    OLED_ShowString(0, 16, "Not Implemented", OLED_8X16);
-    OLED_ShowString(0, 32, "Press BACK", OLED_8X16);
-    OLED_Update();
-
-    // 等待返回键
-    while (Key_Get_Press_Event() != key_back)
+    if (key == key_back)
     {
-        Key_Status_Process();
-        CYZ_Receiver_Process(); // 处理接收到的特定数据包
-        Delay_ms(1);
+        Screen_Pop();
     }
-
-    Menu_Refresh(); // 强制刷新菜单
 }
 
+/*上一次数据界面*/
+static const Screen_t last_result_screen = {NULL, InfoScreen_Update, LastResult_Render, NULL};
+
 /**
- * 函    数：传感器校准
+ * 函    数：数据查看功能,查看上一次的统计结果
  * 参    数：无
  * 返 回 值：无
  */
-void Func_SensorCalibration(void)
+void Func_LastResult(void)
 {
-    char str[32];
+    Screen_Push(&last_result_screen);
+}
 
-    while (1)
-    {
-        Key_Status_Process();                   // 调用按键状态处理
-        Key_action key = Key_Get_Press_Event(); // 获取按键事件
+/**
+ * 函    数：历史记录列表 - 行数
+ * 参    数：无
+ * 返 回 值：记录数量
+ * 说    明：FlashStorage模块实现前没有记录，列表显示为空
+ */
+static uint16_t History_Count(void)
+{
+    return 0;
+}
 
-        CYZ_Receiver_Process(); // 处理接收到的特定数据包
+/**
+ * 函    数：历史记录列表 - 生成行文本
+ * 参    数：index - 行号
+ *          buf, size - 输出缓冲区
+ * 返 回 值：无
+ */
+static void History_GetRow(uint16_t index, char *buf, uint8_t size)
+{
+    Format_Sprintf(buf, size, "Record %u", index + 1);
+}
 
-        if (key == key_back) // 返回键
-        {
-            Menu_Refresh();
-            break;
-        }
+/*查看历史：记录按需生成，不占用RAM*/
+const MenuListProvider_t history_list = {History_Count, History_GetRow, NULL, NULL};
 
-        // 显示传感器实时状态
-        OLED_Clear();
-        OLED_ShowString(0, 0, "Calibration", OLED_8X16);
+/*传感器校准界面控件*/
+static Widget_t calib_index_label, calib_chip_label;
 
-        uint8_t index_state = Sensor_GetIndexHoleState();
-        uint8_t chip_state = Sensor_GetChipDetectState();
+/**
+ * 函    数：传感器校准界面 - 绘制
+ * 参    数：无
+ * 返 回 值：无
+ */
+static void Calibration_Render(void)
+{
+    // 静态内容只绘制一次，传感器状态只在变化时重绘
+    OLED_ShowString(0, 0, "Calibration", OLED_8X16);
+    OLED_ShowString(0, 48, "Press BACK", OLED_8X16);
+    Widget_InitLabel(&calib_index_label, 0, 16, OLED_8X16);
+    Widget_InitLabel(&calib_chip_label, 0, 32, OLED_8X16);
+}
 
-        sprintf(str, "Index: %s", index_state ? "HIGH" : "LOW");
-        OLED_ShowString(0, 16, str, OLED_8X16);
+/**
+ * 函    数：传感器校准界面 - 更新
+ * 参    数：key - 按键事件
+ * 返 回 值：无
+ */
+static void Calibration_Update(Key_action key)
+{
+    if (key == key_back) // 返回键
+    {
+        Screen_Pop();
+        return;
+    }
 
-        sprintf(str, "Chip: %s", chip_state ? "HIGH" : "LOW");
-        OLED_ShowString(0, 32, str, OLED_8X16);
+    // 显示传感器实时状态，状态未变化时没有脏区，不发送
+    uint8_t index_state = Sensor_GetIndexHoleState();
+    uint8_t chip_state = Sensor_GetChipDetectState();
 
-        OLED_ShowString(0, 48, "Press BACK", OLED_8X16);
-        OLED_Update();
+    Widget_SetText(&calib_index_label, index_state ? "Index: HIGH" : "Index: LOW");
+    Widget_SetText(&calib_chip_label, chip_state ? "Chip: HIGH" : "Chip: LOW");
+}
 
-        // Delay_ms(50);
-    }
-    Menu_Refresh(); // 强制刷新菜单
+/*传感器校准界面*/
+static const Screen_t calibration_screen = {NULL, Calibration_Update, Calibration_Render, NULL};
+
+/**
+ * 函    数：传感器校准
+ * 参    数：无
+ * 返 回 值：无
+ */
+void Func_SensorCalibration(void)
+{
+    Screen_Push(&calibration_screen);
 }
 
 /**
@@ -235,296 +350,285 @@ void Func_ResetCounters(void)
     Menu_Refresh();
 }
 
+/*阈值设置界面状态*/
+#define THRESHOLD_ITEMS_COUNT 4  // 3个参数 + BACK
+static uint8_t threshold_index = 0; // 菜单选项索引
+static uint8_t threshold_edit = 0;  // 编辑模式标志
+static uint32_t threshold_temp;     // 临时存储编辑的值
+
 /**
- * 函    数：阈值设置
+ * 函    数：阈值设置界面 - 进入
  * 参    数：无
  * 返 回 值：无
- * 说    明：动态调整统计阈值参数
  */
-void Func_ThresholdSettings(void)
+static void Threshold_Enter(void)
 {
-    uint8_t menu_index = 0; // 菜单选项索引
-    uint8_t edit_mode = 0;  // 编辑模式标志
-    uint32_t temp_value;    // 临时存储编辑的值
+    threshold_index = 0;
+    threshold_edit = 0;
+}
+
+/**
+ * 函    数：阈值设置界面 - 绘制
+ * 参    数：无
+ * 返 回 值：无
+ */
+static void Threshold_Render(void)
+{
+    const char *short_names[THRESHOLD_ITEMS_COUNT] = {"1.FTh", "2.MLoss", "3.TTh", "BACK"};
+    const char *param_names[3] = {"Front", "MidLoss", "Tail"};
+    const uint32_t values[3] = {g_front_chip_threshold, g_middle_loss_max, g_trail_empty_threshold};
+    char text[16];
 
-    char menu_items[4][16] = {
-        "1.Front:3",
-        "2.MidLoss:2",
-        "3.Tail:3",
-        "BACK"};
-#define MENU_ITEMS_COUNT (sizeof(menu_items) / sizeof(menu_items[0]))
+    OLED_ShowString(0, 0, "Threshold Settings", OLED_6X8);
 
-    while (1)
+    if (threshold_edit)
     {
-        Key_Status_Process();
-        Key_action key = Key_Get_Press_Event();
+        // 编辑模式：左侧显示菜单列表（只显示参数名），右侧放大显示当前编辑值
+        for (uint8_t i = 0; i < THRESHOLD_ITEMS_COUNT; i++)
+        {
+            uint8_t y_pos = 12 + (i * 10);
+            if (i == threshold_index)
+            {
+                OLED_ShowString(0, y_pos, ">", OLED_6X8);
+            }
+            OLED_ShowString(8, y_pos, (char *)short_names[i], OLED_6X8);
+        }
 
-        CYZ_Receiver_Process();
+        // 参数名（上方）
+        OLED_ShowString(64, 8, (char *)param_names[threshold_index], OLED_6X8);
 
-        // 显示菜单
-        OLED_Clear();
-        OLED_ShowString(0, 0, "Threshold Settings", OLED_6X8);
+        // 大字号显示数值（中间）
+        Format_Sprintf(text, sizeof(text), "%d", threshold_temp);
+        OLED_ShowString(72, 18, text, OLED_8X16);
 
-        if (edit_mode)
+        // 单位说明（下方）
+        OLED_ShowString(64, 36, "Threshold", OLED_6X8);
+
+        // 操作提示（底部）
+        OLED_ShowString(0, 52, "UP/DOWN:Change  OK:Save  BACK:Cancel", OLED_6X8);
+    }
+    else
+    {
+        // 普通选择模式：紧凑显示所有菜单项
+        for (uint8_t i = 0; i < THRESHOLD_ITEMS_COUNT; i++)
         {
-            // 编辑模式：左侧显示菜单列表，右侧放大显示当前编辑值
-            // 显示菜单项（左侧）
-            for (uint8_t i = 0; i < MENU_ITEMS_COUNT; i++)
+            uint8_t y_pos = 16 + (i * 12);
+            if (i == threshold_index)
             {
-                uint8_t y_pos = 12 + (i * 10);
-                if (i == menu_index)
-                {
-                    OLED_ShowString(0, y_pos, ">", OLED_6X8);
-                }
-                else
-                {
-                    OLED_ShowString(0, y_pos, " ", OLED_6X8);
-                }
-
-                // 显示菜单项文本（简化显示，留出空间给右侧大数值）
-                char simple_text[12];
-                if (i < 3)
-                {
-                    sprintf(simple_text, "%d.%s", i + 1, (i == 0 ? "FTh" : (i == 1 ? "MLoss" : "TTh")));
-                }
-                else
-                {
-                    sprintf(simple_text, "BACK");
-                }
-                OLED_ShowString(8, y_pos, simple_text, OLED_6X8);
+                OLED_ShowString(0, y_pos, ">", OLED_6X8);
             }
-
-            // 右侧显示放大的当前编辑值
-            char param_name[16];
-            if (menu_index == 0)
-                sprintf(param_name, "Front");
-            else if (menu_index == 1)
-                sprintf(param_name, "MidLoss");
+            if (i == 0)
+                Format_Sprintf(text, sizeof(text), "1.FrontTh:%d", values[0]);
+            else if (i == 1)
+                Format_Sprintf(text, sizeof(text), "2.MidLoss:%d", values[1]);
+            else if (i == 2)
+                Format_Sprintf(text, sizeof(text), "3.TrailTh:%d", values[2]);
             else
-                sprintf(param_name, "Tail");
-
-            // 参数名（上方）
-            OLED_ShowString(64, 8, param_name, OLED_6X8);
+                Format_Sprintf(text, sizeof(text), "BACK");
+            OLED_ShowString(8, y_pos, text, OLED_6X8);
+        }
 
-            // 大字号显示数值（中间）
-            char big_value[4];
-            sprintf(big_value, "%d", temp_value);
-            // 使用8x16字体显示大数值
-            OLED_ShowString(72, 18, big_value, OLED_8X16);
+        // 操作提示
+        OLED_ShowString(0, 52, "OK:Edit  BACK:Exit", OLED_6X8);
+    }
+}
 
-            // 单位说明（下方）
-            OLED_ShowString(64, 36, "Threshold", OLED_6X8);
+/**
+ * 函    数：阈值设置界面 - 更新
+ * 参    数：key - 按键事件
+ * 返 回 值：无
+ * 说    明：只在按键时重绘
+ */
+static void Threshold_Update(Key_action key)
+{
+    if (key == key_none)
+    {
+        return;
+    }
 
-            // 操作提示（底部）
-            OLED_ShowString(0, 52, "UP/DOWN:Change  OK:Save  BACK:Cancel", OLED_6X8);
+    if (key == key_up)
+    {
+        if (threshold_edit)
+        {
+            // 编辑模式：增加数值
+            if (threshold_temp < 99)
+                threshold_temp++;
         }
         else
         {
-            // 普通选择模式：紧凑显示所有菜单项
-            for (uint8_t i = 0; i < MENU_ITEMS_COUNT; i++)
-            {
-                uint8_t y_pos = 16 + (i * 12);
-                if (i == menu_index)
-                {
-                    OLED_ShowString(0, y_pos, ">", OLED_6X8);
-                }
-                else
-                {
-                    OLED_ShowString(0, y_pos, " ", OLED_6X8);
-                }
-                OLED_ShowString(8, y_pos, menu_items[i], OLED_6X8);
-            }
-
-            // 操作提示
-            OLED_ShowString(0, 52, "OK:Edit  BACK:Exit", OLED_6X8);
+            // 选择模式：向上移动菜单项
+            threshold_index = (threshold_index > 0) ? (threshold_index - 1) : (THRESHOLD_ITEMS_COUNT - 1);
         }
-        OLED_Update();
-
-        // 更新菜单显示文本以反映最新值（除了BACK项）
-        if (!edit_mode)
+    }
+    else if (key == key_down)
+    {
+        if (threshold_edit)
         {
-            sprintf((char *)menu_items[0], "1.FrontTh:%d", g_front_chip_threshold);
-            sprintf((char *)menu_items[1], "2.MidLoss:%d", g_middle_loss_max);
-            sprintf((char *)menu_items[2], "3.TrailTh:%d", g_trail_empty_threshold);
+            // 编辑模式：减少数值
+            if (threshold_temp > 0)
+                threshold_temp--;
         }
         else
         {
-            // 编辑模式下，菜单项只显示参数名，数值在右侧大区域显示
-            sprintf((char *)menu_items[0], "1.FTh");
-            sprintf((char *)menu_items[1], "2.MLoss");
-            sprintf((char *)menu_items[2], "3.TTh");
+            // 选择模式：向下移动菜单项
+            threshold_index = (threshold_index + 1) % THRESHOLD_ITEMS_COUNT;
         }
-
-        // 按键处理
-        if (key == key_up)
+    }
+    else if (key == key_enter)
+    {
+        if (threshold_edit)
         {
-            if (edit_mode)
+            // 保存编辑的值
+            switch (threshold_index)
             {
-                // 编辑模式：增加数值
-                if (temp_value < 99)
-                    temp_value++;
-            }
-            else
-            {
-                // 选择模式：向上移动菜单项
-                menu_index = (menu_index > 0) ? (menu_index - 1) : (MENU_ITEMS_COUNT - 1);
-                Delay_ms(20);
+            case 0:
+                g_front_chip_threshold = threshold_temp;
+                break;
+            case 1:
+                g_middle_loss_max = threshold_temp;
+                break;
+            case 2:
+                g_trail_empty_threshold = threshold_temp;
+                break;
             }
+            threshold_edit = 0;
         }
-        else if (key == key_down)
+        else if (threshold_index < 3) // 可编辑项
         {
-            if (edit_mode)
-            {
-                // 编辑模式：减少数值
-                if (temp_value > 0)
-                    temp_value--;
-            }
-            else
+            threshold_edit = 1;
+            switch (threshold_index)
             {
-                // 选择模式：向下移动菜单项
-                menu_index = (menu_index + 1) % MENU_ITEMS_COUNT;
-                Delay_ms(20);
+            case 0:
+                threshold_temp = g_front_chip_threshold;
+                break;
+            case 1:
+                threshold_temp = g_middle_loss_max;
+                break;
+            case 2:
+                threshold_temp = g_trail_empty_threshold;
+                break;
             }
         }
-        else if (key == key_enter)
+        else // BACK
         {
-            if (edit_mode)
-            {
-                // 保存编辑的值
-                switch (menu_index)
-                {
-                case 0:
-                    g_front_chip_threshold = temp_value;
-                    break;
-                case 1:
-                    g_middle_loss_max = temp_value;
-                    break;
-                case 2:
-                    g_trail_empty_threshold = temp_value;
-                    break;
-                }
-                edit_mode = 0;
-                // 更新显示文本
-                char new_menu_0[16], new_menu_1[16], new_menu_2[16];
-                sprintf(new_menu_0, "1.FrontTh:%d", g_front_chip_threshold);
-                sprintf(new_menu_1, "2.MidLoss:%d", g_middle_loss_max);
-                sprintf(new_menu_2, "3.TrailTh:%d", g_trail_empty_threshold);
-                // 复制新值到显示数组
-                sprintf(menu_items[0], "%s", new_menu_0);
-                sprintf(menu_items[1], "%s", new_menu_1);
-                sprintf(menu_items[2], "%s", new_menu_2);
-            }
-            else
-            {
-                if (menu_index < 3) // 可编辑项
-                {
-                    edit_mode = 1;
-                    switch (menu_index)
-                    {
-                    case 0:
-                        temp_value = g_front_chip_threshold;
-                        break;
-                    case 1:
-                        temp_value = g_middle_loss_max;
-                        break;
-                    case 2:
-                        temp_value = g_trail_empty_threshold;
-                        break;
-                    }
-                }
-                else // BACK
-                {
-                    Menu_Refresh();
-                    return;
-                }
-            }
+            Screen_Pop();
+            return;
         }
-        else if (key == key_back)
+    }
+    else if (key == key_back)
+    {
+        if (threshold_edit)
         {
-            if (edit_mode)
-            {
-                edit_mode = 0; // 取消编辑
-            }
-            else
-            {
-                Menu_Refresh();
-                return; // 退出设置
-            }
+            threshold_edit = 0; // 取消编辑
+        }
+        else
+        {
+            Screen_Pop(); // 退出设置
+            return;
         }
-
-        Delay_ms(1);
     }
+
+    Screen_Invalidate();
 }
 
+/*阈值设置界面*/
+static const Screen_t threshold_screen = {Threshold_Enter, Threshold_Update, Threshold_Render, NULL};
+
 /**
- * @brief 设置时间
- * @param  无
- * @retval 无
- * @note  时间保存在全局变量 g_current_time 中，退出后继续运行
+ * 函    数：阈值设置
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：动态调整统计阈值参数
  */
-void Func_SetTime(void)
+void Func_ThresholdSettings(void)
+{
+    Screen_Push(&threshold_screen);
+}
+
+/*时间设置界面状态*/
+static uint8_t set_time_shown_second = 0xFF; // 屏幕上显示的秒数
+
+/**
+ * 函    数：时间设置界面 - 显示当前全局时间
+ * 参    数：无
+ * 返 回 值：无
+ */
+static void SetTime_ShowTime(void)
+{
+    char time_str[16]; // 接收最后显示时间字符串
+
+    Format_Sprintf(time_str, sizeof(time_str), "%02d:%02d:%02d", g_current_time.hour, g_current_time.minute, g_current_time.second);
+    OLED_ShowString(32, 32, time_str, OLED_8X16);
+    set_time_shown_second = g_current_time.second;
+}
+
+/**
+ * 函    数：时间设置界面 - 绘制
+ * 参    数：无
+ * 返 回 值：无
+ */
+static void SetTime_Render(void)
 {
     // 显示常量
-    OLED_Clear();
     OLED_ShowString(32, 0, "Set Time", OLED_8X16);
     OLED_ShowString(0, 16, "OK:Get", OLED_8X16);
     OLED_ShowString(52, 16, "BACK:Quit", OLED_8X16);
+    SetTime_ShowTime();
+}
 
+/**
+ * 函    数：时间设置界面 - 更新
+ * 参    数：key - 按键事件
+ * 返 回 值：无
+ * 说    明：时间由主循环每秒走时，这里只在秒数变化时重绘
+ */
+static void SetTime_Update(Key_action key)
+{
     // 接收变量
     char time_buffer[20];   // 接收esp8266返回的时间戳字符串
     uint32_t timestamp = 0; // 接收转换后的时间戳数据
-    char time_str[16];      // 接收最后显示时间字符串
-
-    // 显示当前全局时间
-    sprintf(time_str, "%02d:%02d:%02d", g_current_time.hour, g_current_time.minute, g_current_time.second);
-    OLED_ClearArea(0, 32, 128, 16);
-    OLED_ShowString(32, 32, time_str, OLED_8X16);
-    OLED_Update();
-    Delay_ms(500);
 
-    // 创建非阻塞定时
-    DelayTimer timer_1s;          // 创建一个1秒定时器
-    Delay_Start(&timer_1s, 1000); // 启动1秒定时器
-
-    while (1)
+    if (key == key_back)
     {
-        Key_Status_Process();                   // 调用按键状态处理
-        Key_action key = Key_Get_Press_Event(); // 获取按键事件
-        CYZ_Receiver_Process();                 // 处理接收到的特定数据包
+        Screen_Pop(); // 返回键（时间继续在后台运行）
+        return;
+    }
 
-        if (key == key_enter)
-        {
-            // 发送获取时间指令
-            USART1_ClearRxBuffer();            // 清空接收缓冲区
-            USART1_SendString("GET_TIME\r\n"); // 发送获取时间指令
-            OLED_ShowString(0, 48, "Syncing...", OLED_8X16);
-            OLED_Update();
-            Delay_ms(10);
-            USART1_ReceiveLine(time_buffer, 20, 1000); // 接收时间戳字符串
-            if (time_buffer[0] != '\0')                // 如果接收到时间戳
-            {
-                Parse_Timestamp(time_buffer, &timestamp);       // 解析时间戳函数
-                TimestampToTime(timestamp, &g_current_time, 0); // 时间戳转换为全局时间信息
-                OLED_ShowString(0, 48, "Syncing ok", OLED_8X16);
-                OLED_Update();
-            }
-        }
-        // 每过一秒刷新一次显示（时间在后台持续运行）
-        if (Delay_Check(&timer_1s)) // 每过一秒,执行一次(非阻塞延时)
+    if (key == key_enter)
+    {
+        // 发送获取时间指令
+        USART1_ClearRxBuffer();            // 清空接收缓冲区
+        USART1_SendString("GET_TIME\r\n"); // 发送获取时间指令
+        OLED_ShowString(0, 48, "Syncing...", OLED_8X16);
+        OLED_Update();
+        Delay_ms(10);
+        USART1_ReceiveLine(time_buffer, 20, 1000); // 接收时间戳字符串
+        if (time_buffer[0] != '\0')                // 如果接收到时间戳
         {
-            // 更新显示（显示全局时间）
-            sprintf(time_str, "%02d:%02d:%02d", g_current_time.hour, g_current_time.minute, g_current_time.second);
-            OLED_ClearArea(0, 35, 128, 16);
-            OLED_ShowString(32, 32, time_str, OLED_8X16);
-            OLED_Update();
-            Delay_Start(&timer_1s, 1000); // 重置延时
+            Parse_Timestamp(time_buffer, &timestamp);       // 解析时间戳函数
+            TimestampToTime(timestamp, &g_current_time, 0); // 时间戳转换为全局时间信息
+            OLED_ShowString(0, 48, "Syncing ok", OLED_8X16);
         }
+    }
 
-        if (key == key_back)
-            break; // 返回键（时间继续在后台运行）
+    if (g_current_time.second != set_time_shown_second)
+    {
+        SetTime_ShowTime();
     }
+}
 
-    Menu_Refresh();
+/*时间设置界面*/
+static const Screen_t set_time_screen = {NULL, SetTime_Update, SetTime_Render, NULL};
+
+/**
+ * @brief 设置时间
+ * @param  无
+ * @retval 无
+ * @note  时间保存在全局变量 g_current_time 中，退出后继续运行
+ */
+void Func_SetTime(void)
+{
+    Screen_Push(&set_time_screen);
 }
 
 /**
@@ -554,62 +658,53 @@ void Func_Snake_Game(void)
 }
 
 /**
- * 函    数：ESP8266测试
+ * 函    数：上传数据界面 - 绘制
  * 参    数：无
  * 返 回 值：无
- **/
-void Func_Updata_Esp8266(void)
+ */
+static void Upload_Render(void)
 {
-    OLED_Clear();
     OLED_ShowString(20, 0, "UPLOAD DATA", OLED_8X16);
     OLED_ShowString(10, 50, "Press OK to Upload", OLED_6X8);
-    OLED_Update();
-
-    /*构建JSON格式包进行发送*/
-    // DataPacket_t packet;
-    // DataForward_Init(); // 初始化数据转发模块
-    // DataForward_SetFormat(FORMAT_JSON); // 设置数据格式为JSON
-    // DataForward_EnableTimestamp(false); // 禁用时间戳
-    // DataForward_EnablePrettyJson(ENABLE); // JSON美化
-
-    // DataPacket_Init(&packet); // 初始化数据包
-    // DataPacket_AddInt(&packet, "chip_count", 269);
-    // DataPacket_AddInt(&packet, "loss_count", 3);
-    // DataPacket_AddInt(&packet, "extra_count", 2);
-    // DataPacket_AddInt(&packet, "lead_empty_count", 1);
+}
 
+/**
+ * 函    数：上传数据界面 - 更新
+ * 参    数：key - 按键事件
+ * 返 回 值：无
+ */
+static void Upload_Update(Key_action key)
+{
     char str[32];
-    Key_action key; // 声明按键变量
-    // 等待返回键
-    while (1)
-    {
-        Key_Status_Process();        // 调用按键状态处理
-        key = Key_Get_Press_Event(); // 获取按键事件
-
-        if (key == key_enter)
-        {
 
-            OLED_ClearArea(0, 16, 128, 48);
-            snprintf(str, sizeof(str), "Begin upload...");
-            OLED_ShowString(4, 17, str, OLED_8X16);
-            OLED_Update();
-            ESP8266_UploadDataPoints(&g_statistics); // 上传数据点
-            // DataForward_SendPacket(&packet); // 发送JSON数据包
-            snprintf(str, sizeof(str), "Upload success");
-            OLED_ClearArea(4, 17, 128, 16);
-            OLED_ShowString(8, 17, str, OLED_8X16);
-            OLED_Update();
-        }
-
-        if (key == key_back) // 返回键
-        {
-            break;
-        }
-        CYZ_Receiver_Process(); // 处理接收到的特定数据包
-        Delay_ms(1);
+    if (key == key_enter)
+    {
+        OLED_ClearArea(0, 16, 128, 48);
+        Format_Sprintf(str, sizeof(str), "Begin upload...");
+        OLED_ShowString(4, 17, str, OLED_8X16);
+        OLED_Update();
+        ESP8266_UploadDataPoints(&g_statistics); // 上传数据点
+        Format_Sprintf(str, sizeof(str), "Upload success");
+        OLED_ClearArea(4, 17, 128, 16);
+        OLED_ShowString(8, 17, str, OLED_8X16);
+    }
+    else if (key == key_back) // 返回键
+    {
+        Screen_Pop();
     }
+}
 
-    Menu_Refresh();
+/*上传数据界面*/
+static const Screen_t upload_screen = {NULL, Upload_Update, Upload_Render, NULL};
+
+/**
+ * 函    数：ESP8266测试
+ * 参    数：无
+ * 返 回 值：无
+ **/
+void Func_Updata_Esp8266(void)
+{
+    Screen_Push(&upload_screen);
 }
 /**
  * 函    数：ADC测试
@@ -623,226 +718,289 @@ void Func_ADC_Test(void)
     show_adc_display();
     Menu_Refresh();
 }
+/*温湿度界面状态*/
+static Widget_t dht_temp_label, dht_humi_label;
+static uint8_t dht_have_data = 0; // 0：尚未读到数据，显示"Reading..."
+static DelayTimer dht_read_gap;   // 读取间隔定时器
+
 /**
- * 函    数：读取温湿度信息
+ * 函    数：温湿度界面 - 进入
  * 参    数：无
  * 返 回 值：无
- **/
-void Func_Read_Temp(void)
+ */
+static void ReadTemp_Enter(void)
 {
-    OLED_Clear();
-    OLED_ShowString(24, 24, "Reading...", OLED_8X16);
-    OLED_Update();
-    DelayTimer updata_dht11_gap;
-    Delay_Start(&updata_dht11_gap, 1200); // 每个1.2秒读取一次
-    while (1)
-    {
-        Key_Status_Process(); // 调用按键状态处理
+    dht_have_data = 0;
+    Delay_Start(&dht_read_gap, 1200); // 每个1.2秒读取一次
+}
 
-        if (Delay_Check(&updata_dht11_gap))
-        {
-            // 读取DHT11数据
-            if (DHT11_Read_Data(&DHT11_Data) == 0)
-            {
-                break;
-            }
-            // 清屏
-            OLED_Clear();
-            // 1. 标题行（顶部）
-            OLED_ShowString(16, 0, "DHT11 SENSOR", OLED_8X16);
-            // 2. 温度显示（左侧）
-            OLED_ShowString(16, 16, "TEMP", OLED_8X16);
-            // 温度数值区域
-            char temp_str[8];
-            sprintf(temp_str, "%02d.%d", DHT11_Data.temperature_int, DHT11_Data.temperature_dec);
-            OLED_ShowString(16, 32, temp_str, OLED_8X16);
-            OLED_ShowString(48, 32, "C", OLED_8X16);
-            OLED_ShowString(72, 16, "HUMI", OLED_8X16);
-            // 湿度数值区域
-            char humi_str[8];
-            sprintf(humi_str, "%02d.%d", DHT11_Data.humidity_int, DHT11_Data.humidity_dec);
-            OLED_ShowString(72, 32, humi_str, OLED_8X16);
-            OLED_ShowString(104, 32, "%", OLED_8X16);
-            OLED_ShowString(38, 56, "OK:Upload", OLED_6X8);
-            OLED_Update();
-            Delay_Start(&updata_dht11_gap, 1200);
-        }
+/**
+ * 函    数：温湿度界面 - 显示数值
+ * 参    数：无
+ * 返 回 值：无
+ */
+static void ReadTemp_ShowData(void)
+{
+    char str[8];
+
+    // 温度数值区域
+    Format_Sprintf(str, sizeof(str), "%02d.%d", DHT11_Data.temperature_int, DHT11_Data.temperature_dec);
+    Widget_SetText(&dht_temp_label, str);
+    // 湿度数值区域
+    Format_Sprintf(str, sizeof(str), "%02d.%d", DHT11_Data.humidity_int, DHT11_Data.humidity_dec);
+    Widget_SetText(&dht_humi_label, str);
+}
 
-        // 获取按键事件（只调用一次，避免消费事件）
-        Key_action key = Key_Get_Press_Event(); // 获取按键事件
+/**
+ * 函    数：温湿度界面 - 绘制
+ * 参    数：无
+ * 返 回 值：无
+ */
+static void ReadTemp_Render(void)
+{
+    if (!dht_have_data)
+    {
+        OLED_ShowString(24, 24, "Reading...", OLED_8X16);
+        return;
+    }
 
-        // 按下返回键退出
-        if (key == key_back)
-            break; // 返回键退出
+    // 1. 标题行（顶部）
+    OLED_ShowString(16, 0, "DHT11 SENSOR", OLED_8X16);
+    // 2. 温度显示（左侧）
+    OLED_ShowString(16, 16, "TEMP", OLED_8X16);
+    OLED_ShowString(48, 32, "C", OLED_8X16);
+    OLED_ShowString(72, 16, "HUMI", OLED_8X16);
+    OLED_ShowString(104, 32, "%", OLED_8X16);
+    OLED_ShowString(38, 56, "OK:Upload", OLED_6X8);
+    Widget_InitLabel(&dht_temp_label, 16, 32, OLED_8X16);
+    Widget_InitLabel(&dht_humi_label, 72, 32, OLED_8X16);
+    ReadTemp_ShowData();
+}
 
-        // 按下OK键发送温湿度数据到云端
-        if (key == key_enter)
+/**
+ * 函    数：温湿度界面 - 更新
+ * 参    数：key - 按键事件
+ * 返 回 值：无
+ */
+static void ReadTemp_Update(Key_action key)
+{
+    if (Delay_Check(&dht_read_gap))
+    {
+        // 读取DHT11数据，读取失败时退出
+        if (DHT11_Read_Data(&DHT11_Data) == 0)
+        {
+            Screen_Pop();
+            return;
+        }
+        if (!dht_have_data)
         {
-            ESP8266_SendDHT11Data();                            // 发送温湿度数据
-            OLED_Clear();                                       // 清空屏幕
-            OLED_ShowString(16, 16, "Success send", OLED_8X16); // 显示"Temp:"
-            OLED_Update();                                      // 刷新显示
-            Delay_ms(200);                                      // 延时一段时间，以便观察数据
+            dht_have_data = 1;
+            Screen_Invalidate(); // 第一次读到数据，绘制完整界面
         }
-        CYZ_Receiver_Process(); // 处理接收到的特定数据包
+        else
+        {
+            ReadTemp_ShowData();
+        }
+        Delay_Start(&dht_read_gap, 1200);
+    }
+
+    // 按下返回键退出
+    if (key == key_back)
+    {
+        Screen_Pop();
+        return;
+    }
+
+    // 按下OK键发送温湿度数据到云端
+    if (key == key_enter)
+    {
+        ESP8266_SendDHT11Data();                            // 发送温湿度数据
+        OLED_Clear();                                       // 清空屏幕
+        OLED_ShowString(16, 16, "Success send", OLED_8X16); // 显示"Temp:"
+        OLED_Update();                                      // 刷新显示
+        Delay_ms(200);                                      // 延时一段时间，以便观察数据
+        Screen_Invalidate();                                // 提示覆盖了界面，重新绘制
     }
-    Menu_Refresh();
 }
+
+/*温湿度界面*/
+static const Screen_t read_temp_screen = {ReadTemp_Enter, ReadTemp_Update, ReadTemp_Render, NULL};
+
 /**
- * 函    数：关于系统
+ * 函    数：读取温湿度信息
+ * 参    数：无
+ * 返 回 值：无
+ **/
+void Func_Read_Temp(void)
+{
+    Screen_Push(&read_temp_screen);
+}
+
+/**
+ * 函    数：关于界面 - 绘制
  * 参    数：无
  * 返 回 值：无
  */
-void Func_About(void)
+static void About_Render(void)
 {
-    OLED_Clear();
     OLED_ShowString(0, 0, "Tape Carrier", OLED_8X16);
     OLED_ShowString(0, 16, "Chip Counter", OLED_8X16);
     OLED_ShowString(0, 32, "V6.6.8", OLED_8X16);
     OLED_ShowString(0, 48, "Press BACK", OLED_8X16);
-    OLED_Update();
-
-    // 等待返回键
-    while (Key_Get_Press_Event() != key_back)
-    {
-        Key_Status_Process();
-        CYZ_Receiver_Process(); // 处理接收到的特定数据包
-    }
-
-    Menu_Refresh();
 }
 
+/*关于界面*/
+static const Screen_t about_screen = {NULL, InfoScreen_Update, About_Render, NULL};
+
 /**
- * 函    数：芯片类型设置
+ * 函    数：关于系统
  * 参    数：无
  * 返 回 值：无
- * 说    明：选择不同的载带类型（支持多种载带类型，预留扩展）
  */
-void Func_CarrierType(void)
+void Func_About(void)
 {
-    // uint8_t menu_index = 0;                    // 当前显示的菜单项索引
-    uint8_t current_selection = carrier_class; // 当前选择的载带类型
-    uint8_t display_start = 0;                 // 显示起始位置（用于滚动）
-    char page_info[8];                         // 页面信息字符串
-
-    // 载带类型名称数组
-    const char *carrier_names[] = {
-        "MSOP Carrier",  // CARRIER_MSOP
-        "SOT  Carrier",  // CARRIER_SOP
-        "QFP  Carrier",  // CARRIER_QFP
-        "DFN  Carrier",  // CARRIER_DFN
-        "QFN  Carrier",  // CARRIER_QFN
-        "LQFP Carrier",  // CARRIER_LQFP
-        "TSSOP Carrier", // CARRIER_TSSOP
-        "SSOP Carrier",  // CARRIER_SSOP
-    };
+    Screen_Push(&about_screen);
+}
 
-// 定义每页显示的数量
-#define CARRIER_PAGE_SIZE 4
-// 定义总数量
-#define CARRIER_TOTAL_COUNT (sizeof(carrier_names) / sizeof(carrier_names[0]))
+/*载带类型名称，顺序与carrier_class_t一致*/
+static const char *const carrier_names[CARRIER_COUNT] = {
+    "MSOP Carrier",  // CARRIER_MSOP
+    "SOT  Carrier",  // CARRIER_SOP
+    "QFP  Carrier",  // CARRIER_QFP
+    "DFN  Carrier",  // CARRIER_DFN
+    "QFN  Carrier",  // CARRIER_QFN
+    "LQFP Carrier",  // CARRIER_LQFP
+    "TSSOP Carrier", // CARRIER_TSSOP
+    "SSOP Carrier",  // CARRIER_SSOP
+};
 
-    while (1)
-    {
-        Key_Status_Process();
-        Key_action key = Key_Get_Press_Event();
+/**
+ * 函    数：载带类型列表 - 行数
+ * 参    数：无
+ * 返 回 值：载带类型数量
+ */
+static uint16_t Carrier_Count(void)
+{
+    return CARRIER_COUNT;
+}
 
-        CYZ_Receiver_Process();
+/**
+ * 函    数：载带类型列表 - 生成行文本
+ * 参    数：index - 行号
+ *          buf, size - 输出缓冲区
+ * 返 回 值：无
+ */
+static void Carrier_GetRow(uint16_t index, char *buf, uint8_t size)
+{
+    Format_Sprintf(buf, size, "%s", carrier_names[index]);
+}
 
-        // 显示菜单
-        OLED_Clear();
-        OLED_ShowString(0, 0, "Carrier Type", OLED_8X16);
+/**
+ * 函    数：载带类型列表 - 保存选择
+ * 参    数：index - 选中的行号
+ * 返 回 值：1，保存后关闭列表
+ */
+static uint8_t Carrier_Select(uint16_t index)
+{
+    // 保存选择的载带类型
+    carrier_class = (carrier_class_t)index;
 
-        // 计算滚动显示
-        if (current_selection >= display_start + CARRIER_PAGE_SIZE)
-        {
-            display_start = current_selection - CARRIER_PAGE_SIZE + 1;
-        }
-        if (current_selection < display_start)
-        {
-            display_start = current_selection;
-        }
+    // 显示保存成功提示
+    OLED_Clear();
+    OLED_ShowString(8, 16, "Succeed Saved!", OLED_8X16);
+    OLED_ShowString(28, 32, (char *)carrier_names[index], OLED_6X8);
+    OLED_Update();
+    Delay_ms(1000);
+    return 1;
+}
 
-        // 显示载带类型选项（支持滚动）
-        for (uint8_t i = 0; i < CARRIER_PAGE_SIZE; i++)
-        {
-            uint8_t real_index = display_start + i;
-            if (real_index >= CARRIER_TOTAL_COUNT)
-                break;
+/**
+ * 函    数：载带类型列表 - 初始选中行
+ * 参    数：无
+ * 返 回 值：当前载带类型
+ */
+static uint16_t Carrier_Initial(void)
+{
+    return carrier_class;
+}
 
-            uint8_t y_pos = 16 + (i * 10);
-            if (real_index == current_selection)
-            {
-                OLED_ShowString(0, y_pos, ">", OLED_6X8);
-            }
-            else
-            {
-                OLED_ShowString(0, y_pos, " ", OLED_6X8);
-            }
-            OLED_ShowString(8, y_pos, (char *)carrier_names[real_index], OLED_6X8);
-        }
+/*芯片类型设置：选择不同的载带类型（支持多种载带类型，预留扩展）*/
+const MenuListProvider_t carrier_list = {Carrier_Count, Carrier_GetRow, Carrier_Select, Carrier_Initial};
 
-        // 显示页码信息（当前选中的序号/总数）
-        sprintf(page_info, "%d/%d", current_selection + 1, CARRIER_TOTAL_COUNT);
-        OLED_ShowString(110, 4, page_info, OLED_6X8);
+/**
+ * 函    数：报警界面 - 更新
+ * 参    数：key - 按键事件
+ * 返 回 值：无
+ * 说    明：确认键继续计数，回到下层界面（关闭弹窗后自动重建）；
+ *          返回键暂停计数，通过force_update_display通知实时统计界面一起关闭
+ */
+static void Alarm_Update(Key_action key)
+{
+    if (key == key_enter)
+    {
+        /*用户确认继续，恢复计数*/
+        Statistics_Resume();
+        Screen_Pop();
+    }
+    else if (key == key_back)
+    {
+        /*用户取消，暂停计数，返回菜单*/
+        // Sensor_EnableCounting(0);
+        Statistics_Pause();
+        g_statistics.force_update_display = 1; // 强制更新标志
+        Screen_Pop();
+    }
+}
 
-        // 操作提示
-        OLED_ShowString(0, 56, "UP/DOWN SelectOK Save", OLED_6X8);
-        OLED_Update();
+/**
+ * 函    数：缺失报警界面 - 绘制
+ * 参    数：无
+ * 返 回 值：无
+ */
+static void Missing_Render(void)
+{
+    OLED_ShowString(0, 0, "[*] Missing!", OLED_6X8);
+    OLED_ShowString(0, 16, "Chip Missing", OLED_8X16);
+    Menu_ShowCount(0, 32, "LOSS: ", Statistics_GetData()->Middle_LOSS);
+    OLED_ShowString(0, 48, "OK:Continue", OLED_8X16);
+}
 
-        // 按键处理
-        if (key == key_up)
-        {
-            if (current_selection > 0)
-            {
-                current_selection--;
-            }
-            Delay_ms(50);
-        }
-        else if (key == key_down)
-        {
-            if (current_selection < CARRIER_TOTAL_COUNT - 1)
-            {
-                current_selection++;
-            }
-            Delay_ms(50);
-        }
-        else if (key == key_enter)
-        {
-            // 保存选择的载带类型
-            carrier_class = (carrier_class_t)current_selection;
+/*缺失报警界面*/
+static const Screen_t missing_screen = {NULL, Alarm_Update, Missing_Render, NULL};
 
-            // 显示保存成功提示
-            OLED_Clear();
-            OLED_ShowString(8, 16, "Succeed Saved!", OLED_8X16);
-            if (current_selection < CARRIER_TOTAL_COUNT)
-            {
-                OLED_ShowString(28, 32, (char *)carrier_names[current_selection], OLED_6X8);
-            }
-            OLED_Update();
-            Delay_ms(1000);
-            Menu_Refresh();
-            return;
-        }
-        else if (key == key_back)
-        {
-            Menu_Refresh();
-            return;
-        }
-    }
+/**
+ * 函    数：多余芯片报警界面 - 绘制
+ * 参    数：无
+ * 返 回 值：无
+ */
+static void ExtraChip_Render(void)
+{
+    OLED_ShowString(0, 0, "[*] Extra Chip!", OLED_6X8);
+    OLED_ShowString(0, 16, "Extra Chip", OLED_8X16);
+    OLED_ShowString(0, 32, "Detected", OLED_8X16);
+    Menu_ShowCount(0, 48, "ADD: ", Statistics_GetData()->Lead_Tail_ADD);
 }
 
+/*多余芯片报警界面*/
+static const Screen_t extra_chip_screen = {NULL, Alarm_Update, ExtraChip_Render, NULL};
+
 /**
  * 函    数：缺失检测回调函数
  * 参    数：无
  * 返 回 值：无
- * 说    明：当检测到缺失时，蜂鸣器响三次，暂停计数，等待用户确认
+ * 说    明：当检测到缺失时，蜂鸣器响三次，暂停计数，弹出确认界面
+ *         在主循环中调用（Statistics_DispatchAlarms），弹窗打开期间计数在PendSV中照常进行，
+ *         报警界面已显示时不再重复报警
  *         注意：Middle_LOSS统计不会清除
  */
 void Statistics_OnMissingDetected(void)
 {
     StatisticsData_t *data = Statistics_GetData();
-    char str[32];
+
+    if (Screen_Top() == &missing_screen)
+    {
+        return;
+    }
 
     /*暂停计数*/
     data->is_beginning = 1;
@@ -850,56 +1008,26 @@ void Statistics_OnMissingDetected(void)
     /*蜂鸣器响三次*/
     Buzzer_Beep(3, 200, 100); // 响3次，每次200ms，间隔100ms
 
-    /*显示确认界面*/
-    OLED_Clear();
-    OLED_ShowString(0, 0, "[*] Missing!", OLED_6X8);
-    OLED_ShowString(0, 16, "Chip Missing", OLED_8X16);
-    sprintf(str, "LOSS: %lu", data->Middle_LOSS);
-    OLED_ShowString(0, 32, str, OLED_8X16);
-    OLED_ShowString(0, 48, "OK:Continue", OLED_8X16);
-    OLED_Update();
-
-    /*等待用户确认*/
-    while (1)
-    {
-        Key_Status_Process();
-        Key_action key = Key_Get_Press_Event();
-
-        if (key == key_enter)
-        {
-            /*用户确认继续，恢复计数*/
-            Statistics_Resume();
-            break;
-        }
-        else if (key == key_back)
-        {
-            /*用户取消，保持暂停状态，返回菜单*/
-            // g_live_counting_active = 0;
-            // Sensor_EnableCounting(0);
-            Statistics_Pause();
-            Menu_Refresh();
-            g_statistics.force_update_display = 1; // 强制更新标志
-            // return;
-            break;
-        }
-
-        Delay_ms(10);
-    }
-
-    /*恢复显示实时统计界面*/
-    // 显示会在主循环中自动更新
+    /*显示确认界面，关闭后实时统计界面自动重建*/
+    Screen_Push(&missing_screen);
 }
 
 /**
  * 函    数：多余芯片检测回调函数
  * 参    数：无
  * 返 回 值：无
- * 说    明：当检测到前后空阶段的多余芯片时，蜂鸣器响三次，暂停计数，等待确认
+ * 说    明：当检测到前后空阶段的多余芯片时，蜂鸣器响三次，暂停计数，弹出确认界面
+ *         在主循环中调用（Statistics_DispatchAlarms），报警界面已显示时不再重复报警（ADD计数照常增加）
+ *         注意：后导空阶段继续，不会回到中间阶段
  */
 void Statistics_OnExtraChipDetected(void)
 {
     StatisticsData_t *data = Statistics_GetData();
-    char str[32];
+
+    if (Screen_Top() == &extra_chip_screen)
+    {
+        return;
+    }
 
     /*暂停计数*/
     data->is_beginning = 1;
@@ -907,42 +1035,6 @@ void Statistics_OnExtraChipDetected(void)
     /*蜂鸣器响三次*/
     Buzzer_Beep(3, 200, 100); // 响3次，每次200ms，间隔100ms
 
-    /*显示确认界面*/
-    OLED_Clear();
-    OLED_ShowString(0, 0, "[*] Extra Chip!", OLED_6X8);
-    OLED_ShowString(0, 16, "Extra Chip", OLED_8X16);
-    OLED_ShowString(0, 32, "Detected", OLED_8X16);
-    sprintf(str, "ADD: %lu", data->Lead_Tail_ADD);
-    OLED_ShowString(0, 48, str, OLED_8X16);
-    OLED_Update();
-
-    /*等待用户确认*/
-    while (1)
-    {
-        Key_Status_Process();
-        Key_action key = Key_Get_Press_Event();
-        if (key == key_enter)
-        {
-            /*用户确认继续，恢复计数*/
-            Statistics_Resume();
-            break;
-        }
-        else if (key == key_back)
-        {
-            /*用户取消，保持暂停状态，返回菜单*/
-            // g_live_counting_active = 0;
-            // Sensor_EnableCounting(0);
-            Statistics_Pause();
-            Menu_Refresh();
-            g_statistics.force_update_display = 1;
-            // return;
-            break;
-        }
-
-        Delay_ms(10);
-    }
-
-    /*恢复显示实时统计界面*/
-    // 显示会在主循环中自动更新
-    // 注意：后导空阶段继续，不会回到中间阶段
+    /*显示确认界面，关闭后实时统计界面自动重建*/
+    Screen_Push(&extra_chip_screen);
 }
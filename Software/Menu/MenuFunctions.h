@@ -5,9 +5,12 @@
 #include "Sensor.h"
 #include "Statistics.h"
 #include "OLED.h"
+#include "Widget.h"
+#include "Mirror.h"
 #include "Key_multi.h"
 #include "Delay.h"
 #include "Menu.h"
+#include "Screen.h"
 #include "Buzzer.h"
 #include <stdio.h>
 #include "esp8266.h"
@@ -22,20 +25,25 @@
 #include "GAME_SNAKE.h"
 #include "GAME_TETRIS.h"
 
+/*实时统计界面刷新上限（Hz），两帧之间主循环全速处理计数*/
+#define LIVE_REFRESH_HZ 15
+
 /*菜单功能回调函数声明*/
 void Func_LiveCounting(void);      // 实时统计
 void Func_LastResult(void);        // 上一次数据查看
-void Func_ViewHistory(void);       // 查看历史
 void Func_SensorCalibration(void); // 传感器校准
 void Func_ResetCounters(void);     // 计数清零
 void Func_ThresholdSettings(void); // 阈值设置
 void Func_SetTime(void);           // 时间设置
-void Func_CarrierType(void);       // 载带类型设置
 void Func_Updata_Esp8266(void);    // ESP8266
 void Func_ADC_Test(void);          // ADC测试
 void Func_Read_Temp(void);         // 读取内部温度传感器
 void Func_About(void);             // 关于系统
 
+/*虚拟列表数据提供者*/
+extern const MenuListProvider_t history_list; // 历史记录
+extern const MenuListProvider_t carrier_list; // 载带类型设置
+
 /*实时统计相关函数*/
 void LiveCounting_Display(void); // 显示实时统计界面
 // void LiveCounting_Start(void);         // 开始计数
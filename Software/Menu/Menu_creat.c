@@ -37,52 +37,58 @@ uint8_t Menu_GetAutoUploadStatus(void)
 {
     return auto_upload_enable;
 }
-/*简化菜单创建 - 使用菜单定义表*/
-void Menu_Setup(void)
-{
-    /*定义菜单表
-     * 格式：{名称, 类型, 父菜单ID, 回调函数, 数值指针, 最小值, 最大值, 开关指针}
-     * ID从1开始，0表示根菜单
-     * 父菜单ID指向菜单表中的索引（从根菜单开始自身ID号从1开始按照顺序计数）
-     */
-    MenuDef_t menu_table[] = {
-        // ID=1: 根菜单
-        {"Main_Menu", MENU_TYPE_NORMAL, 0, NULL, NULL, 0, 0, NULL},
 
-        // 一级菜单（父菜单ID=1）
-        {"1.Live_Counting", MENU_TYPE_FUNC, 1, Func_LiveCounting, NULL, 0, 0, NULL}, // 实时统计
-        {"2.View_Data", MENU_TYPE_NORMAL, 1, NULL, NULL, 0, 0, NULL},                // 数据查看
-        {"3.Settings", MENU_TYPE_NORMAL, 1, NULL, NULL, 0, 0, NULL},                 // 系统设置
-        {"4.Game", MENU_TYPE_NORMAL, 1, NULL, NULL, 0, 0, NULL},                     // 游戏
-        {"5.Upload_Data", MENU_TYPE_FUNC, 1, Func_Updata_Esp8266, NULL, 0, 0, NULL},
-        {"6.ADC_display", MENU_TYPE_FUNC, 1, Func_ADC_Test, NULL, 0, 0, NULL},
-        {"7.DHT11_Read", MENU_TYPE_FUNC, 1, Func_Read_Temp, NULL, 0, 0, NULL},
-        {"8.About", MENU_TYPE_FUNC, 1, Func_About, NULL, 0, 0, NULL}, // 关于系统
+/*定义菜单表
+ * 格式：{名称, 类型, 父菜单ID, 回调函数, 数值指针, 最小值, 最大值, 开关指针, 列表数据提供者}
+ * 列表数据提供者只有MENU_TYPE_LIST类型使用，其他类型填NULL
+ * ID从1开始，0表示根菜单
+ * 父菜单ID指向菜单表中的索引（从根菜单开始自身ID号从1开始按照顺序计数）
+ * 修改后运行 python menu_gen.py Menu_creat.c -o Menu_tree.h 重新生成常量菜单树
+ */
+static const MenuDef_t menu_table[] = {
+    // ID=1: 根菜单
+    {"Main_Menu", MENU_TYPE_NORMAL, 0, NULL, NULL, 0, 0, NULL, NULL},
+
+    // 一级菜单（父菜单ID=1）
+    {"1.Live_Counting", MENU_TYPE_FUNC, 1, Func_LiveCounting, NULL, 0, 0, NULL, NULL}, // 实时统计
+    {"2.View_Data", MENU_TYPE_NORMAL, 1, NULL, NULL, 0, 0, NULL, NULL},                // 数据查看
+    {"3.Settings", MENU_TYPE_NORMAL, 1, NULL, NULL, 0, 0, NULL, NULL},                 // 系统设置
+    {"4.Game", MENU_TYPE_NORMAL, 1, NULL, NULL, 0, 0, NULL, NULL},                     // 游戏
+    {"5.Upload_Data", MENU_TYPE_FUNC, 1, Func_Updata_Esp8266, NULL, 0, 0, NULL, NULL},
+    {"6.ADC_display", MENU_TYPE_FUNC, 1, Func_ADC_Test, NULL, 0, 0, NULL, NULL},
+    {"7.DHT11_Read", MENU_TYPE_FUNC, 1, Func_Read_Temp, NULL, 0, 0, NULL, NULL},
+    {"8.About", MENU_TYPE_FUNC, 1, Func_About, NULL, 0, 0, NULL, NULL}, // 关于系统
 
-        // View Data子菜单（父菜单ID=2）
-        {"Last_Result", MENU_TYPE_FUNC, 3, Func_LastResult, NULL, 0, 0, NULL}, // 查看最近结果
-        {"History", MENU_TYPE_FUNC, 3, Func_ViewHistory, NULL, 0, 0, NULL},    // 查看历史 (待FlashStorage模块实现后启用)
+    // View Data子菜单（父菜单ID=2）
+    {"Last_Result", MENU_TYPE_FUNC, 3, Func_LastResult, NULL, 0, 0, NULL, NULL}, // 查看最近结果
+    {"History", MENU_TYPE_LIST, 3, NULL, NULL, 0, 0, NULL, &history_list}, // 查看历史 (待FlashStorage模块实现后填充)
 
-        // Settings子菜单（父菜单ID=3）
-        {"Calibration", MENU_TYPE_FUNC, 4, Func_SensorCalibration, NULL, 0, 0, NULL}, // 传感器校准
-        {"Reset_Count", MENU_TYPE_FUNC, 4, Func_ResetCounters, NULL, 0, 0, NULL},     // 计数清零
-        {"Carrier_Type", MENU_TYPE_FUNC, 4, Func_CarrierType, NULL, 0, 0, NULL},
-        {"Threshold", MENU_TYPE_FUNC, 4, Func_ThresholdSettings, NULL, 0, 0, NULL}, // 阈值设置
-        {"Set_Time", MENU_TYPE_FUNC, 4, Func_SetTime, NULL, 0, 0, NULL},            // 时间设置
-        {"Auto_Mode", MENU_TYPE_TOGGLE, 4, Func_AutoUploadControl, NULL, 0, 0, &auto_upload_enable},
-        {"LED", MENU_TYPE_TOGGLE, 4, Func_LEDControl, NULL, 0, 0, &led_enable}, // LED开关
+    // Settings子菜单（父菜单ID=3）
+    {"Calibration", MENU_TYPE_FUNC, 4, Func_SensorCalibration, NULL, 0, 0, NULL, NULL}, // 传感器校准
+    {"Reset_Count", MENU_TYPE_FUNC, 4, Func_ResetCounters, NULL, 0, 0, NULL, NULL},     // 计数清零
+    {"Carrier_Type", MENU_TYPE_LIST, 4, NULL, NULL, 0, 0, NULL, &carrier_list},
+    {"Threshold", MENU_TYPE_FUNC, 4, Func_ThresholdSettings, NULL, 0, 0, NULL, NULL}, // 阈值设置
+    {"Set_Time", MENU_TYPE_FUNC, 4, Func_SetTime, NULL, 0, 0, NULL, NULL},            // 时间设置
+    {"Auto_Mode", MENU_TYPE_TOGGLE, 4, Func_AutoUploadControl, NULL, 0, 0, &auto_upload_enable, NULL},
+    {"LED", MENU_TYPE_TOGGLE, 4, Func_LEDControl, NULL, 0, 0, &led_enable, NULL}, // LED开关
 
-        // game
-        {"Dinosaur_jump", MENU_TYPE_FUNC, 5, Func_Dinosaur_jump_Game, NULL, 0, 0, NULL}, // 游戏1
-        {"Snake", MENU_TYPE_FUNC, 5, Func_Snake_Game, NULL, 0, 0, NULL},                 // 游戏2
-        {"Tetris", MENU_TYPE_FUNC, 5, Func_Tetris_Game, NULL, 0, 0, NULL},               // 游戏3
-        {"FlappyBird", MENU_TYPE_FUNC, 5, Func_FlappyBird_Game, NULL, 0, 0, NULL},       // 游戏4
+    // game
+    {"Dinosaur_jump", MENU_TYPE_FUNC, 5, Func_Dinosaur_jump_Game, NULL, 0, 0, NULL, NULL}, // 游戏1
+    {"Snake", MENU_TYPE_FUNC, 5, Func_Snake_Game, NULL, 0, 0, NULL, NULL},                 // 游戏2
+    {"Tetris", MENU_TYPE_FUNC, 5, Func_Tetris_Game, NULL, 0, 0, NULL, NULL},               // 游戏3
+    {"FlappyBird", MENU_TYPE_FUNC, 5, Func_FlappyBird_Game, NULL, 0, 0, NULL, NULL},       // 游戏4
 
-    };
+};
 
-    /*从菜单表自动构建菜单树*/
-    MenuItem_t *root = Menu_BuildFromTable(menu_table, sizeof(menu_table) / sizeof(MenuDef_t));
+/*常量菜单树（Flash），由menu_gen.py根据上面的菜单表生成*/
+#include "Menu_tree.h"
 
+/*菜单表与生成的菜单树项数不一致时编译报错，提示重新运行menu_gen.py*/
+typedef char menu_tree_out_of_date[(sizeof(menu_table) / sizeof(MenuDef_t) == MENU_TREE_SIZE) ? 1 : -1];
+
+/*菜单初始化 - 菜单树已在编译时生成，无需建树*/
+void Menu_Setup(void)
+{
     /*初始化菜单系统*/
-    Menu_Init(root);
+    Menu_Init(&menu_tree[0]);
 }
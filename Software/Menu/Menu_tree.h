@@ -0,0 +1,33 @@
+/*
+ * 文件名：Menu_tree.h
+ * 描    述：常量菜单树，由menu_gen.py根据Menu_creat.c中的menu_table生成，请勿手动修改
+ *          修改菜单表后重新运行：python menu_gen.py Menu_creat.c -o Menu_tree.h
+ */
+
+#define MENU_TREE_SIZE 22
+
+static const MenuItem_t menu_tree[MENU_TREE_SIZE] = {
+    // {名称, 类型, 父菜单, 第一个子菜单, 子菜单数量, 同级序号, 回调函数, 数值指针, 最小值, 最大值, 开关指针, 列表数据提供者}
+    {"Main_Menu", MENU_TYPE_NORMAL, NULL, &menu_tree[1], 8, 0, NULL, NULL, 0, 100, NULL, NULL}, // 0: ID=1
+    {"1.Live_Counting", MENU_TYPE_FUNC, &menu_tree[0], NULL, 0, 0, Func_LiveCounting, NULL, 0, 100, NULL, NULL}, // 1: ID=2
+    {"2.View_Data", MENU_TYPE_NORMAL, &menu_tree[0], &menu_tree[9], 2, 1, NULL, NULL, 0, 100, NULL, NULL}, // 2: ID=3
+    {"3.Settings", MENU_TYPE_NORMAL, &menu_tree[0], &menu_tree[11], 7, 2, NULL, NULL, 0, 100, NULL, NULL}, // 3: ID=4
+    {"4.Game", MENU_TYPE_NORMAL, &menu_tree[0], &menu_tree[18], 4, 3, NULL, NULL, 0, 100, NULL, NULL}, // 4: ID=5
+    {"5.Upload_Data", MENU_TYPE_FUNC, &menu_tree[0], NULL, 0, 4, Func_Updata_Esp8266, NULL, 0, 100, NULL, NULL}, // 5: ID=6
+    {"6.ADC_display", MENU_TYPE_FUNC, &menu_tree[0], NULL, 0, 5, Func_ADC_Test, NULL, 0, 100, NULL, NULL}, // 6: ID=7
+    {"7.DHT11_Read", MENU_TYPE_FUNC, &menu_tree[0], NULL, 0, 6, Func_Read_Temp, NULL, 0, 100, NULL, NULL}, // 7: ID=8
+    {"8.About", MENU_TYPE_FUNC, &menu_tree[0], NULL, 0, 7, Func_About, NULL, 0, 100, NULL, NULL}, // 8: ID=9
+    {"Last_Result", MENU_TYPE_FUNC, &menu_tree[2], NULL, 0, 0, Func_LastResult, NULL, 0, 100, NULL, NULL}, // 9: ID=10
+    {"History", MENU_TYPE_LIST, &menu_tree[2], NULL, 0, 1, NULL, NULL, 0, 100, NULL, &history_list}, // 10: ID=11
+    {"Calibration", MENU_TYPE_FUNC, &menu_tree[3], NULL, 0, 0, Func_SensorCalibration, NULL, 0, 100, NULL, NULL}, // 11: ID=12
+    {"Reset_Count", MENU_TYPE_FUNC, &menu_tree[3], NULL, 0, 1, Func_ResetCounters, NULL, 0, 100, NULL, NULL}, // 12: ID=13
+    {"Carrier_Type", MENU_TYPE_LIST, &menu_tree[3], NULL, 0, 2, NULL, NULL, 0, 100, NULL, &carrier_list}, // 13: ID=14
+    {"Threshold", MENU_TYPE_FUNC, &menu_tree[3], NULL, 0, 3, Func_ThresholdSettings, NULL, 0, 100, NULL, NULL}, // 14: ID=15
+    {"Set_Time", MENU_TYPE_FUNC, &menu_tree[3], NULL, 0, 4, Func_SetTime, NULL, 0, 100, NULL, NULL}, // 15: ID=16
+    {"Auto_Mode", MENU_TYPE_TOGGLE, &menu_tree[3], NULL, 0, 5, Func_AutoUploadControl, NULL, 0, 100, &auto_upload_enable, NULL}, // 16: ID=17
+    {"LED", MENU_TYPE_TOGGLE, &menu_tree[3], NULL, 0, 6, Func_LEDControl, NULL, 0, 100, &led_enable, NULL}, // 17: ID=18
+    {"Dinosaur_jump", MENU_TYPE_FUNC, &menu_tree[4], NULL, 0, 0, Func_Dinosaur_jump_Game, NULL, 0, 100, NULL, NULL}, // 18: ID=19
+    {"Snake", MENU_TYPE_FUNC, &menu_tree[4], NULL, 0, 1, Func_Snake_Game, NULL, 0, 100, NULL, NULL}, // 19: ID=20
+    {"Tetris", MENU_TYPE_FUNC, &menu_tree[4], NULL, 0, 2, Func_Tetris_Game, NULL, 0, 100, NULL, NULL}, // 20: ID=21
+    {"FlappyBird", MENU_TYPE_FUNC, &menu_tree[4], NULL, 0, 3, Func_FlappyBird_Game, NULL, 0, 100, NULL, NULL}, // 21: ID=22
+};
@@ -0,0 +1,134 @@
+#include "Screen.h"
+#include "Menu.h"
+
+/*
+ * 文件名：Screen.c
+ * 描    述：非阻塞界面栈实现文件
+ *          每次主循环：栈顶界面需要重绘时先清屏并调用render，再调用update处理按键和周期任务，
+ *          最后统一发送显存的修改（上一帧未发送完时留到下次，不等待）
+ */
+
+static const Screen_t *screen_stack[SCREEN_STACK_DEPTH];
+static uint8_t screen_depth = 0;       // 栈中界面数量
+static uint8_t screen_need_render = 0; // 栈顶界面需要整屏重绘
+
+/**
+ * 函    数：打开界面（压入界面栈）
+ * 参    数：screen - 界面描述
+ * 返 回 值：1成功，0界面栈已满
+ * 说    明：立即调用enter，下一次Screen_Process时绘制，原栈顶界面暂停（不再调用update）
+ */
+uint8_t Screen_Push(const Screen_t *screen)
+{
+    if (screen_depth >= SCREEN_STACK_DEPTH)
+    {
+        return 0;
+    }
+
+    screen_stack[screen_depth++] = screen;
+    screen_need_render = 1;
+    if (screen->enter != NULL)
+    {
+        screen->enter();
+    }
+    return 1;
+}
+
+/**
+ * 函    数：关闭栈顶界面
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：调用exit后弹出；下层界面下次处理时整屏重绘，栈空时回到菜单
+ */
+void Screen_Pop(void)
+{
+    const Screen_t *screen;
+
+    if (screen_depth == 0)
+    {
+        return;
+    }
+
+    screen = screen_stack[--screen_depth];
+    if (screen->exit != NULL)
+    {
+        screen->exit();
+    }
+
+    if (screen_depth > 0)
+    {
+        screen_need_render = 1;
+    }
+    else
+    {
+        Menu_Refresh(); // 回到菜单
+    }
+}
+
+/**
+ * 函    数：请求栈顶界面整屏重绘
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：界面被阻塞的提示框覆盖后，或布局改变时调用
+ */
+void Screen_Invalidate(void)
+{
+    screen_need_render = 1;
+}
+
+/**
+ * 函    数：获取栈顶界面
+ * 参    数：无
+ * 返 回 值：栈顶界面，栈空时返回NULL
+ */
+const Screen_t *Screen_Top(void)
+{
+    return screen_depth > 0 ? screen_stack[screen_depth - 1] : NULL;
+}
+
+/**
+ * 函    数：查询是否有打开的界面
+ * 参    数：无
+ * 返 回 值：1有，0没有（显示菜单）
+ */
+uint8_t Screen_IsOpen(void)
+{
+    return screen_depth > 0;
+}
+
+/**
+ * 函    数：界面处理
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：在主循环中调用，每次只处理栈顶界面，不阻塞
+ */
+void Screen_Process(void)
+{
+    const Screen_t *top = Screen_Top();
+
+    if (top == NULL)
+    {
+        return;
+    }
+
+    if (screen_need_render)
+    {
+        screen_need_render = 0;
+        OLED_Clear();
+        if (top->render != NULL)
+        {
+            top->render();
+        }
+    }
+
+    if (top->update != NULL)
+    {
+        top->update(Key_Get_Press_Event());
+    }
+
+    // 发送本次的修改；上一帧仍在发送时脏区保留到下次，没有修改时不发送
+    if (Screen_IsOpen() && !OLED_IsBusy())
+    {
+        OLED_Update();
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef __SCREEN_H
+#define __SCREEN_H
+
+#include "stm32f10x.h"
+#include <stdio.h> // 也包含 NULL 的定义
+#include "OLED.h"
+#include "Key_multi.h"
+
+/*
+ * 文件名：Screen.h
+ * 描    述：非阻塞界面栈头文件
+ *          功能界面不再自带while(1)循环，而是压入界面栈，由主循环每次调用栈顶界面，
+ *          主循环中的时钟走时、时间同步、自动上传、串口命令在界面打开期间照常按时运行
+ *          界面栈为空时显示菜单
+ */
+
+#define SCREEN_STACK_DEPTH 4 // 界面栈深度（功能界面 + 弹窗）
+
+/*界面描述结构体，各钩子均可为NULL*/
+typedef struct
+{
+    void (*enter)(void);            // 压入栈时调用，初始化界面状态（不要在这里绘图）
+    void (*update)(Key_action key); // 每次主循环调用，key为本次短按事件（无按键为key_none）
+    void (*render)(void);           // 清屏后绘制整个界面：进入后、上层弹窗关闭后、Screen_Invalidate后
+    void (*exit)(void);             // 弹出栈时调用
+} Screen_t;
+
+/*函数声明*/
+uint8_t Screen_Push(const Screen_t *screen);
+void Screen_Pop(void);
+void Screen_Invalidate(void);
+const Screen_t *Screen_Top(void);
+uint8_t Screen_IsOpen(void);
+void Screen_Process(void);
+
+#endif
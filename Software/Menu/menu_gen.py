@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+文件名：menu_gen.py
+描  述：菜单树生成工具，把Menu_creat.c中的MenuDef_t菜单表转换为Flash中的常量菜单树
+
+菜单表仍按MenuDef_t格式编写（父菜单ID从1开始，0表示根菜单），
+本工具预先计算每个菜单项的父菜单、第一个子菜单、子菜单数量和在同级中的序号，
+输出的菜单项按层次顺序排列，同级菜单项在数组中连续存放，
+因此上一项/下一项、滚动偏移都可以直接由序号计算，启动时不需要建树。
+
+用法（修改菜单表后重新运行，生成的Menu_tree.h一并提交）：
+  python menu_gen.py Menu_creat.c -o Menu_tree.h
+"""
+
+import argparse
+import re
+import sys
+
+FIELDS = ('name', 'type', 'parent_id', 'func', 'value', 'min', 'max', 'toggle', 'list')
+
+
+def strip_comments(text):
+    """去掉C注释，保留字符串中的内容"""
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    return re.sub(r'//[^\n]*', '', text)
+
+
+def extract_table(source, name):
+    """从C源文件中提取菜单表的每一项"""
+    match = re.search(r'\b' + re.escape(name) + r'\s*\[\s*\]\s*=\s*\{(.*?)\n\s*\};', source, re.S)
+    if match is None:
+        sys.exit('未找到菜单表：' + name)
+    body = strip_comments(match.group(1))
+    entries = []
+    for raw in re.findall(r'\{([^{}]*)\}', body):
+        parts = [p.strip() for p in raw.split(',')]
+        if len(parts) == len(FIELDS) - 1:
+            parts.append('NULL')  # 列表数据提供者可以省略
+        if len(parts) != len(FIELDS):
+            sys.exit('菜单项字段数量错误：{' + raw.strip() + '}')
+        entry = dict(zip(FIELDS, parts))
+        entry['parent_id'] = int(entry['parent_id'], 0)
+        entries.append(entry)
+    if not entries:
+        sys.exit('菜单表为空')
+    return entries
+
+
+def build(entries):
+    """按层次顺序排列菜单项，计算父子关系与同级序号"""
+    count = len(entries)
+    children = [[] for _ in range(count + 1)]  # 按菜单表ID（从1开始）记录子菜单
+    roots = []
+    for i, e in enumerate(entries):
+        pid = e['parent_id']
+        if pid == 0:
+            roots.append(i + 1)
+        elif pid > count:
+            sys.exit('父菜单ID超出范围：%s' % e['name'])
+        else:
+            children[pid].append(i + 1)
+    if roots != [1]:
+        sys.exit('菜单表必须有且只有一个根菜单，且位于第一项')
+
+    order = [1]  # 层次遍历，同级菜单项连续
+    for tid in order:
+        order.extend(children[tid])
+    if len(order) != count:
+        sys.exit('菜单表中存在无法从根菜单到达的菜单项')
+
+    pos = {tid: n for n, tid in enumerate(order)}
+    nodes = []
+    for n, tid in enumerate(order):
+        e = entries[tid - 1]
+        pid = e['parent_id']
+        kids = children[tid]
+        nodes.append({
+            'id': tid,
+            'entry': e,
+            'parent': pos[pid] if pid else None,
+            'child': pos[kids[0]] if kids else None,
+            'child_count': len(kids),
+            'index': children[pid].index(tid) if pid else 0,
+        })
+    return nodes
+
+
+def emit(nodes, source_name):
+    """输出C代码"""
+    def ref(n):
+        return 'NULL' if n is None else '&menu_tree[%d]' % n
+
+    lines = [
+        '/*',
+        ' * 文件名：Menu_tree.h',
+        ' * 描    述：常量菜单树，由menu_gen.py根据%s中的menu_table生成，请勿手动修改' % source_name,
+        ' *          修改菜单表后重新运行：python menu_gen.py %s -o Menu_tree.h' % source_name,
+        ' */',
+        '',
+        '#define MENU_TREE_SIZE %d' % len(nodes),
+        '',
+        'static const MenuItem_t menu_tree[MENU_TREE_SIZE] = {',
+        '    // {名称, 类型, 父菜单, 第一个子菜单, 子菜单数量, 同级序号, 回调函数, 数值指针, 最小值, 最大值, 开关指针, 列表数据提供者}',
+    ]
+    for n, node in enumerate(nodes):
+        e = node['entry']
+        kind = e['type']
+        func = e['func'] if kind in ('MENU_TYPE_FUNC', 'MENU_TYPE_TOGGLE') else 'NULL'
+        if kind == 'MENU_TYPE_VALUE' and e['value'] != 'NULL':
+            value, vmin, vmax = e['value'], e['min'], e['max']
+        else:
+            value, vmin, vmax = 'NULL', '0', '100'
+        toggle = e['toggle'] if kind == 'MENU_TYPE_TOGGLE' else 'NULL'
+        provider = e['list'] if kind == 'MENU_TYPE_LIST' else 'NULL'
+        fields = [e['name'], kind, ref(node['parent']), ref(node['child']),
+                  str(node['child_count']), str(node['index']), func, value, vmin, vmax, toggle, provider]
+        lines.append('    {%s}, // %d: ID=%d' % (', '.join(fields), n, node['id']))
+    lines.append('};')
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='菜单树生成工具')
+    parser.add_argument('input', help='包含MenuDef_t菜单表的C源文件')
+    parser.add_argument('--table', default='menu_table', help='菜单表数组名，默认menu_table')
+    parser.add_argument('-o', '--output', help='输出文件，省略时输出到标准输出')
+    args = parser.parse_args()
+
+    with open(args.input, encoding='utf-8') as f:
+        entries = extract_table(f.read(), args.table)
+
+    text = emit(build(entries), args.input.replace('\\', '/').split('/')[-1])
+    if args.output:
+        with open(args.output, 'w', encoding='utf-8', newline='\n') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,301 @@
+#include "Mirror.h"
+
+/*
+ * 文件名：Mirror.c
+ * 描    述：OLED远程镜像实现文件
+ *          每帧只发送变化的页，页内容与上一帧异或后RLE压缩，不变的列压缩为游程
+ *          OLED_SetUpdateCallback只记录有新画面，由主循环中的Mirror_Process发送
+ *          数据写入USART1的中断发送缓冲区，每次只写入缓冲区放得下的页，不阻塞主循环
+ */
+
+#define MIRROR_PAGE_MAX 172 // 一页差异数据RLE压缩后的最大字节数（单字节原样与2字节游程交替时）
+#define MIRROR_IDLE     8   // mirror_page为此值时没有正在发送的帧
+
+#if USART1_TX_BUFFER_SIZE < 64 + MIRROR_PAGE_MAX + 1
+#error "USART1_TX_BUFFER_SIZE放不下一页镜像数据"
+#endif
+
+extern uint8_t OLED_DisplayBuf[8][128]; // OLED显存（OLED.c）
+
+static uint8_t mirror_shadow[8][128]; // 上位机当前画面的副本
+static uint8_t mirror_enabled = 0;    // 镜像使能
+static uint8_t mirror_pending = 0;    // 有未发送的刷新
+static uint8_t mirror_seq = 0;        // 帧序号
+static uint8_t mirror_key_count = 0;  // 距下一个关键帧的帧数，为0时发送关键帧
+static uint32_t mirror_last_ms = 0;   // 上一帧发送时间
+static uint32_t mirror_wait_ms = 0;   // 距上一帧需要等待的时间，大帧之后等待更久以满足带宽上限
+static uint32_t mirror_frames = 0;    // 已发送帧数
+static uint32_t mirror_bytes = 0;     // 已发送字节数
+
+/*正在发送的帧*/
+static uint8_t mirror_page = MIRROR_IDLE; // 下一个要发送的页，MIRROR_IDLE表示空闲
+static uint8_t mirror_mask = 0;           // 本帧变化的页
+static uint8_t mirror_key = 0;            // 本帧是关键帧
+static uint32_t mirror_start = 0;         // 本帧开始时的mirror_bytes
+
+/*发送缓冲，攒满后一次性写入USART1发送缓冲区*/
+static uint8_t mirror_tx[64];
+static uint8_t mirror_tx_len = 0;
+static uint8_t mirror_sum = 0;
+
+/**
+ * 函    数：把发送缓冲中的字节写入USART1发送缓冲区
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：写入前已按MIRROR_PAGE_MAX确认过空间，正常不会失败；
+ *          万一失败，上位机会因校验和错误丢弃本帧，下一帧改为关键帧
+ */
+static void Mirror_Flush(void)
+{
+    if (mirror_tx_len > 0)
+    {
+        if (USART1_SendArrayAsync(mirror_tx, mirror_tx_len) == USART1_OK)
+        {
+            mirror_bytes += mirror_tx_len;
+        }
+        else
+        {
+            mirror_key_count = 0;
+        }
+        mirror_tx_len = 0;
+    }
+}
+
+/**
+ * 函    数：输出一个字节
+ * 参    数：byte - 数据
+ * 返 回 值：无
+ */
+static void Mirror_Put(uint8_t byte)
+{
+    mirror_tx[mirror_tx_len++] = byte;
+    mirror_sum += byte;
+    if (mirror_tx_len == sizeof(mirror_tx))
+    {
+        Mirror_Flush();
+    }
+}
+
+
+/**
+ * 函    数：RLE压缩输出一页差异数据
+ * 参    数：data - 128字节差异数据
+ * 返 回 值：无
+ * 说    明：与oled_pack.py的pack()相同，连续2个以上相同字节编码为游程
+ */
+static void Mirror_PutPacked(const uint8_t *data)
+{
+    uint8_t i = 0, j, run;
+
+    while (i < 128)
+    {
+        // 统计重复次数，最少2个才编码为游程
+        run = 1;
+        while (i + run < 128 && data[i + run] == data[i] && run < 129)
+        {
+            run++;
+        }
+        if (run >= 2)
+        {
+            Mirror_Put(0x80 + run - 2);
+            Mirror_Put(data[i]);
+            i += run;
+            continue;
+        }
+
+        // 原样数据，遇到下一个游程时结束
+        j = i;
+        while (j < 128 && !(j + 1 < 128 && data[j + 1] == data[j]))
+        {
+            j++;
+        }
+        Mirror_Put(j - i - 1);
+        while (i < j)
+        {
+            Mirror_Put(data[i++]);
+        }
+    }
+}
+
+/**
+ * 函    数：开始一帧
+ * 参    数：无
+ * 返 回 值：1已写入帧头，0画面没有变化
+ * 说    明：只发送与上一帧不同的页；没有变化且不是关键帧时不发送
+ */
+static uint8_t Mirror_BeginFrame(void)
+{
+    uint8_t page;
+
+    mirror_key = (mirror_key_count == 0);
+    mirror_mask = 0;
+    for (page = 0; page < 8; page++)
+    {
+        if (mirror_key || memcmp(mirror_shadow[page], OLED_DisplayBuf[page], 128) != 0)
+        {
+            mirror_mask |= 1 << page;
+        }
+    }
+    if (mirror_mask == 0)
+    {
+        return 0;
+    }
+
+    mirror_start = mirror_bytes;
+    Mirror_Put(MIRROR_SYNC0);
+    Mirror_Put(MIRROR_SYNC1);
+    mirror_sum = 0; // 校验和从序号开始
+    Mirror_Put(mirror_seq);
+    Mirror_Put(mirror_key ? MIRROR_FLAG_KEYFRAME : 0);
+    Mirror_Put(mirror_mask);
+    mirror_page = 0;
+    return 1;
+}
+
+/**
+ * 函    数：继续发送当前帧
+ * 参    数：无
+ * 返 回 值：1本帧已发完，0发送缓冲区已满，下次再继续
+ * 说    明：发送缓冲区能放下最坏情况的一页时才发送该页；
+ *          帧头之后某页才发送时，以发送时的画面为准，上位机副本与mirror_shadow始终一致
+ */
+static uint8_t Mirror_ContinueFrame(void)
+{
+    uint8_t delta[128];
+    uint8_t x;
+
+    for (; mirror_page < 8; mirror_page++)
+    {
+        if (!(mirror_mask & (1 << mirror_page)))
+        {
+            continue;
+        }
+        if (USART1_GetTxBufferFree() < mirror_tx_len + MIRROR_PAGE_MAX + 1)
+        {
+            return 0;
+        }
+        // 关键帧与全0异或，即原样数据
+        for (x = 0; x < 128; x++)
+        {
+            delta[x] = mirror_key ? OLED_DisplayBuf[mirror_page][x]
+                                  : OLED_DisplayBuf[mirror_page][x] ^ mirror_shadow[mirror_page][x];
+        }
+        Mirror_PutPacked(delta);
+        memcpy(mirror_shadow[mirror_page], OLED_DisplayBuf[mirror_page], 128);
+    }
+
+    if (USART1_GetTxBufferFree() < mirror_tx_len + 1)
+    {
+        return 0;
+    }
+    Mirror_Put(mirror_sum);
+    Mirror_Flush();
+
+    mirror_page = MIRROR_IDLE;
+    mirror_seq++;
+    mirror_frames++;
+    mirror_key_count = (mirror_key_count + 1) % MIRROR_KEYFRAME_EVERY;
+    return 1;
+}
+
+/**
+ * 函    数：OLED刷新回调
+ * 参    数：Bytes - 本次刷新发送给屏幕的字节数（未使用）
+ * 返 回 值：无
+ * 说    明：在OLED_Update中调用，只做标记，帧由主循环的Mirror_Process发送
+ */
+static void Mirror_OnUpdate(uint32_t Bytes)
+{
+    (void)Bytes;
+    mirror_pending = 1;
+}
+
+/**
+ * 函    数：开启或关闭镜像
+ * 参    数：enable - 1开启，0关闭
+ * 返 回 值：无
+ * 说    明：开启后占用OLED_SetUpdateCallback，首帧为关键帧
+ */
+void Mirror_Enable(uint8_t enable)
+{
+    mirror_enabled = enable ? 1 : 0;
+    if (mirror_enabled)
+    {
+        mirror_key_count = 0;
+        mirror_pending = 1;
+        mirror_wait_ms = 0;
+        mirror_page = MIRROR_IDLE; // 关闭时未发完的帧作废，上位机按校验和丢弃
+        mirror_tx_len = 0;
+        OLED_SetUpdateCallback(Mirror_OnUpdate);
+    }
+    else
+    {
+        OLED_SetUpdateCallback(NULL);
+    }
+}
+
+/**
+ * 函    数：查询镜像是否开启
+ * 参    数：无
+ * 返 回 值：1开启，0关闭
+ */
+uint8_t Mirror_IsEnabled(void)
+{
+    return mirror_enabled;
+}
+
+/**
+ * 函    数：镜像处理
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：在主循环中调用，按帧间隔和带宽上限开始新帧，并把当前帧写入发送缓冲区
+ */
+void Mirror_Process(void)
+{
+    if (!mirror_enabled)
+    {
+        return;
+    }
+
+    if (mirror_page == MIRROR_IDLE)
+    {
+        if (!mirror_pending || Delay_Get_Ticks() - mirror_last_ms < mirror_wait_ms)
+        {
+            return;
+        }
+        mirror_pending = 0;
+        if (!Mirror_BeginFrame())
+        {
+            return;
+        }
+        mirror_last_ms = Delay_Get_Ticks();
+    }
+
+    if (Mirror_ContinueFrame())
+    {
+        // 按本帧大小推迟下一帧，平均占用不超过MIRROR_BUDGET_BPS
+        mirror_wait_ms = (mirror_bytes - mirror_start) * 1000 / MIRROR_BUDGET_BPS;
+        if (mirror_wait_ms < MIRROR_INTERVAL_MS)
+        {
+            mirror_wait_ms = MIRROR_INTERVAL_MS;
+        }
+    }
+}
+
+/**
+ * 函    数：获取镜像发送统计
+ * 参    数：frames - 返回已发送帧数，可传入NULL
+ *          bytes - 返回已发送字节数，可传入NULL
+ * 返 回 值：无
+ */
+void Mirror_GetStats(uint32_t *frames, uint32_t *bytes)
+{
+    if (frames != NULL)
+    {
+        *frames = mirror_frames;
+    }
+    if (bytes != NULL)
+    {
+        *bytes = mirror_bytes;
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef __MIRROR_H
+#define __MIRROR_H
+#include "stm32f10x.h"
+#include "OLED.h"
+#include "USART1.h"
+#include "Delay.h"
+
+/*
+ * 文件名：Mirror.h
+ * 描    述：OLED远程镜像头文件
+ *          把OLED_DisplayBuf的变化通过USART1发送出去，上位机用mirror_view还原画面
+ *
+ * 帧格式（所有字段均为1字节）：
+ *   0xA5 0x5A       同步字，上位机据此从文本数据中找到帧头
+ *   seq             帧序号，每发送一帧加1，上位机据此判断丢帧
+ *   flags           bit0：关键帧（内容是与全0的差异，即完整画面）
+ *   mask            变化的页，bit n 对应第n页
+ *   页数据          mask中每个置1的页依次给出：与上一帧异或后的128字节，RLE压缩
+ *   sum             seq到页数据最后一个字节的累加和（低8位）
+ *
+ * RLE格式与oled_pack.py相同：
+ *   控制字节 0x00~0x7F：后面跟随 控制字节+1 个原样数据
+ *   控制字节 0x80~0xFF：后面跟随 1 个数据，重复 控制字节-0x80+2 次
+ */
+
+#define MIRROR_INTERVAL_MS      100  // 最小帧间隔（10fps）
+#define MIRROR_BUDGET_BPS       1152 // 镜像占用的带宽上限（字节/秒），115200波特率的10%
+#define MIRROR_KEYFRAME_EVERY   50   // 每隔多少帧发送一次关键帧，上位机中途接入或丢帧后可恢复
+
+#define MIRROR_SYNC0            0xA5
+#define MIRROR_SYNC1            0x5A
+#define MIRROR_FLAG_KEYFRAME    0x01
+
+/*函数声明*/
+void Mirror_Enable(uint8_t enable);
+uint8_t Mirror_IsEnabled(void);
+void Mirror_Process(void);
+void Mirror_GetStats(uint32_t *frames, uint32_t *bytes);
+
+#endif
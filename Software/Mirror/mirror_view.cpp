@@ -0,0 +1,342 @@
+/*
+ * 文件名：mirror_view.cpp
+ * 描    述：OLED远程镜像上位机查看器
+ *          从串口数据中解析Mirror.c发送的镜像帧，还原128x64画面，输出到终端或PNG文件
+ *          串口上的其他文本数据（ESP8266命令、调试信息）会被自动跳过
+ *
+ * 编译：g++ -std=c++11 -O2 -o mirror_view mirror_view.cpp
+ *
+ * 用法：
+ *   stty -F /dev/ttyUSB0 115200 raw -echo
+ *   ./mirror_view /dev/ttyUSB0                 终端实时显示
+ *   ./mirror_view capture.bin --png out         每帧保存为 out/frame_00000.png
+ *   ./mirror_view capture.bin --stats           只统计每帧字节数
+ *   输入文件为 - 时从标准输入读取
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int kWidth = 128;
+const int kPages = 8;
+const int kHeight = kPages * 8;
+const uint8_t kSync0 = 0xA5;
+const uint8_t kSync1 = 0x5A;
+const uint8_t kFlagKeyframe = 0x01;
+
+typedef uint8_t Frame[kPages][kWidth];
+
+enum ParseResult { kParseOk, kParseNeedMore, kParseBad };
+
+/* 解析一帧，成功时返回帧长度，页数据以异或差异的形式写入delta，mask为变化页掩码 */
+ParseResult ParseFrame(const std::vector<uint8_t> &buf, size_t pos, size_t *length,
+                       uint8_t *seq, uint8_t *flags, uint8_t *mask, Frame delta)
+{
+    size_t p = pos + 2;
+    if (p + 3 > buf.size())
+        return kParseNeedMore;
+
+    uint8_t sum = 0;
+    *seq = buf[p];
+    *flags = buf[p + 1];
+    *mask = buf[p + 2];
+    sum = static_cast<uint8_t>(*seq + *flags + *mask);
+    p += 3;
+    if (*flags & ~kFlagKeyframe)
+        return kParseBad;
+
+    for (int page = 0; page < kPages; page++)
+    {
+        if (!(*mask & (1 << page)))
+            continue;
+        int x = 0;
+        while (x < kWidth)
+        {
+            if (p >= buf.size())
+                return kParseNeedMore;
+            uint8_t ctrl = buf[p++];
+            sum += ctrl;
+            if (ctrl & 0x80)
+            {
+                int run = ctrl - 0x80 + 2;
+                if (p >= buf.size())
+                    return kParseNeedMore;
+                uint8_t value = buf[p++];
+                sum += value;
+                if (x + run > kWidth)
+                    return kParseBad;
+                for (int i = 0; i < run; i++)
+                    delta[page][x++] = value;
+            }
+            else
+            {
+                int count = ctrl + 1;
+                if (x + count > kWidth)
+                    return kParseBad;
+                if (p + count > buf.size())
+                    return kParseNeedMore;
+                for (int i = 0; i < count; i++)
+                {
+                    sum += buf[p];
+                    delta[page][x++] = buf[p++];
+                }
+            }
+        }
+    }
+
+    if (p >= buf.size())
+        return kParseNeedMore;
+    if (buf[p++] != sum)
+        return kParseBad;
+    *length = p - pos;
+    return kParseOk;
+}
+
+uint8_t GetPixel(const Frame frame, int x, int y)
+{
+    return (frame[y / 8][x] >> (y % 8)) & 1;
+}
+
+/* 终端显示，每个字符显示上下两个像素 */
+void RenderTerminal(const Frame frame, uint8_t seq, size_t bytes, bool stale)
+{
+    std::string out = "\x1b[H";
+    for (int y = 0; y < kHeight; y += 2)
+    {
+        for (int x = 0; x < kWidth; x++)
+        {
+            int top = GetPixel(frame, x, y);
+            int bottom = GetPixel(frame, x, y + 1);
+            if (top && bottom)
+                out += "\xe2\x96\x88"; // █
+            else if (top)
+                out += "\xe2\x96\x80"; // ▀
+            else if (bottom)
+                out += "\xe2\x96\x84"; // ▄
+            else
+                out += ' ';
+        }
+        out += '\n';
+    }
+    char status[96];
+    snprintf(status, sizeof(status), "seq %3u  %4u bytes%s\x1b[K\n", seq,
+             static_cast<unsigned>(bytes), stale ? "  (waiting for keyframe)" : "");
+    out += status;
+    fwrite(out.data(), 1, out.size(), stdout);
+    fflush(stdout);
+}
+
+/* PNG写出，使用不压缩的deflate存储块，不依赖zlib */
+uint32_t Crc32(const uint8_t *data, size_t length, uint32_t crc = 0)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for (int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
+
+void PutBE32(std::vector<uint8_t> *v, uint32_t value)
+{
+    v->push_back(static_cast<uint8_t>(value >> 24));
+    v->push_back(static_cast<uint8_t>(value >> 16));
+    v->push_back(static_cast<uint8_t>(value >> 8));
+    v->push_back(static_cast<uint8_t>(value));
+}
+
+void PutChunk(std::vector<uint8_t> *png, const char *type, const std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> body(type, type + 4);
+    body.insert(body.end(), data.begin(), data.end());
+    PutBE32(png, static_cast<uint32_t>(data.size()));
+    png->insert(png->end(), body.begin(), body.end());
+    PutBE32(png, Crc32(body.data(), body.size()));
+}
+
+bool WritePng(const std::string &path, const Frame frame, int scale)
+{
+    const int w = kWidth * scale;
+    const int h = kHeight * scale;
+
+    std::vector<uint8_t> raw;
+    for (int y = 0; y < h; y++)
+    {
+        raw.push_back(0); // 过滤类型：无
+        for (int x = 0; x < w; x++)
+            raw.push_back(GetPixel(frame, x / scale, y / scale) ? 0xFF : 0x00);
+    }
+
+    std::vector<uint8_t> z;
+    z.push_back(0x78);
+    z.push_back(0x01);
+    for (size_t pos = 0; pos < raw.size(); pos += 65535)
+    {
+        size_t n = raw.size() - pos < 65535 ? raw.size() - pos : 65535;
+        z.push_back(pos + n == raw.size() ? 1 : 0);
+        z.push_back(static_cast<uint8_t>(n));
+        z.push_back(static_cast<uint8_t>(n >> 8));
+        z.push_back(static_cast<uint8_t>(~n));
+        z.push_back(static_cast<uint8_t>(~n >> 8));
+        z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + n);
+    }
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < raw.size(); i++)
+    {
+        a = (a + raw[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    PutBE32(&z, (b << 16) | a);
+
+    std::vector<uint8_t> ihdr;
+    PutBE32(&ihdr, w);
+    PutBE32(&ihdr, h);
+    const uint8_t rest[] = {8, 0, 0, 0, 0}; // 8位灰度
+    ihdr.insert(ihdr.end(), rest, rest + 5);
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    PutChunk(&png, "IHDR", ihdr);
+    PutChunk(&png, "IDAT", z);
+    PutChunk(&png, "IEND", std::vector<uint8_t>());
+
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    fwrite(png.data(), 1, png.size(), f);
+    fclose(f);
+    return true;
+}
+
+void Usage()
+{
+    fprintf(stderr, "usage: mirror_view <input|-> [--png DIR] [--stats]\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        Usage();
+        return 1;
+    }
+    std::string png_dir;
+    bool stats_only = false;
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--png") == 0 && i + 1 < argc)
+            png_dir = argv[++i];
+        else if (strcmp(argv[i], "--stats") == 0)
+            stats_only = true;
+        else
+        {
+            Usage();
+            return 1;
+        }
+    }
+
+    FILE *in = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+    if (!in)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    Frame frame = {};
+    Frame delta;
+    bool synced = false; // 收到关键帧之前画面不完整
+    bool have_seq = false;
+    uint8_t last_seq = 0;
+    unsigned long frames = 0, dropped = 0, total_bytes = 0;
+    std::vector<uint8_t> buf;
+    uint8_t chunk[512];
+    size_t n;
+
+    if (!stats_only && png_dir.empty())
+        fputs("\x1b[2J", stdout);
+
+    while ((n = fread(chunk, 1, sizeof(chunk), in)) > 0)
+    {
+        buf.insert(buf.end(), chunk, chunk + n);
+        size_t pos = 0;
+        while (pos + 1 < buf.size())
+        {
+            if (buf[pos] != kSync0 || buf[pos + 1] != kSync1)
+            {
+                pos++;
+                continue;
+            }
+            size_t length = 0;
+            uint8_t seq, flags, mask;
+            ParseResult r = ParseFrame(buf, pos, &length, &seq, &flags, &mask, delta);
+            if (r == kParseNeedMore)
+                break;
+            if (r == kParseBad)
+            {
+                pos++;
+                continue;
+            }
+            pos += length;
+
+            // 序号不连续说明丢帧，差异帧不能再叠加，等待关键帧
+            if (have_seq && static_cast<uint8_t>(last_seq + 1) != seq)
+            {
+                dropped++;
+                synced = false;
+            }
+            have_seq = true;
+            last_seq = seq;
+
+            bool key = flags & kFlagKeyframe;
+            for (int page = 0; page < kPages; page++)
+            {
+                if (!(mask & (1 << page)))
+                    continue;
+                for (int x = 0; x < kWidth; x++)
+                    frame[page][x] = key ? delta[page][x] : frame[page][x] ^ delta[page][x];
+            }
+            if (key)
+                synced = true;
+
+            frames++;
+            total_bytes += length;
+            if (stats_only)
+            {
+                printf("seq %3u %s pages 0x%02X %4u bytes\n", seq, key ? "key  " : "delta",
+                       mask, static_cast<unsigned>(length));
+            }
+            else if (!png_dir.empty())
+            {
+                char name[32];
+                snprintf(name, sizeof(name), "/frame_%05lu.png", frames - 1);
+                if (!WritePng(png_dir + name, frame, 4))
+                {
+                    perror((png_dir + name).c_str());
+                    return 1;
+                }
+            }
+            else
+            {
+                RenderTerminal(frame, seq, length, !synced);
+            }
+        }
+        buf.erase(buf.begin(), buf.begin() + pos);
+    }
+
+    if (frames > 0)
+    {
+        fprintf(stderr, "%lu frames, %lu bytes (%.1f bytes/frame), %lu sequence gaps\n", frames,
+                total_bytes, static_cast<double>(total_bytes) / frames, dropped);
+    }
+    if (in != stdin)
+        fclose(in);
+    return 0;
+}
@@ -10,6 +10,8 @@ uint8_t g_trail_empty_threshold = TRAIL_EMPTY_THRESHOLD_DEFAULT; // 后导空阈
 /*统计数据*/
 StatisticsData_t g_statistics; // 统计数据结构体变量
 
+static volatile uint8_t alarm_pending = 0; // 待处理的报警（STATISTICS_ALARM_xxx）
+
 /*外部函数声明*/
 extern void Statistics_OnMissingDetected(void);   // 缺失检测回调
 extern void Statistics_OnExtraChipDetected(void); // 多余芯片检测回调
@@ -30,6 +32,7 @@ void Statistics_Init(void)
  * 参    数：chip_present - 芯片存在标志（CHIP_PRESENT或CHIP_ABSENT）
  * 返 回 值：无
  * 说    明：根据载带阶段和检测结果进行详细统计
+ *          在PendSV中调用，不能阻塞：报警只记录标志，由Statistics_DispatchAlarms在主循环中处理
  */
 void Statistics_ProcessChip(uint8_t chip_present)
 {
@@ -114,8 +117,8 @@ void Statistics_ProcessChip(uint8_t chip_present)
         if (chip_present == CHIP_PRESENT)
         {
             g_statistics.Lead_Tail_ADD++; // 统计到F_T_ADD（报警统计，不清除）
-            /*触发多余芯片报警*/
-            Statistics_OnExtraChipDetected();
+            /*触发多余芯片报警（主循环中弹窗）*/
+            alarm_pending |= STATISTICS_ALARM_EXTRA_CHIP;
             /*不回到中间阶段，继续后导空检测*/
             g_statistics.empty_sequence_count = 0; // 重置连续空计数
         }
@@ -133,21 +136,26 @@ void Statistics_ProcessChip(uint8_t chip_present)
 
     /*标记数据有效*/
     g_statistics.data_valid = 1;
+    g_statistics.update_count++;
 }
 
 /**
  * 函    数：重置所有统计数据
  * 参    数：无
  * 返 回 值：无
+ * 说    明：在主循环中调用，清零期间暂缓PendSV中的计数处理，避免清零到一半时被统计打断
  */
 void Statistics_Reset(void)
 {
+    Sensor_LockCounting();
+
     /*基础统计*/
     // g_statistics.total_count = 0;
     // g_statistics.chip_present = 0;
     // g_statistics.chip_absent = 0;
     g_statistics.yield_rate = 0.0f;
     exti0_trigger_count = 0;
+    Sensor_ResetPockets(); // 丢弃上一轮未处理的料袋
 
     /*详细统计*/
     g_statistics.lead_empty_count = 0;
@@ -165,6 +173,35 @@ void Statistics_Reset(void)
     g_statistics.force_update_display = 0;
     g_statistics.is_beginning = 0;
     g_statistics.data_valid = 0;
+    g_statistics.update_count++; // 清零也是一次数据变化
+    alarm_pending = 0;
+    Sensor_UnlockCounting();
+}
+
+/**
+ * 函    数：处理待处理的报警
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：在主循环中调用，报警回调中的蜂鸣器和弹窗不影响PendSV中的计数
+ */
+void Statistics_DispatchAlarms(void)
+{
+    uint8_t pending;
+
+    if (alarm_pending == 0)
+    {
+        return;
+    }
+
+    Sensor_LockCounting(); // 取出并清除标志，期间PendSV不会再置位
+    pending = alarm_pending;
+    alarm_pending = 0;
+    Sensor_UnlockCounting();
+
+    if (pending & STATISTICS_ALARM_EXTRA_CHIP)
+    {
+        Statistics_OnExtraChipDetected();
+    }
 }
 
 /**
@@ -17,6 +17,9 @@ typedef enum
 #define FRONT_CHIP_THRESHOLD_DEFAULT 3  // 默认值：连续3个芯片认为进入中间芯片阶段
 #define MIDDLE_LOSS_MAX_DEFAULT 3       // 默认值：连续缺失中间缺失最大计数（超过此值不报警，转为后导空）
 
+/*报警标志：计数在PendSV中检测到报警时只记录，由主循环调用报警回调*/
+#define STATISTICS_ALARM_EXTRA_CHIP 0x01 // 前/后空阶段多余芯片
+
 /*全局阈值变量 - 可在运行时修改*/
 extern uint8_t g_front_chip_threshold;  // 前导芯片阈值
 extern uint8_t g_middle_loss_max;       // 中间缺失最大计数
@@ -46,6 +49,7 @@ typedef struct
     uint8_t force_update_display;  // 强制更新显示标志
     uint8_t data_valid;            // 数据有效标志
     uint8_t is_beginning;          // 是否开始标志（1：开始-0：暂停）
+    uint32_t update_count;         // 数据更新次数（每处理一个坑位加1），显示端据此判断是否需要重绘
     
 } StatisticsData_t;
 
@@ -61,6 +65,7 @@ TapeStage_t Statistics_GetCurrentStage(void);
 uint8_t Statistics_IsPaused(void);
 void Statistics_Resume(void);
 void Statistics_Pause(void);
+void Statistics_DispatchAlarms(void);       // 主循环中调用，执行待处理的报警回调
 void Statistics_OnMissingDetected(void);   // 缺失报警回调
 void Statistics_OnExtraChipDetected(void); // 多余芯片报警回调
 
@@ -0,0 +1,264 @@
+#include "Widget.h"
+
+/*
+ * 文件名：Widget.c
+ * 描    述：保留模式控件层实现文件
+ *          文本类控件逐字符比较，只重绘变化的字符格；进度条只填充或清除变化的像素列
+ *          绘图函数会自动标记脏区，未变化的控件不产生任何发送
+ */
+
+/**
+ * 函    数：控件公共初始化
+ * 参    数：w - 控件
+ *          x, y - 左上角坐标
+ *          width, height - 区域大小
+ *          font - 字体
+ * 返 回 值：无
+ */
+static void Widget_Init(Widget_t *w, int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t font)
+{
+    memset(w, 0, sizeof(Widget_t));
+    w->x = x;
+    w->y = y;
+    w->width = width;
+    w->height = height;
+    w->font = font;
+}
+
+/**
+ * 函    数：绘制文本，只重绘与上次不同的字符格
+ * 参    数：w - 控件
+ *          text - 新文本，超过WIDGET_TEXT_LEN的部分不显示
+ *          reverse - 重绘的字符格是否反色（选中的列表行）
+ * 返 回 值：无
+ * 说    明：新文本比旧文本短时，多出的旧字符格被清除
+ */
+static void Widget_DrawText(Widget_t *w, const char *text, uint8_t reverse)
+{
+    char buf[WIDGET_TEXT_LEN + 1];
+    int16_t cx;
+    uint8_t i;
+
+    strncpy(buf, text, WIDGET_TEXT_LEN); // 不足部分补0，便于逐字符比较
+    buf[WIDGET_TEXT_LEN] = '\0';
+
+    for (i = 0; i < WIDGET_TEXT_LEN; i++)
+    {
+        // 内容相同的字符格跳过；首次绘制时空白格也跳过
+        if (buf[i] == w->text[i] && (w->valid || buf[i] == '\0'))
+        {
+            continue;
+        }
+
+        cx = w->x + i * w->font;
+        if (buf[i] != '\0')
+        {
+            OLED_ShowChar(cx, w->y, buf[i], w->font); // 字模整格覆盖，无需先清除
+        }
+        else
+        {
+            OLED_ClearArea(cx, w->y, w->font, w->height);
+        }
+        if (reverse)
+        {
+            OLED_ReverseArea(cx, w->y, w->font, w->height);
+        }
+    }
+
+    memcpy(w->text, buf, sizeof(buf));
+    w->valid = 1;
+}
+
+/**
+ * 函    数：初始化文本标签
+ * 参    数：w - 控件
+ *          x, y - 左上角坐标
+ *          font - 字体，OLED_6X8 或 OLED_8X16
+ * 返 回 值：无
+ * 说    明：静态标签设置一次即可，动态文本（如状态）每次设置只重绘变化的字符
+ */
+void Widget_InitLabel(Widget_t *w, int16_t x, int16_t y, uint8_t font)
+{
+    Widget_Init(w, x, y, 0, font == OLED_8X16 ? 16 : 8, font);
+}
+
+/**
+ * 函    数：初始化数值字段
+ * 参    数：w - 控件
+ *          x, y - 左上角坐标
+ *          font - 字体，OLED_6X8 或 OLED_8X16
+ *          prefix - 前缀，如"F: "，可为NULL
+ *          suffix - 后缀，如"%"，可为NULL
+ *          frac - 小数位数，Widget_SetNumber的值按10^frac放大
+ * 返 回 值：无
+ */
+void Widget_InitNumber(Widget_t *w, int16_t x, int16_t y, uint8_t font,
+                       const char *prefix, const char *suffix, uint8_t frac)
+{
+    Widget_Init(w, x, y, 0, font == OLED_8X16 ? 16 : 8, font);
+    w->prefix = prefix;
+    w->suffix = suffix;
+    w->frac = frac;
+}
+
+/**
+ * 函    数：初始化进度条
+ * 参    数：w - 控件
+ *          x, y - 左上角坐标
+ *          width, height - 外框大小，均不小于3
+ * 返 回 值：无
+ */
+void Widget_InitBar(Widget_t *w, int16_t x, int16_t y, uint8_t width, uint8_t height)
+{
+    Widget_Init(w, x, y, width, height, 0);
+}
+
+/**
+ * 函    数：初始化列表行
+ * 参    数：w - 控件
+ *          x, y - 左上角坐标
+ *          width - 行宽度，选中时整行反色
+ *          font - 字体，OLED_6X8 或 OLED_8X16
+ * 返 回 值：无
+ */
+void Widget_InitRow(Widget_t *w, int16_t x, int16_t y, uint8_t width, uint8_t font)
+{
+    Widget_Init(w, x, y, width, font == OLED_8X16 ? 16 : 8, font);
+}
+
+/**
+ * 函    数：使控件失效
+ * 参    数：w - 控件
+ * 返 回 值：无
+ * 说    明：屏幕被其他界面覆盖并清屏后调用，下次设置时整块重新绘制
+ */
+void Widget_Invalidate(Widget_t *w)
+{
+    memset(w->text, 0, sizeof(w->text));
+    w->state = 0;
+    w->valid = 0;
+}
+
+/**
+ * 函    数：设置标签文本
+ * 参    数：w - 控件
+ *          text - 文本
+ * 返 回 值：无
+ */
+void Widget_SetText(Widget_t *w, const char *text)
+{
+    Widget_DrawText(w, text, 0);
+}
+
+/**
+ * 函    数：设置数值字段
+ * 参    数：w - 控件
+ *          value - 数值，按10^frac放大的定点数，例如frac为1时975表示97.5
+ * 返 回 值：无
+ * 说    明：显示为 前缀+数值+后缀，数值未变化时文本相同，不写显存
+ */
+void Widget_SetNumber(Widget_t *w, int32_t value)
+{
+    char buf[WIDGET_TEXT_LEN + 1];
+    Format_t fmt;
+
+    Format_Init(&fmt, buf, sizeof(buf));
+    if (w->prefix != NULL)
+    {
+        Format_Str(&fmt, w->prefix);
+    }
+    Format_Fixed(&fmt, value, w->frac);
+    if (w->suffix != NULL)
+    {
+        Format_Str(&fmt, w->suffix);
+    }
+    Widget_DrawText(w, buf, 0);
+}
+
+/**
+ * 函    数：设置进度条
+ * 参    数：w - 控件
+ *          value - 当前值
+ *          max - 满量程，为0时进度条为空
+ * 返 回 值：无
+ * 说    明：首次设置时绘制外框；之后只填充或清除与上次相比变化的像素列
+ */
+void Widget_SetBar(Widget_t *w, uint32_t value, uint32_t max)
+{
+    uint8_t inner, fill;
+
+    if (w->width < 3 || w->height < 3)
+    {
+        return;
+    }
+    inner = w->width - 2;
+
+    // 计算填充宽度，满量程过大时先缩小，避免乘法溢出
+    if (value > max)
+    {
+        value = max;
+    }
+    while (max > 0x00FFFFFF)
+    {
+        max >>= 1;
+        value >>= 1;
+    }
+    fill = max ? value * inner / max : 0;
+
+    if (!w->valid)
+    {
+        OLED_ClearArea(w->x, w->y, w->width, w->height);
+        OLED_DrawRectangle(w->x, w->y, w->width, w->height, OLED_UNFILLED);
+        w->state = 0;
+        w->valid = 1;
+    }
+
+    if (fill > w->state)
+    {
+        OLED_DrawRectangle(w->x + 1 + w->state, w->y + 1, fill - w->state, w->height - 2, OLED_FILLED);
+    }
+    else if (fill < w->state)
+    {
+        OLED_ClearArea(w->x + 1 + fill, w->y + 1, w->state - fill, w->height - 2);
+    }
+    w->state = fill;
+}
+
+/**
+ * 函    数：设置列表行
+ * 参    数：w - 控件
+ *          text - 行文本，超出行宽的部分不显示
+ *          selected - 是否选中，选中时整行反色
+ * 返 回 值：无
+ * 说    明：选中状态改变时整行重绘，否则只重绘变化的字符
+ */
+void Widget_SetRow(Widget_t *w, const char *text, uint8_t selected)
+{
+    char buf[WIDGET_TEXT_LEN + 1];
+    uint8_t n = w->width / w->font;
+
+    if (n > WIDGET_TEXT_LEN)
+    {
+        n = WIDGET_TEXT_LEN;
+    }
+    strncpy(buf, text, n);
+    buf[n] = '\0';
+    selected = selected ? 1 : 0;
+
+    if (!w->valid || selected != w->state)
+    {
+        OLED_ClearArea(w->x, w->y, w->width, w->height);
+        memset(w->text, 0, sizeof(w->text));
+        w->valid = 0;
+        Widget_DrawText(w, buf, 0);
+        if (selected)
+        {
+            OLED_ReverseArea(w->x, w->y, w->width, w->height);
+        }
+        w->state = selected;
+    }
+    else
+    {
+        Widget_DrawText(w, buf, selected);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef __WIDGET_H
+#define __WIDGET_H
+#include "stm32f10x.h"
+#include "OLED.h"
+#include "Format.h"
+
+/*
+ * 文件名：Widget.h
+ * 描    述：保留模式控件层头文件
+ *          控件记住上一次绘制的内容，设置新值时只重绘变化的字符/像素列，
+ *          其余区域不写显存也不标记脏区，配合OLED_Update只发送变化部分
+ */
+
+#define WIDGET_TEXT_LEN     21  // 控件文本最大长度（6x8字体一行21个字符）
+
+/*控件结构体，由各Widget_InitXxx函数初始化*/
+typedef struct {
+    int16_t x;                      // 左上角横坐标
+    int16_t y;                      // 左上角纵坐标
+    uint8_t width;                  // 区域宽度（进度条、列表行使用）
+    uint8_t height;                 // 区域高度（进度条使用，文本类控件为字体高度）
+    uint8_t font;                   // 字体：OLED_6X8 或 OLED_8X16
+    uint8_t frac;                   // 数值字段的小数位数
+    const char *prefix;             // 数值字段前缀，可为NULL
+    const char *suffix;             // 数值字段后缀，可为NULL
+    uint8_t state;                  // 进度条：已填充宽度；列表行：是否选中
+    uint8_t valid;                  // 0：屏幕上尚无该控件，下次设置时整块绘制
+    char text[WIDGET_TEXT_LEN + 1]; // 上次绘制的文本，不足部分补0
+} Widget_t;
+
+/*初始化函数，调用前屏幕对应区域应为空白（通常在OLED_Clear之后）*/
+void Widget_InitLabel(Widget_t *w, int16_t x, int16_t y, uint8_t font);
+void Widget_InitNumber(Widget_t *w, int16_t x, int16_t y, uint8_t font,
+                       const char *prefix, const char *suffix, uint8_t frac);
+void Widget_InitBar(Widget_t *w, int16_t x, int16_t y, uint8_t width, uint8_t height);
+void Widget_InitRow(Widget_t *w, int16_t x, int16_t y, uint8_t width, uint8_t font);
+void Widget_Invalidate(Widget_t *w);
+
+/*设置函数，内容未变化时不写显存*/
+void Widget_SetText(Widget_t *w, const char *text);
+void Widget_SetNumber(Widget_t *w, int32_t value);
+void Widget_SetBar(Widget_t *w, uint32_t value, uint32_t max);
+void Widget_SetRow(Widget_t *w, const char *text, uint8_t selected);
+
+#endif
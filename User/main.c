@@ -50,21 +50,32 @@ int main(void)
   /*主循环*/
   while (1)
   {
-    /*扫描按键（状态机处理，建议10ms调用一次）*/
-    Key_Status_Process();
-    /*处理按键事件（支持长按连续翻动）*/
-    Menu_Process(key_none); // 参数0表示不使用直接按键值，在Menu_Process内部获取事件
+    /*按键由TIM4中断每1ms扫描，这里只从事件队列中取事件*/
+    if (Screen_IsOpen())
+    {
+      /*功能界面打开时由栈顶界面处理按键和显示（实时统计、阈值设置等），不阻塞主循环*/
+      Screen_Process();
+    }
+    else
+    {
+      /*处理按键事件（支持长按连续翻动）*/
+      Menu_Process(key_none); // 参数0表示不使用直接按键值，在Menu_Process内部读取事件队列
+    }
 
-    /*刷新菜单显示（仅在非实时统计模式下）*/
-    /*实时统计模式下，显示由LiveCounting_Display()函数处理*/
-    Menu_Display();
+    /*刷新菜单显示（仅在没有打开功能界面时）*/
+    if (!Screen_IsOpen())
+    {
+      Menu_Display();
+    }
     CYZ_Receiver_Process(); // 处理接收到的特定数据包
+    Sensor_ProcessInLoop(); // 计数在PendSV中完成，这里弹出报警界面
+    Mirror_Process();       // 发送推迟的屏幕镜像帧（镜像关闭时直接返回）
 
     /*全局时间更新（每秒更新一次）*/
     if (Delay_Check(&time_update_timer))
     {
       Time_Update();                         // 更新全局时间
-      Menu_Refresh();                        // 刷新菜单显示以更新状态栏时间
+      Menu_UpdateTime();                     // 下次显示时只重绘状态栏中的时间
       Delay_Start(&time_update_timer, 1000); // 重新开始定时器
     }
 
@@ -93,7 +104,7 @@ int main(void)
 void System_startup(void)
 {
   // 显示LOGO
-  OLED_ShowImage(32, 0, 64, 64, HT_LOGO1);
+  OLED_ShowPackedImage(32, 0, 64, 64, HT_LOGO1_RLE);
   OLED_Update();
   while (GPIO_ReadInputDataBit(GPIOA, GPIO_Pin_2))
     ; // 等待按下开始按键                                        // 按下开始按键启动系统
@@ -120,7 +131,7 @@ void System_startup(void)
     }
     // 显示百分比
     char text[16];
-    sprintf(text, "Loading... %d%%", i);
+    Format_Sprintf(text, sizeof(text), "Loading... %d%%", i);
     OLED_ShowString(10, 48, text, OLED_8X16);
     OLED_Update();
     Delay_ms(100); // 控制进度速度
@@ -17,6 +17,7 @@
 #include "GPIO_Config.h"
 #include "ESP8266.h"
 #include "DHT11.h"
+#include "Mirror.h"
 
 #endif
 
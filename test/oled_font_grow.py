@@ -0,0 +1,54 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+文件名：oled_font_grow.py
+描  述：测试用，复制OLED_Data.c并在OLED_CF16x16末尾的默认图形之前加入指定数量的汉字字模，
+        用于在较大的字模库上测试和比较汉字查找；字模内容无意义，汉字按固定步长从基本区中选取
+
+用法：
+  python oled_font_grow.py OLED_Data.c 490 -o OLED_Data.c
+"""
+
+import argparse
+import sys
+
+
+def main():
+    parser = argparse.ArgumentParser(description='扩充汉字字模库')
+    parser.add_argument('input', help='OLED_Data.c')
+    parser.add_argument('count', type=int, help='加入的汉字数量')
+    parser.add_argument('-o', '--output', required=True, help='输出文件')
+    args = parser.parse_args()
+
+    with open(args.input, encoding='utf-8-sig') as f:
+        lines = f.read().split('\n')
+
+    start = next((i for i, line in enumerate(lines) if 'OLED_CF16x16[] =' in line), None)
+    if start is None:
+        sys.exit('未找到OLED_CF16x16')
+    end = next((i for i in range(start, len(lines)) if lines[i].strip() == '"",'), None)
+    if end is None:
+        sys.exit('未找到末尾的默认图形')
+
+    existing = set(''.join(lines[start:end]))
+    cells = []
+    added = 0
+    code = 0x4E00
+    while added < args.count:
+        char = chr(code)
+        code += 37
+        if char in existing:
+            continue
+        data = [(added * 13 + k * 7) & 0xFF for k in range(32)]
+        added += 1
+        cells.append('\t"%s",' % char)
+        for half in (data[:16], data[16:]):
+            cells.append('\t' + ','.join('0x%02X' % b for b in half) + ',')
+
+    lines[end:end] = cells
+    with open(args.output, 'w', encoding='utf-8', newline='\n') as f:
+        f.write('\n'.join(lines))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,169 @@
+#include "Delay.h"
+#include "stub.h"
+
+/*
+文件名：Delay_stub.c
+描    述：主机测试用的延时模块，代替Delay.c
+          时间由测试通过Stub_Delay_AdvanceUs/Ms推进，阻塞延时直接推进时间
+          非阻塞延时的判断方式与Delay.c相同，每经过1ms调用一次节拍回调（相当于TIM2/TIM4中断）
+          固件读取时间时调用轮询回调，测试可以在回调中推进时间、模拟中断，用于测试忙等待的代码
+*/
+
+static uint32_t now_us = 0;                           // 当前时间（微秒）
+static void (*tick_hook)(uint32_t ms) = NULL;         // 每毫秒回调
+static void (*poll_hook)(void) = NULL;                // 读取时间时回调
+static bool in_poll_hook = false;                     // 回调中读取时间不再回调
+static Delay_CaptureCallback capture_callback = NULL; // 输入捕获回调
+
+/**
+ * @brief  时间清零，清除回调
+ */
+void Stub_Delay_Reset(void)
+{
+  now_us = 0;
+  tick_hook = NULL;
+  poll_hook = NULL;
+  capture_callback = NULL;
+}
+
+/**
+ * @brief  设置每毫秒回调
+ * @param  hook: 回调函数，参数为当前毫秒数，NULL表示不回调
+ * @note   用来模拟按键扫描、传感器计数等1ms定时器中断
+ */
+void Stub_Delay_SetTickHook(void (*hook)(uint32_t ms))
+{
+  tick_hook = hook;
+}
+
+/**
+ * @brief  设置读取时间时的回调
+ * @param  hook: 回调函数，NULL表示不回调
+ * @note   Delay_Get_Ticks/Us/Cycles读取时间前调用，回调中读取时间不会再次回调
+ */
+void Stub_Delay_SetPollHook(void (*hook)(void))
+{
+  poll_hook = hook;
+}
+
+static void Stub_Delay_Poll(void)
+{
+  if (poll_hook != NULL && !in_poll_hook)
+  {
+    in_poll_hook = true;
+    poll_hook();
+    in_poll_hook = false;
+  }
+}
+
+/**
+ * @brief  推进时间
+ * @param  us: 微秒数
+ * @note   每跨过一个毫秒边界调用一次节拍回调，回调中可以再次推进时间
+ */
+void Stub_Delay_AdvanceUs(uint32_t us)
+{
+  while (us > 0)
+  {
+    uint32_t step = 1000 - now_us % 1000;
+    if (step > us)
+    {
+      now_us += us;
+      return;
+    }
+    now_us += step;
+    us -= step;
+    if (tick_hook != NULL)
+    {
+      tick_hook(now_us / 1000);
+    }
+  }
+}
+
+void Stub_Delay_AdvanceMs(uint32_t ms)
+{
+  Stub_Delay_AdvanceUs(ms * 1000);
+}
+
+/**
+ * @brief  模拟TIM2通道1输入捕获
+ * @param  time_us: 捕获时刻（微秒）
+ */
+void Stub_Delay_Capture(uint32_t time_us)
+{
+  if (capture_callback != NULL)
+  {
+    capture_callback(time_us);
+  }
+}
+
+void Delay_Init(void)
+{
+}
+
+void Delay_SetCaptureCallback(Delay_CaptureCallback callback)
+{
+  capture_callback = callback;
+}
+
+uint32_t Delay_Get_Ticks(void)
+{
+  Stub_Delay_Poll();
+  return now_us / 1000;
+}
+
+uint32_t Delay_Get_Us(void)
+{
+  Stub_Delay_Poll();
+  return now_us;
+}
+
+uint32_t Delay_Get_Cycles(void)
+{
+  Stub_Delay_Poll();
+  return now_us * 72;
+}
+
+bool Delay_Start(DelayTimer *timer, uint32_t ms)
+{
+  if (timer == NULL)
+    return false;
+  timer->start_time = Delay_Get_Ticks();
+  timer->delay_ms = ms;
+  timer->is_running = true;
+  return true;
+}
+
+bool Delay_Check(DelayTimer *timer)
+{
+  if (timer == NULL)
+    return false;
+  if (timer->is_running == false)
+    return false;
+
+  if (Delay_Get_Ticks() - timer->start_time >= timer->delay_ms)
+  {
+    timer->is_running = false;
+    timer->start_time = 0;
+    return true;
+  }
+
+  return false;
+}
+
+void Delay_Stop(DelayTimer *timer)
+{
+  if (timer == NULL)
+    return;
+  timer->is_running = false;
+}
+
+void Delay_us(uint32_t nus)
+{
+  Stub_Delay_AdvanceUs(nus);
+}
+
+void Delay_ms(uint32_t nms)
+{
+  Stub_Delay_AdvanceMs(nms);
+}
@@ -0,0 +1,511 @@
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+/*
+ * 文件名：stm32f10x.h（主机测试桩）
+ * 描    述：在PC上编译固件源码时代替器件头文件和标准外设库
+ *          外设寄存器是普通的全局变量，标准外设库函数由stm32f10x_stub.c实现，
+ *          只读写这些变量，不访问任何硬件；测试通过修改寄存器变量模拟引脚电平、中断标志等
+ *          只包含固件实际用到的部分，宏的取值与标准外设库相同
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*基本类型*********************/
+
+typedef enum {RESET = 0, SET = !RESET} FlagStatus, ITStatus;
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+typedef enum {ERROR = 0, SUCCESS = !ERROR} ErrorStatus;
+
+typedef int32_t  s32;
+typedef int16_t  s16;
+typedef int8_t   s8;
+typedef uint32_t u32;
+typedef uint16_t u16;
+typedef uint8_t  u8;
+
+#define __I  volatile const
+#define __O  volatile
+#define __IO volatile
+
+#define __NVIC_PRIO_BITS 4
+
+typedef enum
+{
+	SysTick_IRQn = -1,
+	PendSV_IRQn = -2,
+	EXTI0_IRQn = 6,
+	DMA1_Channel1_IRQn = 11,
+	DMA1_Channel5_IRQn = 15,
+	DMA1_Channel6_IRQn = 16,
+	TIM2_IRQn = 28,
+	TIM3_IRQn = 29,
+	TIM4_IRQn = 30,
+	I2C1_EV_IRQn = 31,
+	I2C1_ER_IRQn = 32,
+	USART1_IRQn = 37,
+} IRQn_Type;
+
+/*寄存器结构*********************/
+
+typedef struct
+{
+	__IO uint32_t CRL, CRH, IDR, ODR, BSRR, BRR, LCKR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+	__IO uint16_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC, ARR, RCR;
+	__IO uint16_t CCR1, CCR2, CCR3, CCR4, BDTR, DCR, DMAR;
+} TIM_TypeDef;
+
+typedef struct
+{
+	__IO uint16_t SR, DR, BRR, CR1, CR2, CR3, GTPR;
+} USART_TypeDef;
+
+typedef struct
+{
+	__IO uint16_t CR1, CR2, OAR1, OAR2, DR, SR1, SR2, CCR, TRISE;
+} I2C_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CCR, CNDTR, CPAR, CMAR;
+} DMA_Channel_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t ISR, IFCR;
+} DMA_TypeDef;
+
+typedef struct
+{
+	__IO uint16_t CR1, CR2, SR, DR;
+} SPI_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t SR, CR1, CR2, DR;
+} ADC_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CPUID, ICSR, VTOR, AIRCR, SCR, CCR;
+} SCB_Type;
+
+typedef struct
+{
+	__IO uint32_t CTRL, LOAD, VAL, CALIB;
+} SysTick_Type;
+
+extern GPIO_TypeDef Stub_GPIOA, Stub_GPIOB, Stub_GPIOC;
+extern TIM_TypeDef Stub_TIM1, Stub_TIM2, Stub_TIM3, Stub_TIM4;
+extern USART_TypeDef Stub_USART1, Stub_USART2;
+extern I2C_TypeDef Stub_I2C1;
+extern DMA_TypeDef Stub_DMA1;
+extern DMA_Channel_TypeDef Stub_DMA1_Channel[7];
+extern SPI_TypeDef Stub_SPI1;
+extern ADC_TypeDef Stub_ADC1;
+extern SCB_Type Stub_SCB;
+extern SysTick_Type Stub_SysTick;
+
+#define GPIOA			(&Stub_GPIOA)
+#define GPIOB			(&Stub_GPIOB)
+#define GPIOC			(&Stub_GPIOC)
+#define TIM1			(&Stub_TIM1)
+#define TIM2			(&Stub_TIM2)
+#define TIM3			(&Stub_TIM3)
+#define TIM4			(&Stub_TIM4)
+#define USART1			(&Stub_USART1)
+#define USART2			(&Stub_USART2)
+#define I2C1			(&Stub_I2C1)
+#define DMA1			(&Stub_DMA1)
+#define DMA1_Channel1	(&Stub_DMA1_Channel[0])
+#define DMA1_Channel5	(&Stub_DMA1_Channel[4])
+#define DMA1_Channel6	(&Stub_DMA1_Channel[5])
+#define SPI1			(&Stub_SPI1)
+#define ADC1			(&Stub_ADC1)
+#define SCB				(&Stub_SCB)
+#define SysTick			(&Stub_SysTick)
+
+#define SCB_ICSR_PENDSVSET		((uint32_t)0x10000000)
+#define SysTick_CTRL_ENABLE		((uint32_t)0x00000001)
+
+#define I2C_CR1_PE				((uint16_t)0x0001)
+#define I2C_CR1_START			((uint16_t)0x0100)
+#define I2C_CR1_STOP			((uint16_t)0x0200)
+#define I2C_CR2_ITERREN			((uint16_t)0x0100)
+#define I2C_CR2_ITEVTEN			((uint16_t)0x0200)
+#define I2C_CR2_DMAEN			((uint16_t)0x0800)
+#define I2C_SR1_SB				((uint16_t)0x0001)
+#define I2C_SR1_ADDR			((uint16_t)0x0002)
+#define I2C_SR1_BTF				((uint16_t)0x0004)
+#define I2C_SR1_BERR			((uint16_t)0x0100)
+#define I2C_SR1_ARLO			((uint16_t)0x0200)
+#define I2C_SR1_AF				((uint16_t)0x0400)
+#define I2C_SR1_OVR				((uint16_t)0x0800)
+
+/*内核函数*********************/
+
+extern uint32_t SystemCoreClock;
+extern uint32_t Stub_BASEPRI;
+extern uint32_t Stub_PRIMASK;
+
+void __set_BASEPRI(uint32_t value);
+uint32_t __get_BASEPRI(void);
+void __enable_irq(void);
+void __disable_irq(void);
+#define __NOP()
+#define __DSB()
+#define __ISB()
+#define __DMB()
+#define __WFI()
+
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+void NVIC_SetPendingIRQ(IRQn_Type IRQn);
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+uint32_t SysTick_Config(uint32_t ticks);
+
+/*misc*********************/
+
+typedef struct
+{
+	uint8_t NVIC_IRQChannel;
+	uint8_t NVIC_IRQChannelPreemptionPriority;
+	uint8_t NVIC_IRQChannelSubPriority;
+	FunctionalState NVIC_IRQChannelCmd;
+} NVIC_InitTypeDef;
+
+#define NVIC_PriorityGroup_0	((uint32_t)0x700)
+#define NVIC_PriorityGroup_1	((uint32_t)0x600)
+#define NVIC_PriorityGroup_2	((uint32_t)0x500)
+#define NVIC_PriorityGroup_3	((uint32_t)0x400)
+#define NVIC_PriorityGroup_4	((uint32_t)0x300)
+
+void NVIC_PriorityGroupConfig(uint32_t NVIC_PriorityGroup);
+void NVIC_Init(NVIC_InitTypeDef *NVIC_InitStruct);
+
+/*RCC*********************/
+
+#define RCC_AHBPeriph_DMA1		((uint32_t)0x00000001)
+#define RCC_APB2Periph_AFIO		((uint32_t)0x00000001)
+#define RCC_APB2Periph_GPIOA	((uint32_t)0x00000004)
+#define RCC_APB2Periph_GPIOB	((uint32_t)0x00000008)
+#define RCC_APB2Periph_GPIOC	((uint32_t)0x00000010)
+#define RCC_APB2Periph_ADC1		((uint32_t)0x00000200)
+#define RCC_APB2Periph_TIM1		((uint32_t)0x00000800)
+#define RCC_APB2Periph_SPI1		((uint32_t)0x00001000)
+#define RCC_APB2Periph_USART1	((uint32_t)0x00004000)
+#define RCC_APB1Periph_TIM2		((uint32_t)0x00000001)
+#define RCC_APB1Periph_TIM3		((uint32_t)0x00000002)
+#define RCC_APB1Periph_TIM4		((uint32_t)0x00000004)
+#define RCC_APB1Periph_USART2	((uint32_t)0x00020000)
+#define RCC_APB1Periph_I2C1		((uint32_t)0x00200000)
+#define RCC_PCLK2_Div6			((uint32_t)0x00008000)
+
+void RCC_AHBPeriphClockCmd(uint32_t RCC_AHBPeriph, FunctionalState NewState);
+void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState);
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState);
+void RCC_ADCCLKConfig(uint32_t RCC_PCLK2);
+
+/*GPIO*********************/
+
+typedef enum
+{
+	GPIO_Speed_10MHz = 1,
+	GPIO_Speed_2MHz,
+	GPIO_Speed_50MHz
+} GPIOSpeed_TypeDef;
+
+typedef enum
+{
+	GPIO_Mode_AIN = 0x0,
+	GPIO_Mode_IN_FLOATING = 0x04,
+	GPIO_Mode_IPD = 0x28,
+	GPIO_Mode_IPU = 0x48,
+	GPIO_Mode_Out_OD = 0x14,
+	GPIO_Mode_Out_PP = 0x10,
+	GPIO_Mode_AF_OD = 0x1C,
+	GPIO_Mode_AF_PP = 0x18
+} GPIOMode_TypeDef;
+
+typedef struct
+{
+	uint16_t GPIO_Pin;
+	GPIOSpeed_TypeDef GPIO_Speed;
+	GPIOMode_TypeDef GPIO_Mode;
+} GPIO_InitTypeDef;
+
+typedef enum
+{
+	Bit_RESET = 0,
+	Bit_SET
+} BitAction;
+
+#define GPIO_Pin_0		((uint16_t)0x0001)
+#define GPIO_Pin_1		((uint16_t)0x0002)
+#define GPIO_Pin_2		((uint16_t)0x0004)
+#define GPIO_Pin_3		((uint16_t)0x0008)
+#define GPIO_Pin_4		((uint16_t)0x0010)
+#define GPIO_Pin_5		((uint16_t)0x0020)
+#define GPIO_Pin_6		((uint16_t)0x0040)
+#define GPIO_Pin_7		((uint16_t)0x0080)
+#define GPIO_Pin_8		((uint16_t)0x0100)
+#define GPIO_Pin_9		((uint16_t)0x0200)
+#define GPIO_Pin_10		((uint16_t)0x0400)
+#define GPIO_Pin_11		((uint16_t)0x0800)
+#define GPIO_Pin_12		((uint16_t)0x1000)
+#define GPIO_Pin_13		((uint16_t)0x2000)
+#define GPIO_Pin_14		((uint16_t)0x4000)
+#define GPIO_Pin_15		((uint16_t)0x8000)
+#define GPIO_Pin_All	((uint16_t)0xFFFF)
+
+#define GPIO_Remap_I2C1					((uint32_t)0x00000002)
+#define GPIO_Remap_USART1				((uint32_t)0x00000004)
+#define GPIO_Remap_SWJ_JTAGDisable		((uint32_t)0x00300200)
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct);
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+uint16_t GPIO_ReadInputData(GPIO_TypeDef *GPIOx);
+uint8_t GPIO_ReadOutputDataBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void GPIO_SetBits(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void GPIO_ResetBits(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void GPIO_WriteBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, BitAction BitVal);
+void GPIO_PinRemapConfig(uint32_t GPIO_Remap, FunctionalState NewState);
+
+/*TIM*********************/
+
+typedef struct
+{
+	uint16_t TIM_Prescaler;
+	uint16_t TIM_CounterMode;
+	uint16_t TIM_Period;
+	uint16_t TIM_ClockDivision;
+	uint8_t TIM_RepetitionCounter;
+} TIM_TimeBaseInitTypeDef;
+
+typedef struct
+{
+	uint16_t TIM_Channel;
+	uint16_t TIM_ICPolarity;
+	uint16_t TIM_ICSelection;
+	uint16_t TIM_ICPrescaler;
+	uint16_t TIM_ICFilter;
+} TIM_ICInitTypeDef;
+
+#define TIM_CounterMode_Up				((uint16_t)0x0000)
+#define TIM_CKD_DIV1					((uint16_t)0x0000)
+#define TIM_CKD_DIV2					((uint16_t)0x0100)
+#define TIM_CKD_DIV4					((uint16_t)0x0200)
+#define TIM_Channel_1					((uint16_t)0x0000)
+#define TIM_Channel_2					((uint16_t)0x0004)
+#define TIM_ICPolarity_Rising			((uint16_t)0x0000)
+#define TIM_ICPolarity_Falling			((uint16_t)0x0002)
+#define TIM_ICSelection_DirectTI		((uint16_t)0x0001)
+#define TIM_ICPSC_DIV1					((uint16_t)0x0000)
+#define TIM_EncoderMode_TI12			((uint16_t)0x0003)
+#define TIM_TIxExternalCLK1Source_TI1	((uint16_t)0x0050)
+#define TIM_IT_Update					((uint16_t)0x0001)
+#define TIM_IT_CC1						((uint16_t)0x0002)
+#define TIM_FLAG_Update					((uint16_t)0x0001)
+#define TIM_DMA_Update					((uint16_t)0x0100)
+#define TIM_DMA_CC1						((uint16_t)0x0200)
+
+void TIM_TimeBaseInit(TIM_TypeDef *TIMx, TIM_TimeBaseInitTypeDef *TIM_TimeBaseInitStruct);
+void TIM_TimeBaseStructInit(TIM_TimeBaseInitTypeDef *TIM_TimeBaseInitStruct);
+void TIM_ICInit(TIM_TypeDef *TIMx, TIM_ICInitTypeDef *TIM_ICInitStruct);
+void TIM_ICStructInit(TIM_ICInitTypeDef *TIM_ICInitStruct);
+void TIM_EncoderInterfaceConfig(TIM_TypeDef *TIMx, uint16_t TIM_EncoderMode, uint16_t TIM_IC1Polarity, uint16_t TIM_IC2Polarity);
+void TIM_TIxExternalClockConfig(TIM_TypeDef *TIMx, uint16_t TIM_TIxExternalCLKSource, uint16_t TIM_ICPolarity, uint16_t ICFilter);
+void TIM_SetClockDivision(TIM_TypeDef *TIMx, uint16_t TIM_CKD);
+void TIM_Cmd(TIM_TypeDef *TIMx, FunctionalState NewState);
+void TIM_ITConfig(TIM_TypeDef *TIMx, uint16_t TIM_IT, FunctionalState NewState);
+void TIM_DMACmd(TIM_TypeDef *TIMx, uint16_t TIM_DMASource, FunctionalState NewState);
+ITStatus TIM_GetITStatus(TIM_TypeDef *TIMx, uint16_t TIM_IT);
+FlagStatus TIM_GetFlagStatus(TIM_TypeDef *TIMx, uint16_t TIM_FLAG);
+void TIM_ClearITPendingBit(TIM_TypeDef *TIMx, uint16_t TIM_IT);
+void TIM_ClearFlag(TIM_TypeDef *TIMx, uint16_t TIM_FLAG);
+uint16_t TIM_GetCounter(TIM_TypeDef *TIMx);
+void TIM_SetCounter(TIM_TypeDef *TIMx, uint16_t Counter);
+uint16_t TIM_GetCapture1(TIM_TypeDef *TIMx);
+
+/*DMA*********************/
+
+typedef struct
+{
+	uint32_t DMA_PeripheralBaseAddr;
+	uint32_t DMA_MemoryBaseAddr;
+	uint32_t DMA_DIR;
+	uint32_t DMA_BufferSize;
+	uint32_t DMA_PeripheralInc;
+	uint32_t DMA_MemoryInc;
+	uint32_t DMA_PeripheralDataSize;
+	uint32_t DMA_MemoryDataSize;
+	uint32_t DMA_Mode;
+	uint32_t DMA_Priority;
+	uint32_t DMA_M2M;
+} DMA_InitTypeDef;
+
+#define DMA_DIR_PeripheralDST			((uint32_t)0x00000010)
+#define DMA_DIR_PeripheralSRC			((uint32_t)0x00000000)
+#define DMA_PeripheralInc_Enable		((uint32_t)0x00000040)
+#define DMA_PeripheralInc_Disable		((uint32_t)0x00000000)
+#define DMA_MemoryInc_Enable			((uint32_t)0x00000080)
+#define DMA_MemoryInc_Disable			((uint32_t)0x00000000)
+#define DMA_PeripheralDataSize_Byte		((uint32_t)0x00000000)
+#define DMA_PeripheralDataSize_HalfWord	((uint32_t)0x00000100)
+#define DMA_MemoryDataSize_Byte			((uint32_t)0x00000000)
+#define DMA_MemoryDataSize_HalfWord		((uint32_t)0x00000400)
+#define DMA_Mode_Circular				((uint32_t)0x00000020)
+#define DMA_Mode_Normal					((uint32_t)0x00000000)
+#define DMA_Priority_High				((uint32_t)0x00002000)
+#define DMA_Priority_Medium				((uint32_t)0x00001000)
+#define DMA_M2M_Disable					((uint32_t)0x00000000)
+#define DMA_IT_TC						((uint32_t)0x00000002)
+#define DMA_IT_HT						((uint32_t)0x00000004)
+#define DMA1_IT_GL5						((uint32_t)0x00010000)
+#define DMA1_IT_TC5						((uint32_t)0x00020000)
+#define DMA1_IT_HT5						((uint32_t)0x00040000)
+#define DMA1_IT_GL6						((uint32_t)0x00100000)
+#define DMA1_IT_TC6						((uint32_t)0x00200000)
+
+void DMA_DeInit(DMA_Channel_TypeDef *DMAy_Channelx);
+void DMA_Init(DMA_Channel_TypeDef *DMAy_Channelx, DMA_InitTypeDef *DMA_InitStruct);
+void DMA_Cmd(DMA_Channel_TypeDef *DMAy_Channelx, FunctionalState NewState);
+void DMA_ITConfig(DMA_Channel_TypeDef *DMAy_Channelx, uint32_t DMA_IT, FunctionalState NewState);
+void DMA_SetCurrDataCounter(DMA_Channel_TypeDef *DMAy_Channelx, uint16_t DataNumber);
+uint16_t DMA_GetCurrDataCounter(DMA_Channel_TypeDef *DMAy_Channelx);
+ITStatus DMA_GetITStatus(uint32_t DMAy_IT);
+void DMA_ClearITPendingBit(uint32_t DMAy_IT);
+
+/*USART*********************/
+
+typedef struct
+{
+	uint32_t USART_BaudRate;
+	uint16_t USART_WordLength;
+	uint16_t USART_StopBits;
+	uint16_t USART_Parity;
+	uint16_t USART_Mode;
+	uint16_t USART_HardwareFlowControl;
+} USART_InitTypeDef;
+
+#define USART_WordLength_8b				((uint16_t)0x0000)
+#define USART_StopBits_1				((uint16_t)0x0000)
+#define USART_Parity_No					((uint16_t)0x0000)
+#define USART_Mode_Rx					((uint16_t)0x0004)
+#define USART_Mode_Tx					((uint16_t)0x0008)
+#define USART_HardwareFlowControl_None	((uint16_t)0x0000)
+#define USART_IT_RXNE					((uint16_t)0x0525)
+#define USART_IT_TXE					((uint16_t)0x0727)
+#define USART_IT_TC						((uint16_t)0x0626)
+#define USART_FLAG_RXNE					((uint16_t)0x0020)
+#define USART_FLAG_TC					((uint16_t)0x0040)
+#define USART_FLAG_TXE					((uint16_t)0x0080)
+
+void USART_Init(USART_TypeDef *USARTx, USART_InitTypeDef *USART_InitStruct);
+void USART_DeInit(USART_TypeDef *USARTx);
+void USART_Cmd(USART_TypeDef *USARTx, FunctionalState NewState);
+void USART_ITConfig(USART_TypeDef *USARTx, uint16_t USART_IT, FunctionalState NewState);
+void USART_SendData(USART_TypeDef *USARTx, uint16_t Data);
+uint16_t USART_ReceiveData(USART_TypeDef *USARTx);
+FlagStatus USART_GetFlagStatus(USART_TypeDef *USARTx, uint16_t USART_FLAG);
+ITStatus USART_GetITStatus(USART_TypeDef *USARTx, uint16_t USART_IT);
+void USART_ClearITPendingBit(USART_TypeDef *USARTx, uint16_t USART_IT);
+
+/*I2C*********************/
+
+typedef struct
+{
+	uint32_t I2C_ClockSpeed;
+	uint16_t I2C_Mode;
+	uint16_t I2C_DutyCycle;
+	uint16_t I2C_OwnAddress1;
+	uint16_t I2C_Ack;
+	uint16_t I2C_AcknowledgedAddress;
+} I2C_InitTypeDef;
+
+#define I2C_Mode_I2C					((uint16_t)0x0000)
+#define I2C_DutyCycle_2					((uint16_t)0xBFFF)
+#define I2C_Ack_Enable					((uint16_t)0x0400)
+#define I2C_AcknowledgedAddress_7bit	((uint16_t)0x4000)
+#define I2C_Direction_Transmitter		((uint8_t)0x00)
+#define I2C_IT_ERR						((uint16_t)0x0100)
+#define I2C_IT_EVT						((uint16_t)0x0200)
+
+void I2C_DeInit(I2C_TypeDef *I2Cx);
+void I2C_Init(I2C_TypeDef *I2Cx, I2C_InitTypeDef *I2C_InitStruct);
+void I2C_Cmd(I2C_TypeDef *I2Cx, FunctionalState NewState);
+void I2C_DMACmd(I2C_TypeDef *I2Cx, FunctionalState NewState);
+void I2C_ITConfig(I2C_TypeDef *I2Cx, uint16_t I2C_IT, FunctionalState NewState);
+void I2C_GenerateSTART(I2C_TypeDef *I2Cx, FunctionalState NewState);
+void I2C_GenerateSTOP(I2C_TypeDef *I2Cx, FunctionalState NewState);
+void I2C_Send7bitAddress(I2C_TypeDef *I2Cx, uint8_t Address, uint8_t I2C_Direction);
+void I2C_SoftwareResetCmd(I2C_TypeDef *I2Cx, FunctionalState NewState);
+
+/*SPI*********************/
+
+typedef struct
+{
+	uint16_t SPI_Direction;
+	uint16_t SPI_Mode;
+	uint16_t SPI_DataSize;
+	uint16_t SPI_CPOL;
+	uint16_t SPI_CPHA;
+	uint16_t SPI_NSS;
+	uint16_t SPI_BaudRatePrescaler;
+	uint16_t SPI_FirstBit;
+	uint16_t SPI_CRCPolynomial;
+} SPI_InitTypeDef;
+
+#define SPI_Direction_2Lines_FullDuplex	((uint16_t)0x0000)
+#define SPI_Mode_Master					((uint16_t)0x0104)
+#define SPI_DataSize_8b					((uint16_t)0x0000)
+#define SPI_CPOL_Low					((uint16_t)0x0000)
+#define SPI_CPHA_1Edge					((uint16_t)0x0000)
+#define SPI_NSS_Soft					((uint16_t)0x0200)
+#define SPI_BaudRatePrescaler_16		((uint16_t)0x0018)
+#define SPI_FirstBit_MSB				((uint16_t)0x0000)
+#define SPI_I2S_FLAG_RXNE				((uint16_t)0x0001)
+#define SPI_I2S_FLAG_TXE				((uint16_t)0x0002)
+
+void SPI_Init(SPI_TypeDef *SPIx, SPI_InitTypeDef *SPI_InitStruct);
+void SPI_Cmd(SPI_TypeDef *SPIx, FunctionalState NewState);
+void SPI_I2S_SendData(SPI_TypeDef *SPIx, uint16_t Data);
+uint16_t SPI_I2S_ReceiveData(SPI_TypeDef *SPIx);
+FlagStatus SPI_I2S_GetFlagStatus(SPI_TypeDef *SPIx, uint16_t SPI_I2S_FLAG);
+
+/*ADC*********************/
+
+typedef struct
+{
+	uint32_t ADC_Mode;
+	FunctionalState ADC_ScanConvMode;
+	FunctionalState ADC_ContinuousConvMode;
+	uint32_t ADC_ExternalTrigConv;
+	uint32_t ADC_DataAlign;
+	uint8_t ADC_NbrOfChannel;
+} ADC_InitTypeDef;
+
+#define ADC_Mode_Independent			((uint32_t)0x00000000)
+#define ADC_ExternalTrigConv_None		((uint32_t)0x000E0000)
+#define ADC_DataAlign_Right				((uint32_t)0x00000000)
+#define ADC_Channel_4					((uint8_t)0x04)
+#define ADC_SampleTime_55Cycles5		((uint8_t)0x05)
+
+void ADC_Init(ADC_TypeDef *ADCx, ADC_InitTypeDef *ADC_InitStruct);
+void ADC_Cmd(ADC_TypeDef *ADCx, FunctionalState NewState);
+void ADC_DMACmd(ADC_TypeDef *ADCx, FunctionalState NewState);
+void ADC_RegularChannelConfig(ADC_TypeDef *ADCx, uint8_t ADC_Channel, uint8_t Rank, uint8_t ADC_SampleTime);
+void ADC_ResetCalibration(ADC_TypeDef *ADCx);
+FlagStatus ADC_GetResetCalibrationStatus(ADC_TypeDef *ADCx);
+void ADC_StartCalibration(ADC_TypeDef *ADCx);
+FlagStatus ADC_GetCalibrationStatus(ADC_TypeDef *ADCx);
+void ADC_SoftwareStartConvCmd(ADC_TypeDef *ADCx, FunctionalState NewState);
+uint16_t ADC_GetConversionValue(ADC_TypeDef *ADCx);
+
+#endif
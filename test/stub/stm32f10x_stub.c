@@ -0,0 +1,481 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include <string.h>
+
+/*
+ * 文件名：stm32f10x_stub.c
+ * 描    述：主机测试用的标准外设库实现，只读写stm32f10x.h中的寄存器变量
+ *          GPIO读IDR、写ODR，测试通过修改IDR模拟按键等输入
+ *          定时器、DMA的中断标志来自SR/ISR寄存器，由测试置位后直接调用中断服务函数
+ *          USART发送的字节记录在Stub_Usart_t中，TXE/TC标志始终为SET；接收数据由Stub_Usart_Feed注入
+ *          I2C只记录START/STOP、中断和DMA使能位，总线行为由测试模拟
+ *          SPI/ADC/RCC/NVIC只保存配置或什么都不做
+ */
+
+GPIO_TypeDef Stub_GPIOA, Stub_GPIOB, Stub_GPIOC;
+TIM_TypeDef Stub_TIM1, Stub_TIM2, Stub_TIM3, Stub_TIM4;
+USART_TypeDef Stub_USART1, Stub_USART2;
+I2C_TypeDef Stub_I2C1;
+DMA_TypeDef Stub_DMA1;
+DMA_Channel_TypeDef Stub_DMA1_Channel[7];
+SPI_TypeDef Stub_SPI1;
+ADC_TypeDef Stub_ADC1;
+SCB_Type Stub_SCB;
+SysTick_Type Stub_SysTick;
+
+uint32_t SystemCoreClock = 72000000;
+uint32_t Stub_BASEPRI;
+uint32_t Stub_PRIMASK;
+
+Stub_Usart_t Stub_Usart1;
+Stub_Usart_t Stub_Usart2;
+
+void (*Stub_GPIO_WriteHook)(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint8_t Level);
+
+/**
+ * 函    数：复位所有寄存器变量和记录
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：GPIO输入默认为高电平（按键上拉，未按下）
+ */
+void Stub_Reset(void)
+{
+	memset(&Stub_GPIOA, 0, sizeof(Stub_GPIOA));
+	memset(&Stub_GPIOB, 0, sizeof(Stub_GPIOB));
+	memset(&Stub_GPIOC, 0, sizeof(Stub_GPIOC));
+	Stub_GPIOA.IDR = Stub_GPIOB.IDR = Stub_GPIOC.IDR = 0xFFFF;
+	memset(&Stub_TIM1, 0, sizeof(Stub_TIM1));
+	memset(&Stub_TIM2, 0, sizeof(Stub_TIM2));
+	memset(&Stub_TIM3, 0, sizeof(Stub_TIM3));
+	memset(&Stub_TIM4, 0, sizeof(Stub_TIM4));
+	memset(&Stub_USART1, 0, sizeof(Stub_USART1));
+	memset(&Stub_USART2, 0, sizeof(Stub_USART2));
+	memset(&Stub_I2C1, 0, sizeof(Stub_I2C1));
+	memset(&Stub_DMA1, 0, sizeof(Stub_DMA1));
+	memset(Stub_DMA1_Channel, 0, sizeof(Stub_DMA1_Channel));
+	memset(&Stub_SPI1, 0, sizeof(Stub_SPI1));
+	memset(&Stub_ADC1, 0, sizeof(Stub_ADC1));
+	memset(&Stub_SCB, 0, sizeof(Stub_SCB));
+	memset(&Stub_SysTick, 0, sizeof(Stub_SysTick));
+	memset(&Stub_Usart1, 0, sizeof(Stub_Usart1));
+	memset(&Stub_Usart2, 0, sizeof(Stub_Usart2));
+	Stub_BASEPRI = 0;
+	Stub_PRIMASK = 0;
+	Stub_GPIO_WriteHook = NULL;
+}
+
+/*内核*********************/
+
+void __set_BASEPRI(uint32_t value) { Stub_BASEPRI = value; }
+uint32_t __get_BASEPRI(void) { return Stub_BASEPRI; }
+void __enable_irq(void) { Stub_PRIMASK = 0; }
+void __disable_irq(void) { Stub_PRIMASK = 1; }
+
+void NVIC_EnableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+void NVIC_DisableIRQ(IRQn_Type IRQn) { (void)IRQn; }
+void NVIC_SetPendingIRQ(IRQn_Type IRQn) { (void)IRQn; }
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn) { (void)IRQn; }
+void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) { (void)IRQn; (void)priority; }
+void NVIC_PriorityGroupConfig(uint32_t NVIC_PriorityGroup) { (void)NVIC_PriorityGroup; }
+void NVIC_Init(NVIC_InitTypeDef *NVIC_InitStruct) { (void)NVIC_InitStruct; }
+
+uint32_t SysTick_Config(uint32_t ticks)
+{
+	SysTick->LOAD = ticks - 1;
+	SysTick->CTRL = 7;
+	return 0;
+}
+
+/*RCC*********************/
+
+void RCC_AHBPeriphClockCmd(uint32_t RCC_AHBPeriph, FunctionalState NewState) { (void)RCC_AHBPeriph; (void)NewState; }
+void RCC_APB2PeriphClockCmd(uint32_t RCC_APB2Periph, FunctionalState NewState) { (void)RCC_APB2Periph; (void)NewState; }
+void RCC_APB1PeriphClockCmd(uint32_t RCC_APB1Periph, FunctionalState NewState) { (void)RCC_APB1Periph; (void)NewState; }
+void RCC_ADCCLKConfig(uint32_t RCC_PCLK2) { (void)RCC_PCLK2; }
+
+/*GPIO*********************/
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct) { (void)GPIOx; (void)GPIO_InitStruct; }
+
+uint8_t GPIO_ReadInputDataBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	return (GPIOx->IDR & GPIO_Pin) ? Bit_SET : Bit_RESET;
+}
+
+uint16_t GPIO_ReadInputData(GPIO_TypeDef *GPIOx)
+{
+	return (uint16_t)GPIOx->IDR;
+}
+
+uint8_t GPIO_ReadOutputDataBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	return (GPIOx->ODR & GPIO_Pin) ? Bit_SET : Bit_RESET;
+}
+
+void GPIO_SetBits(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	GPIOx->ODR |= GPIO_Pin;
+	if (Stub_GPIO_WriteHook != NULL)
+	{
+		Stub_GPIO_WriteHook(GPIOx, GPIO_Pin, 1);
+	}
+}
+
+void GPIO_ResetBits(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+	if (Stub_GPIO_WriteHook != NULL)
+	{
+		Stub_GPIO_WriteHook(GPIOx, GPIO_Pin, 0);
+	}
+}
+
+void GPIO_WriteBit(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, BitAction BitVal)
+{
+	if (BitVal != Bit_RESET)
+	{
+		GPIO_SetBits(GPIOx, GPIO_Pin);
+	}
+	else
+	{
+		GPIO_ResetBits(GPIOx, GPIO_Pin);
+	}
+}
+
+void GPIO_PinRemapConfig(uint32_t GPIO_Remap, FunctionalState NewState) { (void)GPIO_Remap; (void)NewState; }
+
+/*TIM*********************/
+
+void TIM_TimeBaseInit(TIM_TypeDef *TIMx, TIM_TimeBaseInitTypeDef *TIM_TimeBaseInitStruct)
+{
+	TIMx->PSC = TIM_TimeBaseInitStruct->TIM_Prescaler;
+	TIMx->ARR = TIM_TimeBaseInitStruct->TIM_Period;
+}
+
+void TIM_TimeBaseStructInit(TIM_TimeBaseInitTypeDef *TIM_TimeBaseInitStruct)
+{
+	memset(TIM_TimeBaseInitStruct, 0, sizeof(*TIM_TimeBaseInitStruct));
+	TIM_TimeBaseInitStruct->TIM_Period = 0xFFFF;
+}
+
+void TIM_ICInit(TIM_TypeDef *TIMx, TIM_ICInitTypeDef *TIM_ICInitStruct) { (void)TIMx; (void)TIM_ICInitStruct; }
+
+void TIM_ICStructInit(TIM_ICInitTypeDef *TIM_ICInitStruct)
+{
+	memset(TIM_ICInitStruct, 0, sizeof(*TIM_ICInitStruct));
+	TIM_ICInitStruct->TIM_ICSelection = TIM_ICSelection_DirectTI;
+}
+
+void TIM_EncoderInterfaceConfig(TIM_TypeDef *TIMx, uint16_t TIM_EncoderMode, uint16_t TIM_IC1Polarity, uint16_t TIM_IC2Polarity)
+{
+	(void)TIMx; (void)TIM_EncoderMode; (void)TIM_IC1Polarity; (void)TIM_IC2Polarity;
+}
+
+void TIM_TIxExternalClockConfig(TIM_TypeDef *TIMx, uint16_t TIM_TIxExternalCLKSource, uint16_t TIM_ICPolarity, uint16_t ICFilter)
+{
+	(void)TIMx; (void)TIM_TIxExternalCLKSource; (void)TIM_ICPolarity; (void)ICFilter;
+}
+
+void TIM_SetClockDivision(TIM_TypeDef *TIMx, uint16_t TIM_CKD) { (void)TIMx; (void)TIM_CKD; }
+
+void TIM_Cmd(TIM_TypeDef *TIMx, FunctionalState NewState)
+{
+	if (NewState != DISABLE)
+	{
+		TIMx->CR1 |= 1;
+	}
+	else
+	{
+		TIMx->CR1 &= ~1;
+	}
+}
+
+void TIM_ITConfig(TIM_TypeDef *TIMx, uint16_t TIM_IT, FunctionalState NewState)
+{
+	if (NewState != DISABLE)
+	{
+		TIMx->DIER |= TIM_IT;
+	}
+	else
+	{
+		TIMx->DIER &= ~TIM_IT;
+	}
+}
+
+void TIM_DMACmd(TIM_TypeDef *TIMx, uint16_t TIM_DMASource, FunctionalState NewState)
+{
+	if (NewState != DISABLE)
+	{
+		TIMx->DIER |= TIM_DMASource;
+	}
+	else
+	{
+		TIMx->DIER &= ~TIM_DMASource;
+	}
+}
+
+ITStatus TIM_GetITStatus(TIM_TypeDef *TIMx, uint16_t TIM_IT)
+{
+	return (TIMx->SR & TIM_IT) && (TIMx->DIER & TIM_IT) ? SET : RESET;
+}
+
+FlagStatus TIM_GetFlagStatus(TIM_TypeDef *TIMx, uint16_t TIM_FLAG)
+{
+	return (TIMx->SR & TIM_FLAG) ? SET : RESET;
+}
+
+void TIM_ClearITPendingBit(TIM_TypeDef *TIMx, uint16_t TIM_IT) { TIMx->SR &= ~TIM_IT; }
+void TIM_ClearFlag(TIM_TypeDef *TIMx, uint16_t TIM_FLAG) { TIMx->SR &= ~TIM_FLAG; }
+uint16_t TIM_GetCounter(TIM_TypeDef *TIMx) { return TIMx->CNT; }
+void TIM_SetCounter(TIM_TypeDef *TIMx, uint16_t Counter) { TIMx->CNT = Counter; }
+
+uint16_t TIM_GetCapture1(TIM_TypeDef *TIMx)
+{
+	TIMx->SR &= ~TIM_IT_CC1; // 与硬件相同，读取捕获值同时清除CC1标志
+	return TIMx->CCR1;
+}
+
+/*DMA*********************/
+
+void DMA_DeInit(DMA_Channel_TypeDef *DMAy_Channelx) { memset((void *)DMAy_Channelx, 0, sizeof(*DMAy_Channelx)); }
+
+void DMA_Init(DMA_Channel_TypeDef *DMAy_Channelx, DMA_InitTypeDef *DMA_InitStruct)
+{
+	DMAy_Channelx->CNDTR = DMA_InitStruct->DMA_BufferSize;
+	DMAy_Channelx->CPAR = (uint32_t)DMA_InitStruct->DMA_PeripheralBaseAddr;
+	DMAy_Channelx->CMAR = (uint32_t)DMA_InitStruct->DMA_MemoryBaseAddr;
+}
+
+void DMA_Cmd(DMA_Channel_TypeDef *DMAy_Channelx, FunctionalState NewState)
+{
+	if (NewState != DISABLE)
+	{
+		DMAy_Channelx->CCR |= 1;
+	}
+	else
+	{
+		DMAy_Channelx->CCR &= ~1u;
+	}
+}
+
+void DMA_ITConfig(DMA_Channel_TypeDef *DMAy_Channelx, uint32_t DMA_IT, FunctionalState NewState)
+{
+	if (NewState != DISABLE)
+	{
+		DMAy_Channelx->CCR |= DMA_IT;
+	}
+	else
+	{
+		DMAy_Channelx->CCR &= ~DMA_IT;
+	}
+}
+
+void DMA_SetCurrDataCounter(DMA_Channel_TypeDef *DMAy_Channelx, uint16_t DataNumber) { DMAy_Channelx->CNDTR = DataNumber; }
+uint16_t DMA_GetCurrDataCounter(DMA_Channel_TypeDef *DMAy_Channelx) { return (uint16_t)DMAy_Channelx->CNDTR; }
+ITStatus DMA_GetITStatus(uint32_t DMAy_IT) { return (DMA1->ISR & DMAy_IT) ? SET : RESET; }
+
+void DMA_ClearITPendingBit(uint32_t DMAy_IT)
+{
+	DMA1->ISR &= ~DMAy_IT;
+}
+
+/*USART*********************/
+
+static Stub_Usart_t *Stub_UsartOf(USART_TypeDef *USARTx)
+{
+	return USARTx == USART1 ? &Stub_Usart1 : &Stub_Usart2;
+}
+
+static uint16_t Stub_UsartITBit(uint16_t USART_IT)
+{
+	switch (USART_IT)
+	{
+	case USART_IT_RXNE:
+		return 1;
+	case USART_IT_TXE:
+		return 2;
+	case USART_IT_TC:
+		return 4;
+	default:
+		return 0;
+	}
+}
+
+/**
+ * 函    数：注入串口接收数据
+ * 参    数：USARTx 串口，data/len 数据
+ * 返 回 值：无
+ * 说    明：之后由测试调用对应的中断服务函数读取
+ */
+void Stub_Usart_Feed(USART_TypeDef *USARTx, const uint8_t *data, uint32_t len)
+{
+	Stub_Usart_t *u = Stub_UsartOf(USARTx);
+	while (len--)
+	{
+		u->Rx[u->RxHead++ % STUB_USART_RX_MAX] = *data++;
+	}
+}
+
+void USART_Init(USART_TypeDef *USARTx, USART_InitTypeDef *USART_InitStruct) { (void)USARTx; (void)USART_InitStruct; }
+void USART_DeInit(USART_TypeDef *USARTx) { Stub_UsartOf(USARTx)->ITMask = 0; }
+void USART_Cmd(USART_TypeDef *USARTx, FunctionalState NewState) { (void)USARTx; (void)NewState; }
+
+void USART_ITConfig(USART_TypeDef *USARTx, uint16_t USART_IT, FunctionalState NewState)
+{
+	Stub_Usart_t *u = Stub_UsartOf(USARTx);
+	if (NewState != DISABLE)
+	{
+		u->ITMask |= Stub_UsartITBit(USART_IT);
+	}
+	else
+	{
+		u->ITMask &= ~Stub_UsartITBit(USART_IT);
+	}
+}
+
+void USART_SendData(USART_TypeDef *USARTx, uint16_t Data)
+{
+	Stub_Usart_t *u = Stub_UsartOf(USARTx);
+	if (u->TxCount < STUB_USART_TX_MAX)
+	{
+		u->Tx[u->TxCount] = (uint8_t)Data;
+	}
+	u->TxCount++;
+}
+
+uint16_t USART_ReceiveData(USART_TypeDef *USARTx)
+{
+	Stub_Usart_t *u = Stub_UsartOf(USARTx);
+	if (u->RxTail == u->RxHead)
+	{
+		return 0;
+	}
+	return u->Rx[u->RxTail++ % STUB_USART_RX_MAX];
+}
+
+FlagStatus USART_GetFlagStatus(USART_TypeDef *USARTx, uint16_t USART_FLAG)
+{
+	Stub_Usart_t *u = Stub_UsartOf(USARTx);
+	if (USART_FLAG == USART_FLAG_RXNE)
+	{
+		return u->RxTail != u->RxHead ? SET : RESET;
+	}
+	return SET; // 发送立即完成
+}
+
+ITStatus USART_GetITStatus(USART_TypeDef *USARTx, uint16_t USART_IT)
+{
+	Stub_Usart_t *u = Stub_UsartOf(USARTx);
+	if (!(u->ITMask & Stub_UsartITBit(USART_IT)))
+	{
+		return RESET;
+	}
+	if (USART_IT == USART_IT_RXNE)
+	{
+		return u->RxTail != u->RxHead ? SET : RESET;
+	}
+	return SET;
+}
+
+void USART_ClearITPendingBit(USART_TypeDef *USARTx, uint16_t USART_IT) { (void)USARTx; (void)USART_IT; }
+
+/*I2C*********************/
+
+void I2C_DeInit(I2C_TypeDef *I2Cx) { memset((void *)I2Cx, 0, sizeof(*I2Cx)); }
+void I2C_Init(I2C_TypeDef *I2Cx, I2C_InitTypeDef *I2C_InitStruct) { (void)I2Cx; (void)I2C_InitStruct; }
+void I2C_Cmd(I2C_TypeDef *I2Cx, FunctionalState NewState)
+{
+	if (NewState != DISABLE)
+	{
+		I2Cx->CR1 |= I2C_CR1_PE;
+	}
+	else
+	{
+		I2Cx->CR1 &= ~I2C_CR1_PE;
+	}
+}
+
+void I2C_DMACmd(I2C_TypeDef *I2Cx, FunctionalState NewState)
+{
+	if (NewState != DISABLE)
+	{
+		I2Cx->CR2 |= I2C_CR2_DMAEN;
+	}
+	else
+	{
+		I2Cx->CR2 &= ~I2C_CR2_DMAEN;
+	}
+}
+
+void I2C_ITConfig(I2C_TypeDef *I2Cx, uint16_t I2C_IT, FunctionalState NewState)
+{
+	if (NewState != DISABLE)
+	{
+		I2Cx->CR2 |= I2C_IT;
+	}
+	else
+	{
+		I2Cx->CR2 &= ~I2C_IT;
+	}
+}
+
+void I2C_GenerateSTART(I2C_TypeDef *I2Cx, FunctionalState NewState)
+{
+	if (NewState != DISABLE)
+	{
+		I2Cx->CR1 |= I2C_CR1_START;
+	}
+	else
+	{
+		I2Cx->CR1 &= ~I2C_CR1_START;
+	}
+}
+
+void I2C_GenerateSTOP(I2C_TypeDef *I2Cx, FunctionalState NewState)
+{
+	if (NewState != DISABLE)
+	{
+		I2Cx->CR1 |= I2C_CR1_STOP;
+	}
+	else
+	{
+		I2Cx->CR1 &= ~I2C_CR1_STOP;
+	}
+}
+
+void I2C_Send7bitAddress(I2C_TypeDef *I2Cx, uint8_t Address, uint8_t I2C_Direction)
+{
+	I2Cx->DR = Address | I2C_Direction;
+}
+
+void I2C_SoftwareResetCmd(I2C_TypeDef *I2Cx, FunctionalState NewState)
+{
+	if (NewState != DISABLE)
+	{
+		memset((void *)I2Cx, 0, sizeof(*I2Cx));
+	}
+}
+
+/*SPI*********************/
+
+void SPI_Init(SPI_TypeDef *SPIx, SPI_InitTypeDef *SPI_InitStruct) { (void)SPIx; (void)SPI_InitStruct; }
+void SPI_Cmd(SPI_TypeDef *SPIx, FunctionalState NewState) { (void)SPIx; (void)NewState; }
+void SPI_I2S_SendData(SPI_TypeDef *SPIx, uint16_t Data) { SPIx->DR = 0xFF; (void)Data; }
+uint16_t SPI_I2S_ReceiveData(SPI_TypeDef *SPIx) { return SPIx->DR; }
+FlagStatus SPI_I2S_GetFlagStatus(SPI_TypeDef *SPIx, uint16_t SPI_I2S_FLAG) { (void)SPIx; (void)SPI_I2S_FLAG; return SET; }
+
+/*ADC*********************/
+
+void ADC_Init(ADC_TypeDef *ADCx, ADC_InitTypeDef *ADC_InitStruct) { (void)ADCx; (void)ADC_InitStruct; }
+void ADC_Cmd(ADC_TypeDef *ADCx, FunctionalState NewState) { (void)ADCx; (void)NewState; }
+void ADC_DMACmd(ADC_TypeDef *ADCx, FunctionalState NewState) { (void)ADCx; (void)NewState; }
+void ADC_RegularChannelConfig(ADC_TypeDef *ADCx, uint8_t ADC_Channel, uint8_t Rank, uint8_t ADC_SampleTime)
+{
+	(void)ADCx; (void)ADC_Channel; (void)Rank; (void)ADC_SampleTime;
+}
+void ADC_ResetCalibration(ADC_TypeDef *ADCx) { (void)ADCx; }
+FlagStatus ADC_GetResetCalibrationStatus(ADC_TypeDef *ADCx) { (void)ADCx; return RESET; }
+void ADC_StartCalibration(ADC_TypeDef *ADCx) { (void)ADCx; }
+FlagStatus ADC_GetCalibrationStatus(ADC_TypeDef *ADCx) { (void)ADCx; return RESET; }
+void ADC_SoftwareStartConvCmd(ADC_TypeDef *ADCx, FunctionalState NewState) { (void)ADCx; (void)NewState; }
+uint16_t ADC_GetConversionValue(ADC_TypeDef *ADCx) { return (uint16_t)ADCx->DR; }
@@ -0,0 +1,46 @@
+#ifndef __STUB_H
+#define __STUB_H
+
+/*
+ * 文件名：stub.h
+ * 描    述：主机测试桩的控制接口，测试程序用来推进时间、注入串口数据、读取串口输出
+ *          固件源码不包含此文件
+ */
+
+#include "stm32f10x.h"
+#include <stdint.h>
+
+/*时间（Delay_stub.c）*********************/
+
+void Stub_Delay_Reset(void);
+void Stub_Delay_AdvanceUs(uint32_t us);
+void Stub_Delay_AdvanceMs(uint32_t ms);
+void Stub_Delay_SetTickHook(void (*hook)(uint32_t ms));
+void Stub_Delay_SetPollHook(void (*hook)(void));
+void Stub_Delay_Capture(uint32_t time_us);
+
+/*外设（stm32f10x_stub.c）*********************/
+
+#define STUB_USART_TX_MAX 65536
+#define STUB_USART_RX_MAX 4096
+
+typedef struct
+{
+	uint8_t Tx[STUB_USART_TX_MAX]; // USART_SendData写出的字节
+	uint32_t TxCount;
+	uint8_t Rx[STUB_USART_RX_MAX]; // 等待USART_ReceiveData读取的字节
+	uint32_t RxHead;
+	uint32_t RxTail;
+	uint16_t ITMask;			   // 已使能的中断：bit0 RXNE，bit1 TXE，bit2 TC
+} Stub_Usart_t;
+
+extern Stub_Usart_t Stub_Usart1;
+extern Stub_Usart_t Stub_Usart2;
+
+/*GPIO_SetBits/ResetBits之后调用，用于模拟外部器件对输出的响应*/
+extern void (*Stub_GPIO_WriteHook)(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint8_t Level);
+
+void Stub_Reset(void);
+void Stub_Usart_Feed(USART_TypeDef *USARTx, const uint8_t *data, uint32_t len);
+
+#endif
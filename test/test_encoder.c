@@ -0,0 +1,158 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "Key_multi.h"
+#include <stdio.h>
+
+/*
+ * 文件名：test_encoder.c
+ * 描    述：旋转编码器测试
+ *          按不同转速改变TIM3计数值，每1ms节拍调用一次Key_Scan，主循环用Key_Get_Press_Event逐步取出：
+ *          慢速每格一步，快速时按加速曲线每格多步，换向后的第一格不加速，来回微调时每格一步，
+ *          不足一格不产生事件，补足后产生一步
+ */
+
+#define DETENTS 20
+
+static uint32_t failures;
+static uint32_t up_steps, down_steps;
+
+/*1ms节拍：采样按键和编码器，主循环取出全部步数*/
+static void Tick(uint32_t ms)
+{
+    Key_action key;
+
+    (void)ms;
+    Key_Scan();
+    while ((key = Key_Get_Press_Event()) != key_none)
+    {
+        if (key == key_up)
+        {
+            up_steps++;
+        }
+        else if (key == key_down)
+        {
+            down_steps++;
+        }
+    }
+}
+
+/*转动Count格，每格Interval毫秒，Dir为1顺时针、-1逆时针；每格4个计数均匀分布*/
+static void Turn(uint32_t Count, uint32_t Interval, int8_t Dir)
+{
+    uint32_t d, c;
+
+    up_steps = 0;
+    down_steps = 0;
+    for (d = 0; d < Count; d++)
+    {
+        for (c = 0; c < KEY_ENCODER_COUNTS; c++)
+        {
+            Stub_Delay_AdvanceMs(Interval / KEY_ENCODER_COUNTS + (c < Interval % KEY_ENCODER_COUNTS));
+            TIM3->CNT = (uint16_t)(TIM3->CNT + Dir);
+        }
+    }
+    Stub_Delay_AdvanceMs(20); // 等待最后一格被读取
+}
+
+static void Test_Speeds(void)
+{
+    /*第一格前停顿了1秒，不加速；其余各格按加速曲线*/
+    static const struct
+    {
+        uint32_t interval;
+        uint32_t steps;
+    } cases[] = {
+        {200, DETENTS},
+        {80, DETENTS},
+        {40, 1 + (DETENTS - 1) * 2},
+        {20, 1 + (DETENTS - 1) * 4},
+        {10, 1 + (DETENTS - 1) * 8},
+    };
+    uint32_t i;
+
+    for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        Turn(DETENTS, cases[i].interval, 1);
+        printf("%u detents, %3u ms per detent: %3u steps down, %u up\n", DETENTS, cases[i].interval, down_steps, up_steps);
+        if (down_steps != cases[i].steps || up_steps != 0)
+        {
+            printf("FAIL expected %u steps down\n", cases[i].steps);
+            failures++;
+        }
+        Stub_Delay_AdvanceMs(1000);
+    }
+
+    Turn(DETENTS, 10, -1);
+    printf("%u detents counterclockwise, 10 ms per detent: %u steps up\n", DETENTS, up_steps);
+    if (up_steps != 1 + (DETENTS - 1) * 8 || down_steps != 0)
+    {
+        printf("FAIL counterclockwise steps\n");
+        failures++;
+    }
+    if (Key_GetOverflow() != 0)
+    {
+        printf("FAIL %u events dropped\n", Key_GetOverflow());
+        failures++;
+    }
+}
+
+/*来回微调：每次换向后的第一格不加速*/
+static void Test_Alternate(void)
+{
+    uint32_t up = 0, down = 0, i;
+
+    for (i = 0; i < 10; i++)
+    {
+        Turn(1, 10, 1);
+        down += down_steps;
+        up += up_steps;
+        Turn(1, 10, -1);
+        down += down_steps;
+        up += up_steps;
+    }
+    printf("10 x (1 detent clockwise, 1 counterclockwise): %u down, %u up\n", down, up);
+    if (down != 10 || up != 10)
+    {
+        printf("FAIL alternating detents accelerated\n");
+        failures++;
+    }
+}
+
+static void Test_HalfDetent(void)
+{
+    up_steps = 0;
+    down_steps = 0;
+    TIM3->CNT = (uint16_t)(TIM3->CNT + KEY_ENCODER_COUNTS / 2);
+    Stub_Delay_AdvanceMs(50);
+    if (up_steps || down_steps)
+    {
+        printf("FAIL half a detent produced %u steps\n", up_steps + down_steps);
+        failures++;
+    }
+
+    /*补足另外半格*/
+    TIM3->CNT = (uint16_t)(TIM3->CNT + KEY_ENCODER_COUNTS / 2);
+    Stub_Delay_AdvanceMs(50);
+    if (down_steps != 1 || up_steps)
+    {
+        printf("FAIL completed detent produced %u down, %u up\n", down_steps, up_steps);
+        failures++;
+    }
+}
+
+int main(void)
+{
+    Stub_Reset();
+    GPIOA->IDR = 0xFFFF; // 按键松开，上拉为高电平
+    GPIOB->IDR = 0xFFFF;
+    Key_Init();
+    Stub_Delay_SetTickHook(Tick);
+    Stub_Delay_AdvanceMs(1000);
+
+    Test_Speeds();
+    Test_Alternate();
+    Test_HalfDetent();
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
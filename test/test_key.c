@@ -0,0 +1,212 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "Key_multi.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * 文件名：test_key.c
+ * 描    述：按键消抖和事件队列测试
+ *          通过GPIO输入寄存器产生按键波形，每1ms节拍调用一次Key_Scan（相当于TIM4中断），主循环按不同周期取事件：
+ *          带随机抖动的按键每次只产生一个按下和一个释放事件，延迟不超过抖动时间+消抖时间+取事件周期；
+ *          短于消抖时间的毛刺不产生事件；按住产生一次长按和按固定间隔的连发；
+ *          按住一个键再按另一个键时产生组合键事件；队列满时保留最早的事件并统计丢弃的个数
+ */
+
+#define BOUNCE_PRESSES 200
+#define BOUNCE_MAX_MS 8
+
+static uint32_t seed = 4;
+static uint32_t failures;
+static uint32_t poll_ms = 10;
+static uint32_t counts[5][5]; // [事件类型][按键]
+static uint8_t chord_keys;
+
+/*固定种子的线性同余随机数，各平台结果相同*/
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+}
+
+/*按键引脚：按下为低电平*/
+static void Key_Level(Key_action key, uint8_t pressed)
+{
+    GPIO_TypeDef *port = key == key_enter ? GPIOA : GPIOB;
+    uint16_t pin = key == key_up ? GPIO_Pin_0 : key == key_down ? GPIO_Pin_1 : key == key_back ? GPIO_Pin_10 : GPIO_Pin_2;
+
+    if (pressed)
+    {
+        port->IDR &= ~pin;
+    }
+    else
+    {
+        port->IDR |= pin;
+    }
+}
+
+/*主循环取出全部事件*/
+static void Drain(void)
+{
+    Key_Event_t event;
+
+    while (Key_Get_Event(&event))
+    {
+        counts[event.type][event.key]++;
+        if (event.type == KEY_EVENT_CHORD)
+        {
+            chord_keys = event.keys;
+        }
+    }
+}
+
+/*1ms节拍：采样按键，每poll_ms取一次事件*/
+static void Tick(uint32_t ms)
+{
+    Key_Scan();
+    if (ms % poll_ms == 0)
+    {
+        Drain();
+    }
+}
+
+static void Reset(void)
+{
+    memset(counts, 0, sizeof(counts));
+    chord_keys = 0;
+    Key_Clear_Events();
+    Key_ResetStats();
+}
+
+static void Check(uint8_t ok, const char *what)
+{
+    if (!ok)
+    {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+/*电平在Bounce毫秒内随机跳变，最后稳定在Pressed*/
+static void Bounce(Key_action key, uint8_t Pressed, uint32_t Bounce)
+{
+    while (Bounce--)
+    {
+        Key_Level(key, Random() & 1);
+        Stub_Delay_AdvanceMs(1);
+    }
+    Key_Level(key, Pressed);
+}
+
+static void Test_Bounce(void)
+{
+    static const uint32_t polls[] = {1, 10, 50};
+    uint32_t p, r, max;
+
+    for (p = 0; p < sizeof(polls) / sizeof(polls[0]); p++)
+    {
+        poll_ms = polls[p];
+        Reset();
+        for (r = 0; r < BOUNCE_PRESSES; r++)
+        {
+            uint32_t bounce = Random() % BOUNCE_MAX_MS;
+            Bounce(key_up, 1, bounce);
+            Stub_Delay_AdvanceMs(100);
+            Bounce(key_up, 0, bounce);
+            Stub_Delay_AdvanceMs(100);
+        }
+        Stub_Delay_AdvanceMs(100);
+        Key_GetLatency(NULL, &max);
+        printf("poll %2ums: %u bouncing presses -> %u press, %u release, latency at most %u ms\n",
+               poll_ms, BOUNCE_PRESSES, counts[KEY_EVENT_PRESS][key_up], counts[KEY_EVENT_RELEASE][key_up], max);
+        Check(counts[KEY_EVENT_PRESS][key_up] == BOUNCE_PRESSES && counts[KEY_EVENT_RELEASE][key_up] == BOUNCE_PRESSES,
+              "one press and one release per bouncing press");
+        Check(max <= BOUNCE_MAX_MS + KEY_DEBOUNCE_TIME_MS + poll_ms, "latency within bounce + debounce + poll period");
+    }
+    poll_ms = 10;
+}
+
+static void Test_Glitch(void)
+{
+    uint32_t i;
+
+    Reset();
+    for (i = 0; i < 500; i++)
+    {
+        Key_Level(key_down, i % 5 == 0); // 每5ms一个1ms的毛刺
+        Stub_Delay_AdvanceMs(1);
+    }
+    Key_Level(key_down, 0);
+    Stub_Delay_AdvanceMs(50);
+    Check(counts[KEY_EVENT_PRESS][key_down] == 0 && counts[KEY_EVENT_RELEASE][key_down] == 0, "glitches produce no events");
+}
+
+static void Test_Hold(void)
+{
+    Reset();
+    Key_Level(key_up, 1);
+    Stub_Delay_AdvanceMs(1600);
+    Key_Level(key_up, 0);
+    Stub_Delay_AdvanceMs(50);
+    printf("hold 1600ms: %u press, %u long, %u repeat, %u release\n", counts[KEY_EVENT_PRESS][key_up],
+           counts[KEY_EVENT_LONG][key_up], counts[KEY_EVENT_REPEAT][key_up], counts[KEY_EVENT_RELEASE][key_up]);
+    /*确认按下后500ms长按，之后每500ms连发*/
+    Check(counts[KEY_EVENT_PRESS][key_up] == 1 && counts[KEY_EVENT_LONG][key_up] == 1 &&
+          counts[KEY_EVENT_REPEAT][key_up] == (1600 - KEY_DEBOUNCE_TIME_MS - KEY_LONG_PRESS_TIME_MS) / KEY_SCROLL_SPEED_MS &&
+          counts[KEY_EVENT_RELEASE][key_up] == 1,
+          "long press and repeat timing");
+}
+
+static void Test_Chord(void)
+{
+    Reset();
+    Key_Level(key_up, 1);
+    Stub_Delay_AdvanceMs(50);
+    Key_Level(key_down, 1);
+    Stub_Delay_AdvanceMs(50);
+    Key_Level(key_up, 0);
+    Key_Level(key_down, 0);
+    Stub_Delay_AdvanceMs(50);
+    Check(counts[KEY_EVENT_PRESS][key_up] == 1 && counts[KEY_EVENT_CHORD][key_down] == 1 &&
+          counts[KEY_EVENT_PRESS][key_down] == 0, "second key of a chord reported as chord");
+    Check(chord_keys == (KEY_MASK(key_up) | KEY_MASK(key_down)), "chord event carries both keys");
+}
+
+static void Test_Overflow(void)
+{
+    uint32_t i;
+
+    Reset();
+    poll_ms = 1000000; // 主循环不取事件
+    for (i = 0; i < 20; i++)
+    {
+        Key_Level(key_enter, 1);
+        Stub_Delay_AdvanceMs(30);
+        Key_Level(key_enter, 0);
+        Stub_Delay_AdvanceMs(30);
+    }
+    printf("20 presses not read: %u events dropped\n", Key_GetOverflow());
+    Check(Key_GetOverflow() == 2 * 20 - KEY_FIFO_SIZE, "dropped events counted when the queue is full");
+    Drain();
+    Check(counts[KEY_EVENT_PRESS][key_enter] + counts[KEY_EVENT_RELEASE][key_enter] == KEY_FIFO_SIZE &&
+          counts[KEY_EVENT_PRESS][key_enter] == KEY_FIFO_SIZE / 2, "queue keeps the oldest events");
+    poll_ms = 10;
+}
+
+int main(void)
+{
+    Stub_Reset();
+    GPIOA->IDR = 0xFFFF; // 按键松开，上拉为高电平
+    GPIOB->IDR = 0xFFFF;
+    Key_Init();
+    Stub_Delay_SetTickHook(Tick);
+
+    Test_Bounce();
+    Test_Glitch();
+    Test_Hold();
+    Test_Chord();
+    Test_Overflow();
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
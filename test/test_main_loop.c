@@ -0,0 +1,262 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "Key_multi.h"
+#include "Menu.h"
+#include "Menu_creat.h"
+#include "Screen.h"
+#include "Timestamp.h"
+#include "ESP8266.h"
+#include "CYZ_Package.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * 文件名：test_main_loop.c
+ * 描    述：主循环测试
+ *          运行main.c的主循环，按键通过GPIO输入并由TIM4中断扫描：进入设置菜单，打开Auto_Mode，
+ *          再打开阈值设置界面并在其中操作，约150秒后返回菜单，共运行200秒
+ *          阈值设置界面不阻塞主循环，打开期间时钟必须每秒走时，自动上传必须在60秒和120秒照常进行，
+ *          关闭后180秒的自动上传同样进行
+ *          CYZ_Package.c、ESP8266.c、Timestamp.c由本文件代替：每次CYZ_Receiver_Process推进1ms，
+ *          走时、时间同步和上传只记录调用时刻
+ */
+
+#define END_MS 200000
+#define PRESS_MS 50       // 按住时间，超过消抖时间
+#define MAX_LATE_MS 2     // 走时允许的延迟
+#define MAX_TICKS 256
+#define MAX_UPLOADS 8
+
+int Firmware_Main(void);
+void TIM4_IRQHandler(void);
+
+/*按键脚本：在指定时刻按下按键*/
+typedef struct
+{
+    uint32_t ms;
+    Key_action key;
+} Press_t;
+
+static const Press_t script[] =
+{
+    {500, key_enter},                                                  // 进入主菜单
+    {700, key_down}, {900, key_down}, {1100, key_enter},               // 3.Settings
+    {1300, key_down}, {1500, key_down}, {1700, key_down},
+    {1900, key_down}, {2100, key_down}, {2300, key_enter},             // Auto_Mode打开
+    {2500, key_up}, {2700, key_up}, {2900, key_enter},                 // Threshold
+    {5000, key_down}, {6000, key_enter}, {7000, key_up}, {8000, key_enter}, // MidLoss加1并保存
+    {65000, key_down}, {90000, key_up},
+    {150000, key_back},                                                // 返回菜单
+};
+
+static uint32_t now_ms;
+static uint32_t script_index;
+static uint32_t release_ms;
+static uint32_t ticks[MAX_TICKS], tick_count;
+static uint32_t uploads[MAX_UPLOADS], upload_count;
+static uint32_t sync_count;
+static uint32_t opened_ms, closed_ms;
+static uint32_t middle_loss_max;
+
+/*Timestamp.c的替代*****************************************/
+
+TimeInfo_t g_current_time = {12, 0, 0};
+
+bool Parse_Timestamp(const char *str, uint32_t *timestamp)
+{
+    (void)str;
+    (void)timestamp;
+    return false;
+}
+
+void TimestampToTime(uint32_t timestamp, TimeInfo_t *time_info, int8_t timezone)
+{
+    (void)timestamp;
+    (void)time_info;
+    (void)timezone;
+}
+
+void Time_Update(void)
+{
+    if (tick_count < MAX_TICKS)
+    {
+        ticks[tick_count] = now_ms;
+    }
+    tick_count++;
+    g_current_time.second = (g_current_time.second + 1) % 60;
+}
+
+bool Time_SyncFromNetwork(void)
+{
+    sync_count++;
+    return false;
+}
+
+/*ESP8266.c的替代*****************************************/
+
+void ESP8266_UploadDataPoints(StatisticsData_t *statistics_struct)
+{
+    (void)statistics_struct;
+    if (upload_count < MAX_UPLOADS)
+    {
+        uploads[upload_count] = now_ms;
+    }
+    upload_count++;
+}
+
+void ESP8266_SendDHT11Data(void)
+{
+}
+
+/*CYZ_Package.c的替代*****************************************/
+
+void CYZ_Receiver_Init(uint32_t baudrate)
+{
+    (void)baudrate;
+}
+
+void CYZ_Receiver_SetCallback(CYZ_Callback_t callback)
+{
+    (void)callback;
+}
+
+void cyz_data_handler(const char *data)
+{
+    (void)data;
+}
+
+/*按键引脚：按下为低电平*/
+static void Key_Level(Key_action key, uint8_t pressed)
+{
+    GPIO_TypeDef *port = key == key_enter ? GPIOA : GPIOB;
+    uint16_t pin = key == key_up ? GPIO_Pin_0 : key == key_down ? GPIO_Pin_1 : key == key_back ? GPIO_Pin_10 : GPIO_Pin_2;
+
+    if (pressed)
+    {
+        port->IDR &= ~pin;
+    }
+    else
+    {
+        port->IDR |= pin;
+    }
+}
+
+/*1ms节拍：TIM4中断扫描按键*/
+static void Tick(uint32_t ms)
+{
+    now_ms = ms;
+    TIM4->SR |= TIM_IT_Update;
+    TIM4_IRQHandler();
+}
+
+static uint32_t Report(void)
+{
+    uint32_t failures = 0, in_screen = 0, late = 0, i;
+
+    printf("Threshold open from %u ms to %u ms\n", opened_ms, closed_ms);
+    if (!opened_ms || !closed_ms)
+    {
+        printf("FAIL Threshold was not opened and closed by the key script\n");
+        return 1;
+    }
+
+    for (i = 0; i < tick_count && i < MAX_TICKS; i++)
+    {
+        uint32_t lateness = ticks[i] - (i + 1) * 1000;
+        if (ticks[i] < (i + 1) * 1000 || lateness > MAX_LATE_MS)
+        {
+            if (late < 5)
+            {
+                printf("FAIL clock tick %u at %u ms\n", i + 1, ticks[i]);
+            }
+            late++;
+        }
+        in_screen += ticks[i] > opened_ms && ticks[i] < closed_ms;
+    }
+    printf("clock ticks: %u, %u while Threshold open\n", tick_count, in_screen);
+    if (tick_count != END_MS / 1000 - 1 && tick_count != END_MS / 1000)
+    {
+        printf("FAIL expected one clock tick per second\n");
+        failures++;
+    }
+    if (in_screen + 2 < (closed_ms - opened_ms) / 1000)
+    {
+        printf("FAIL clock stopped while Threshold was open\n");
+        failures++;
+    }
+    failures += late;
+
+    for (i = 0; i < upload_count && i < MAX_UPLOADS; i++)
+    {
+        printf("auto-upload at %u ms%s\n", uploads[i], uploads[i] > opened_ms && uploads[i] < closed_ms ? " (Threshold open)" : "");
+        if (uploads[i] < (i + 1) * 60000 || uploads[i] > (i + 1) * 60000 + MAX_LATE_MS)
+        {
+            printf("FAIL auto-upload %u late\n", i + 1);
+            failures++;
+        }
+    }
+    if (upload_count != 3)
+    {
+        printf("FAIL %u auto-uploads, expected 3\n", upload_count);
+        failures++;
+    }
+    printf("time syncs: %u\n", sync_count);
+    if (sync_count != END_MS / 30000)
+    {
+        printf("FAIL expected a time sync every 30 s\n");
+        failures++;
+    }
+    if (!Menu_GetAutoUploadStatus() || g_middle_loss_max != middle_loss_max + 1)
+    {
+        printf("FAIL key script did not reach Auto_Mode and Threshold\n");
+        failures++;
+    }
+    return failures;
+}
+
+/*主循环每次调用：推进1ms，按脚本按下和松开按键，记录界面打开和关闭的时刻*/
+bool CYZ_Receiver_Process(void)
+{
+    uint32_t failures;
+
+    Stub_Delay_AdvanceMs(1);
+
+    if (release_ms && now_ms >= release_ms)
+    {
+        Key_Level(script[script_index - 1].key, 0);
+        release_ms = 0;
+    }
+    if (script_index < sizeof(script) / sizeof(script[0]) && now_ms >= script[script_index].ms)
+    {
+        Key_Level(script[script_index].key, 1);
+        release_ms = now_ms + PRESS_MS;
+        script_index++;
+    }
+
+    if (Screen_Top() != NULL && !opened_ms)
+    {
+        opened_ms = now_ms;
+    }
+    else if (Screen_Top() == NULL && opened_ms && !closed_ms)
+    {
+        closed_ms = now_ms;
+    }
+
+    if (now_ms >= END_MS)
+    {
+        failures = Report();
+        printf("%s\n", failures ? "FAILED" : "PASSED");
+        exit(failures ? 1 : 0);
+    }
+    return false;
+}
+
+int main(void)
+{
+    Stub_Reset();
+    GPIOA->IDR = 0xFFFF; // 按键松开，上拉为高电平
+    GPIOB->IDR = 0xFFFF;
+    Stub_Delay_SetTickHook(Tick);
+    middle_loss_max = g_middle_loss_max;
+    return Firmware_Main();
+}
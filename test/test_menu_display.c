@@ -0,0 +1,245 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "Menu.h"
+#include "Menu_creat.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * 文件名：test_menu_display.c
+ * 描    述：菜单局部重绘测试
+ *          在实际的菜单树上移动光标、上下滚动、切换开关和走时，每个事件后Menu_Display只重绘变化的部分，
+ *          结果必须与整屏重绘相同，录制接口还原的屏幕必须与显存数组相同；走时只能改动状态栏中的时间区域
+ *          最后输出每种事件发送的字节数和局部重绘、整屏重绘的耗时，供参考
+ */
+
+extern uint8_t OLED_DisplayBuf[8][128];
+
+/*菜单按键处理函数在Menu.c中定义，Menu.h未声明*/
+void Menu_MoveUp(void);
+void Menu_MoveDown(void);
+void Menu_Enter(void);
+void Menu_Back(void);
+
+#define ROUNDS 200
+#define TOGGLES 2000
+#define TICKS 2000
+#define TIME_WIDTH (8 * 8) // HH:MM:SS，8x16字体
+
+typedef struct
+{
+    const char *name;
+    uint32_t count;
+    uint32_t bytes;
+    double partial;
+    double full;
+} Stat_t;
+
+static Stat_t cursor = {.name = "cursor"};
+static Stat_t scroll_down = {.name = "scroll down"};
+static Stat_t scroll_up = {.name = "scroll up"};
+static Stat_t toggle = {.name = "toggle"};
+static Stat_t tick = {.name = "clock tick"};
+
+static uint32_t failures;
+
+/*整屏重绘，结果必须与局部重绘相同，屏幕必须与显存数组相同*/
+static void Check(Stat_t *Stat)
+{
+    static uint8_t partial[8][128];
+    clock_t start;
+    int16_t X, Y;
+
+    memcpy(partial, OLED_DisplayBuf, sizeof(partial));
+    start = clock();
+    Menu_Refresh();
+    Stat->full += (double)(clock() - start) / CLOCKS_PER_SEC;
+    if (memcmp(partial, OLED_DisplayBuf, sizeof(partial)) != 0)
+    {
+        if (failures < 10)
+        {
+            printf("FAIL %s on \"%s\": partial redraw differs from full redraw\n", Stat->name, MenuCtrl.current_item->name);
+        }
+        failures++;
+    }
+    for (Y = 0; Y < 64; Y++)
+    {
+        for (X = 0; X < 128; X++)
+        {
+            if (OLED_Recorder_GetPoint(X, Y) != OLED_GetPoint(X, Y))
+            {
+                printf("FAIL %s: screen differs from the frame buffer at %d,%d\n", Stat->name, X, Y);
+                failures++;
+                return;
+            }
+        }
+    }
+}
+
+/*局部重绘一次，统计发送的字节数和耗时*/
+static void Display(Stat_t *Stat)
+{
+    uint32_t Before = OLED_GetSentBytes();
+    clock_t start = clock();
+
+    Menu_Display();
+    Stat->partial += (double)(clock() - start) / CLOCKS_PER_SEC;
+    Stat->bytes += OLED_GetSentBytes() - Before;
+    Stat->count++;
+    Check(Stat);
+}
+
+/*移动一项，按滚动偏移是否改变分类统计*/
+static void Move(uint8_t Down)
+{
+    uint8_t Offset = MenuCtrl.scroll_offset;
+
+    if (Down)
+    {
+        Menu_MoveDown();
+    }
+    else
+    {
+        Menu_MoveUp();
+    }
+    if (MenuCtrl.scroll_offset == Offset)
+    {
+        Display(&cursor);
+    }
+    else
+    {
+        Display(MenuCtrl.scroll_offset > Offset ? &scroll_down : &scroll_up);
+    }
+}
+
+/*主菜单8项：逐项移到底再回到顶部*/
+static void Test_Navigate(void)
+{
+    uint32_t r;
+    uint8_t i;
+
+    for (r = 0; r < ROUNDS; r++)
+    {
+        for (i = 0; i < 7; i++)
+        {
+            Move(1);
+        }
+        for (i = 0; i < 7; i++)
+        {
+            Move(0);
+        }
+    }
+    if (MenuCtrl.current_item != MenuCtrl.current_menu->child || MenuCtrl.scroll_offset != 0)
+    {
+        printf("FAIL not back at the first item\n");
+        failures++;
+    }
+}
+
+/*进入设置菜单，在LED开关上反复切换*/
+static void Test_Toggle(void)
+{
+    uint32_t n;
+    uint8_t i;
+
+    Menu_MoveDown();
+    Menu_MoveDown();
+    Menu_Enter();
+    for (i = 0; i < 6; i++)
+    {
+        Menu_MoveDown();
+    }
+    Menu_Display();
+    if (MenuCtrl.current_item->type != MENU_TYPE_TOGGLE)
+    {
+        printf("FAIL \"%s\" is not a toggle\n", MenuCtrl.current_item->name);
+        failures++;
+        return;
+    }
+
+    for (n = 0; n < TOGGLES; n++)
+    {
+        Menu_Enter();
+        Display(&toggle);
+    }
+}
+
+/*走时：只能改动状态栏中的时间区域*/
+static void Test_Tick(void)
+{
+    static uint8_t before[8][128];
+    uint32_t n;
+    uint8_t Page, X;
+
+    for (n = 0; n < TICKS; n++)
+    {
+        memcpy(before, OLED_DisplayBuf, sizeof(before));
+        g_current_time.second = (g_current_time.second + 1) % 60;
+        if (g_current_time.second == 0)
+        {
+            g_current_time.minute = (g_current_time.minute + 1) % 60;
+        }
+        Menu_UpdateTime();
+        Display(&tick);
+
+        for (Page = 0; Page < 8; Page++)
+        {
+            for (X = 0; X < 128; X++)
+            {
+                uint8_t InTime = Page < 2 && X >= MenuCtrl.time_x && X < MenuCtrl.time_x + TIME_WIDTH;
+                if (!InTime && before[Page][X] != OLED_DisplayBuf[Page][X])
+                {
+                    printf("FAIL clock tick changed page %u column %u\n", Page, X);
+                    failures++;
+                    return;
+                }
+            }
+        }
+    }
+    /*最多两页时间区域的数据（每页一次传输）加上设置页列地址的命令*/
+    if (tick.bytes / tick.count > 2 * (2 + TIME_WIDTH + 3 * 3))
+    {
+        printf("FAIL clock tick sends %u bytes\n", tick.bytes / tick.count);
+        failures++;
+    }
+}
+
+static void Report(const Stat_t *Stat)
+{
+    printf("%-12s %6u events %6.1f B/event  partial %6.2fus  full %6.2fus\n", Stat->name, Stat->count,
+           (double)Stat->bytes / Stat->count, Stat->partial / Stat->count * 1e6, Stat->full / Stat->count * 1e6);
+}
+
+int main(void)
+{
+    Stub_Reset();
+    OLED_Init();
+    Menu_Setup();
+    Menu_Enter();
+    Menu_Display();
+
+    Test_Navigate();
+    Test_Toggle();
+    Test_Tick();
+
+    Report(&cursor);
+    Report(&scroll_down);
+    Report(&scroll_up);
+    Report(&toggle);
+    Report(&tick);
+    if (!cursor.count || !scroll_down.count || !scroll_up.count)
+    {
+        printf("FAIL navigation did not both move the cursor and scroll\n");
+        failures++;
+    }
+    /*硬件移屏后只重绘状态栏和新露出的一行，发送量必须少于整屏*/
+    else if (scroll_down.bytes / scroll_down.count >= 8 * 128 || scroll_up.bytes / scroll_up.count >= 8 * 128)
+    {
+        printf("FAIL scrolling resends the whole screen\n");
+        failures++;
+    }
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
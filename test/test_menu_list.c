@@ -0,0 +1,260 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "Menu.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * 文件名：test_menu_list.c
+ * 描    述：虚拟列表菜单测试
+ *          在10000行的列表中逐行移动到底再回到顶部，每次显示只能向提供者请求可见的几行，
+ *          选中行和滚动偏移在两端被限制，局部重绘的结果必须与整屏重绘相同，录制接口还原的屏幕必须与显存数组相同；
+ *          行数减少后选中行被限制在范围内，确认键把选中行交给提供者并关闭列表
+ *          最后比较10行和10000行列表每次按键的耗时，供参考
+ */
+
+extern uint8_t OLED_DisplayBuf[8][128];
+
+/*菜单按键处理函数在Menu.c中定义，Menu.h未声明*/
+void Menu_MoveUp(void);
+void Menu_MoveDown(void);
+void Menu_Enter(void);
+void Menu_Back(void);
+
+#define LIST_ROWS 10000
+#define BENCH_KEYS 20000
+
+static uint16_t row_count = LIST_ROWS;
+static uint32_t get_row_calls;
+static uint16_t row_min, row_max;
+static int32_t selected = -1;
+static uint32_t failures;
+
+static uint16_t List_Count(void)
+{
+    return row_count;
+}
+
+static void List_GetRow(uint16_t index, char *buf, uint8_t size)
+{
+    get_row_calls++;
+    if (index < row_min)
+    {
+        row_min = index;
+    }
+    if (index > row_max)
+    {
+        row_max = index;
+    }
+    snprintf(buf, size, "Row %u", index);
+}
+
+static uint8_t List_Select(uint16_t index)
+{
+    selected = index;
+    return 1;
+}
+
+static const MenuListProvider_t test_list = {List_Count, List_GetRow, List_Select, NULL};
+
+/*根菜单下一个虚拟列表和一个普通菜单项，与menu_gen.py生成的菜单树结构相同*/
+static const MenuItem_t tree[] =
+{
+    {"Root", MENU_TYPE_NORMAL, NULL, &tree[1], 2, 0, NULL, NULL, 0, 0, NULL, NULL},
+    {"Records", MENU_TYPE_LIST, &tree[0], NULL, 0, 0, NULL, NULL, 0, 0, NULL, &test_list},
+    {"About", MENU_TYPE_FUNC, &tree[0], NULL, 0, 1, NULL, NULL, 0, 0, NULL, NULL},
+};
+
+static void Fail(const char *what, uint16_t index)
+{
+    if (failures < 10)
+    {
+        printf("FAIL %s at row %u\n", what, index);
+    }
+    failures++;
+}
+
+/*局部重绘后检查：只请求了可见行，屏幕与显存数组相同，且与整屏重绘结果相同*/
+static void Display_Check(const char *what)
+{
+    static uint8_t partial[8][128];
+    uint16_t index = MenuCtrl.list_index;
+    int16_t X, Y;
+
+    get_row_calls = 0;
+    row_min = 0xFFFF;
+    row_max = 0;
+    Menu_Display();
+    if (get_row_calls > MENU_MAX_ITEM_LINES)
+    {
+        Fail("more rows requested than visible", index);
+    }
+    if (get_row_calls && (row_min < MenuCtrl.list_offset || row_max >= MenuCtrl.list_offset + MENU_MAX_ITEM_LINES))
+    {
+        Fail("row outside the screen requested", index);
+    }
+    for (Y = 0; Y < 64; Y++)
+    {
+        for (X = 0; X < 128; X++)
+        {
+            if (OLED_Recorder_GetPoint(X, Y) != OLED_GetPoint(X, Y))
+            {
+                Fail("screen differs from the frame buffer", index);
+                Y = 64;
+                break;
+            }
+        }
+    }
+
+    memcpy(partial, OLED_DisplayBuf, sizeof(partial));
+    Menu_Refresh();
+    if (memcmp(partial, OLED_DisplayBuf, sizeof(partial)) != 0)
+    {
+        printf("FAIL %s: partial redraw differs from full redraw at row %u\n", what, index);
+        failures++;
+    }
+}
+
+static void Open_List(void)
+{
+    Menu_Init(&tree[0]);
+    Menu_Enter();
+    Menu_Enter();
+    Menu_Display();
+}
+
+static void Test_Walk(void)
+{
+    uint32_t i;
+
+    Open_List();
+    if (MenuCtrl.list != &test_list || MenuCtrl.list_index != 0)
+    {
+        printf("FAIL list not opened at row 0\n");
+        failures++;
+        return;
+    }
+
+    for (i = 0; i < LIST_ROWS + 5; i++)
+    {
+        Menu_MoveDown();
+        Display_Check("down");
+        if (MenuCtrl.list_index != (i + 1 < LIST_ROWS ? i + 1 : LIST_ROWS - 1) ||
+            MenuCtrl.list_index < MenuCtrl.list_offset ||
+            MenuCtrl.list_index >= MenuCtrl.list_offset + MENU_MAX_ITEM_LINES)
+        {
+            Fail("wrong position moving down", MenuCtrl.list_index);
+        }
+    }
+    if (MenuCtrl.list_offset != LIST_ROWS - MENU_MAX_ITEM_LINES)
+    {
+        printf("FAIL offset %u at the bottom\n", MenuCtrl.list_offset);
+        failures++;
+    }
+
+    for (i = 0; i < LIST_ROWS + 5; i++)
+    {
+        Menu_MoveUp();
+        Display_Check("up");
+    }
+    if (MenuCtrl.list_index != 0 || MenuCtrl.list_offset != 0)
+    {
+        printf("FAIL row %u, offset %u at the top\n", MenuCtrl.list_index, MenuCtrl.list_offset);
+        failures++;
+    }
+    printf("%u rows walked down and up, at most %u rows requested per display\n", LIST_ROWS, MENU_MAX_ITEM_LINES);
+}
+
+static void Test_Shrink(void)
+{
+    uint32_t i;
+
+    Open_List();
+    for (i = 0; i < 500; i++)
+    {
+        Menu_MoveDown();
+    }
+    Menu_Display();
+
+    /*数据被删除，行数减少到选中行之前*/
+    row_count = 7;
+    Menu_Refresh();
+    if (MenuCtrl.list_index != 6 || MenuCtrl.list_offset > 6)
+    {
+        printf("FAIL row %u, offset %u after shrinking to 7 rows\n", MenuCtrl.list_index, MenuCtrl.list_offset);
+        failures++;
+    }
+    Menu_MoveUp();
+    Display_Check("shrink");
+
+    row_count = 0;
+    Menu_Refresh();
+    Menu_Enter();
+    if (selected != -1 || MenuCtrl.list == NULL)
+    {
+        printf("FAIL empty list selected a row\n");
+        failures++;
+    }
+
+    row_count = LIST_ROWS;
+    Menu_Refresh();
+    for (i = 0; i < 42; i++)
+    {
+        Menu_MoveDown();
+    }
+    Menu_Enter();
+    if (selected != 42 || MenuCtrl.list != NULL || MenuCtrl.current_item != &tree[1])
+    {
+        printf("FAIL select: row %d, list %s\n", selected, MenuCtrl.list != NULL ? "open" : "closed");
+        failures++;
+    }
+}
+
+/*每次按键（移动并局部重绘）的平均耗时，单位us*/
+static double Key_Time(uint16_t Rows)
+{
+    clock_t start;
+    uint32_t i;
+
+    row_count = Rows;
+    Open_List();
+    for (i = 0; i < Rows / 2; i++)
+    {
+        Menu_MoveDown();
+    }
+    Menu_Display();
+
+    start = clock();
+    for (i = 0; i < BENCH_KEYS; i++)
+    {
+        if (i % 2)
+        {
+            Menu_MoveUp();
+        }
+        else
+        {
+            Menu_MoveDown();
+        }
+        Menu_Display();
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC / BENCH_KEYS * 1e6;
+}
+
+int main(void)
+{
+    double Small, Large;
+
+    Stub_Reset();
+    OLED_Init();
+
+    Test_Walk();
+    Test_Shrink();
+
+    Small = Key_Time(10);
+    Large = Key_Time(LIST_ROWS);
+    printf("per key: 10 rows %.2fus, %u rows %.2fus\n", Small, LIST_ROWS, Large);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
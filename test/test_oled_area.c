@@ -0,0 +1,160 @@
+#include "stm32f10x.h"
+#include "OLED.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * 文件名：test_oled_area.c
+ * 描    述：按页掩码实现的区域清空和取反测试
+ *          随机矩形下，OLED_ClearArea和OLED_ReverseArea的结果必须与改写前逐点操作的实现完全相同，
+ *          包括负坐标、超出屏幕、宽高为0和宽高达到255的情况；另外检查整屏的OLED_Clear和OLED_Reverse
+ */
+
+extern uint8_t OLED_DisplayBuf[8][128];
+
+#define RANDOM_CASES 50000
+
+static uint32_t seed = 5;
+
+/*固定种子的线性同余随机数，各平台结果相同*/
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+}
+
+/*改写前的OLED_ClearArea/OLED_ReverseArea，逐点操作*/
+static void Ref_Area(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, uint8_t Reverse)
+{
+    int16_t i, j;
+
+    for (j = Y; j < Y + Height; j++)
+    {
+        for (i = X; i < X + Width; i++)
+        {
+            if (i >= 0 && i <= 127 && j >= 0 && j <= 63)
+            {
+                if (Reverse)
+                {
+                    OLED_DisplayBuf[j / 8][i] ^= 0x01 << (j % 8);
+                }
+                else
+                {
+                    OLED_DisplayBuf[j / 8][i] &= ~(0x01 << (j % 8));
+                }
+            }
+        }
+    }
+}
+
+static void RandomFill(uint8_t Buf[8][128])
+{
+    uint32_t k;
+
+    for (k = 0; k < 8 * 128; k++)
+    {
+        ((uint8_t *)Buf)[k] = Random();
+    }
+}
+
+static uint32_t Test_Random(void)
+{
+    static uint8_t background[8][128];
+    static uint8_t expected[8][128];
+    uint32_t failures = 0;
+    uint32_t n;
+
+    for (n = 0; n < RANDOM_CASES; n++)
+    {
+        int16_t X, Y;
+        uint8_t Width, Height;
+        uint8_t Reverse = Random() % 2;
+
+        if (n % 3 == 0)
+        {
+            /*大多落在屏幕边缘附近*/
+            X = (int16_t)(Random() % 140) - 6;
+            Y = (int16_t)(Random() % 72) - 4;
+            Width = Random() % 130;
+            Height = Random() % 66;
+        }
+        else
+        {
+            X = (int16_t)(Random() % 400) - 200;
+            Y = (int16_t)(Random() % 200) - 100;
+            Width = Random() % 256;
+            Height = Random() % 256;
+        }
+
+        RandomFill(background);
+        memcpy(OLED_DisplayBuf, background, sizeof(background));
+        Ref_Area(X, Y, Width, Height, Reverse);
+        memcpy(expected, OLED_DisplayBuf, sizeof(expected));
+
+        memcpy(OLED_DisplayBuf, background, sizeof(background));
+        if (Reverse)
+        {
+            OLED_ReverseArea(X, Y, Width, Height);
+        }
+        else
+        {
+            OLED_ClearArea(X, Y, Width, Height);
+        }
+
+        if (memcmp(expected, OLED_DisplayBuf, sizeof(expected)) != 0)
+        {
+            if (failures < 5)
+            {
+                printf("FAIL %s X=%d Y=%d Width=%u Height=%u\n",
+                       Reverse ? "OLED_ReverseArea" : "OLED_ClearArea", X, Y, Width, Height);
+            }
+            failures++;
+        }
+    }
+    printf("%u random rectangles, %u mismatches\n", RANDOM_CASES, failures);
+    return failures;
+}
+
+static uint32_t Test_Full(void)
+{
+    static uint8_t background[8][128];
+    uint32_t failures = 0;
+    uint32_t k;
+
+    RandomFill(background);
+    memcpy(OLED_DisplayBuf, background, sizeof(background));
+    OLED_Reverse();
+    for (k = 0; k < 8 * 128; k++)
+    {
+        if ((((uint8_t *)OLED_DisplayBuf)[k] ^ ((uint8_t *)background)[k]) != 0xFF) // 每一位都取反
+        {
+            failures++;
+        }
+    }
+    if (failures)
+    {
+        printf("FAIL OLED_Reverse: %u bytes differ\n", failures);
+    }
+
+    OLED_Clear();
+    for (k = 0; k < 8 * 128; k++)
+    {
+        if (((uint8_t *)OLED_DisplayBuf)[k] != 0)
+        {
+            printf("FAIL OLED_Clear: byte %u is 0x%02X\n", k, ((uint8_t *)OLED_DisplayBuf)[k]);
+            failures++;
+            break;
+        }
+    }
+    return failures;
+}
+
+int main(void)
+{
+    uint32_t failures = Test_Random();
+
+    failures += Test_Full();
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
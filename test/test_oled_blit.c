@@ -0,0 +1,160 @@
+#include "stm32f10x.h"
+#include "OLED.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * 文件名：test_oled_blit.c
+ * 描    述：按页合成的图像显示测试
+ *          随机的位置、尺寸、背景和图像下，OLED_ShowImageMode的结果必须与改写前逐点清空、逐字节移位的实现完全相同，
+ *          包括负坐标、超出屏幕和透明模式；最后输出8x16字符在页对齐和不对齐位置的显示速度，供参考
+ */
+
+extern uint8_t OLED_DisplayBuf[8][128];
+
+#define RANDOM_CASES 50000
+#define BENCH_GLYPHS 1000000
+
+static uint32_t seed = 1;
+
+/*固定种子的线性同余随机数，各平台结果相同*/
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+}
+
+/*改写前的OLED_ClearArea，逐点清零*/
+static void Ref_ClearArea(int16_t X, int16_t Y, uint8_t Width, uint8_t Height)
+{
+    int16_t i, j;
+
+    for (j = Y; j < Y + Height; j++)
+    {
+        for (i = X; i < X + Width; i++)
+        {
+            if (i >= 0 && i <= 127 && j >= 0 && j <= 63)
+            {
+                OLED_DisplayBuf[j / 8][i] &= ~(0x01 << (j % 8));
+            }
+        }
+    }
+}
+
+/*改写前的OLED_ShowImage，Transparent为1时不清空区域*/
+static void Ref_ShowImage(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const uint8_t *Image, uint8_t Transparent)
+{
+    uint8_t i = 0, j = 0;
+    int16_t Page, Shift;
+
+    if (!Transparent)
+    {
+        Ref_ClearArea(X, Y, Width, Height);
+    }
+    for (j = 0; j < (Height - 1) / 8 + 1; j++)
+    {
+        for (i = 0; i < Width; i++)
+        {
+            if (X + i >= 0 && X + i <= 127)
+            {
+                Page = Y / 8;
+                Shift = Y % 8;
+                if (Y < 0)
+                {
+                    Page -= 1;
+                    Shift += 8;
+                }
+                if (Page + j >= 0 && Page + j <= 7)
+                {
+                    OLED_DisplayBuf[Page + j][X + i] |= Image[j * Width + i] << (Shift);
+                }
+                if (Page + j + 1 >= 0 && Page + j + 1 <= 7)
+                {
+                    OLED_DisplayBuf[Page + j + 1][X + i] |= Image[j * Width + i] >> (8 - Shift);
+                }
+            }
+        }
+    }
+}
+
+static uint32_t Test_Random(void)
+{
+    static uint8_t image[8 * 128];
+    static uint8_t background[8][128];
+    static uint8_t expected[8][128];
+    uint32_t failures = 0;
+    uint32_t n, k;
+
+    for (n = 0; n < RANDOM_CASES; n++)
+    {
+        uint8_t Width = Random() % 128 + 1;
+        uint8_t Height = Random() % 64 + 1;
+        int16_t X = (int16_t)(Random() % 300) - 150;
+        int16_t Y = (int16_t)(Random() % 160) - 80;
+        uint8_t Mode = Random() % 2 ? OLED_IMAGE_TRANSPARENT : OLED_IMAGE_OPAQUE;
+
+        for (k = 0; k < sizeof(background); k++)
+        {
+            ((uint8_t *)background)[k] = Random();
+        }
+        for (k = 0; k < (uint32_t)Width * ((Height - 1) / 8 + 1); k++)
+        {
+            image[k] = Random();
+        }
+
+        memcpy(OLED_DisplayBuf, background, sizeof(background));
+        Ref_ShowImage(X, Y, Width, Height, image, Mode == OLED_IMAGE_TRANSPARENT);
+        memcpy(expected, OLED_DisplayBuf, sizeof(expected));
+
+        memcpy(OLED_DisplayBuf, background, sizeof(background));
+        OLED_ShowImageMode(X, Y, Width, Height, image, Mode);
+
+        if (memcmp(expected, OLED_DisplayBuf, sizeof(expected)) != 0)
+        {
+            if (failures < 5)
+            {
+                printf("FAIL X=%d Y=%d Width=%u Height=%u Mode=%u\n", X, Y, Width, Height, Mode);
+            }
+            failures++;
+        }
+    }
+    printf("%u random cases, %u mismatches\n", RANDOM_CASES, failures);
+    return failures;
+}
+
+/*8x16字符显示速度，Step为字符之间的纵向间隔*/
+static void Bench(const char *name, uint8_t Step)
+{
+    clock_t start;
+    double ref, now;
+    uint32_t n;
+
+    start = clock();
+    for (n = 0; n < BENCH_GLYPHS; n++)
+    {
+        Ref_ShowImage((n * 8) % 128, (n % 4) * Step, 8, 16, OLED_F8x16[n % 95], 0);
+    }
+    ref = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (n = 0; n < BENCH_GLYPHS; n++)
+    {
+        OLED_ShowImage((n * 8) % 128, (n % 4) * Step, 8, 16, OLED_F8x16[n % 95]);
+    }
+    now = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("8x16 %s: old %.0f glyphs/s, new %.0f glyphs/s\n", name,
+           ref > 0 ? BENCH_GLYPHS / ref : 0, now > 0 ? BENCH_GLYPHS / now : 0);
+}
+
+int main(void)
+{
+    uint32_t failures = Test_Random();
+
+    Bench("page aligned", 16);
+    Bench("unaligned", 13);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+#include "stm32f10x.h"
+#include "OLED.h"
+#include "OLED_Data.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * 文件名：test_oled_chinese.c
+ * 描    述：汉字字模索引测试
+ *          OLED_FindChinese在排序索引中二分查找，结果必须与原来沿OLED_CF16x16逐项strcmp的顺序查找相同：
+ *          字模库中的每个汉字（含重复定义的汉字）、基本区的全部汉字（多数不在字模库中，应返回默认图形）
+ *          最后输出64个汉字的字符串的查找和显示耗时，供参考
+ *          索引文件是否过期由oled_index.py --check检查；test_oled_chinese_500在扩充到500个汉字的字模库上运行同一测试，
+ *          见CMakeLists.txt
+ */
+
+#define BENCH_STRINGS 20000
+
+uint16_t OLED_FindChinese(const char *Chinese);
+
+/*原来的顺序查找*/
+static uint16_t Ref_FindChinese(const char *Chinese)
+{
+    uint16_t pIndex;
+
+    for (pIndex = 0; strcmp(OLED_CF16x16[pIndex].Index, "") != 0; pIndex++)
+    {
+        if (strcmp(OLED_CF16x16[pIndex].Index, Chinese) == 0)
+        {
+            break;
+        }
+    }
+    return pIndex;
+}
+
+/*码点转换为UTF-8三字节编码*/
+static void EncodeUtf8(uint32_t Code, char *Out)
+{
+    Out[0] = (char)(0xE0 | (Code >> 12));
+    Out[1] = (char)(0x80 | ((Code >> 6) & 0x3F));
+    Out[2] = (char)(0x80 | (Code & 0x3F));
+    Out[3] = '\0';
+}
+
+static uint32_t Test_Table(void)
+{
+    uint32_t failures = 0;
+    uint16_t i;
+
+    for (i = 0; i < OLED_CF16x16_Count; i++)
+    {
+        const char *Chinese = OLED_CF16x16[i].Index;
+        uint16_t Found = OLED_FindChinese(Chinese);
+        if (Found != Ref_FindChinese(Chinese))
+        {
+            printf("FAIL \"%s\": OLED_FindChinese %u, linear search %u\n", Chinese, Found, Ref_FindChinese(Chinese));
+            failures++;
+        }
+    }
+    printf("%u table entries checked\n", OLED_CF16x16_Count);
+    return failures;
+}
+
+static uint32_t Test_Unknown(void)
+{
+    uint32_t failures = 0;
+    uint32_t found = 0;
+    uint32_t Code;
+    char Chinese[4];
+
+    for (Code = 0x4E00; Code <= 0x9FFF; Code++)
+    {
+        EncodeUtf8(Code, Chinese);
+        uint16_t Index = OLED_FindChinese(Chinese);
+        if (Index != Ref_FindChinese(Chinese))
+        {
+            if (failures < 5)
+            {
+                printf("FAIL U+%04X: OLED_FindChinese %u, linear search %u\n", Code, Index, Ref_FindChinese(Chinese));
+            }
+            failures++;
+        }
+        found += Index != OLED_CF16x16_Count - 1;
+    }
+    printf("U+4E00~U+9FFF checked, %u in the font\n", found);
+    return failures;
+}
+
+static void Bench(void)
+{
+    char text[64 * OLED_CHN_CHAR_WIDTH + 1];
+    char one[OLED_CHN_CHAR_WIDTH + 1] = {0};
+    volatile uint32_t sink = 0;
+    clock_t start;
+    double ref, now, show;
+    uint32_t n, i;
+
+    /*字模库中的汉字和不在字模库中的汉字各占一半*/
+    for (i = 0; i < 64; i++)
+    {
+        if (i % 2 == 0 && OLED_CF16x16_Count > 1)
+        {
+            memcpy(text + i * OLED_CHN_CHAR_WIDTH, OLED_CF16x16[(i * 7) % (OLED_CF16x16_Count - 1)].Index, OLED_CHN_CHAR_WIDTH);
+        }
+        else
+        {
+            EncodeUtf8(0x9F00 + i, one);
+            memcpy(text + i * OLED_CHN_CHAR_WIDTH, one, OLED_CHN_CHAR_WIDTH);
+        }
+    }
+    text[sizeof(text) - 1] = '\0';
+
+    start = clock();
+    for (n = 0; n < BENCH_STRINGS; n++)
+    {
+        for (i = 0; i < 64; i++)
+        {
+            memcpy(one, text + i * OLED_CHN_CHAR_WIDTH, OLED_CHN_CHAR_WIDTH);
+            sink += Ref_FindChinese(one);
+        }
+    }
+    ref = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (n = 0; n < BENCH_STRINGS; n++)
+    {
+        for (i = 0; i < 64; i++)
+        {
+            memcpy(one, text + i * OLED_CHN_CHAR_WIDTH, OLED_CHN_CHAR_WIDTH);
+            sink += OLED_FindChinese(one);
+        }
+    }
+    now = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (n = 0; n < BENCH_STRINGS; n++)
+    {
+        OLED_ShowChinese(0, 0, text);
+    }
+    show = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("64-glyph string, %u-glyph font: linear %.2fus, indexed %.2fus, OLED_ShowChinese %.2fus\n",
+           OLED_CF16x16_Count, ref / BENCH_STRINGS * 1e6, now / BENCH_STRINGS * 1e6, show / BENCH_STRINGS * 1e6);
+}
+
+int main(void)
+{
+    uint32_t failures = Test_Table();
+
+    failures += Test_Unknown();
+    Bench();
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
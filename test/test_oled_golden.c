@@ -0,0 +1,362 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "OLED.h"
+#include "Key_multi.h"
+#include "Menu.h"
+#include "Menu_creat.h"
+#include "Screen.h"
+#include "Statistics.h"
+#include "Sensor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * 文件名：test_oled_golden.c
+ * 描    述：界面截屏比对测试
+ *          用录制接口运行菜单、实时计数、阈值设置和贪吃蛇界面，按键由GPIO电平模拟，经Key_Scan消抖后进入事件队列
+ *          在各检查点把录制接口还原出的屏幕与golden目录中的PBM图像比较，
+ *          同时比较上一检查点以来的刷新次数、发送字节总数和最后一次刷新的字节数（golden/frames.txt）
+ *          界面或刷新方式有意修改后，在test目录下运行 test_oled_golden --update 重新生成
+ */
+
+#define GOLDEN_DIR "golden/"
+#define PBM_SIZE (10 + 128 * 64 / 8)
+#define TIMELINE_MAX 64
+
+typedef enum
+{
+    STEP_PRESS,   // 按下按键
+    STEP_RELEASE, // 释放按键
+    STEP_CHECK    // 检查点
+} StepType_t;
+
+typedef struct
+{
+    uint32_t time;
+    StepType_t type;
+    Key_action key;
+    const char *name;
+} Step_t;
+
+static Step_t timeline[TIMELINE_MAX];
+static uint32_t timeline_count;
+static uint32_t timeline_next;
+static uint32_t script_time; // 编排时间轴时的当前时刻
+
+static uint8_t update_mode;
+static uint32_t failures;
+static FILE *frames_file; // --update时写入，否则为NULL
+static char *frames_golden;
+
+/*上一检查点以来的刷新统计*/
+static uint32_t frame_updates;
+static uint32_t frame_bytes;
+static uint32_t frame_last;
+
+static uint8_t pbm[PBM_SIZE];
+static uint32_t pbm_len;
+
+static void OnUpdate(uint32_t Bytes)
+{
+    frame_updates++;
+    frame_bytes += Bytes;
+    frame_last = Bytes;
+}
+
+static void PbmPut(uint8_t Byte)
+{
+    if (pbm_len < PBM_SIZE)
+    {
+        pbm[pbm_len] = Byte;
+    }
+    pbm_len++;
+}
+
+/**
+ * 函    数：设置按键引脚电平
+ * 参    数：key 按键，pressed 1为按下（低电平）
+ * 返 回 值：无
+ */
+static void SetKey(Key_action key, uint8_t pressed)
+{
+    GPIO_TypeDef *port = GPIOB;
+    uint16_t pin;
+
+    switch (key)
+    {
+    case key_up:
+        pin = GPIO_Pin_0;
+        break;
+    case key_down:
+        pin = GPIO_Pin_1;
+        break;
+    case key_back:
+        pin = GPIO_Pin_10;
+        break;
+    default:
+        port = GPIOA;
+        pin = GPIO_Pin_2;
+        break;
+    }
+    if (pressed)
+    {
+        port->IDR &= ~(uint32_t)pin;
+    }
+    else
+    {
+        port->IDR |= pin;
+    }
+}
+
+/**
+ * 函    数：检查点，比较屏幕和刷新统计
+ * 参    数：name 检查点名称，对应golden目录中的name.pbm
+ * 返 回 值：无
+ */
+static void Check(const char *name)
+{
+    char path[128];
+    char line[128];
+    uint8_t golden[PBM_SIZE];
+    FILE *fp;
+
+    pbm_len = 0;
+    OLED_Recorder_WritePBM(PbmPut);
+    snprintf(path, sizeof(path), GOLDEN_DIR "%s.pbm", name);
+    snprintf(line, sizeof(line), "%s %u %u %u\n", name, frame_updates, frame_bytes, frame_last);
+
+    if (update_mode)
+    {
+        fp = fopen(path, "wb");
+        if (fp == NULL || fwrite(pbm, 1, PBM_SIZE, fp) != PBM_SIZE)
+        {
+            printf("FAIL %s: cannot write %s\n", name, path);
+            failures++;
+        }
+        if (fp != NULL)
+        {
+            fclose(fp);
+        }
+        fputs(line, frames_file);
+        printf("updated %s", line);
+    }
+    else
+    {
+        fp = fopen(path, "rb");
+        if (fp == NULL || fread(golden, 1, PBM_SIZE, fp) != PBM_SIZE || memcmp(golden, pbm, PBM_SIZE) != 0)
+        {
+            uint32_t diff = 0;
+            for (uint32_t i = 10; i < PBM_SIZE; i++)
+            {
+                diff += (uint32_t)__builtin_popcount((golden[i] ^ pbm[i]) & 0xFF);
+            }
+            printf("FAIL %s: screen differs from %s (%u pixels)\n", name, path, fp == NULL ? 128 * 64 : diff);
+            failures++;
+        }
+        if (fp != NULL)
+        {
+            fclose(fp);
+        }
+        if (frames_golden == NULL || strstr(frames_golden, line) == NULL)
+        {
+            printf("FAIL %s: updates/bytes/last = %u %u %u, not in golden/frames.txt\n",
+                   name, frame_updates, frame_bytes, frame_last);
+            failures++;
+        }
+        else
+        {
+            printf("ok   %s", line);
+        }
+    }
+
+    frame_updates = 0;
+    frame_bytes = 0;
+    frame_last = 0;
+}
+
+/**
+ * 函    数：每毫秒节拍，相当于TIM4中断
+ * 参    数：ms 当前时间
+ * 返 回 值：无
+ * 说    明：执行到期的时间轴步骤后扫描按键；游戏自带阻塞循环，也由这里推进按键和检查点
+ */
+static void Tick(uint32_t ms)
+{
+    if (ms > script_time + 10000)
+    {
+        printf("FAIL timeline stuck at step %u (游戏没有退出？)\n", timeline_next);
+        exit(1);
+    }
+    while (timeline_next < timeline_count && timeline[timeline_next].time <= ms)
+    {
+        const Step_t *step = &timeline[timeline_next++];
+        switch (step->type)
+        {
+        case STEP_PRESS:
+            SetKey(step->key, 1);
+            break;
+        case STEP_RELEASE:
+            SetKey(step->key, 0);
+            break;
+        case STEP_CHECK:
+            Check(step->name);
+            break;
+        }
+    }
+    Key_Scan();
+}
+
+static void AddStep(uint32_t time, StepType_t type, Key_action key, const char *name)
+{
+    if (timeline_count >= TIMELINE_MAX)
+    {
+        printf("timeline too long\n");
+        exit(2);
+    }
+    timeline[timeline_count].time = time;
+    timeline[timeline_count].type = type;
+    timeline[timeline_count].key = key;
+    timeline[timeline_count].name = name;
+    timeline_count++;
+}
+
+/*按下60ms后释放，间隔200ms再进行下一步*/
+static void Press(Key_action key)
+{
+    AddStep(script_time, STEP_PRESS, key, NULL);
+    AddStep(script_time + 60, STEP_RELEASE, key, NULL);
+    script_time += 260;
+}
+
+static void Wait(uint32_t ms)
+{
+    script_time += ms;
+}
+
+static void CheckAt(const char *name)
+{
+    AddStep(script_time, STEP_CHECK, key_none, name);
+    script_time += 1;
+}
+
+static char *ReadFile(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    char *text;
+    long size;
+
+    if (fp == NULL)
+    {
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    text = calloc(1, (size_t)size + 1);
+    if (fread(text, 1, (size_t)size, fp) != (size_t)size)
+    {
+        size = 0;
+    }
+    fclose(fp);
+    return text;
+}
+
+int main(int argc, char **argv)
+{
+    update_mode = argc > 1 && strcmp(argv[1], "--update") == 0;
+    if (update_mode)
+    {
+        frames_file = fopen(GOLDEN_DIR "frames.txt", "w");
+        if (frames_file == NULL)
+        {
+            printf("cannot write " GOLDEN_DIR "frames.txt\n");
+            return 1;
+        }
+    }
+    else
+    {
+        frames_golden = ReadFile(GOLDEN_DIR "frames.txt");
+    }
+
+    Stub_Reset();
+    Stub_Delay_Reset();
+    OLED_SetUpdateCallback(OnUpdate);
+    OLED_Init();
+    Key_Init();
+    Statistics_Init();
+    Menu_Setup();
+    Menu_Display();
+
+    /*时间轴：主菜单 -> 实时计数 -> 设置/阈值 -> 游戏/贪吃蛇*/
+    script_time = 100;
+    CheckAt("menu");
+    Press(key_enter); // 上电时停在根菜单，确认键进入第一项后才显示光标
+    CheckAt("menu_cursor");
+    Press(key_down);
+    CheckAt("menu_down");
+    Press(key_up);
+    Press(key_enter);
+    Wait(1000);
+    CheckAt("live_counting");
+    Press(key_back);
+    CheckAt("menu_back");
+    Press(key_down);
+    Press(key_down);
+    Press(key_enter);
+    CheckAt("settings");
+    Press(key_down);
+    Press(key_down);
+    Press(key_down);
+    Press(key_enter);
+    CheckAt("threshold");
+    Press(key_down);
+    CheckAt("threshold_down");
+    Press(key_back);
+    Press(key_back); // 返回上级菜单时光标回到第一项
+    Press(key_down);
+    Press(key_down);
+    Press(key_down);
+    Press(key_enter);
+    Press(key_down);
+    Press(key_enter);
+    Wait(300);
+    CheckAt("snake");
+    Press(key_enter);
+    Wait(300); // 蛇头从第8格向右走，撞墙前检查
+    CheckAt("snake_play");
+    AddStep(script_time, STEP_PRESS, key_back, NULL);
+    AddStep(script_time + 40, STEP_RELEASE, key_back, NULL);
+    AddStep(script_time + 120, STEP_PRESS, key_back, NULL);
+    AddStep(script_time + 160, STEP_RELEASE, key_back, NULL);
+    script_time += 500;
+    CheckAt("snake_exit");
+
+    Stub_Delay_SetTickHook(Tick);
+
+    /*主循环中与界面有关的部分，与main.c相同*/
+    while (timeline_next < timeline_count)
+    {
+        if (Screen_IsOpen())
+        {
+            Screen_Process();
+        }
+        else
+        {
+            Menu_Process(key_none);
+        }
+        if (!Screen_IsOpen())
+        {
+            Menu_Display();
+        }
+        Delay_ms(1);
+    }
+
+    if (update_mode)
+    {
+        fclose(frames_file);
+        return 0;
+    }
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
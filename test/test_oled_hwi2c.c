@@ -0,0 +1,332 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "OLED.h"
+#include "Delay.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * 文件名：test_oled_hwi2c.c
+ * 描    述：硬件I2C1+DMA通信接口测试
+ *          测试中模拟I2C1、DMA1通道6和SSD1306：固件轮询时间时（Delay_Get_Ticks）推进一步总线，
+ *          相当于忙等待期间发生的中断，依次调用I2C1事件中断、DMA中断和错误中断服务函数
+ *          检查：屏幕内容与显存一致；一次更新的多个传输以重复起始条件连续发送，只在队列清空后产生一次终止条件；
+ *          发送字节统计与总线上的字节数一致；从机无响应时每次传输超时放弃，恢复总线后继续发送；
+ *          无应答错误只放弃当前传输
+ */
+
+extern uint8_t OLED_DisplayBuf[8][128];
+
+/*OLED.c中的中断服务函数，由总线模拟调用*/
+void I2C1_EV_IRQHandler(void);
+void I2C1_ER_IRQHandler(void);
+void DMA1_Channel6_IRQHandler(void);
+
+#define SDA_PIN GPIO_Pin_9
+#define SCL_PIN GPIO_Pin_8
+
+static uint32_t failures;
+
+#define CHECK(cond, ...)                \
+    do                                  \
+    {                                   \
+        if (!(cond))                    \
+        {                               \
+            printf("FAIL line %d: ", __LINE__); \
+            printf(__VA_ARGS__);        \
+            printf("\n");               \
+            failures++;                 \
+        }                               \
+    } while (0)
+
+/*总线模拟*********************/
+
+static uint8_t bus_stuck;     // 从机无响应：起始条件之后不再产生SB
+static uint8_t bus_nack_next; // 下一次传输的数据阶段产生无应答错误
+static uint32_t bus_starts;   // 起始条件（含重复起始条件）次数
+static uint32_t bus_stops;    // 终止条件次数
+static uint32_t bus_bytes;    // 总线上的字节数（从机地址+控制字节+数据）
+static uint32_t bus_nacks;    // 模拟的无应答次数
+static uint32_t bus_starts_since_stop;
+static uint32_t bus_max_chain; // 两次终止条件之间最多的传输次数
+
+/*SSD1306模拟，只处理页寻址模式下的地址命令*/
+static uint8_t panel[8][128];
+static uint8_t panel_page;
+static uint8_t panel_column;
+static uint8_t panel_skip; // 尚未收到的命令参数数量
+
+static uint8_t Panel_ParamCount(uint8_t command)
+{
+    switch (command)
+    {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+static void Panel_Write(uint8_t control, const uint8_t *data, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        uint8_t b = data[i];
+        if (control == 0x40)
+        {
+            panel[panel_page][panel_column] = b;
+            panel_column = (panel_column + 1) & 0x7F;
+        }
+        else if (panel_skip > 0)
+        {
+            panel_skip--;
+        }
+        else if (b <= 0x0F)
+        {
+            panel_column = (panel_column & 0xF0) | b;
+        }
+        else if (b <= 0x1F)
+        {
+            panel_column = ((b & 0x07) << 4) | (panel_column & 0x0F);
+        }
+        else if (b >= 0xB0 && b <= 0xB7)
+        {
+            panel_page = b & 0x07;
+        }
+        else
+        {
+            panel_skip = Panel_ParamCount(b);
+        }
+    }
+}
+
+/**
+ * 函    数：推进一次I2C传输
+ * 参    数：无
+ * 返 回 值：无
+ * 说    明：起始条件 -> SB中断 -> ADDR中断 -> DMA搬运 -> DMA中断 -> BTF中断，
+ *           中断中产生的重复起始条件留到下一次调用处理；终止条件在中断返回后立即发完
+ */
+static void Bus_Step(void)
+{
+    uint8_t control;
+    const uint8_t *data;
+    uint32_t count;
+
+    if (!(I2C1->CR1 & I2C_CR1_START) || bus_stuck)
+    {
+        return;
+    }
+    I2C1->CR1 &= ~I2C_CR1_START;
+    bus_starts++;
+    if (++bus_starts_since_stop > bus_max_chain)
+    {
+        bus_max_chain = bus_starts_since_stop;
+    }
+
+    CHECK(I2C1->CR2 & I2C_CR2_ITEVTEN, "event interrupt disabled at START");
+    I2C1->SR1 = I2C_SR1_SB;
+    I2C1_EV_IRQHandler();
+    CHECK((I2C1->DR & 0xFE) == 0x78, "slave address 0x%02X", I2C1->DR);
+
+    I2C1->SR1 = I2C_SR1_ADDR;
+    I2C1_EV_IRQHandler();
+    control = (uint8_t)I2C1->DR;
+    CHECK(control == 0x00 || control == 0x40, "control byte 0x%02X", control);
+    bus_bytes += 2;
+
+    if (bus_nack_next)
+    {
+        /*数据阶段无应答：错误中断放弃本次传输*/
+        bus_nack_next = 0;
+        bus_nacks++;
+        DMA1_Channel6->CNDTR = 0;
+        I2C1->SR1 = I2C_SR1_AF;
+        I2C1_ER_IRQHandler();
+        CHECK((I2C1->SR1 & I2C_SR1_AF) == 0, "AF not cleared");
+    }
+    else
+    {
+        if ((DMA1_Channel6->CCR & 1) && (I2C1->CR2 & I2C_CR2_DMAEN))
+        {
+            data = (const uint8_t *)(uintptr_t)DMA1_Channel6->CMAR;
+            count = DMA1_Channel6->CNDTR;
+            Panel_Write(control, data, count);
+            bus_bytes += count;
+            DMA1_Channel6->CNDTR = 0;
+            DMA1->ISR |= DMA1_IT_TC6 | DMA1_IT_GL6;
+            CHECK(DMA1_Channel6->CCR & DMA_IT_TC, "DMA TC interrupt disabled");
+            DMA1_Channel6_IRQHandler();
+            CHECK((DMA1->ISR & DMA1_IT_TC6) == 0, "DMA TC6 not cleared");
+        }
+
+        CHECK(I2C1->CR2 & I2C_CR2_ITEVTEN, "event interrupt disabled before BTF");
+        I2C1->SR1 = I2C_SR1_BTF;
+        I2C1_EV_IRQHandler();
+    }
+    I2C1->SR1 = 0;
+
+    if (I2C1->CR1 & I2C_CR1_STOP)
+    {
+        CHECK(!(I2C1->CR1 & I2C_CR1_START), "START and STOP requested together");
+        I2C1->CR1 &= ~I2C_CR1_STOP;
+        bus_stops++;
+        bus_starts_since_stop = 0;
+    }
+}
+
+/*固件忙等待时：推进总线，时间前进10us*/
+static void Poll(void)
+{
+    Bus_Step();
+    Stub_Delay_AdvanceUs(10);
+}
+
+/*总线恢复时模拟卡死的从机：拉低SDA，收到3个时钟后释放*/
+static uint8_t slave_hold_clocks;
+static uint32_t recovery_clocks;
+static uint32_t recovery_stops;
+
+static void GpioWrite(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint8_t Level)
+{
+    if (GPIOx != GPIOB)
+    {
+        return;
+    }
+    if ((GPIO_Pin & SCL_PIN) && Level && !(GPIO_Pin & SDA_PIN))
+    {
+        recovery_clocks++;
+        if (slave_hold_clocks > 0 && --slave_hold_clocks == 0)
+        {
+            GPIOB->IDR |= SDA_PIN; // 从机移出剩余的位，释放SDA，之后恢复正常
+            bus_stuck = 0;
+        }
+    }
+    if (GPIO_Pin == SDA_PIN && Level && (GPIOB->ODR & SCL_PIN))
+    {
+        recovery_stops++; // SCL高电平期间SDA由低变高
+    }
+}
+
+static void WaitIdle(void)
+{
+    OLED_WaitIdle();
+    CHECK(!OLED_IsBusy(), "still busy after OLED_WaitIdle");
+}
+
+static uint32_t PanelDiff(void)
+{
+    uint32_t diff = 0;
+    for (uint32_t p = 0; p < 8; p++)
+    {
+        for (uint32_t x = 0; x < 128; x++)
+        {
+            diff += panel[p][x] != OLED_DisplayBuf[p][x];
+        }
+    }
+    return diff;
+}
+
+static void Test_Normal(void)
+{
+    uint32_t stops;
+
+    OLED_Init();
+    WaitIdle();
+    CHECK(PanelDiff() == 0, "panel differs after init: %u bytes", PanelDiff());
+    CHECK(bus_stops >= 1, "no STOP after init");
+
+    OLED_ResetSentBytes();
+    bus_bytes = 0;
+    bus_max_chain = 0;
+    stops = bus_stops;
+    OLED_ShowString(0, 0, "Hardware I2C", OLED_8X16);
+    OLED_ShowString(0, 24, "DMA + repeated START", OLED_6X8);
+    OLED_DrawCircle(100, 48, 12, OLED_FILLED);
+    OLED_Update();
+    WaitIdle();
+
+    CHECK(PanelDiff() == 0, "panel differs after update: %u bytes", PanelDiff());
+    CHECK(bus_stops == stops + 1, "%u STOPs for one update, expected 1", bus_stops - stops);
+    CHECK(bus_max_chain > 1, "transfers not chained with repeated START");
+    CHECK(OLED_GetSentBytes() == bus_bytes, "OLED_GetSentBytes %u, bus bytes %u", OLED_GetSentBytes(), bus_bytes);
+    CHECK(OLED_HwI2C_GetErrors() == 0, "%u errors", OLED_HwI2C_GetErrors());
+    printf("update: %u bytes, %u transfers chained before STOP\n", bus_bytes, bus_max_chain);
+}
+
+static void Test_Timeout(void)
+{
+    uint32_t errors = OLED_HwI2C_GetErrors();
+    uint32_t start;
+    uint32_t elapsed;
+
+    /*从机卡死：SDA被拉低，不再响应*/
+    bus_stuck = 1;
+    GPIOB->IDR &= ~SDA_PIN;
+    slave_hold_clocks = 3;
+    recovery_clocks = 0;
+    recovery_stops = 0;
+    Stub_GPIO_WriteHook = GpioWrite;
+
+    OLED_ShowString(0, 40, "stuck", OLED_8X16);
+    start = Delay_Get_Ticks();
+    OLED_Update();
+    WaitIdle();
+    elapsed = Delay_Get_Ticks() - start;
+    Stub_GPIO_WriteHook = NULL;
+
+    CHECK(OLED_HwI2C_GetErrors() == errors + 1, "errors %u -> %u, expected one timeout", errors, OLED_HwI2C_GetErrors());
+    CHECK(elapsed >= OLED_TX_TIMEOUT_MS && elapsed < OLED_TX_TIMEOUT_MS + 5, "stuck transfer took %u ms", elapsed);
+    CHECK(recovery_clocks == 3, "%u recovery clocks, slave released SDA after 3", recovery_clocks);
+    CHECK(recovery_stops >= 1, "no STOP generated during recovery");
+    CHECK(I2C1->CR2 & I2C_CR2_ITERREN, "error interrupt not re-enabled after recovery");
+
+    /*被丢弃的传输由整屏刷新补发*/
+    OLED_UpdateFull();
+    WaitIdle();
+    CHECK(PanelDiff() == 0, "panel differs after recovery: %u bytes", PanelDiff());
+    printf("timeout: recovered after %u ms with %u clocks\n", elapsed, recovery_clocks);
+}
+
+static void Test_Nack(void)
+{
+    uint32_t errors = OLED_HwI2C_GetErrors();
+    uint32_t stops = bus_stops;
+
+    bus_nack_next = 1;
+    OLED_ClearArea(0, 40, 128, 16);
+    OLED_ShowString(0, 40, "nack", OLED_8X16);
+    OLED_Update();
+    WaitIdle();
+
+    CHECK(bus_nacks == 1, "NACK not simulated");
+    CHECK(OLED_HwI2C_GetErrors() == errors + 1, "errors %u -> %u, expected one NACK", errors, OLED_HwI2C_GetErrors());
+    CHECK(bus_stops == stops + 1, "%u STOPs after NACK, expected 1", bus_stops - stops);
+
+    OLED_UpdateFull();
+    WaitIdle();
+    CHECK(PanelDiff() == 0, "panel differs after NACK: %u bytes", PanelDiff());
+}
+
+int main(void)
+{
+    Stub_Reset();
+    Stub_Delay_Reset();
+    Stub_Delay_SetPollHook(Poll);
+
+    Test_Normal();
+    Test_Timeout();
+    Test_Nack();
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,242 @@
+#include "stm32f10x.h"
+#include "OLED.h"
+#include "OLED_Data.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * 文件名：test_oled_packed.c
+ * 描    述：RLE压缩图像测试
+ *          用与oled_pack.py相同格式的编码器压缩随机图像（含长游程、跨页游程和不压缩的数据），
+ *          在随机位置和背景下，OLED_ShowPackedImage的结果必须与对原图调用OLED_ShowImage完全相同；
+ *          HT_LOGO1_RLE解压后同样比较
+ *          最后输出字模按字压缩后的大小和每个16x16区域的解压显示耗时，供参考
+ */
+
+extern uint8_t OLED_DisplayBuf[8][128];
+
+#define RANDOM_CASES 20000
+#define BENCH_IMAGES 200000
+#define F8X16_COUNT 95
+#define F6X8_COUNT 95
+#define LOGO_SIZE (64 * 64 / 8)
+
+static uint32_t seed = 2;
+
+/*固定种子的线性同余随机数，各平台结果相同*/
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+}
+
+/**
+ * 函    数：RLE压缩，与oled_pack.py的pack相同
+ * 参    数：Data 原始数据，Count 数据数量，Out 压缩数据输出
+ * 返 回 值：压缩后的字节数
+ * 说    明：控制字节0x00~0x7F后跟控制字节+1个原样数据，0x80~0xFF后跟1个数据，重复控制字节-0x80+2次
+ */
+static uint32_t Pack(const uint8_t *Data, uint32_t Count, uint8_t *Out)
+{
+    uint32_t i = 0, n = 0;
+
+    while (i < Count)
+    {
+        uint32_t Run = 1;
+        while (i + Run < Count && Data[i + Run] == Data[i] && Run < 129)
+        {
+            Run++;
+        }
+        if (Run >= 2)
+        {
+            Out[n++] = (uint8_t)(0x80 + Run - 2);
+            Out[n++] = Data[i];
+            i += Run;
+            continue;
+        }
+
+        uint32_t Literal = 0;
+        uint32_t Control = n++;
+        while (i < Count && Literal < 128 && !(i + 1 < Count && Data[i + 1] == Data[i]))
+        {
+            Out[n++] = Data[i++];
+            Literal++;
+        }
+        Out[Control] = (uint8_t)(Literal - 1);
+    }
+    return n;
+}
+
+/*解压Count个字节，返回消耗的压缩数据字节数*/
+static uint32_t Unpack(const uint8_t *Packed, uint32_t Count, uint8_t *Out)
+{
+    const uint8_t *p = Packed;
+    uint32_t n = 0, k;
+
+    while (n < Count)
+    {
+        if (*p & 0x80)
+        {
+            uint32_t Run = *p++ - 0x80 + 2;
+            for (k = 0; k < Run && n < Count; k++)
+            {
+                Out[n++] = *p;
+            }
+            p++;
+        }
+        else
+        {
+            uint32_t Literal = *p++ + 1;
+            for (k = 0; k < Literal && n < Count; k++)
+            {
+                Out[n++] = *p++;
+            }
+        }
+    }
+    return (uint32_t)(p - Packed);
+}
+
+/*随机图像：游程和随机数据交替，游程可以跨页*/
+static void RandomImage(uint8_t *Image, uint32_t Count)
+{
+    uint32_t n = 0;
+
+    while (n < Count)
+    {
+        uint32_t Length = Random() % 200 + 1;
+        uint8_t Value = Random();
+        uint8_t IsRun = Random() % 2;
+        while (Length-- && n < Count)
+        {
+            Image[n++] = IsRun ? Value : (uint8_t)Random();
+        }
+    }
+}
+
+static uint8_t Compare(int16_t X, int16_t Y, uint8_t Width, uint8_t Height, const uint8_t *Image, const uint8_t *Packed)
+{
+    static uint8_t background[8][128];
+    static uint8_t expected[8][128];
+    uint32_t k;
+
+    for (k = 0; k < sizeof(background); k++)
+    {
+        ((uint8_t *)background)[k] = Random();
+    }
+    memcpy(OLED_DisplayBuf, background, sizeof(background));
+    OLED_ShowImage(X, Y, Width, Height, Image);
+    memcpy(expected, OLED_DisplayBuf, sizeof(expected));
+
+    memcpy(OLED_DisplayBuf, background, sizeof(background));
+    OLED_ShowPackedImage(X, Y, Width, Height, Packed);
+    return memcmp(expected, OLED_DisplayBuf, sizeof(expected)) != 0;
+}
+
+static uint32_t Test_Random(void)
+{
+    static uint8_t image[8 * 128];
+    static uint8_t packed[8 * 128 * 2];
+    uint32_t failures = 0;
+    uint32_t n;
+
+    for (n = 0; n < RANDOM_CASES; n++)
+    {
+        uint8_t Width = Random() % 128 + 1;
+        uint8_t Height = Random() % 64 + 1;
+        int16_t X = (int16_t)(Random() % 200) - 60;
+        int16_t Y = (int16_t)(Random() % 120) - 50;
+        uint32_t Count = (uint32_t)Width * ((Height - 1) / 8 + 1);
+
+        RandomImage(image, Count);
+        Pack(image, Count, packed);
+        if (Compare(X, Y, Width, Height, image, packed))
+        {
+            if (failures < 5)
+            {
+                printf("FAIL X=%d Y=%d Width=%u Height=%u\n", X, Y, Width, Height);
+            }
+            failures++;
+        }
+    }
+    printf("%u random images, %u mismatches\n", RANDOM_CASES, failures);
+    return failures;
+}
+
+static uint32_t Test_Logo(uint8_t *Logo)
+{
+    uint32_t failures = 0;
+    uint32_t n;
+
+    for (n = 0; n < 500; n++)
+    {
+        failures += Compare((int16_t)(Random() % 200) - 60, (int16_t)(Random() % 120) - 50, 64, 64, Logo, HT_LOGO1_RLE);
+    }
+    if (failures)
+    {
+        printf("FAIL HT_LOGO1_RLE: %u of %u positions differ\n", failures, n);
+    }
+    return failures;
+}
+
+/*逐字压缩字模，返回压缩后的总字节数*/
+static uint32_t PackedFontSize(const uint8_t *Font, uint32_t GlyphSize, uint32_t Stride, uint32_t Count)
+{
+    static uint8_t packed[64];
+    uint32_t Total = 0, i;
+
+    for (i = 0; i < Count; i++)
+    {
+        Total += Pack(Font + i * Stride, GlyphSize, packed);
+    }
+    return Total;
+}
+
+static void Report(const uint8_t *Logo, uint32_t LogoPacked)
+{
+    uint32_t chinese = 0;
+    clock_t start;
+    double raw, rle;
+    uint32_t n;
+
+    while (OLED_CF16x16[chinese].Index[0] != '\0')
+    {
+        chinese++;
+    }
+
+    printf("HT_LOGO1:     %u -> %u bytes\n", LOGO_SIZE, LogoPacked);
+    printf("OLED_F8x16:   %u -> %u bytes per glyph packed\n", F8X16_COUNT * 16,
+           PackedFontSize(OLED_F8x16[0], 16, 16, F8X16_COUNT));
+    printf("OLED_F6x8:    %u -> %u bytes per glyph packed\n", F6X8_COUNT * 6,
+           PackedFontSize(OLED_F6x8[0], 6, 6, F6X8_COUNT));
+    printf("OLED_CF16x16: %u -> %u bytes per glyph packed\n", chinese * 32,
+           PackedFontSize(OLED_CF16x16[0].Data, 32, sizeof(ChineseCell_t), chinese));
+
+    start = clock();
+    for (n = 0; n < BENCH_IMAGES; n++)
+    {
+        OLED_ShowImage(32, (n % 2) * 3, 64, 64, Logo);
+    }
+    raw = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (n = 0; n < BENCH_IMAGES; n++)
+    {
+        OLED_ShowPackedImage(32, (n % 2) * 3, 64, 64, HT_LOGO1_RLE);
+    }
+    rle = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("64x64 logo: raw %.3fus, packed %.3fus per 16x16 cell\n",
+           raw / BENCH_IMAGES * 1e6 / 16, rle / BENCH_IMAGES * 1e6 / 16);
+}
+
+int main(void)
+{
+    static uint8_t logo[LOGO_SIZE];
+    uint32_t failures = Test_Random();
+    uint32_t LogoPacked = Unpack(HT_LOGO1_RLE, LOGO_SIZE, logo);
+
+    failures += Test_Logo(logo);
+    Report(logo, LogoPacked);
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,425 @@
+#include "stm32f10x.h"
+#include "OLED.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * 文件名：test_oled_raster.c
+ * 描    述：整数图形函数测试
+ *          三角形、多边形填充与逐点OLED_pnpoly判断的结果比较，圆弧与atan2判断角度的结果比较，
+ *          椭圆与浮点判别式的结果比较，要求逐点相同；参考实现取自改写前的OLED.c
+ *          椭圆半轴达到210以上时，浮点判别式精度不足，整数实现按精确的中点曲线绘制，不再比较
+ *          最后输出参考实现与当前实现的耗时，供参考；主机有浮点单元，atan2的耗时远小于在STM32F103上软件模拟的耗时
+ */
+
+extern uint8_t OLED_DisplayBuf[8][128];
+
+static uint32_t seed = 7;
+static uint32_t failures;
+
+/*固定种子的线性同余随机数，各平台结果相同*/
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+}
+
+static int16_t RandomRange(int16_t Min, int16_t Max)
+{
+    return Min + (int16_t)(Random() % (uint32_t)(Max - Min + 1));
+}
+
+/*参考实现*********************/
+
+static void Ref_DrawPoint(int16_t X, int16_t Y)
+{
+    if (X >= 0 && X <= 127 && Y >= 0 && Y <= 63)
+    {
+        OLED_DisplayBuf[Y / 8][X] |= 0x01 << (Y % 8);
+    }
+}
+
+static uint8_t Ref_pnpoly(uint8_t nvert, int16_t *vertx, int16_t *verty, int16_t testx, int16_t testy)
+{
+    int16_t i, j, c = 0;
+
+    for (i = 0, j = nvert - 1; i < nvert; j = i++)
+    {
+        if (((verty[i] > testy) != (verty[j] > testy)) &&
+            (testx < (vertx[j] - vertx[i]) * (testy - verty[i]) / (verty[j] - verty[i]) + vertx[i]))
+        {
+            c = !c;
+        }
+    }
+    return c;
+}
+
+static uint8_t Ref_IsInAngle(int16_t X, int16_t Y, int16_t StartAngle, int16_t EndAngle)
+{
+    int16_t PointAngle;
+    PointAngle = atan2(Y, X) / 3.14 * 180;
+    if (StartAngle < EndAngle)
+    {
+        if (PointAngle >= StartAngle && PointAngle <= EndAngle)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        if (PointAngle >= StartAngle || PointAngle <= EndAngle)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*改写前的填充：遍历外接矩形，逐点判断是否在多边形内部*/
+static void Ref_FillPolygon(uint8_t Count, int16_t *X, int16_t *Y)
+{
+    int16_t minx = X[0], miny = Y[0], maxx = X[0], maxy = Y[0];
+    int16_t i, j;
+
+    for (i = 1; i < Count; i++)
+    {
+        if (X[i] < minx) minx = X[i];
+        if (X[i] > maxx) maxx = X[i];
+        if (Y[i] < miny) miny = Y[i];
+        if (Y[i] > maxy) maxy = Y[i];
+    }
+    for (i = minx; i <= maxx; i++)
+    {
+        for (j = miny; j <= maxy; j++)
+        {
+            if (Ref_pnpoly(Count, X, Y, i, j))
+            {
+                Ref_DrawPoint(i, j);
+            }
+        }
+    }
+}
+
+static void Ref_DrawEllipse(int16_t X, int16_t Y, uint8_t A, uint8_t B, uint8_t IsFilled)
+{
+    int16_t x, y, j;
+    int16_t a = A, b = B;
+    float d1, d2;
+
+    x = 0;
+    y = b;
+    d1 = b * b + a * a * (-b + 0.5);
+
+    if (IsFilled)
+    {
+        for (j = -y; j < y; j++)
+        {
+            Ref_DrawPoint(X, Y + j);
+        }
+    }
+
+    Ref_DrawPoint(X + x, Y + y);
+    Ref_DrawPoint(X - x, Y - y);
+    Ref_DrawPoint(X - x, Y + y);
+    Ref_DrawPoint(X + x, Y - y);
+
+    while (b * b * (x + 1) < a * a * (y - 0.5))
+    {
+        if (d1 <= 0)
+        {
+            d1 += b * b * (2 * x + 3);
+        }
+        else
+        {
+            d1 += b * b * (2 * x + 3) + a * a * (-2 * y + 2);
+            y--;
+        }
+        x++;
+
+        if (IsFilled)
+        {
+            for (j = -y; j < y; j++)
+            {
+                Ref_DrawPoint(X + x, Y + j);
+                Ref_DrawPoint(X - x, Y + j);
+            }
+        }
+
+        Ref_DrawPoint(X + x, Y + y);
+        Ref_DrawPoint(X - x, Y - y);
+        Ref_DrawPoint(X - x, Y + y);
+        Ref_DrawPoint(X + x, Y - y);
+    }
+
+    d2 = b * b * (x + 0.5) * (x + 0.5) + a * a * (y - 1) * (y - 1) - a * a * b * b;
+
+    while (y > 0)
+    {
+        if (d2 <= 0)
+        {
+            d2 += b * b * (2 * x + 2) + a * a * (-2 * y + 3);
+            x++;
+        }
+        else
+        {
+            d2 += a * a * (-2 * y + 3);
+        }
+        y--;
+
+        if (IsFilled)
+        {
+            for (j = -y; j < y; j++)
+            {
+                Ref_DrawPoint(X + x, Y + j);
+                Ref_DrawPoint(X - x, Y + j);
+            }
+        }
+
+        Ref_DrawPoint(X + x, Y + y);
+        Ref_DrawPoint(X - x, Y - y);
+        Ref_DrawPoint(X - x, Y + y);
+        Ref_DrawPoint(X + x, Y - y);
+    }
+}
+
+/*在圆上的点满足角度条件时画点*/
+#define REF_ARC_POINT(x, y)                                \
+    if (Ref_IsInAngle((x), (y), StartAngle, EndAngle))     \
+    {                                                      \
+        Ref_DrawPoint(X + (x), Y + (y));                   \
+    }
+
+static void Ref_DrawArc(int16_t X, int16_t Y, uint8_t Radius, int16_t StartAngle, int16_t EndAngle, uint8_t IsFilled)
+{
+    int16_t x, y, d, j;
+
+    d = 1 - Radius;
+    x = 0;
+    y = Radius;
+
+    REF_ARC_POINT(x, y);
+    REF_ARC_POINT(-x, -y);
+    REF_ARC_POINT(y, x);
+    REF_ARC_POINT(-y, -x);
+
+    if (IsFilled)
+    {
+        for (j = -y; j < y; j++)
+        {
+            REF_ARC_POINT(0, j);
+        }
+    }
+
+    while (x < y)
+    {
+        x++;
+        if (d < 0)
+        {
+            d += 2 * x + 1;
+        }
+        else
+        {
+            y--;
+            d += 2 * (x - y) + 1;
+        }
+
+        REF_ARC_POINT(x, y);
+        REF_ARC_POINT(y, x);
+        REF_ARC_POINT(-x, -y);
+        REF_ARC_POINT(-y, -x);
+        REF_ARC_POINT(x, -y);
+        REF_ARC_POINT(y, -x);
+        REF_ARC_POINT(-x, y);
+        REF_ARC_POINT(-y, x);
+
+        if (IsFilled)
+        {
+            for (j = -y; j < y; j++)
+            {
+                REF_ARC_POINT(x, j);
+                REF_ARC_POINT(-x, j);
+            }
+            for (j = -x; j < x; j++)
+            {
+                REF_ARC_POINT(-y, j);
+                REF_ARC_POINT(y, j);
+            }
+        }
+    }
+}
+
+/*********************参考实现*/
+
+static uint8_t expected[8][128];
+static double ref_seconds;
+static double new_seconds;
+static clock_t clock_start;
+
+static void BeginRef(void)
+{
+    memset(OLED_DisplayBuf, 0, sizeof(expected));
+    clock_start = clock();
+}
+
+static void BeginNew(void)
+{
+    ref_seconds += (double)(clock() - clock_start) / CLOCKS_PER_SEC;
+    memcpy(expected, OLED_DisplayBuf, sizeof(expected));
+    memset(OLED_DisplayBuf, 0, sizeof(expected));
+    clock_start = clock();
+}
+
+/*比较两次绘制的结果，返回1表示不同*/
+static uint8_t EndCompare(void)
+{
+    new_seconds += (double)(clock() - clock_start) / CLOCKS_PER_SEC;
+    return memcmp(expected, OLED_DisplayBuf, sizeof(expected)) != 0;
+}
+
+static void Report(const char *name, uint32_t cases, uint32_t bad)
+{
+    printf("%-9s %6u cases, %u mismatches, old %.3fs, new %.3fs\n", name, cases, bad, ref_seconds, new_seconds);
+    failures += bad;
+    ref_seconds = 0;
+    new_seconds = 0;
+}
+
+static void Test_Triangle(void)
+{
+    uint32_t n, bad = 0;
+    int16_t X[3], Y[3];
+
+    for (n = 0; n < 2000; n++)
+    {
+        /*多数在屏幕附近，少数顶点远在屏幕外*/
+        int16_t R = n % 10 == 0 ? 600 : (n % 2 ? 200 : 40);
+        for (uint8_t k = 0; k < 3; k++)
+        {
+            X[k] = 64 + RandomRange(-R, R);
+            Y[k] = 32 + RandomRange(-R, R);
+        }
+
+        BeginRef();
+        Ref_FillPolygon(3, X, Y);
+        BeginNew();
+        OLED_DrawTriangle(X[0], Y[0], X[1], Y[1], X[2], Y[2], OLED_FILLED);
+        if (EndCompare())
+        {
+            if (bad < 5)
+            {
+                printf("FAIL triangle (%d,%d) (%d,%d) (%d,%d)\n", X[0], Y[0], X[1], Y[1], X[2], Y[2]);
+            }
+            bad++;
+        }
+    }
+    Report("triangle", n, bad);
+}
+
+static void Test_Polygon(void)
+{
+    uint32_t n, bad = 0;
+    int16_t X[16], Y[16];
+
+    for (n = 0; n < 4000; n++)
+    {
+        uint8_t Count = RandomRange(3, 16);
+        for (uint8_t k = 0; k < Count; k++)
+        {
+            X[k] = RandomRange(-40, 167);
+            Y[k] = RandomRange(-30, 93);
+        }
+
+        BeginRef();
+        Ref_FillPolygon(Count, X, Y);
+        BeginNew();
+        OLED_DrawPolygon(X, Y, Count, OLED_FILLED);
+        if (EndCompare())
+        {
+            if (bad < 5)
+            {
+                printf("FAIL polygon with %u vertices, first (%d,%d)\n", Count, X[0], Y[0]);
+            }
+            bad++;
+        }
+    }
+    Report("polygon", n, bad);
+}
+
+static void Test_Arc(void)
+{
+    uint32_t n, bad = 0;
+
+    for (n = 0; n < 6000; n++)
+    {
+        int16_t X = RandomRange(-16, 143);
+        int16_t Y = RandomRange(-16, 79);
+        uint8_t Radius = Random() % (n < 3000 ? 64 : 256);
+        int16_t StartAngle = RandomRange(-180, 180);
+        int16_t EndAngle = RandomRange(-180, 180);
+        uint8_t IsFilled = Random() % 2;
+
+        BeginRef();
+        Ref_DrawArc(X, Y, Radius, StartAngle, EndAngle, IsFilled);
+        BeginNew();
+        OLED_DrawArc(X, Y, Radius, StartAngle, EndAngle, IsFilled);
+        if (EndCompare())
+        {
+            if (bad < 5)
+            {
+                printf("FAIL arc (%d,%d) R=%u %d~%d filled=%u\n", X, Y, Radius, StartAngle, EndAngle, IsFilled);
+            }
+            bad++;
+        }
+    }
+    Report("arc", n, bad);
+}
+
+static uint8_t CompareEllipse(int16_t X, int16_t Y, uint8_t A, uint8_t B, uint8_t IsFilled)
+{
+    BeginRef();
+    Ref_DrawEllipse(X, Y, A, B, IsFilled);
+    BeginNew();
+    OLED_DrawEllipse(X, Y, A, B, IsFilled);
+    if (EndCompare())
+    {
+        printf("FAIL ellipse (%d,%d) A=%u B=%u filled=%u\n", X, Y, A, B, IsFilled);
+        return 1;
+    }
+    return 0;
+}
+
+static void Test_Ellipse(void)
+{
+    uint32_t n = 0, bad = 0;
+    uint16_t A, B;
+
+    /*屏幕内的半轴全部比较*/
+    for (A = 0; A < 80; A++)
+    {
+        for (B = 0; B < 80; B++)
+        {
+            bad += CompareEllipse(64, 32, A, B, A % 2 ^ B % 2);
+            n++;
+        }
+    }
+
+    /*大半轴、偏离屏幕的椭圆随机抽样*/
+    for (; n < 8400 && bad < 5; n++)
+    {
+        bad += CompareEllipse(RandomRange(-100, 227), RandomRange(-100, 163), Random() % 210, Random() % 210, Random() % 2);
+    }
+    Report("ellipse", n, bad);
+}
+
+int main(void)
+{
+    Test_Triangle();
+    Test_Polygon();
+    Test_Arc();
+    Test_Ellipse();
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
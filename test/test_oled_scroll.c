@@ -0,0 +1,189 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "OLED.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * 文件名：test_oled_scroll.c
+ * 描    述：硬件滚动测试
+ *          录制接口按显示起始行还原屏幕，每次OLED_ScrollPages并在露出的页中绘制后，屏幕必须与显存数组相同，
+ *          且只发送露出的页和改动的点；连续滚动期间更新函数不发送数据，停止后整屏重发并恢复一致
+ */
+
+#define RANDOM_STEPS 300
+#define MENU_STEPS 100
+
+static uint32_t seed = 1;
+static uint32_t failures;
+static uint32_t last_bytes;
+
+/*固定种子的线性同余随机数，各平台结果相同*/
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+}
+
+static void OnUpdate(uint32_t Bytes)
+{
+    last_bytes = Bytes;
+}
+
+/*屏幕与显存数组不同的点数*/
+static uint32_t ScreenDiff(void)
+{
+    uint32_t diff = 0;
+    int16_t X, Y;
+
+    for (Y = 0; Y < 64; Y++)
+    {
+        for (X = 0; X < 128; X++)
+        {
+            diff += OLED_Recorder_GetPoint(X, Y) != OLED_GetPoint(X, Y);
+        }
+    }
+    return diff;
+}
+
+static uint32_t UpdateBytes(void)
+{
+    uint32_t Before = OLED_GetSentBytes();
+    OLED_Update();
+    return OLED_GetSentBytes() - Before;
+}
+
+static void Test_RandomSteps(void)
+{
+    char text[24];
+    uint32_t step, bad = 0, worst = 0;
+
+    for (step = 0; step < RANDOM_STEPS; step++)
+    {
+        int8_t Pages = (int8_t)(Random() % 15) - 7;
+        uint8_t Count, k;
+        int16_t Y0;
+        uint32_t Bytes, diff;
+
+        if (Pages == 0)
+        {
+            Pages = 2;
+        }
+        OLED_ScrollPages(Pages);
+
+        /*在露出的页中绘制新内容*/
+        Count = Pages > 0 ? Pages : -Pages;
+        Y0 = Pages > 0 ? (8 - Count) * 8 : 0;
+        for (k = 0; k < Count; k++)
+        {
+            snprintf(text, sizeof(text), "row %u.%u", step, k);
+            OLED_ShowString(Random() % 60, Y0 + k * 8, text, OLED_6X8);
+        }
+        if (Random() % 3 == 0)
+        {
+            OLED_DrawPoint(Random() % 128, Random() % 64); // 偶尔改动未滚动的区域
+        }
+
+        Bytes = UpdateBytes();
+        if (Bytes > worst)
+        {
+            worst = Bytes;
+        }
+        diff = ScreenDiff();
+        if (diff)
+        {
+            if (bad < 5)
+            {
+                printf("FAIL step %u, %d pages: %u pixels differ\n", step, Pages, diff);
+            }
+            bad++;
+        }
+    }
+    printf("%u random scroll steps, %u mismatches, at most %u bytes per step\n", RANDOM_STEPS, bad, worst);
+    failures += bad;
+}
+
+/*菜单下移一项：滚动2页，在底部绘制新菜单项*/
+static void Test_MenuSteps(void)
+{
+    char text[24];
+    uint32_t step, bad = 0, total = 0;
+
+    for (step = 0; step < MENU_STEPS; step++)
+    {
+        OLED_ScrollPages(2);
+        snprintf(text, sizeof(text), "Item %u", step);
+        OLED_ShowString(0, 48, text, OLED_8X16);
+        total += UpdateBytes();
+        bad += ScreenDiff() != 0;
+    }
+    printf("menu: %u steps, %u bytes per step\n", MENU_STEPS, total / MENU_STEPS);
+    if (bad)
+    {
+        printf("FAIL menu: %u steps differ\n", bad);
+    }
+    /*最多两页数据（每页一次传输）加上设置起始行和页列地址的命令，远小于整屏*/
+    if (total / MENU_STEPS > 2 * (2 + 128) + 3 + 2 * 3 * 3)
+    {
+        printf("FAIL menu: more than the two exposed pages sent\n");
+        bad++;
+    }
+    failures += bad;
+}
+
+static void Test_Continuous(void)
+{
+    uint32_t diff;
+
+    OLED_ScrollStart(OLED_SCROLL_LEFT, 2, 5, 7);
+    OLED_ShowString(0, 0, "during", OLED_8X16);
+    last_bytes = 0;
+    OLED_Update();
+    if (last_bytes != 0)
+    {
+        printf("FAIL %u bytes sent while scrolling\n", last_bytes);
+        failures++;
+    }
+
+    OLED_ScrollStop();
+    diff = ScreenDiff();
+    printf("continuous scroll: stop resent %u bytes\n", last_bytes);
+    if (diff)
+    {
+        printf("FAIL %u pixels differ after OLED_ScrollStop\n", diff);
+        failures++;
+    }
+
+    OLED_ScrollPages(3);
+    OLED_ScrollDiagonalStart(OLED_SCROLL_RIGHT, 0, 7, 0, 1);
+    OLED_ScrollStop();
+    diff = ScreenDiff();
+    if (diff)
+    {
+        printf("FAIL %u pixels differ after diagonal scroll\n", diff);
+        failures++;
+    }
+}
+
+int main(void)
+{
+    char text[24];
+    uint8_t i;
+
+    Stub_Reset();
+    OLED_SetUpdateCallback(OnUpdate);
+    OLED_Init();
+    for (i = 0; i < 4; i++)
+    {
+        snprintf(text, sizeof(text), "Item %u", i);
+        OLED_ShowString(0, i * 16, text, OLED_8X16);
+    }
+    OLED_Update();
+
+    Test_RandomSteps();
+    Test_MenuSteps();
+    Test_Continuous();
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
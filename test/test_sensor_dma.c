@@ -0,0 +1,226 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "Sensor.h"
+#include "Statistics.h"
+#include <stdio.h>
+#include <time.h>
+
+/*
+ * 文件名：test_sensor_dma.c
+ * 描    述：DMA计数模式测试（SENSOR_USE_DMA_COUNT、DELAY_USE_SYSTICK）
+ *          模拟硬件：每个孔TIM2计数器加1，DMA1通道5把GPIOA->IDR写入CMAR指向的缓冲区，CNDTR减1，
+ *          过半和到底时置位HT/TC标志并进入DMA1_Channel5_IRQHandler，中断返回后执行挂起且未被屏蔽的PendSV；
+ *          20万个料袋成批处理后的统计必须与逐个直接调用Statistics_ProcessChip相同，不足半个缓冲区的采样
+ *          由Sensor_ProcessInLoop定时处理；PendSV被屏蔽期间少于SENSOR_DMA_BUFFER_SIZE个孔照常处理，
+ *          超过时整批计入丢失，计数和序号保持连续
+ *          最后输出每半个缓冲区（128个采样）的处理耗时，供参考
+ */
+
+#define POCKETS 200000
+
+void PendSV_Handler(void);
+void DMA1_Channel5_IRQHandler(void);
+
+static uint32_t seed = 24;
+static uint32_t failures;
+static uint8_t chips[POCKETS];
+static clock_t half_time;
+static uint32_t halves;
+
+/*固定种子的线性同余随机数，各平台结果相同*/
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+}
+
+static void Check(uint8_t ok, const char *what)
+{
+    if (!ok)
+    {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+/*中断返回时执行挂起且未被屏蔽的PendSV（尾链）*/
+static void Tail_Chain(void)
+{
+    if ((SCB->ICSR & SCB_ICSR_PENDSVSET) && __get_BASEPRI() == 0)
+    {
+        SCB->ICSR = 0;
+        PendSV_Handler();
+    }
+}
+
+/*一个孔：TIM2计数，同一边沿的捕获DMA请求搬运一次GPIOA->IDR，半满/全满时进中断*/
+static void Hole(uint8_t chip)
+{
+    uint16_t *buffer = (uint16_t *)(uintptr_t)DMA1_Channel5->CMAR;
+    clock_t start;
+
+    if (chip)
+    {
+        GPIOA->IDR |= CHIP_DETECT_PIN;
+    }
+    else
+    {
+        GPIOA->IDR &= ~CHIP_DETECT_PIN;
+    }
+    TIM2->CNT = (uint16_t)(TIM2->CNT + 1);
+    buffer[SENSOR_DMA_BUFFER_SIZE - DMA1_Channel5->CNDTR] = (uint16_t)GPIOA->IDR;
+    DMA1_Channel5->CNDTR--;
+    if (DMA1_Channel5->CNDTR == SENSOR_DMA_BUFFER_SIZE / 2)
+    {
+        DMA1->ISR |= DMA1_IT_HT5 | DMA1_IT_GL5;
+    }
+    else if (DMA1_Channel5->CNDTR == 0)
+    {
+        DMA1->ISR |= DMA1_IT_TC5 | DMA1_IT_GL5;
+        DMA1_Channel5->CNDTR = SENSOR_DMA_BUFFER_SIZE; // 循环模式自动重装
+    }
+    else
+    {
+        return;
+    }
+
+    DMA1_Channel5_IRQHandler();
+    start = clock();
+    if (__get_BASEPRI() == 0)
+    {
+        halves++;
+    }
+    Tail_Chain();
+    half_time += clock() - start;
+}
+
+/*主循环定时处理不足半个缓冲区的采样*/
+static void Flush(void)
+{
+    Stub_Delay_AdvanceMs(SENSOR_DMA_FLUSH_MS);
+    Sensor_ProcessInLoop();
+    Tail_Chain();
+}
+
+static void Restart(carrier_class_t Carrier)
+{
+    Statistics_Reset();
+    Statistics_Resume();
+    carrier_class = Carrier;
+}
+
+static uint8_t Same(const StatisticsData_t *A, const StatisticsData_t *B)
+{
+    return A->lead_empty_count == B->lead_empty_count && A->middle_chip_count == B->middle_chip_count &&
+           A->trail_empty_count == B->trail_empty_count && A->Middle_LOSS == B->Middle_LOSS &&
+           A->Lead_Tail_ADD == B->Lead_Tail_ADD && A->current_stage == B->current_stage &&
+           A->empty_sequence_count == B->empty_sequence_count && A->chip_sequence_count == B->chip_sequence_count &&
+           A->yield_rate == B->yield_rate;
+}
+
+/*前导空，中间约2%缺失，后导空；与逐个直接处理比较*/
+static void Test_Match(void)
+{
+    StatisticsData_t batched;
+    SensorPocketStats_t pockets;
+    uint32_t i;
+
+    for (i = 0; i < POCKETS; i++)
+    {
+        chips[i] = (i >= 40 && i < POCKETS - 200) ? Random() % 50 != 0 : 0;
+    }
+
+    Restart(CARRIER_MSOP);
+    half_time = 0;
+    halves = 0;
+    for (i = 0; i < POCKETS; i++)
+    {
+        Hole(chips[i]);
+    }
+    printf("%u pockets: %u processed from half/full interrupts, %u left for the main loop\n", POCKETS,
+           exti0_trigger_count, POCKETS - exti0_trigger_count);
+    Check(exti0_trigger_count == POCKETS / (SENSOR_DMA_BUFFER_SIZE / 2) * (SENSOR_DMA_BUFFER_SIZE / 2),
+          "every complete half processed by the interrupt");
+    Flush();
+    batched = g_statistics;
+    Sensor_GetPocketStats(&pockets);
+    printf("middle %u, loss %u, trail %u; lost %u, max batch %u\n", batched.middle_chip_count, batched.Middle_LOSS,
+           batched.trail_empty_count, pockets.overflow, pockets.max_depth);
+    Check(exti0_trigger_count == POCKETS, "remaining samples processed by Sensor_ProcessInLoop");
+    Check(pockets.overflow == 0 && pockets.max_depth == SENSOR_DMA_BUFFER_SIZE / 2, "no pocket lost, half a buffer per batch");
+    Check(batched.current_stage == TAPE_STAGE_TRAIL_EMPTY, "tape reached the trail");
+
+    Restart(CARRIER_MSOP);
+    for (i = 0; i < POCKETS; i += 2)
+    {
+        Statistics_ProcessChip(chips[i] ? CHIP_PRESENT : CHIP_ABSENT); // 序号i+1为奇数
+    }
+    Check(Same(&batched, &g_statistics), "statistics from DMA batches match per-pocket processing");
+
+    printf("PendSV per %u-sample half: %.2f us, %.1f ns/pocket\n", SENSOR_DMA_BUFFER_SIZE / 2,
+           (double)half_time / CLOCKS_PER_SEC / halves * 1e6,
+           (double)half_time / CLOCKS_PER_SEC / halves / (SENSOR_DMA_BUFFER_SIZE / 2) * 1e9);
+}
+
+/*PendSV被屏蔽Count个孔后解锁，返回解锁后处理的料袋数*/
+static uint32_t Stall(uint32_t Count)
+{
+    uint32_t updates = g_statistics.update_count;
+    uint32_t i;
+
+    Sensor_LockCounting();
+    for (i = 0; i < Count; i++)
+    {
+        Hole(1);
+    }
+    Check(g_statistics.update_count == updates, "no pocket processed while locked");
+    Sensor_UnlockCounting();
+    Tail_Chain(); // 解锁时硬件立即执行挂起的PendSV
+    Flush();
+    return g_statistics.update_count - updates;
+}
+
+static void Test_Stall(void)
+{
+    SensorPocketStats_t pockets;
+    uint32_t processed;
+
+    /*差一个孔绕过一圈：缓冲区中的采样仍然有效*/
+    Restart(CARRIER_SOT);
+    processed = Stall(SENSOR_DMA_BUFFER_SIZE - 1);
+    Sensor_GetPocketStats(&pockets);
+    printf("stall of %u holes: %u processed, %u lost\n", SENSOR_DMA_BUFFER_SIZE - 1, processed, pockets.overflow);
+    Check(processed == SENSOR_DMA_BUFFER_SIZE - 1 && pockets.overflow == 0, "stall shorter than the buffer processed");
+
+    /*超过缓冲区长度：整批计入丢失*/
+    Restart(CARRIER_SOT);
+    processed = Stall(300);
+    Sensor_GetPocketStats(&pockets);
+    printf("stall of %u holes: %u processed, %u lost, trigger count %u\n", 300, processed, pockets.overflow,
+           exti0_trigger_count);
+    Check(processed == 0 && pockets.overflow == 300 && exti0_trigger_count == 300, "stall longer than the buffer counted as lost");
+
+    /*之后的孔照常处理，MSOP按硬件孔数保持奇偶：第301个处理，第302个不处理*/
+    carrier_class = CARRIER_MSOP;
+    processed = g_statistics.update_count;
+    Hole(1);
+    Flush();
+    Check(g_statistics.update_count == processed + 1 && exti0_trigger_count == 301, "hole 301 (odd) processed after the stall");
+    Hole(1);
+    Flush();
+    Check(g_statistics.update_count == processed + 1 && exti0_trigger_count == 302, "hole 302 (even) skipped");
+}
+
+int main(void)
+{
+    Stub_Reset();
+    Delay_Init();
+    Sensor_Init();
+    Statistics_Init();
+
+    Test_Match();
+    Test_Stall();
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
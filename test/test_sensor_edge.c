@@ -0,0 +1,166 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "Sensor.h"
+#include "Statistics.h"
+#include <stdio.h>
+
+/*
+ * 文件名：test_sensor_edge.c
+ * 描    述：定位孔边沿去抖测试
+ *          通过桩的输入捕获回调（相当于TIM2通道1捕获中断）送入带抖动的边沿序列：
+ *          1kHz每个孔后150us内最多5个抖动边沿、2.5kHz孔间隔±50us抖动、20Hz每个孔后250us抖动、
+ *          以及跨过2^32us回绕的1kHz序列；每种情况下有效边沿数必须等于孔数，
+ *          被剔除的边沿数必须等于抖动边沿数，每个孔之后的孔间隔必须等于与上一个孔的时间差
+ */
+
+#define HOLES 10000
+
+void PendSV_Handler(void);
+
+static uint32_t seed = 21;
+static uint32_t failures;
+static uint32_t time_base; // 当前情况的起始时刻，回绕情况从2^32之前开始
+
+/*固定种子的线性同余随机数，各平台结果相同*/
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+}
+
+/*捕获中断返回后执行挂起的PendSV，避免队列满影响计数*/
+static void Capture(uint32_t time_us)
+{
+    Stub_Delay_Capture(time_us);
+    if (SCB->ICSR & SCB_ICSR_PENDSVSET)
+    {
+        SCB->ICSR = 0;
+        PendSV_Handler();
+    }
+}
+
+typedef struct
+{
+    const char *name;
+    uint32_t holes;
+    uint32_t period_us;  // 孔的名义间隔
+    uint32_t jitter_us;  // 孔时刻在名义位置前后的最大偏移
+    uint32_t bounce_us;  // 抖动边沿距孔的最大时间
+    uint32_t max_bounce; // 每个孔后的最多抖动边沿数
+} Case_t;
+
+static void Run(const Case_t *Case)
+{
+    SensorIndexStats_t before, stats;
+    uint32_t accepted = exti0_trigger_count;
+    uint32_t bounces = 0, bad_period = 0;
+    uint32_t last = 0, hole, i, n, offset;
+
+    Sensor_GetIndexStats(&before);
+    for (i = 0; i < Case->holes; i++)
+    {
+        hole = time_base + i * Case->period_us;
+        if (Case->jitter_us)
+        {
+            hole = hole + Random() % (2 * Case->jitter_us + 1) - Case->jitter_us;
+        }
+        Capture(hole);
+
+        /*第一个孔与上一种情况的最后一个孔之间没有固定间隔，不检查*/
+        Sensor_GetIndexStats(&stats);
+        if (i > 0 && stats.period_us != hole - last)
+        {
+            if (bad_period < 5)
+            {
+                printf("FAIL %s: hole %u period %u us, expected %u us\n", Case->name, i, stats.period_us, hole - last);
+            }
+            bad_period++;
+        }
+        last = hole;
+
+        /*抖动边沿按时间顺序分布在孔之后bounce_us以内*/
+        n = Random() % (Case->max_bounce + 1);
+        offset = 0;
+        while (n--)
+        {
+            offset += 1 + Random() % ((Case->bounce_us - offset) / (n + 1));
+            Capture(hole + offset);
+            bounces++;
+        }
+    }
+
+    accepted = exti0_trigger_count - accepted;
+    Sensor_GetIndexStats(&stats);
+    printf("%-26s %5u holes accepted of %5u, %5u of %5u bounce edges rejected, last period %u us\n", Case->name,
+           accepted, Case->holes, stats.rejected - before.rejected, bounces, stats.period_us);
+    if (accepted != Case->holes)
+    {
+        printf("FAIL %s: %u holes accepted, expected %u\n", Case->name, accepted, Case->holes);
+        failures++;
+    }
+    if (stats.rejected - before.rejected != bounces)
+    {
+        printf("FAIL %s: %u edges rejected, expected %u\n", Case->name, stats.rejected - before.rejected, bounces);
+        failures++;
+    }
+    failures += bad_period;
+    time_base = last + 1000000; // 下一种情况在1秒后开始
+}
+
+/*最小间隔的边界：差1us被剔除，正好INDEX_HOLE_MIN_INTERVAL_US被接受*/
+static void Test_Boundary(void)
+{
+    SensorIndexStats_t before, stats;
+    uint32_t accepted = exti0_trigger_count;
+
+    Sensor_GetIndexStats(&before);
+    Capture(time_base);
+    Capture(time_base + INDEX_HOLE_MIN_INTERVAL_US - 1);
+    Capture(time_base + INDEX_HOLE_MIN_INTERVAL_US);
+    Sensor_GetIndexStats(&stats);
+    if (exti0_trigger_count - accepted != 2 || stats.rejected - before.rejected != 1 ||
+        stats.period_us != INDEX_HOLE_MIN_INTERVAL_US)
+    {
+        printf("FAIL minimum interval: %u accepted, %u rejected, period %u us\n", exti0_trigger_count - accepted,
+               stats.rejected - before.rejected, stats.period_us);
+        failures++;
+    }
+    time_base += 1000000;
+}
+
+int main(void)
+{
+    static const Case_t bounce = {.name = "1 kHz, 5 bounces in 150us", .holes = HOLES, .period_us = 1000,
+                                  .bounce_us = 150, .max_bounce = 5};
+    static const Case_t jitter = {.name = "2.5 kHz, +/-50us jitter", .holes = HOLES, .period_us = 400,
+                                  .jitter_us = 50, .bounce_us = 150, .max_bounce = 5};
+    static const Case_t slow = {.name = "20 Hz, bounce in 250us", .holes = 200, .period_us = 50000,
+                                .bounce_us = 250, .max_bounce = 5};
+    static const Case_t wrap = {.name = "1 kHz across 2^32 us", .holes = HOLES, .period_us = 1000,
+                                .bounce_us = 150, .max_bounce = 5};
+
+    Stub_Reset();
+    GPIOA->IDR = 0xFFFF; // 每个料袋都有芯片
+    Delay_Init();
+    Sensor_Init();
+    Statistics_Init();
+    Statistics_Resume();
+
+    time_base = 1000;
+    Run(&bounce);
+    Run(&jitter);
+    Run(&slow);
+    Test_Boundary();
+
+    /*一半的孔在回绕之前*/
+    time_base = (uint32_t)(0 - HOLES / 2 * 1000);
+    Run(&wrap);
+    if (time_base > HOLES * 1000 + 1000000)
+    {
+        printf("FAIL wrap case did not cross 2^32 us\n");
+        failures++;
+    }
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
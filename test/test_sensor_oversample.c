@@ -0,0 +1,207 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "Sensor.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * 文件名：test_sensor_oversample.c
+ * 描    述：芯片检测过采样测试（SENSOR_USE_CHIP_OVERSAMPLE）
+ *          采样次数1~32，采样字节的其它位随机：Sensor_PackChipSamples、Sensor_ChipMajority、Sensor_ChipRun
+ *          必须与逐位循环的结果相同；
+ *          最后在两种噪声波形上比较单次读取（边沿时刻的第一个采样）、多数表决和连续游程的误判率，供参考：
+ *          settle为边沿后前几个采样未稳定，spike为每个采样独立地出现反光尖峰或信号跌落
+ */
+
+#define TRIALS 2000
+#define POCKETS 100000
+#define SETTLE_MAX 3   // settle波形中未稳定的最多采样数
+#define SPIKE_RATE 10  // spike波形中每个采样出错的概率（%）
+
+static uint32_t seed = 25;
+static uint32_t failures;
+
+/*固定种子的线性同余随机数，各平台结果相同*/
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+}
+
+static uint32_t Random32(void)
+{
+    return Random() << 17 ^ Random() << 2 ^ Random();
+}
+
+/*逐字节取出芯片检测位*/
+static uint32_t Naive_Pack(const uint8_t *Samples, uint8_t Count)
+{
+    uint32_t bits = 0;
+    uint8_t i;
+
+    for (i = 0; i < Count; i++)
+    {
+        bits |= (uint32_t)((Samples[i] >> CHIP_DETECT_BIT) & 1) << i;
+    }
+    return bits;
+}
+
+static uint8_t Naive_Majority(uint32_t Bits, uint8_t Count)
+{
+    uint8_t ones = 0, i;
+
+    for (i = 0; i < Count; i++)
+    {
+        ones += (Bits >> i) & 1;
+    }
+    return ones * 2 > Count ? SENSOR_HIGH : SENSOR_LOW;
+}
+
+static uint8_t Naive_Run(uint32_t Bits, uint8_t Run)
+{
+    uint8_t length = 0, i;
+
+    for (i = 0; i < 32; i++)
+    {
+        length = (Bits >> i) & 1 ? length + 1 : 0;
+        if (length >= Run)
+        {
+            return SENSOR_HIGH;
+        }
+    }
+    return SENSOR_LOW;
+}
+
+static void Test_Bits(void)
+{
+    uint32_t words[8];
+    uint8_t *bytes = (uint8_t *)words; // DMA按字节写入，Sensor_PackChipSamples按字读取（小端）
+    uint32_t bits, mask, t, errors[3] = {0};
+    uint8_t count, i;
+
+    for (count = 1; count <= 32; count++)
+    {
+        mask = count < 32 ? (1UL << count) - 1 : 0xFFFFFFFF;
+        for (t = 0; t < TRIALS; t++)
+        {
+            /*其它位和没有采样的字节都是随机值*/
+            for (i = 0; i < 8; i++)
+            {
+                words[i] = Random32();
+            }
+            bits = Sensor_PackChipSamples(words, count);
+            if (bits != Naive_Pack(bytes, count))
+            {
+                if (errors[0]++ < 5)
+                {
+                    printf("FAIL pack %u samples: %08X, expected %08X\n", count, bits, Naive_Pack(bytes, count));
+                }
+            }
+
+            /*不同密度的位图，长游程和短游程都会出现*/
+            switch (t % 4)
+            {
+            case 0:
+                bits = Random32() & Random32();
+                break;
+            case 1:
+                bits = Random32();
+                break;
+            case 2:
+                bits = Random32() | Random32();
+                break;
+            default:
+                bits = Random32() | Random32() | Random32();
+                break;
+            }
+            bits &= mask;
+            if (Sensor_ChipMajority(bits, count) != Naive_Majority(bits, count))
+            {
+                if (errors[1]++ < 5)
+                {
+                    printf("FAIL majority of %u samples %08X\n", count, bits);
+                }
+            }
+            for (i = 1; i <= 32; i++)
+            {
+                if (Sensor_ChipRun(bits, i) != Naive_Run(bits, i))
+                {
+                    if (errors[2]++ < 5)
+                    {
+                        printf("FAIL run of %u in %08X\n", i, bits);
+                    }
+                }
+            }
+        }
+    }
+    printf("1..32 samples x %u: pack %u, majority %u, run %u mismatches\n", TRIALS, errors[0], errors[1], errors[2]);
+    failures += errors[0] + errors[1] + errors[2];
+}
+
+/*一个料袋的采样：Truth为实际状态，settle波形前几个采样随机，spike波形每个采样以SPIKE_RATE%的概率取反；
+  芯片检测位写入采样字节，其它位随机，经Sensor_PackChipSamples打包*/
+static uint32_t Sample(uint8_t Truth, uint8_t Spike)
+{
+    static uint32_t words[(CHIP_SAMPLE_COUNT + 3) / 4];
+    uint8_t *bytes = (uint8_t *)words;
+    uint8_t i, level, settle = Random() % (SETTLE_MAX + 1);
+
+    for (i = 0; i < sizeof(words); i++)
+    {
+        level = Truth;
+        if (Spike ? Random() % 100 < SPIKE_RATE : i < settle && (Random() & 1))
+        {
+            level = !level;
+        }
+        bytes[i] = (uint8_t)((Random() & ~(1u << CHIP_DETECT_BIT)) | level << CHIP_DETECT_BIT);
+    }
+    return Sensor_PackChipSamples(words, CHIP_SAMPLE_COUNT);
+}
+
+/*单次读取、多数表决、连续游程（2~6）的误判数*/
+static void Test_Noise(uint8_t Spike, const char *Name)
+{
+    uint32_t errors[7] = {0};
+    uint32_t bits, n;
+    uint8_t truth, run;
+
+    for (n = 0; n < POCKETS; n++)
+    {
+        truth = Random() & 1;
+        bits = Sample(truth, Spike);
+        errors[0] += (bits & 1) != truth; // 边沿时刻的第一个采样
+        errors[1] += Sensor_ChipMajority(bits, CHIP_SAMPLE_COUNT) != truth;
+        for (run = 2; run <= 6; run++)
+        {
+            errors[run] += Sensor_ChipRun(bits, run) != truth;
+        }
+    }
+
+    printf("%-6s single %5.2f%%  majority of %u %5.2f%%  run>=2 %5.2f%%  >=3 %5.2f%%  >=4 %5.2f%%  >=5 %5.2f%%  >=6 %5.2f%%\n",
+           Name, errors[0] * 100.0 / POCKETS, CHIP_SAMPLE_COUNT, errors[1] * 100.0 / POCKETS,
+           errors[2] * 100.0 / POCKETS, errors[3] * 100.0 / POCKETS, errors[4] * 100.0 / POCKETS,
+           errors[5] * 100.0 / POCKETS, errors[6] * 100.0 / POCKETS);
+    if (errors[1] >= errors[0])
+    {
+        printf("FAIL %s: majority no better than a single read\n", Name);
+        failures++;
+    }
+    /*未稳定的采样不超过一半，多数表决不会出错*/
+    if (!Spike && errors[1] != 0)
+    {
+        printf("FAIL %s: majority wrong with at most %u unsettled samples\n", Name, SETTLE_MAX);
+        failures++;
+    }
+}
+
+int main(void)
+{
+    Stub_Reset();
+
+    Test_Bits();
+    Test_Noise(0, "settle");
+    Test_Noise(1, "spike");
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,257 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "Sensor.h"
+#include "Statistics.h"
+#include "Screen.h"
+#include "Menu.h"
+#include "Menu_creat.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * 文件名：test_sensor_pendsv.c
+ * 描    述：PendSV计数下半部测试
+ *          每次桩的输入捕获回调（定位孔中断）返回后，若PendSV已挂起且未被BASEPRI屏蔽，则立即执行PendSV_Handler，
+ *          与硬件的尾链相同；1kHz的20万个料袋经队列处理后的统计必须与逐个直接调用Statistics_ProcessChip相同，
+ *          且没有丢失；报警回调（蜂鸣器、弹窗）不能在PendSV中执行，只能由主循环中的Sensor_ProcessInLoop执行；
+ *          Sensor_LockCounting期间到达的料袋留在队列中，Sensor_UnlockCounting后被取完；
+ *          PendSV被屏蔽时送入超过队列长度的料袋，丢失数、最大积压和料袋序号必须正确
+ */
+
+#define POCKETS 200000
+#define PERIOD_US 1000
+
+void PendSV_Handler(void);
+
+static uint32_t seed = 23;
+static uint32_t failures;
+static uint8_t chips[POCKETS];
+static uint8_t in_pendsv;
+static uint32_t pendsv_gpio_writes;
+static uint32_t pendsv_screens;
+
+/*固定种子的线性同余随机数，各平台结果相同*/
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+}
+
+static void Check(uint8_t ok, const char *what)
+{
+    if (!ok)
+    {
+        printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+/*蜂鸣器等输出只能在主循环中操作*/
+static void GPIO_Write(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, uint8_t Level)
+{
+    (void)GPIOx;
+    (void)GPIO_Pin;
+    (void)Level;
+    if (in_pendsv)
+    {
+        pendsv_gpio_writes++;
+    }
+}
+
+/*中断返回时执行挂起且未被屏蔽的PendSV（尾链）*/
+static void Tail_Chain(void)
+{
+    if ((SCB->ICSR & SCB_ICSR_PENDSVSET) && __get_BASEPRI() == 0)
+    {
+        SCB->ICSR = 0;
+        in_pendsv = 1;
+        PendSV_Handler();
+        in_pendsv = 0;
+        pendsv_screens += Screen_Top() != NULL;
+    }
+}
+
+/*一个孔：芯片检测电平在边沿前稳定，推进到边沿时刻后捕获*/
+static void Hole(uint8_t chip)
+{
+    if (chip)
+    {
+        GPIOA->IDR |= CHIP_DETECT_PIN;
+    }
+    else
+    {
+        GPIOA->IDR &= ~CHIP_DETECT_PIN;
+    }
+    Stub_Delay_AdvanceUs(PERIOD_US);
+    Stub_Delay_Capture(Delay_Get_Us());
+    Tail_Chain();
+}
+
+/*解锁时硬件立即执行被屏蔽期间挂起的PendSV*/
+static void Unlock(void)
+{
+    Sensor_UnlockCounting();
+    Tail_Chain();
+}
+
+static void Restart(carrier_class_t Carrier)
+{
+    Statistics_Reset();
+    Statistics_Resume();
+    carrier_class = Carrier;
+}
+
+/*载带：前导空，中间约2%缺失，后导空中夹几个多余芯片*/
+static void Make_Tape(uint32_t Count)
+{
+    uint32_t i;
+
+    for (i = 0; i < Count; i++)
+    {
+        if (i < 40 || i >= Count - 200)
+        {
+            chips[i] = (i % 50 == 24); // 序号为奇数，MSOP也处理
+        }
+        else
+        {
+            chips[i] = Random() % 50 != 0;
+        }
+    }
+}
+
+/*与队列处理前相同：定位孔中断中逐个直接处理，MSOP只处理奇数序号*/
+static void Direct(uint32_t Count, carrier_class_t Carrier)
+{
+    uint32_t i;
+
+    Restart(Carrier);
+    for (i = 0; i < Count; i++)
+    {
+        if (Carrier != CARRIER_MSOP || (i + 1) % 2 == 1)
+        {
+            Statistics_ProcessChip(chips[i] ? CHIP_PRESENT : CHIP_ABSENT);
+        }
+    }
+}
+
+static uint8_t Same(const StatisticsData_t *A, const StatisticsData_t *B)
+{
+    return A->lead_empty_count == B->lead_empty_count && A->middle_chip_count == B->middle_chip_count &&
+           A->trail_empty_count == B->trail_empty_count && A->Middle_LOSS == B->Middle_LOSS &&
+           A->Lead_Tail_ADD == B->Lead_Tail_ADD && A->current_stage == B->current_stage &&
+           A->empty_sequence_count == B->empty_sequence_count && A->chip_sequence_count == B->chip_sequence_count &&
+           A->yield_rate == B->yield_rate;
+}
+
+static void Test_Match(uint32_t Count, carrier_class_t Carrier, const char *Name)
+{
+    StatisticsData_t queued;
+    SensorPocketStats_t pockets;
+    uint32_t i;
+
+    Make_Tape(Count);
+    Restart(Carrier);
+    pendsv_gpio_writes = 0;
+    pendsv_screens = 0;
+    for (i = 0; i < Count; i++)
+    {
+        Hole(chips[i]);
+    }
+    queued = g_statistics;
+    Sensor_GetPocketStats(&pockets);
+
+    printf("%-5s %6u pockets: middle %u, loss %u, add %u, trail %u; lost %u, max depth %u, max latency %u us\n", Name,
+           Count, queued.middle_chip_count, queued.Middle_LOSS, queued.Lead_Tail_ADD, queued.trail_empty_count,
+           pockets.overflow, pockets.max_depth, pockets.max_latency_us);
+    Check(exti0_trigger_count == Count, "every hole counted");
+    Check(pockets.overflow == 0 && pockets.max_depth == 1, "pockets processed on every edge, none lost");
+    Check(queued.current_stage == TAPE_STAGE_TRAIL_EMPTY && queued.Lead_Tail_ADD > 0, "tape reached the trail with extra chips");
+    Check(pendsv_gpio_writes == 0 && pendsv_screens == 0, "no alarm callback inside PendSV");
+
+    /*报警在主循环中执行*/
+    Sensor_ProcessInLoop();
+    Check(Screen_Top() != NULL, "alarm callback runs from Sensor_ProcessInLoop");
+    while (Screen_Top() != NULL)
+    {
+        Screen_Pop();
+    }
+
+    Direct(Count, Carrier);
+    Check(Same(&queued, &g_statistics), "statistics through PendSV match direct processing");
+}
+
+/*加锁期间到达的料袋留在队列中，解锁后取完*/
+static void Test_Lock(void)
+{
+    SensorPocketStats_t pockets;
+    uint32_t updates;
+    uint8_t i;
+
+    Restart(CARRIER_SOT);
+    updates = g_statistics.update_count;
+    Sensor_LockCounting();
+    for (i = 0; i < 10; i++)
+    {
+        Hole(1);
+    }
+    Check(g_statistics.update_count == updates, "no pocket processed while locked");
+    Check((SCB->ICSR & SCB_ICSR_PENDSVSET) != 0, "PendSV left pending while locked");
+    Unlock();
+    Sensor_GetPocketStats(&pockets);
+    printf("10 pockets while locked: %u processed after unlock, max depth %u\n", g_statistics.update_count - updates,
+           pockets.max_depth);
+    Check(g_statistics.update_count - updates == 10 && pockets.max_depth == 10 && pockets.overflow == 0,
+          "pockets queued under the lock drained on unlock");
+}
+
+/*PendSV被屏蔽时队列满：丢失数、最大积压，序号保持连续*/
+static void Test_Overflow(void)
+{
+    SensorPocketStats_t pockets;
+    uint32_t updates;
+    uint32_t i;
+
+    Restart(CARRIER_SOT);
+    updates = g_statistics.update_count;
+    Sensor_LockCounting();
+    for (i = 0; i < SENSOR_POCKET_RING_SIZE + 36; i++)
+    {
+        Hole(1);
+    }
+    Unlock();
+    Sensor_GetPocketStats(&pockets);
+    printf("%u pockets with PendSV masked: %u lost, max depth %u, %u processed, trigger count %u\n",
+           SENSOR_POCKET_RING_SIZE + 36, pockets.overflow, pockets.max_depth, g_statistics.update_count - updates,
+           exti0_trigger_count);
+    Check(pockets.overflow == 36 && pockets.max_depth == SENSOR_POCKET_RING_SIZE, "overflow and max depth");
+    Check(g_statistics.update_count - updates == SENSOR_POCKET_RING_SIZE, "ring contents processed after unlock");
+    Check(exti0_trigger_count == SENSOR_POCKET_RING_SIZE + 36, "lost pockets still counted");
+
+    /*MSOP只处理奇数序号：丢失的料袋也占序号，之后的第101个处理，第102个不处理*/
+    carrier_class = CARRIER_MSOP;
+    updates = g_statistics.update_count;
+    Hole(1);
+    Check(g_statistics.update_count == updates + 1, "pocket 101 (odd) processed");
+    Hole(1);
+    Check(g_statistics.update_count == updates + 1 && exti0_trigger_count == SENSOR_POCKET_RING_SIZE + 38,
+          "pocket 102 (even) skipped, ordinals continuous");
+}
+
+int main(void)
+{
+    Stub_Reset();
+    Stub_GPIO_WriteHook = GPIO_Write;
+    OLED_Init();
+    Menu_Setup(); // 关闭报警界面后回到菜单
+    Delay_Init();
+    Sensor_Init();
+    Statistics_Init();
+
+    Test_Match(POCKETS, CARRIER_MSOP, "MSOP");
+    Test_Match(POCKETS / 10, CARRIER_SOT, "SOT");
+    Test_Lock();
+    Test_Overflow();
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,398 @@
+#include "stm32f10x.h"
+#include "stub.h"
+#include "OLED.h"
+#include "Widget.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * 文件名：test_widget.c
+ * 描    述：保留模式控件测试
+ *          随机设置标签、数值字段、进度条和列表行，每次设置后显存数组必须与从空白屏幕直接绘制的结果相同，
+ *          录制接口还原的屏幕必须与显存数组相同；内容未变化时不发送任何数据，只改一个字符时只发送该字符格
+ *          最后按实时计数界面的布局，模拟每秒200个料袋，比较清屏重绘与控件两种方式每秒发送的字节数
+ */
+
+extern uint8_t OLED_DisplayBuf[8][128];
+
+#define RANDOM_STEPS 5000
+#define FEED_RATE 200 // 每秒料袋数
+#define FEED_SECONDS 10
+
+static uint32_t seed = 3;
+static uint32_t failures;
+
+/*固定种子的线性同余随机数，各平台结果相同*/
+static uint32_t Random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0x7FFF;
+}
+
+/*更新屏幕，返回发送的字节数，并检查屏幕与显存数组一致*/
+static uint32_t Frame(void)
+{
+    uint32_t Before = OLED_GetSentBytes();
+    uint32_t diff = 0;
+    int16_t X, Y;
+
+    OLED_Update();
+    for (Y = 0; Y < 64; Y++)
+    {
+        for (X = 0; X < 128; X++)
+        {
+            diff += OLED_Recorder_GetPoint(X, Y) != OLED_GetPoint(X, Y);
+        }
+    }
+    if (diff)
+    {
+        printf("FAIL screen differs from the frame buffer in %u pixels\n", diff);
+        failures++;
+    }
+    return OLED_GetSentBytes() - Before;
+}
+
+/*随机测试的控件和它们当前的内容*/
+typedef enum
+{
+    KIND_LABEL,
+    KIND_NUMBER,
+    KIND_BAR,
+    KIND_ROW
+} Kind_t;
+
+typedef struct
+{
+    Kind_t kind;
+    Widget_t w;
+    char text[32];
+    int32_t value;
+    uint32_t max;
+    uint8_t selected;
+} Item_t;
+
+static Item_t items[6]; // 各控件区域互不重叠
+
+static void Items_Init(void)
+{
+    items[0].kind = KIND_LABEL;
+    Widget_InitLabel(&items[0].w, 0, 0, OLED_6X8);
+    items[1].kind = KIND_NUMBER;
+    Widget_InitNumber(&items[1].w, 0, 8, OLED_8X16, "F: ", "%", 1);
+    items[2].kind = KIND_NUMBER;
+    Widget_InitNumber(&items[2].w, 0, 24, OLED_6X8, NULL, NULL, 0);
+    items[3].kind = KIND_BAR;
+    Widget_InitBar(&items[3].w, 4, 33, 120, 6);
+    items[4].kind = KIND_ROW;
+    Widget_InitRow(&items[4].w, 0, 40, 128, OLED_8X16);
+    items[5].kind = KIND_ROW;
+    Widget_InitRow(&items[5].w, 0, 56, 96, OLED_6X8);
+}
+
+static void Item_Set(Item_t *item)
+{
+    switch (item->kind)
+    {
+    case KIND_LABEL:
+        Widget_SetText(&item->w, item->text);
+        break;
+    case KIND_NUMBER:
+        Widget_SetNumber(&item->w, item->value);
+        break;
+    case KIND_BAR:
+        Widget_SetBar(&item->w, item->value, item->max);
+        break;
+    case KIND_ROW:
+        Widget_SetRow(&item->w, item->text, item->selected);
+        break;
+    }
+}
+
+/*不经过控件，直接绘制控件当前内容*/
+static void Item_DrawReference(const Item_t *item)
+{
+    const Widget_t *w = &item->w;
+    char buf[WIDGET_TEXT_LEN + 1];
+    Format_t fmt;
+    uint8_t n;
+
+    switch (item->kind)
+    {
+    case KIND_LABEL:
+        strncpy(buf, item->text, WIDGET_TEXT_LEN);
+        buf[WIDGET_TEXT_LEN] = '\0';
+        OLED_ShowString(w->x, w->y, buf, w->font);
+        break;
+    case KIND_NUMBER:
+        Format_Init(&fmt, buf, sizeof(buf));
+        Format_Str(&fmt, w->prefix != NULL ? w->prefix : "");
+        Format_Fixed(&fmt, item->value, w->frac);
+        Format_Str(&fmt, w->suffix != NULL ? w->suffix : "");
+        OLED_ShowString(w->x, w->y, buf, w->font);
+        break;
+    case KIND_BAR:
+        OLED_DrawRectangle(w->x, w->y, w->width, w->height, OLED_UNFILLED);
+        n = item->max ? (uint32_t)item->value * (w->width - 2) / item->max : 0;
+        if (n > 0)
+        {
+            OLED_DrawRectangle(w->x + 1, w->y + 1, n, w->height - 2, OLED_FILLED);
+        }
+        break;
+    case KIND_ROW:
+        n = w->width / w->font;
+        strncpy(buf, item->text, n);
+        buf[n] = '\0';
+        OLED_ShowString(w->x, w->y, buf, w->font);
+        if (item->selected)
+        {
+            OLED_ReverseArea(w->x, w->y, w->width, w->height);
+        }
+        break;
+    }
+}
+
+static void RandomText(char *text, uint8_t MaxLen)
+{
+    uint8_t len = Random() % (MaxLen + 1);
+    uint8_t i;
+
+    /*从上次的文本随机改动几个字符，或整体换成新文本*/
+    if (Random() % 4 == 0 || strlen(text) == 0)
+    {
+        for (i = 0; i < len; i++)
+        {
+            text[i] = 'A' + Random() % 26;
+        }
+        text[len] = '\0';
+    }
+    else
+    {
+        text[Random() % strlen(text)] = 'a' + Random() % 26;
+    }
+}
+
+static void Test_Random(void)
+{
+    static uint8_t actual[8][128];
+    uint32_t step, bad = 0, k;
+
+    OLED_Clear();
+    Items_Init();
+    for (k = 0; k < 6; k++)
+    {
+        items[k].max = 100;
+        Item_Set(&items[k]);
+    }
+    Frame();
+
+    for (step = 0; step < RANDOM_STEPS; step++)
+    {
+        Item_t *item = &items[Random() % 6];
+        uint32_t Bytes;
+
+        switch (item->kind)
+        {
+        case KIND_LABEL:
+            RandomText(item->text, 25);
+            break;
+        case KIND_NUMBER:
+            item->value = Random() % 3 ? item->value + (int32_t)(Random() % 21) - 10 : (int32_t)(Random() * 7) - 100000;
+            break;
+        case KIND_BAR:
+            item->max = Random() % 4 ? 100 : Random() % 1000;
+            item->value = Random() % (item->max + 20);
+            if ((uint32_t)item->value > item->max)
+            {
+                item->value = item->max;
+            }
+            break;
+        case KIND_ROW:
+            RandomText(item->text, 24);
+            if (Random() % 4 == 0)
+            {
+                item->selected = !item->selected;
+            }
+            break;
+        }
+        Item_Set(item);
+
+        /*与从空白屏幕直接绘制的结果比较*/
+        memcpy(actual, OLED_DisplayBuf, sizeof(actual));
+        memset(OLED_DisplayBuf, 0, sizeof(actual));
+        for (k = 0; k < 6; k++)
+        {
+            Item_DrawReference(&items[k]);
+        }
+        if (memcmp(actual, OLED_DisplayBuf, sizeof(actual)) != 0)
+        {
+            if (bad < 5)
+            {
+                printf("FAIL step %u: widget %u differs from a fresh drawing\n", step, (uint32_t)(item - items));
+            }
+            bad++;
+        }
+        memcpy(OLED_DisplayBuf, actual, sizeof(actual));
+        Frame();
+
+        /*再设置一次相同的内容，不应发送任何数据*/
+        Item_Set(item);
+        Bytes = Frame();
+        if (Bytes != 0)
+        {
+            if (bad < 5)
+            {
+                printf("FAIL step %u: unchanged widget %u sent %u bytes\n", step, (uint32_t)(item - items), Bytes);
+            }
+            bad++;
+        }
+    }
+    printf("%u random widget updates, %u mismatches\n", RANDOM_STEPS, bad);
+    failures += bad;
+}
+
+/*数值只变一位时只发送该字符格*/
+static void Test_OneDigit(void)
+{
+    Widget_t w;
+    uint32_t Bytes;
+
+    OLED_Clear();
+    Widget_InitNumber(&w, 20, 16, OLED_8X16, "C: ", NULL, 0);
+    Widget_SetNumber(&w, 1000);
+    Frame();
+    Widget_SetNumber(&w, 1001);
+    Bytes = Frame();
+    printf("one 8x16 digit changed: %u bytes\n", Bytes);
+    /*两页各一次传输，每次最多8列数据，外加设置页列地址的命令*/
+    if (Bytes == 0 || Bytes > 2 * ((2 + 8) + 3 * 3))
+    {
+        printf("FAIL one digit sent %u bytes\n", Bytes);
+        failures++;
+    }
+}
+
+/*实时计数界面*********************/
+
+typedef struct
+{
+    uint32_t lead, loss, chip, hole, tail, add;
+    int32_t yield; // 合格率，单位0.1%
+    uint8_t stage;
+} Counting_t;
+
+static const char *stage_names[] = {"Lead", "Chips", "Tail"};
+
+static void ShowCount(int16_t X, int16_t Y, const char *Label, uint32_t Value)
+{
+    char buf[24];
+    Format_t fmt;
+
+    Format_Init(&fmt, buf, sizeof(buf));
+    Format_Str(&fmt, Label);
+    Format_Uint(&fmt, Value, 0, 0);
+    OLED_ShowString(X, Y, buf, OLED_8X16);
+}
+
+/*改写前的方式：清屏后重绘全部内容*/
+static void Counting_Redraw(const Counting_t *d)
+{
+    char buf[24];
+    Format_t fmt;
+
+    OLED_Clear();
+    OLED_ShowString(0, 0, (char *)stage_names[d->stage], OLED_6X8);
+    Format_Init(&fmt, buf, sizeof(buf));
+    Format_Str(&fmt, "Yield:");
+    Format_Fixed(&fmt, d->yield, 1);
+    Format_Char(&fmt, '%');
+    OLED_ShowString(32, 0, buf, OLED_8X16);
+    ShowCount(0, 16, "F: ", d->lead);
+    ShowCount(62, 16, "LOSS :", d->loss);
+    ShowCount(0, 32, "C: ", d->chip);
+    ShowCount(62, 32, "H: ", d->hole);
+    ShowCount(0, 48, "T: ", d->tail);
+    ShowCount(62, 48, "ADD: ", d->add);
+}
+
+static Widget_t counting_widgets[8];
+
+static void Counting_Widgets(const Counting_t *d)
+{
+    Widget_t *w = counting_widgets;
+
+    if (!w[0].height)
+    {
+        OLED_Clear();
+        Widget_InitLabel(&w[0], 0, 0, OLED_6X8);
+        Widget_InitNumber(&w[1], 32, 0, OLED_8X16, "Yield:", "%", 1);
+        Widget_InitNumber(&w[2], 0, 16, OLED_8X16, "F: ", NULL, 0);
+        Widget_InitNumber(&w[3], 62, 16, OLED_8X16, "LOSS :", NULL, 0);
+        Widget_InitNumber(&w[4], 0, 32, OLED_8X16, "C: ", NULL, 0);
+        Widget_InitNumber(&w[5], 62, 32, OLED_8X16, "H: ", NULL, 0);
+        Widget_InitNumber(&w[6], 0, 48, OLED_8X16, "T: ", NULL, 0);
+        Widget_InitNumber(&w[7], 62, 48, OLED_8X16, "ADD: ", NULL, 0);
+    }
+    Widget_SetText(&w[0], stage_names[d->stage]);
+    Widget_SetNumber(&w[1], d->yield);
+    Widget_SetNumber(&w[2], d->lead);
+    Widget_SetNumber(&w[3], d->loss);
+    Widget_SetNumber(&w[4], d->chip);
+    Widget_SetNumber(&w[5], d->hole);
+    Widget_SetNumber(&w[6], d->tail);
+    Widget_SetNumber(&w[7], d->add);
+}
+
+/*每个料袋刷新一帧，返回每秒发送的字节数*/
+static uint32_t Feed(void (*Draw)(const Counting_t *d), const char *name)
+{
+    Counting_t d = {12, 0, 1000, 1012, 0, 0, 1000, 1};
+    uint32_t Bytes = 0, n;
+    clock_t start;
+    double seconds;
+
+    Draw(&d);
+    Frame();
+    start = clock();
+    for (n = 0; n < FEED_RATE * FEED_SECONDS; n++)
+    {
+        d.chip++;
+        d.hole++;
+        if (n % 97 == 0)
+        {
+            d.loss++;
+        }
+        d.yield = (int32_t)((uint64_t)d.chip * 1000 / (d.chip + d.loss));
+        Draw(&d);
+        Bytes += Frame();
+    }
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%-14s %u bytes/s, %.1f us/frame including the check\n", name, Bytes / FEED_SECONDS,
+           seconds * 1e6 / (FEED_RATE * FEED_SECONDS));
+    return Bytes / FEED_SECONDS;
+}
+
+/*********************实时计数界面*/
+
+int main(void)
+{
+    uint32_t redraw, widgets;
+
+    Stub_Reset();
+    OLED_Init();
+
+    Test_Random();
+    Test_OneDigit();
+
+    OLED_Clear();
+    redraw = Feed(Counting_Redraw, "clear+redraw:");
+    widgets = Feed(Counting_Widgets, "widgets:");
+    if (widgets > redraw)
+    {
+        printf("FAIL widgets send more than clear+redraw\n");
+        failures++;
+    }
+
+    printf("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}